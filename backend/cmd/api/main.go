@@ -1,7 +1,10 @@
 package main
 
 import (
+	"context"
 	"log"
+	"path/filepath"
+	"time"
 
 	"github.com/gin-gonic/gin"
 
@@ -9,6 +12,7 @@ import (
 	"ticket-system/backend/internal/config"
 	"ticket-system/backend/internal/delivery"
 	"ticket-system/backend/internal/middleware"
+	"ticket-system/backend/internal/model"
 	"ticket-system/backend/internal/repository"
 	"ticket-system/backend/internal/repository/adapters"
 	"ticket-system/backend/internal/usecase"
@@ -78,10 +82,37 @@ func main() {
 	attachmentRepo := repository.NewTicketAttachmentRepository(db)
 	attachmentHandler := delivery.NewTicketAttachmentHandler(attachmentRepo, ticketRepo)
 
+	blobRepo := repository.NewAttachmentBlobRepository(db, filepath.Join(cfg.AttachmentDir, "blobs"))
+	uploadService := usecase.NewUploadService(repository.NewAttachmentUploadRepository(db), attachmentRepo, blobRepo, cfg.UploadDir, cfg.AttachmentDir, cfg.UploadChunkSize, cfg.UploadMaxSize)
+	uploadHandler := delivery.NewAttachmentUploadHandler(uploadService, ticketRepo)
+	go uploadService.RunPurge(context.Background(), time.Hour)
+
+	// Change push: database triggers -> LISTEN -> coalescing feed -> /events streams.
+	eventHub := usecase.NewEventHub()
+	changes := make(chan model.ChangeNotification, 1024)
+	go repository.ListenForChanges(context.Background(), cfg.DBUrl, changes)
+	go usecase.NewChangeFeed(ticketRepo, eventHub).Run(context.Background(), changes)
+	eventHandler := delivery.NewEventHandler(eventHub)
+
+	idempotencyRepo := repository.NewIdempotencyRepository(db)
+	go middleware.PurgeIdempotencyKeys(context.Background(), idempotencyRepo, time.Hour)
+
+	// Partitions ahead of the clock, cold ones moved to tickets_archive.
+	partitionManager := usecase.NewPartitionManager(repository.NewTicketPartitionRepository(db),
+		cfg.PartitionGranularity, cfg.PartitionsAhead, cfg.HotMonths)
+	go partitionManager.Run(context.Background(), 6*time.Hour)
+
+	// Dashboard counts are written by triggers as deltas and folded on a timer; the
+	// age buckets are refreshed on another.
+	dashboardService := usecase.NewDashboardService(repository.NewDashboardRepository(db))
+	go dashboardService.Run(context.Background(), 5*time.Minute)
+	go dashboardService.RunFold(context.Background(), 5*time.Second)
+	dashboardHandler := delivery.NewDashboardHandler(dashboardService)
+
 	r := gin.New()
 
 	r.Use(gin.Logger())
-	r.Use(gin.Recovery())
+	r.Use(middleware.Recovery())
 
 	r.GET("/swagger/*any", ginSwagger.WrapHandler(swaggerFiles.Handler))
 
@@ -99,12 +130,14 @@ func main() {
 
 	protected := api.Group("")
 	protected.Use(middleware.JWT(cfg.JWTSecret))
+	protected.Use(middleware.Idempotency(idempotencyRepo))
 	// Ticket
 	protected.GET("/tickets", ticketHandler.GetTickets)
 	protected.POST("/tickets", ticketHandler.CreateTicket)
 	protected.GET("/tickets/:id", ticketHandler.GetTicketByID)
 	protected.PATCH("/tickets/:id", ticketHandler.UpdateTicket)
 	protected.DELETE("/tickets/:id", ticketHandler.DeleteTicket)
+	protected.POST("/tickets/batch", ticketHandler.BatchTickets)
 	// Ticket history
 	protected.GET("/tickets/:id/history", historyHandler.GetHistory)
 	// Ticket comments
@@ -117,6 +150,23 @@ func main() {
 	protected.GET("/tickets/:id/attachments/:att_id", attachmentHandler.GetAttachmentByID)
 	protected.DELETE("/tickets/:id/attachments/:att_id", attachmentHandler.DeleteAttachment)
 	protected.GET("/tickets/:id/attachments/:att_id/download", attachmentHandler.DownloadAttachment)
+	protected.GET("/tickets/:id/attachments/:att_id/thumbnail", attachmentHandler.GetThumbnail)
+	protected.GET("/tickets/:id/attachments/archive", attachmentHandler.DownloadTicketArchive)
+	protected.GET("/attachments/archive", attachmentHandler.DownloadArchive)
+
+	// Chunked attachment uploads
+	protected.POST("/tickets/:id/uploads", uploadHandler.InitiateUpload)
+	protected.GET("/tickets/:id/uploads/:upload_id", uploadHandler.GetUpload)
+	protected.PUT("/tickets/:id/uploads/:upload_id/chunks/:offset", uploadHandler.PutChunk)
+	protected.POST("/tickets/:id/uploads/:upload_id/commit", uploadHandler.CommitUpload)
+	protected.DELETE("/tickets/:id/uploads/:upload_id", uploadHandler.AbortUpload)
+	protected.GET("/blobs/:sha256", uploadHandler.GetBlob)
+	protected.HEAD("/blobs/:sha256", uploadHandler.GetBlob)
+	protected.POST("/tickets/:id/attachments/by-hash", uploadHandler.AttachBlob)
+	// Change push
+	protected.GET("/events", eventHandler.Stream)
+	// Dashboard
+	protected.GET("/dashboard", dashboardHandler.GetDashboard)
 
 	if err := r.Run(":" + cfg.ServerPort); err != nil {
 		log.Fatalf("failed to start server: %v", err)
@@ -2,21 +2,34 @@ package config
 
 import (
 	"os"
+	"strconv"
 )
 
 type Config struct {
-	DBUrl      string
-	JWTSecret  string
-	ServerPort string
-	LogLevel   string
+	DBUrl           string
+	JWTSecret       string
+	ServerPort      string
+	LogLevel        string
+	UploadDir       string
+	AttachmentDir   string
+	UploadChunkSize int64
+	UploadMaxSize   int64
+	// Partition management of tickets: "year" or "month" partitions, how many
+	// periods to create ahead, and after how many months a partition is archived
+	// (0 keeps everything in the hot partitions).
+	PartitionGranularity string
+	PartitionsAhead      int
+	HotMonths            int
 }
 
 func LoadConfig() *Config {
 	cfg := &Config{
-		DBUrl:      os.Getenv("DB_URL"),
-		JWTSecret:  os.Getenv("JWT_SECRET"),
-		ServerPort: os.Getenv("SERVER_PORT"),
-		LogLevel:   os.Getenv("LOG_LEVEL"),
+		DBUrl:         os.Getenv("DB_URL"),
+		JWTSecret:     os.Getenv("JWT_SECRET"),
+		ServerPort:    os.Getenv("SERVER_PORT"),
+		LogLevel:      os.Getenv("LOG_LEVEL"),
+		UploadDir:     os.Getenv("UPLOAD_DIR"),
+		AttachmentDir: os.Getenv("ATTACHMENT_DIR"),
 	}
 	if cfg.ServerPort == "" {
 		cfg.ServerPort = "8080"
@@ -24,5 +37,30 @@ func LoadConfig() *Config {
 	if cfg.LogLevel == "" {
 		cfg.LogLevel = "info"
 	}
+	if cfg.UploadDir == "" {
+		cfg.UploadDir = "data/uploads"
+	}
+	if cfg.AttachmentDir == "" {
+		cfg.AttachmentDir = "data/attachments"
+	}
+	cfg.UploadChunkSize, _ = strconv.ParseInt(os.Getenv("UPLOAD_CHUNK_SIZE"), 10, 64)
+	if cfg.UploadChunkSize <= 0 {
+		cfg.UploadChunkSize = 8 << 20
+	}
+	cfg.UploadMaxSize, _ = strconv.ParseInt(os.Getenv("UPLOAD_MAX_SIZE"), 10, 64)
+	if cfg.UploadMaxSize <= 0 {
+		cfg.UploadMaxSize = 4 << 30
+	}
+	cfg.PartitionGranularity = os.Getenv("TICKET_PARTITION_GRANULARITY")
+	if cfg.PartitionGranularity == "" {
+		cfg.PartitionGranularity = "year"
+	}
+	var err error
+	if cfg.PartitionsAhead, err = strconv.Atoi(os.Getenv("TICKET_PARTITIONS_AHEAD")); err != nil || cfg.PartitionsAhead < 0 {
+		cfg.PartitionsAhead = 1
+	}
+	if cfg.HotMonths, err = strconv.Atoi(os.Getenv("TICKET_HOT_MONTHS")); err != nil || cfg.HotMonths < 0 {
+		cfg.HotMonths = 24
+	}
 	return cfg
 }
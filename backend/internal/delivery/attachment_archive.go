@@ -0,0 +1,171 @@
+package delivery
+
+import (
+	"archive/zip"
+	"compress/flate"
+	"fmt"
+	"io"
+	"log"
+	"net/http"
+	"os"
+	"path"
+	"strconv"
+	"strings"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+)
+
+// maxArchiveTickets bounds a multi-ticket export request.
+const maxArchiveTickets = 200
+
+// archiveCopyBuffer is the buffer each entry is streamed through.
+const archiveCopyBuffer = 256 << 10
+
+// storedExtensions are formats that are already compressed; deflating them only costs CPU.
+var storedExtensions = map[string]bool{
+	".jpg": true, ".jpeg": true, ".png": true, ".gif": true, ".webp": true,
+	".zip": true, ".gz": true, ".tgz": true, ".bz2": true, ".xz": true, ".zst": true, ".7z": true, ".rar": true,
+	".mp4": true, ".mov": true, ".mkv": true, ".mp3": true, ".pdf": true, ".docx": true, ".xlsx": true,
+}
+
+// DownloadTicketArchive streams all attachments of one ticket as a zip.
+func (h *TicketAttachmentHandler) DownloadTicketArchive(c *gin.Context) {
+	ticketID, err := uuid.Parse(c.Param("id"))
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid ticket id"})
+		return
+	}
+	h.streamArchive(c, []uuid.UUID{ticketID}, "ticket-"+ticketID.String()+"-attachments.zip")
+}
+
+// DownloadArchive streams the attachments of several tickets (?ticket_ids=a,b,...) as one
+// zip, with a folder per ticket.
+func (h *TicketAttachmentHandler) DownloadArchive(c *gin.Context) {
+	var ticketIDs []uuid.UUID
+	seen := map[uuid.UUID]bool{}
+	for _, raw := range strings.Split(c.Query("ticket_ids"), ",") {
+		if raw = strings.TrimSpace(raw); raw == "" {
+			continue
+		}
+		id, err := uuid.Parse(raw)
+		if err != nil {
+			c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid ticket id", Details: raw})
+			return
+		}
+		if !seen[id] {
+			seen[id] = true
+			ticketIDs = append(ticketIDs, id)
+		}
+	}
+	if len(ticketIDs) == 0 || len(ticketIDs) > maxArchiveTickets {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: fmt.Sprintf("ticket_ids must list 1 to %d tickets", maxArchiveTickets)})
+		return
+	}
+	h.streamArchive(c, ticketIDs, "attachments-"+time.Now().UTC().Format("20060102-150405")+".zip")
+}
+
+type archiveEntry struct {
+	name string
+	att  *domain.TicketAttachment
+}
+
+func (h *TicketAttachmentHandler) streamArchive(c *gin.Context, ticketIDs []uuid.UUID, filename string) {
+	// Collect metadata first so errors can still be reported as JSON and the
+	// client gets the payload size before the first byte of the body.
+	var entries []archiveEntry
+	var total int64
+	for _, ticketID := range ticketIDs {
+		atts, err := h.Repo.GetByTicketID(ticketID)
+		if err != nil {
+			c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+			return
+		}
+		dir := ""
+		if len(ticketIDs) > 1 {
+			dir = ticketID.String() + "/"
+		}
+		used := map[string]bool{}
+		for _, att := range atts {
+			entries = append(entries, archiveEntry{name: dir + uniqueArchiveName(att.Filename, used), att: att})
+			total += att.SizeBytes
+		}
+	}
+	if len(entries) == 0 {
+		c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: "No attachments to export"})
+		return
+	}
+
+	c.Header("Content-Type", "application/zip")
+	c.Header("Content-Disposition", "attachment; filename=\""+filename+"\"")
+	c.Header("Cache-Control", "no-store")
+	// The zip is built on the fly, so its length is unknown; this is the sum of the file sizes.
+	c.Header("X-Archive-Files", strconv.Itoa(len(entries)))
+	c.Header("X-Archive-Uncompressed-Size", strconv.FormatInt(total, 10))
+	c.Status(http.StatusOK)
+
+	zw := zip.NewWriter(c.Writer)
+	// Favour throughput: the export should be bound by disk and network, not by deflate.
+	zw.RegisterCompressor(zip.Deflate, func(out io.Writer) (io.WriteCloser, error) {
+		return flate.NewWriter(out, flate.BestSpeed)
+	})
+	buf := make([]byte, archiveCopyBuffer)
+	for _, entry := range entries {
+		if err := h.writeArchiveEntry(zw, entry, buf); err != nil {
+			// Headers are gone. Panicking with ErrAbortHandler makes net/http reset the
+			// connection without logging a stack, so the client sees a network error
+			// instead of a well-terminated body that is merely a truncated zip.
+			log.Printf("attachment archive: %s: %v", entry.name, err)
+			panic(http.ErrAbortHandler)
+		}
+		c.Writer.Flush()
+	}
+	if err := zw.Close(); err != nil {
+		log.Printf("attachment archive: %v", err)
+	}
+}
+
+func (h *TicketAttachmentHandler) writeArchiveEntry(zw *zip.Writer, entry archiveEntry, buf []byte) error {
+	var src io.Reader
+	if entry.att.FilePath != nil {
+		f, err := os.Open(*entry.att.FilePath)
+		if err != nil {
+			return err
+		}
+		defer f.Close()
+		src = f
+	} else {
+		src = &attachmentContent{repo: h.Repo, id: entry.att.ID, size: entry.att.SizeBytes}
+	}
+	header := &zip.FileHeader{Name: entry.name, Method: zip.Deflate, Modified: entry.att.UploadedAt}
+	if storedExtensions[strings.ToLower(path.Ext(entry.name))] {
+		header.Method = zip.Store
+	}
+	w, err := zw.CreateHeader(header)
+	if err != nil {
+		return err
+	}
+	_, err = io.CopyBuffer(w, src, buf)
+	return err
+}
+
+// uniqueArchiveName keeps entry names flat and distinct: "a.log", "a (2).log", ...
+// An attachment literally named "a (2).log" takes that name, and later copies
+// of "a.log" skip past it.
+func uniqueArchiveName(filename string, used map[string]bool) string {
+	name := path.Base(strings.ReplaceAll(filename, "\\", "/"))
+	if name == "." || name == "/" || name == ".." {
+		name = "attachment"
+	}
+	ext := path.Ext(name)
+	candidate := name
+	for n := 2; used[candidate]; n++ {
+		candidate = fmt.Sprintf("%s (%d)%s", strings.TrimSuffix(name, ext), n, ext)
+	}
+	used[candidate] = true
+	return candidate
+}
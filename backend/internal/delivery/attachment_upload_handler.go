@@ -0,0 +1,259 @@
+package delivery
+
+import (
+	"errors"
+	"net/http"
+	"strconv"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+	"ticket-system/backend/internal/usecase"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+)
+
+type AttachmentUploadHandler struct {
+	Service    *usecase.UploadService
+	TicketRepo usecase.TicketRepository
+}
+
+func NewAttachmentUploadHandler(service *usecase.UploadService, ticketRepo usecase.TicketRepository) *AttachmentUploadHandler {
+	return &AttachmentUploadHandler{Service: service, TicketRepo: ticketRepo}
+}
+
+func currentUserID(c *gin.Context) (uuid.UUID, bool) {
+	userIDRaw, exists := c.Get("user_id")
+	if !exists {
+		c.JSON(http.StatusUnauthorized, model.APIError{Code: "401", Message: "No user_id in token"})
+		return uuid.Nil, false
+	}
+	userIDStr, ok := userIDRaw.(string)
+	if !ok {
+		c.JSON(http.StatusUnauthorized, model.APIError{Code: "401", Message: "user_id in token is not a string"})
+		return uuid.Nil, false
+	}
+	userID, err := uuid.Parse(userIDStr)
+	if err != nil {
+		c.JSON(http.StatusUnauthorized, model.APIError{Code: "401", Message: "Invalid user_id in token"})
+		return uuid.Nil, false
+	}
+	return userID, true
+}
+
+// loadUpload resolves :upload_id and checks that it belongs to the caller and to
+// the ticket in :id.
+func (h *AttachmentUploadHandler) loadUpload(c *gin.Context) (*domain.AttachmentUpload, bool) {
+	userID, ok := currentUserID(c)
+	if !ok {
+		return nil, false
+	}
+	ticketID, err := uuid.Parse(c.Param("id"))
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid ticket id"})
+		return nil, false
+	}
+	uploadID, err := uuid.Parse(c.Param("upload_id"))
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid upload id"})
+		return nil, false
+	}
+	upload, err := h.Service.Uploads.GetByID(uploadID)
+	if err != nil || upload.TicketID != ticketID {
+		c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: "Upload not found"})
+		return nil, false
+	}
+	if upload.UploadedBy != userID {
+		c.JSON(http.StatusForbidden, model.APIError{Code: "403", Message: "Upload belongs to another user"})
+		return nil, false
+	}
+	return upload, true
+}
+
+func (h *AttachmentUploadHandler) status(upload *domain.AttachmentUpload) (model.UploadStatus, error) {
+	offsets, err := h.Service.ReceivedOffsets(upload)
+	if err != nil {
+		return model.UploadStatus{}, err
+	}
+	var received int64
+	for _, offset := range offsets {
+		if rest := upload.SizeBytes - offset; rest < upload.ChunkSize {
+			received += rest
+		} else {
+			received += upload.ChunkSize
+		}
+	}
+	return model.UploadStatus{
+		UploadID:        upload.ID,
+		Filename:        upload.Filename,
+		SizeBytes:       upload.SizeBytes,
+		ChunkSize:       upload.ChunkSize,
+		ReceivedOffsets: offsets,
+		ReceivedBytes:   received,
+	}, nil
+}
+
+func (h *AttachmentUploadHandler) InitiateUpload(c *gin.Context) {
+	ticketID, err := uuid.Parse(c.Param("id"))
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid ticket id"})
+		return
+	}
+	userID, ok := currentUserID(c)
+	if !ok {
+		return
+	}
+	var req model.InitiateUploadRequest
+	if err := c.ShouldBindJSON(&req); err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Validation failed", Details: err.Error()})
+		return
+	}
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+	ticket, err := h.TicketRepo.GetByID(ticketID, createdAt)
+	if err != nil || ticket == nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Ticket not found"})
+		return
+	}
+	upload, err := h.Service.Initiate(ticket, req.Filename, req.SizeBytes, req.SHA256, userID)
+	if err != nil {
+		if errors.Is(err, usecase.ErrUploadInvalidFilename) {
+			c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: err.Error()})
+			return
+		}
+		if errors.Is(err, usecase.ErrUploadTooLarge) {
+			c.JSON(http.StatusRequestEntityTooLarge, model.APIError{Code: "413", Message: err.Error()})
+			return
+		}
+		c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		return
+	}
+	status, err := h.status(upload)
+	if err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		return
+	}
+	c.JSON(http.StatusCreated, status)
+}
+
+func (h *AttachmentUploadHandler) GetUpload(c *gin.Context) {
+	upload, ok := h.loadUpload(c)
+	if !ok {
+		return
+	}
+	status, err := h.status(upload)
+	if err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		return
+	}
+	c.JSON(http.StatusOK, status)
+}
+
+func (h *AttachmentUploadHandler) PutChunk(c *gin.Context) {
+	upload, ok := h.loadUpload(c)
+	if !ok {
+		return
+	}
+	offset, err := strconv.ParseInt(c.Param("offset"), 10, 64)
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid chunk offset"})
+		return
+	}
+	if err := h.Service.WriteChunk(upload, offset, c.Request.Body); err != nil {
+		if errors.Is(err, usecase.ErrUploadChunkOffset) || errors.Is(err, usecase.ErrUploadChunkSize) {
+			c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: err.Error()})
+			return
+		}
+		c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		return
+	}
+	c.JSON(http.StatusOK, gin.H{"offset": offset})
+}
+
+func (h *AttachmentUploadHandler) CommitUpload(c *gin.Context) {
+	upload, ok := h.loadUpload(c)
+	if !ok {
+		return
+	}
+	att, err := h.Service.Commit(upload)
+	if err != nil {
+		switch {
+		case errors.Is(err, usecase.ErrUploadIncomplete), errors.Is(err, usecase.ErrUploadCommitting):
+			c.JSON(http.StatusConflict, model.APIError{Code: "409", Message: err.Error()})
+		case errors.Is(err, usecase.ErrUploadChecksum):
+			c.JSON(http.StatusUnprocessableEntity, model.APIError{Code: "422", Message: err.Error()})
+		default:
+			c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		}
+		return
+	}
+	c.JSON(http.StatusCreated, att)
+}
+
+func (h *AttachmentUploadHandler) AbortUpload(c *gin.Context) {
+	upload, ok := h.loadUpload(c)
+	if !ok {
+		return
+	}
+	if err := h.Service.Abort(upload); err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		return
+	}
+	c.Status(http.StatusNoContent)
+}
+
+// GetBlob answers whether the caller already uploaded content with the given
+// sha256, so the client can attach it by hash instead of uploading it again.
+func (h *AttachmentUploadHandler) GetBlob(c *gin.Context) {
+	userID, ok := currentUserID(c)
+	if !ok {
+		return
+	}
+	blob, err := h.Service.FindBlob(c.Param("sha256"), userID)
+	if err != nil {
+		c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: err.Error()})
+		return
+	}
+	c.JSON(http.StatusOK, model.BlobInfo{SHA256: blob.SHA256, SizeBytes: blob.SizeBytes})
+}
+
+func (h *AttachmentUploadHandler) AttachBlob(c *gin.Context) {
+	ticketID, err := uuid.Parse(c.Param("id"))
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid ticket id"})
+		return
+	}
+	userID, ok := currentUserID(c)
+	if !ok {
+		return
+	}
+	var req model.AttachBlobRequest
+	if err := c.ShouldBindJSON(&req); err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Validation failed", Details: err.Error()})
+		return
+	}
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+	ticket, err := h.TicketRepo.GetByID(ticketID, createdAt)
+	if err != nil || ticket == nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Ticket not found"})
+		return
+	}
+	att, err := h.Service.AttachBlob(ticket, req.SHA256, req.Filename, userID)
+	if err != nil {
+		switch {
+		case errors.Is(err, usecase.ErrBlobNotFound):
+			c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: err.Error()})
+		case errors.Is(err, usecase.ErrUploadInvalidFilename):
+			c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: err.Error()})
+		default:
+			c.JSON(http.StatusInternalServerError, model.APIError{Code: "500", Message: err.Error()})
+		}
+		return
+	}
+	c.JSON(http.StatusCreated, att)
+}
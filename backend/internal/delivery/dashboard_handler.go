@@ -0,0 +1,50 @@
+package delivery
+
+import (
+	"log"
+	"net/http"
+	"strconv"
+
+	"ticket-system/backend/internal/model"
+	"ticket-system/backend/internal/usecase"
+
+	"github.com/gin-gonic/gin"
+)
+
+const (
+	defaultDashboardDays = 30
+	maxDashboardDays     = 365
+)
+
+type DashboardHandler struct {
+	Service *usecase.DashboardService
+}
+
+func NewDashboardHandler(service *usecase.DashboardService) *DashboardHandler {
+	return &DashboardHandler{Service: service}
+}
+
+// GetDashboard serves GET /dashboard: open-ticket counts per department, priority and
+// assignee, open tickets by age, and created/closed per day for the last ?days=
+// (default 30, at most 365). Everything comes from summary tables, so clients can
+// refetch it on every change event.
+func (h *DashboardHandler) GetDashboard(c *gin.Context) {
+	days, err := strconv.Atoi(c.DefaultQuery("days", strconv.Itoa(defaultDashboardDays)))
+	if err != nil || days <= 0 || days > maxDashboardDays {
+		c.JSON(http.StatusBadRequest, model.APIError{
+			Code:    "INVALID_DAYS",
+			Message: "days must be between 1 and 365",
+		})
+		return
+	}
+	dashboard, err := h.Service.Dashboard(days)
+	if err != nil {
+		log.Printf("dashboard: %v", err)
+		c.JSON(http.StatusInternalServerError, model.APIError{
+			Code:    "500",
+			Message: "Failed to load dashboard",
+		})
+		return
+	}
+	c.JSON(http.StatusOK, dashboard)
+}
@@ -0,0 +1,80 @@
+package delivery
+
+import (
+	"encoding/json"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+	"ticket-system/backend/internal/repository"
+	"ticket-system/backend/internal/usecase"
+
+	"github.com/gin-gonic/gin"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func setupDashboardRouter(t *testing.T) (*gin.Engine, *gorm.DB) {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.TicketStatus{}, &domain.TicketSummary{}, &domain.TicketDailyStats{}, &domain.TicketAgeBucket{}))
+	require.NoError(t, db.Create(&domain.TicketStatus{ID: 1, Code: "open", Label: "Open"}).Error)
+	require.NoError(t, db.Create(&domain.TicketStatus{ID: 2, Code: "closed", Label: "Closed"}).Error)
+
+	gin.SetMode(gin.TestMode)
+	r := gin.New()
+	h := NewDashboardHandler(usecase.NewDashboardService(repository.NewDashboardRepository(db)))
+	r.GET("/dashboard", h.GetDashboard)
+	return r, db
+}
+
+func TestDashboardHandler_GetDashboard(t *testing.T) {
+	r, db := setupDashboardRouter(t)
+	require.NoError(t, db.Create(&[]domain.TicketSummary{
+		{DepartmentID: 1, PriorityID: 3, StatusID: 1, TicketCount: 2},
+		{DepartmentID: 1, PriorityID: 3, StatusID: 2, TicketCount: 9},
+	}).Error)
+	require.NoError(t, db.Create(&domain.TicketDailyStats{Day: time.Now().UTC().Truncate(24 * time.Hour), CreatedCount: 2}).Error)
+
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/dashboard?days=7", nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, http.StatusOK, w.Code)
+
+	var d model.Dashboard
+	require.NoError(t, json.Unmarshal(w.Body.Bytes(), &d))
+	assert.Equal(t, int64(2), d.OpenTotal)
+	require.Len(t, d.OpenByDepartment, 1)
+	assert.Equal(t, "1", d.OpenByDepartment[0].ID)
+	require.Len(t, d.Throughput, 7)
+	assert.Equal(t, int64(2), d.Throughput[6].Created)
+}
+
+func TestDashboardHandler_GetDashboard_InvalidDays(t *testing.T) {
+	r, _ := setupDashboardRouter(t)
+	for _, days := range []string{"0", "-1", "366", "abc"} {
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("GET", "/dashboard?days="+days, nil)
+		r.ServeHTTP(w, req)
+		assert.Equal(t, http.StatusBadRequest, w.Code, days)
+	}
+}
+
+func TestDashboardHandler_GetDashboard_DBError(t *testing.T) {
+	r, db := setupDashboardRouter(t)
+	require.NoError(t, db.Migrator().DropTable(&domain.TicketSummary{}))
+
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/dashboard", nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, http.StatusInternalServerError, w.Code)
+
+	var apiErr model.APIError
+	require.NoError(t, json.Unmarshal(w.Body.Bytes(), &apiErr))
+	assert.Equal(t, "Failed to load dashboard", apiErr.Message, "database errors are not sent to clients")
+}
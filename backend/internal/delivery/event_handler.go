@@ -0,0 +1,71 @@
+package delivery
+
+import (
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"time"
+
+	"ticket-system/backend/internal/usecase"
+
+	"github.com/gin-gonic/gin"
+)
+
+// eventHeartbeat keeps idle streams alive through proxies and lets the server notice
+// disconnected clients.
+const eventHeartbeat = 25 * time.Second
+
+// eventSubscriberBuffer is how many batches a slow client may lag before it is dropped.
+const eventSubscriberBuffer = 64
+
+type EventHandler struct {
+	Hub *usecase.EventHub
+}
+
+func NewEventHandler(hub *usecase.EventHub) *EventHandler {
+	return &EventHandler{Hub: hub}
+}
+
+// Stream serves GET /events as Server-Sent Events. Each message is a "changes" event
+// whose data is a JSON array of coalesced model.ChangeEvent values. The stream ends
+// if the client falls too far behind; clients reload on reconnect.
+func (h *EventHandler) Stream(c *gin.Context) {
+	events, unsubscribe := h.Hub.Subscribe(eventSubscriberBuffer)
+	defer unsubscribe()
+
+	c.Header("Content-Type", "text/event-stream")
+	c.Header("Cache-Control", "no-store")
+	c.Header("Connection", "keep-alive")
+	c.Header("X-Accel-Buffering", "no")
+	c.Status(http.StatusOK)
+	fmt.Fprint(c.Writer, "retry: 3000\n\n")
+	c.Writer.Flush()
+
+	heartbeat := time.NewTicker(eventHeartbeat)
+	defer heartbeat.Stop()
+	var seq uint64
+	for {
+		select {
+		case <-c.Request.Context().Done():
+			return
+		case <-heartbeat.C:
+			if _, err := fmt.Fprint(c.Writer, ": ping\n\n"); err != nil {
+				return
+			}
+			c.Writer.Flush()
+		case batch, ok := <-events:
+			if !ok {
+				return
+			}
+			data, err := json.Marshal(batch)
+			if err != nil {
+				continue
+			}
+			seq++
+			if _, err := fmt.Fprintf(c.Writer, "id: %d\nevent: changes\ndata: %s\n\n", seq, data); err != nil {
+				return
+			}
+			c.Writer.Flush()
+		}
+	}
+}
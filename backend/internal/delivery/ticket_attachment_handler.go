@@ -1,8 +1,15 @@
 package delivery
 
 import (
+	"crypto/sha256"
+	"encoding/hex"
+	"errors"
+	"fmt"
 	"io"
+	"log"
 	"net/http"
+	"os"
+	"strconv"
 	"strings"
 	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/model"
@@ -13,13 +20,18 @@ import (
 	"github.com/google/uuid"
 )
 
+// maxConcurrentThumbnails bounds how many images are decoded for thumbnails at
+// once; each decode may hold up to MaxThumbnailSourcePixels pixels.
+const maxConcurrentThumbnails = 2
+
 type TicketAttachmentHandler struct {
 	Repo       usecase.TicketAttachmentRepository
 	TicketRepo usecase.TicketRepository
+	thumbSlots chan struct{}
 }
 
 func NewTicketAttachmentHandler(repo usecase.TicketAttachmentRepository, ticketRepo usecase.TicketRepository) *TicketAttachmentHandler {
-	return &TicketAttachmentHandler{Repo: repo, TicketRepo: ticketRepo}
+	return &TicketAttachmentHandler{Repo: repo, TicketRepo: ticketRepo, thumbSlots: make(chan struct{}, maxConcurrentThumbnails)}
 }
 
 func (h *TicketAttachmentHandler) GetAttachments(c *gin.Context) {
@@ -54,7 +66,11 @@ func (h *TicketAttachmentHandler) AddAttachment(c *gin.Context) {
 		return
 	}
 
-	ticket, err := h.TicketRepo.GetByID(ticketID)
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+	ticket, err := h.TicketRepo.GetByID(ticketID, createdAt)
 	if err != nil || ticket == nil {
 		c.JSON(http.StatusBadRequest, model.APIError{
 			Code:    "400",
@@ -107,12 +123,15 @@ func (h *TicketAttachmentHandler) AddAttachment(c *gin.Context) {
 		return
 	}
 
+	checksum := sha256.Sum256(fileData)
 	att := domain.TicketAttachment{
 		ID:              uuid.New(),
 		TicketID:        ticketID,
 		TicketCreatedAt: ticket.CreatedAt,
 		Filename:        header.Filename,
 		FileData:        fileData,
+		SizeBytes:       int64(len(fileData)),
+		SHA256:          hex.EncodeToString(checksum[:]),
 		UploadedBy:      userID,
 		UploadedAt:      time.Now().UTC(),
 	}
@@ -124,6 +143,18 @@ func (h *TicketAttachmentHandler) AddAttachment(c *gin.Context) {
 		})
 		return
 	}
+	if usecase.IsThumbnailable(att.Filename) {
+		// With every slot busy the upload skips pregeneration instead of queueing
+		// another decoded image; GetThumbnail then builds it on first request.
+		select {
+		case h.thumbSlots <- struct{}{}:
+			go func() {
+				defer func() { <-h.thumbSlots }()
+				h.generateThumbnails(att.ID, fileData)
+			}()
+		default:
+		}
+	}
 	c.JSON(http.StatusCreated, att)
 }
 
@@ -155,8 +186,8 @@ func (h *TicketAttachmentHandler) DownloadAttachment(c *gin.Context) {
 		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid attachment id"})
 		return
 	}
-	att, err := h.Repo.GetByID(attID)
-	if err != nil || att.FileData == nil {
+	att, err := h.Repo.GetMetaByID(attID)
+	if err != nil {
 		c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: "Attachment not found"})
 		return
 	}
@@ -170,7 +201,176 @@ func (h *TicketAttachmentHandler) DownloadAttachment(c *gin.Context) {
 		contentType = "image/gif"
 	}
 	c.Header("Content-Disposition", "attachment; filename=\""+filename+"\"")
-	c.Data(http.StatusOK, contentType, att.FileData)
+	c.Header("Content-Type", contentType)
+	if att.SHA256 != "" {
+		c.Header("ETag", "\""+att.SHA256+"\"")
+		c.Header("X-Content-SHA256", att.SHA256)
+	}
+
+	// http.ServeContent handles Range, If-Range and If-None-Match.
+	if att.FilePath != nil {
+		f, err := os.Open(*att.FilePath)
+		if err != nil {
+			c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: "Attachment not found"})
+			return
+		}
+		defer f.Close()
+		http.ServeContent(c.Writer, c.Request, filename, att.UploadedAt, f)
+		return
+	}
+	content := &attachmentContent{repo: h.Repo, id: att.ID, size: att.SizeBytes}
+	http.ServeContent(c.Writer, c.Request, filename, att.UploadedAt, content)
+}
+
+// attachmentReadAhead is how much file_data one database round trip fetches.
+const attachmentReadAhead = 1 << 20
+
+// attachmentContent is an io.ReadSeeker over file_data. It reads the column in
+// chunks, so serving a download or a Range never loads the whole BYTEA.
+type attachmentContent struct {
+	repo    usecase.TicketAttachmentRepository
+	id      uuid.UUID
+	size    int64
+	offset  int64
+	buf     []byte
+	bufFrom int64
+}
+
+func (a *attachmentContent) Read(p []byte) (int, error) {
+	if a.offset >= a.size {
+		return 0, io.EOF
+	}
+	if a.offset < a.bufFrom || a.offset >= a.bufFrom+int64(len(a.buf)) {
+		n := int64(attachmentReadAhead)
+		if rest := a.size - a.offset; rest < n {
+			n = rest
+		}
+		data, err := a.repo.ReadDataRange(a.id, a.offset, int(n))
+		if err != nil {
+			return 0, err
+		}
+		if len(data) == 0 {
+			return 0, io.ErrUnexpectedEOF
+		}
+		a.buf, a.bufFrom = data, a.offset
+	}
+	n := copy(p, a.buf[a.offset-a.bufFrom:])
+	a.offset += int64(n)
+	return n, nil
+}
+
+func (a *attachmentContent) Seek(offset int64, whence int) (int64, error) {
+	switch whence {
+	case io.SeekStart:
+	case io.SeekCurrent:
+		offset += a.offset
+	case io.SeekEnd:
+		offset += a.size
+	default:
+		return 0, errors.New("invalid whence")
+	}
+	if offset < 0 {
+		return 0, errors.New("negative position")
+	}
+	a.offset = offset
+	return offset, nil
+}
+
+// maxThumbnailSourceBytes bounds how much of a file_path attachment is read to make a thumbnail.
+const maxThumbnailSourceBytes = 64 << 20
+
+// thumbnailCacheControl is safe because attachments are immutable: a new upload gets a new id.
+const thumbnailCacheControl = "private, max-age=31536000, immutable"
+
+func (h *TicketAttachmentHandler) GetThumbnail(c *gin.Context) {
+	attIDStr := c.Param("att_id")
+	attID, err := uuid.Parse(attIDStr)
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid attachment id"})
+		return
+	}
+	size := usecase.ThumbnailSizes[0]
+	if raw := c.Query("size"); raw != "" {
+		requested, err := strconv.Atoi(raw)
+		if err != nil || requested <= 0 {
+			c.JSON(http.StatusBadRequest, model.APIError{Code: "400", Message: "Invalid thumbnail size"})
+			return
+		}
+		size = usecase.ThumbnailSizeFor(requested)
+	}
+	etag := fmt.Sprintf("\"%s-%d\"", attID, size)
+	c.Header("Cache-Control", thumbnailCacheControl)
+	c.Header("ETag", etag)
+	if c.GetHeader("If-None-Match") == etag {
+		c.Status(http.StatusNotModified)
+		return
+	}
+	thumb, err := h.Repo.GetThumbnail(attID, size)
+	if err != nil {
+		// Attachments uploaded before thumbnails existed get theirs on first request.
+		select {
+		case h.thumbSlots <- struct{}{}:
+			thumb, err = h.createThumbnail(attID, size)
+			<-h.thumbSlots
+		case <-c.Request.Context().Done():
+			return
+		}
+	}
+	if err != nil {
+		c.Header("Cache-Control", "no-store")
+		c.JSON(http.StatusNotFound, model.APIError{Code: "404", Message: "Thumbnail not available"})
+		return
+	}
+	c.Data(http.StatusOK, thumb.ContentType, thumb.Data)
+}
+
+func (h *TicketAttachmentHandler) createThumbnail(attID uuid.UUID, size int) (*domain.TicketAttachmentThumbnail, error) {
+	att, err := h.Repo.GetByID(attID)
+	if err != nil {
+		return nil, err
+	}
+	if !usecase.IsThumbnailable(att.Filename) {
+		return nil, usecase.ErrUnsupportedImage
+	}
+	data := att.FileData
+	if data == nil && att.FilePath != nil {
+		if att.SizeBytes > maxThumbnailSourceBytes {
+			return nil, usecase.ErrUnsupportedImage
+		}
+		if data, err = os.ReadFile(*att.FilePath); err != nil {
+			return nil, err
+		}
+	}
+	// The decode is the expensive part, so every size is made and stored from it.
+	thumbs, err := h.saveThumbnails(attID, data)
+	if err != nil {
+		return nil, err
+	}
+	for _, thumb := range thumbs {
+		if thumb.Size == size {
+			return thumb, nil
+		}
+	}
+	return nil, usecase.ErrUnsupportedImage
+}
+
+func (h *TicketAttachmentHandler) generateThumbnails(attID uuid.UUID, data []byte) {
+	if _, err := h.saveThumbnails(attID, data); err != nil {
+		log.Printf("failed to generate thumbnails %s: %v", attID, err)
+	}
+}
+
+func (h *TicketAttachmentHandler) saveThumbnails(attID uuid.UUID, data []byte) ([]*domain.TicketAttachmentThumbnail, error) {
+	thumbs, err := usecase.GenerateThumbnails(attID, data, usecase.ThumbnailSizes)
+	if err != nil {
+		return nil, err
+	}
+	for _, thumb := range thumbs {
+		if err := h.Repo.SaveThumbnail(thumb); err != nil {
+			log.Printf("failed to save thumbnail %s/%d: %v", attID, thumb.Size, err)
+		}
+	}
+	return thumbs, nil
 }
 
 func (h *TicketAttachmentHandler) DeleteAttachment(c *gin.Context) {
@@ -227,7 +427,7 @@ func (h *TicketAttachmentHandler) DeleteAttachment(c *gin.Context) {
 	}
 	isAdmin := roleID == "00000000-0000-0000-0000-000000000002"
 
-	att, err := h.Repo.GetByID(attID)
+	att, err := h.Repo.GetMetaByID(attID)
 	if err != nil {
 		c.JSON(http.StatusNotFound, model.APIError{
 			Code:    "404",
@@ -0,0 +1,145 @@
+package delivery
+
+import (
+	"archive/zip"
+	"bytes"
+	"crypto/sha256"
+	"encoding/hex"
+	"io"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/repository"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func setupTestAttachmentHandler(t *testing.T, data []byte) (*TicketAttachmentHandler, *domain.TicketAttachment) {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.Ticket{}, &domain.TicketAttachment{}))
+	checksum := sha256.Sum256(data)
+	att := &domain.TicketAttachment{
+		ID:         uuid.New(),
+		TicketID:   uuid.New(),
+		Filename:   "bundle.log",
+		FileData:   data,
+		SizeBytes:  int64(len(data)),
+		SHA256:     hex.EncodeToString(checksum[:]),
+		UploadedBy: uuid.New(),
+		UploadedAt: time.Now().UTC(),
+	}
+	require.NoError(t, db.Create(att).Error)
+	return NewTicketAttachmentHandler(repository.NewTicketAttachmentRepository(db), repository.NewTicketRepository(db)), att
+}
+
+func testAttachmentData(n int) []byte {
+	data := make([]byte, n)
+	for i := range data {
+		data[i] = byte(i % 251)
+	}
+	return data
+}
+
+func TestTicketAttachmentHandler_Download_Full(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	data := testAttachmentData(3*attachmentReadAhead + 17)
+	h, att := setupTestAttachmentHandler(t, data)
+	r := gin.New()
+	r.GET("/attachments/:att_id/download", h.DownloadAttachment)
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/attachments/"+att.ID.String()+"/download", nil)
+	r.ServeHTTP(w, req)
+	assert.Equal(t, http.StatusOK, w.Code)
+	assert.Equal(t, "bytes", w.Header().Get("Accept-Ranges"))
+	assert.Equal(t, att.SHA256, w.Header().Get("X-Content-SHA256"))
+	assert.Equal(t, data, w.Body.Bytes())
+}
+
+func TestTicketAttachmentHandler_Download_Range(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	data := testAttachmentData(2*attachmentReadAhead + 5)
+	h, att := setupTestAttachmentHandler(t, data)
+	r := gin.New()
+	r.GET("/attachments/:att_id/download", h.DownloadAttachment)
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/attachments/"+att.ID.String()+"/download", nil)
+	req.Header.Set("Range", "bytes=1048570-1048585")
+	r.ServeHTTP(w, req)
+	assert.Equal(t, http.StatusPartialContent, w.Code)
+	assert.Equal(t, "bytes 1048570-1048585/2097157", w.Header().Get("Content-Range"))
+	assert.Equal(t, data[1048570:1048586], w.Body.Bytes())
+}
+
+func TestTicketAttachmentHandler_Download_NotModified(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h, att := setupTestAttachmentHandler(t, testAttachmentData(64))
+	r := gin.New()
+	r.GET("/attachments/:att_id/download", h.DownloadAttachment)
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/attachments/"+att.ID.String()+"/download", nil)
+	req.Header.Set("If-None-Match", "\""+att.SHA256+"\"")
+	r.ServeHTTP(w, req)
+	assert.Equal(t, http.StatusNotModified, w.Code)
+}
+
+func TestTicketAttachmentHandler_Archive(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	data := testAttachmentData(attachmentReadAhead + 99)
+	h, att := setupTestAttachmentHandler(t, data)
+	dup := *att
+	dup.ID = uuid.New()
+	dup.FileData = []byte("second")
+	dup.SizeBytes = 6
+	require.NoError(t, h.Repo.Create(&dup))
+	r := gin.New()
+	r.GET("/tickets/:id/attachments/archive", h.DownloadTicketArchive)
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/tickets/"+att.TicketID.String()+"/attachments/archive", nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, http.StatusOK, w.Code)
+	assert.Equal(t, "application/zip", w.Header().Get("Content-Type"))
+
+	zr, err := zip.NewReader(bytes.NewReader(w.Body.Bytes()), int64(w.Body.Len()))
+	require.NoError(t, err)
+	contents := map[string][]byte{}
+	for _, f := range zr.File {
+		rc, err := f.Open()
+		require.NoError(t, err)
+		body, err := io.ReadAll(rc)
+		require.NoError(t, err)
+		rc.Close()
+		contents[f.Name] = body
+	}
+	require.Len(t, contents, 2)
+	assert.Equal(t, data, contents["bundle.log"])
+	assert.Equal(t, []byte("second"), contents["bundle (2).log"])
+}
+
+func TestUniqueArchiveName(t *testing.T) {
+	used := map[string]bool{}
+	var names []string
+	for _, filename := range []string{"a (2).log", "a.log", "a.log", "a.log", `C:\logs\b.txt`, "..", "b.txt"} {
+		names = append(names, uniqueArchiveName(filename, used))
+	}
+	assert.Equal(t, []string{"a (2).log", "a.log", "a (3).log", "a (4).log", "b.txt", "attachment", "b (2).txt"}, names)
+}
+
+func TestTicketAttachmentHandler_Archive_NoAttachments(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h, _ := setupTestAttachmentHandler(t, testAttachmentData(8))
+	r := gin.New()
+	r.GET("/attachments/archive", h.DownloadArchive)
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/attachments/archive?ticket_ids="+uuid.NewString(), nil)
+	r.ServeHTTP(w, req)
+	assert.Equal(t, http.StatusNotFound, w.Code)
+}
@@ -0,0 +1,95 @@
+package delivery
+
+import (
+	"fmt"
+	"net/http"
+
+	"ticket-system/backend/internal/model"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+)
+
+// maxBatchTickets bounds one POST /tickets/batch request.
+const maxBatchTickets = 1000
+
+// BatchTickets applies one update or a delete to many tickets in a single transaction
+// and answers with a result per ticket.
+func (h *TicketHandler) BatchTickets(c *gin.Context) {
+	var req model.TicketBatchRequest
+	if err := c.ShouldBindJSON(&req); err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{
+			Code:    "INVALID_JSON",
+			Message: "Invalid request body",
+			Details: err.Error(),
+		})
+		return
+	}
+
+	userID, ok := c.Get("user_id")
+	if !ok {
+		c.JSON(http.StatusUnauthorized, model.APIError{
+			Code:    "UNAUTHORIZED",
+			Message: "User not authenticated",
+		})
+		return
+	}
+	userUUID, _ := uuid.Parse(userID.(string))
+
+	ids := make([]uuid.UUID, 0, len(req.TicketIDs))
+	seen := make(map[uuid.UUID]bool, len(req.TicketIDs))
+	for _, id := range req.TicketIDs {
+		if !seen[id] {
+			seen[id] = true
+			ids = append(ids, id)
+		}
+	}
+	if len(ids) > maxBatchTickets {
+		c.JSON(http.StatusBadRequest, model.APIError{
+			Code:    "VALIDATION_ERROR",
+			Message: fmt.Sprintf("A batch may contain at most %d tickets", maxBatchTickets),
+		})
+		return
+	}
+	if req.Action == model.TicketBatchUpdate {
+		if validationError := validateBatchPatch(&req.Patch); validationError != nil {
+			c.JSON(http.StatusBadRequest, *validationError)
+			return
+		}
+	}
+
+	results, err := h.TicketRepo.Batch(req.Action, ids, &req.Patch, userUUID)
+	if err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{
+			Code:    "DATABASE_ERROR",
+			Message: "Failed to apply batch",
+		})
+		return
+	}
+	c.JSON(http.StatusOK, model.TicketBatchResponse{Results: results})
+}
+
+func validateBatchPatch(patch *model.TicketPatch) *model.APIError {
+	if patch.Title != nil || patch.Description != nil {
+		return &model.APIError{
+			Code:    "VALIDATION_ERROR",
+			Message: "Title and description cannot be changed in a batch",
+		}
+	}
+	if patch.StatusID == nil && patch.PriorityID == nil && patch.DepartmentID == nil && patch.AssigneeID == nil {
+		return &model.APIError{
+			Code:    "VALIDATION_ERROR",
+			Message: "Nothing to update",
+		}
+	}
+	if (patch.StatusID != nil && *patch.StatusID <= 0) ||
+		(patch.PriorityID != nil && *patch.PriorityID <= 0) ||
+		(patch.DepartmentID != nil && *patch.DepartmentID <= 0) ||
+		(patch.AssigneeID != nil && *patch.AssigneeID == uuid.Nil) {
+		return &model.APIError{
+			Code:    "VALIDATION_ERROR",
+			Message: "Invalid value in batch update",
+		}
+	}
+	return nil
+}
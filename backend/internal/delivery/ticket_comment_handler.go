@@ -3,6 +3,7 @@ package delivery
 import (
 	"fmt"
 	"net/http"
+	"strconv"
 	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/model"
 	"ticket-system/backend/internal/usecase"
@@ -11,6 +12,8 @@ import (
 	"github.com/google/uuid"
 )
 
+const maxCommentPageSize = 200
+
 type TicketCommentHandler struct {
 	Repo usecase.TicketCommentRepository
 }
@@ -29,6 +32,10 @@ func (h *TicketCommentHandler) GetComments(c *gin.Context) {
 		})
 		return
 	}
+	if _, paged := c.GetQuery("limit"); paged {
+		h.getCommentsPage(c, ticketID)
+		return
+	}
 	comments, err := h.Repo.GetByTicketID(ticketID)
 	if err != nil {
 		c.JSON(http.StatusInternalServerError, model.APIError{
@@ -40,6 +47,51 @@ func (h *TicketCommentHandler) GetComments(c *gin.Context) {
 	c.JSON(http.StatusOK, comments)
 }
 
+// getCommentsPage serves ?limit=N[&before=cursor]: newest-first pages with an opaque keyset cursor.
+func (h *TicketCommentHandler) getCommentsPage(c *gin.Context, ticketID uuid.UUID) {
+	limit, err := strconv.Atoi(c.Query("limit"))
+	if err != nil || limit <= 0 || limit > maxCommentPageSize {
+		c.JSON(http.StatusBadRequest, model.APIError{
+			Code:    "400",
+			Message: fmt.Sprintf("limit must be between 1 and %d", maxCommentPageSize),
+		})
+		return
+	}
+	var before *model.CommentCursor
+	if v := c.Query("before"); v != "" {
+		before, err = model.DecodeCommentCursor(v)
+		if err != nil {
+			c.JSON(http.StatusBadRequest, model.APIError{
+				Code:    "400",
+				Message: "Invalid cursor",
+				Details: err.Error(),
+			})
+			return
+		}
+	}
+	comments, err := h.Repo.GetPageByTicketID(ticketID, before, limit+1)
+	if err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{
+			Code:    "500",
+			Message: err.Error(),
+		})
+		return
+	}
+	nextCursor := ""
+	if len(comments) > limit {
+		comments = comments[:limit]
+		last := comments[limit-1]
+		nextCursor = model.CommentCursor{CreatedAt: last.CreatedAt, ID: last.ID}.Encode()
+	}
+	if comments == nil {
+		comments = []*domain.TicketComment{}
+	}
+	c.JSON(http.StatusOK, gin.H{
+		"items":       comments,
+		"next_cursor": nextCursor,
+	})
+}
+
 func (h *TicketCommentHandler) AddComment(c *gin.Context) {
 	ticketIDStr := c.Param("id")
 	ticketID, err := uuid.Parse(ticketIDStr)
@@ -0,0 +1,107 @@
+package delivery
+
+import (
+	"encoding/json"
+	"fmt"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/repository"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+type commentPage struct {
+	Items      []domain.TicketComment `json:"items"`
+	NextCursor string                 `json:"next_cursor"`
+}
+
+// setupCommentRouter stores five comments on one ticket, one minute apart, "comment 0" oldest.
+func setupCommentRouter(t *testing.T) (*gin.Engine, uuid.UUID) {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.TicketComment{}))
+	repo := repository.NewTicketCommentRepository(db)
+	ticketID := uuid.New()
+	base := time.Date(2025, 3, 1, 12, 0, 0, 0, time.UTC)
+	for i := 0; i < 5; i++ {
+		require.NoError(t, repo.Create(&domain.TicketComment{
+			ID:        uuid.New(),
+			TicketID:  ticketID,
+			AuthorID:  uuid.New(),
+			Content:   fmt.Sprintf("comment %d", i),
+			CreatedAt: base.Add(time.Duration(i) * time.Minute),
+		}))
+	}
+
+	gin.SetMode(gin.TestMode)
+	r := gin.New()
+	r.GET("/tickets/:id/comments", NewTicketCommentHandler(repo).GetComments)
+	return r, ticketID
+}
+
+func getCommentPage(t *testing.T, r *gin.Engine, url string) commentPage {
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", url, nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, http.StatusOK, w.Code, w.Body.String())
+	var page commentPage
+	require.NoError(t, json.Unmarshal(w.Body.Bytes(), &page))
+	return page
+}
+
+func TestTicketCommentHandler_GetComments_Paged(t *testing.T) {
+	r, ticketID := setupCommentRouter(t)
+	url := "/tickets/" + ticketID.String() + "/comments?limit=2"
+
+	first := getCommentPage(t, r, url)
+	require.Len(t, first.Items, 2)
+	assert.Equal(t, "comment 4", first.Items[0].Content)
+	assert.Equal(t, "comment 3", first.Items[1].Content)
+	require.NotEmpty(t, first.NextCursor)
+
+	second := getCommentPage(t, r, url+"&before="+first.NextCursor)
+	require.Len(t, second.Items, 2)
+	assert.Equal(t, "comment 2", second.Items[0].Content)
+	require.NotEmpty(t, second.NextCursor)
+
+	last := getCommentPage(t, r, url+"&before="+second.NextCursor)
+	require.Len(t, last.Items, 1)
+	assert.Equal(t, "comment 0", last.Items[0].Content)
+	assert.Empty(t, last.NextCursor, "no cursor after the oldest page")
+}
+
+func TestTicketCommentHandler_GetComments_EmptyPage(t *testing.T) {
+	r, _ := setupCommentRouter(t)
+	page := getCommentPage(t, r, "/tickets/"+uuid.NewString()+"/comments?limit=10")
+	assert.NotNil(t, page.Items)
+	assert.Empty(t, page.Items)
+	assert.Empty(t, page.NextCursor)
+}
+
+func TestTicketCommentHandler_GetComments_BadRequest(t *testing.T) {
+	r, ticketID := setupCommentRouter(t)
+	base := "/tickets/" + ticketID.String() + "/comments"
+	for _, url := range []string{
+		"/tickets/not-a-uuid/comments?limit=10",
+		base + "?limit=0",
+		base + "?limit=-1",
+		base + fmt.Sprintf("?limit=%d", maxCommentPageSize+1),
+		base + "?limit=abc",
+		base + "?limit=10&before=not-base64!",
+		base + "?limit=10&before=bm8tc2VwYXJhdG9y",
+	} {
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("GET", url, nil)
+		r.ServeHTTP(w, req)
+		assert.Equal(t, http.StatusBadRequest, w.Code, url)
+	}
+}
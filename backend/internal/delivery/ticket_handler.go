@@ -97,6 +97,13 @@ func (h *TicketHandler) validateTicket(ticket *domain.Ticket) *model.APIError {
 	return nil
 }
 
+// The archive holds every ticket older than the hot window, so it is only listed
+// a page at a time: without a limit the first defaultArchivePageSize are returned.
+const (
+	defaultArchivePageSize = 200
+	maxArchivePageSize     = 1000
+)
+
 func (h *TicketHandler) GetTickets(c *gin.Context) {
 	var filter model.TicketFilter
 	if v := c.Query("status_id"); v != "" {
@@ -115,6 +122,7 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 		}
 	}
 	filter.Q = c.Query("q")
+	filter.Archived = c.Query("archived") == "true"
 	if v, ok := c.GetQuery("limit"); ok {
 		if _, err := fmt.Sscan(v, &filter.Limit); err != nil {
 			c.JSON(400, gin.H{"error": "Invalid limit parameter"})
@@ -128,6 +136,14 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 		}
 	}
 
+	if filter.Archived {
+		if filter.Limit <= 0 {
+			filter.Limit = defaultArchivePageSize
+		} else if filter.Limit > maxArchivePageSize {
+			filter.Limit = maxArchivePageSize
+		}
+	}
+
 	if filter.AssigneeID != nil {
 		if _, err := uuid.Parse(*filter.AssigneeID); err != nil {
 			c.JSON(http.StatusBadRequest, model.APIError{
@@ -158,7 +174,49 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 		}
 	}
 
-	tickets, err := h.TicketRepo.Search(filter)
+	// Clients pass this back as updated_since. It is read from the database before
+	// the query, so rows of transactions still open now are in the next delta.
+	watermark, err := h.TicketRepo.SyncWatermark()
+	if err != nil {
+		c.JSON(http.StatusInternalServerError, model.APIError{
+			Code:    "DATABASE_ERROR",
+			Message: "Failed to get tickets",
+		})
+		return
+	}
+	c.Header("X-Sync-Watermark", watermark.Format(time.RFC3339Nano))
+
+	var tickets []*domain.Ticket
+	var gone []uuid.UUID
+	// Archived tickets do not change, so they are not part of delta sync.
+	if v, ok := c.GetQuery("updated_since"); ok && !filter.Archived {
+		since, parseErr := time.Parse(time.RFC3339Nano, v)
+		if parseErr != nil {
+			c.JSON(http.StatusBadRequest, model.APIError{
+				Code:    "INVALID_UPDATED_SINCE",
+				Message: "updated_since must be an RFC 3339 timestamp",
+			})
+			return
+		}
+		var held []uuid.UUID
+		for _, v := range strings.Split(c.Query("held"), ",") {
+			if v == "" {
+				continue
+			}
+			id, parseErr := uuid.Parse(v)
+			if parseErr != nil {
+				c.JSON(http.StatusBadRequest, model.APIError{
+					Code:    "INVALID_UUID",
+					Message: "Invalid id in held",
+				})
+				return
+			}
+			held = append(held, id)
+		}
+		tickets, gone, err = h.TicketRepo.Changes(filter, since, held)
+	} else {
+		tickets, err = h.TicketRepo.Search(filter)
+	}
 	if err != nil {
 		c.JSON(http.StatusInternalServerError, model.APIError{
 			Code:    "DATABASE_ERROR",
@@ -167,8 +225,13 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 		return
 	}
 
+	result := make([]gin.H, 0, len(tickets)+len(gone))
+	// Tombstones: tickets that left the view (deleted, archived, or held ones no longer matching the filter).
+	for _, id := range gone {
+		result = append(result, gin.H{"ticket_id": id, "deleted": true})
+	}
 	if len(tickets) == 0 {
-		c.JSON(http.StatusOK, make([]gin.H, 0))
+		c.JSON(http.StatusOK, result)
 		return
 	}
 
@@ -194,7 +257,6 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 		userMap[u.ID.String()] = u.Username
 	}
 
-	var result []gin.H
 	for _, t := range tickets {
 		result = append(result, gin.H{
 			"ticket_id":       t.ID,
@@ -212,11 +274,21 @@ func (h *TicketHandler) GetTickets(c *gin.Context) {
 			"created_at":      t.CreatedAt,
 			"updated_at":      t.UpdatedAt,
 			"deleted_at":      t.DeletedAt,
+			"archived":        t.Archived,
 		})
 	}
 	c.JSON(http.StatusOK, result)
 }
 
+// Clients pick a new ticket's created_at themselves, so they can refer to it before
+// the server has seen it. created_at is the partition key: a value ahead of the
+// server clock by more than maxCreatedAtSkew, or older than maxCreatedAtAge (a
+// write held offline too long, whose partition may be archived), is refused.
+const (
+	maxCreatedAtSkew = 5 * time.Minute
+	maxCreatedAtAge  = 30 * 24 * time.Hour
+)
+
 func (h *TicketHandler) CreateTicket(c *gin.Context) {
 	var req domain.Ticket
 	if err := c.ShouldBindJSON(&req); err != nil {
@@ -244,6 +316,18 @@ func (h *TicketHandler) CreateTicket(c *gin.Context) {
 		return
 	}
 
+	if !req.CreatedAt.IsZero() {
+		now := time.Now().UTC()
+		if req.CreatedAt.After(now.Add(maxCreatedAtSkew)) || req.CreatedAt.Before(now.Add(-maxCreatedAtAge)) {
+			c.JSON(http.StatusBadRequest, model.APIError{
+				Code:    "INVALID_CREATED_AT",
+				Message: "created_at is too far from the server clock",
+			})
+			return
+		}
+	}
+	clientID := req.ID != uuid.Nil
+
 	userID, exists := c.Get("user_id")
 	if !exists {
 		c.JSON(http.StatusUnauthorized, model.APIError{
@@ -273,6 +357,21 @@ func (h *TicketHandler) CreateTicket(c *gin.Context) {
 	req.CreatorID = parsedUUID
 
 	if err := h.TicketRepo.Create(&req); err != nil {
+		// A create replayed after its idempotency record was purged finds the ticket
+		// already stored; it is answered as the first attempt was.
+		if clientID {
+			if existing, getErr := h.TicketRepo.GetByID(req.ID, &req.CreatedAt); getErr == nil {
+				if existing.CreatorID == req.CreatorID {
+					c.JSON(http.StatusCreated, existing)
+				} else {
+					c.JSON(http.StatusConflict, model.APIError{
+						Code:    "TICKET_EXISTS",
+						Message: "A ticket with this id already exists",
+					})
+				}
+				return
+			}
+		}
 		c.JSON(http.StatusInternalServerError, model.APIError{
 			Code:    "DATABASE_ERROR",
 			Message: "Failed to create ticket",
@@ -295,6 +394,25 @@ func (h *TicketHandler) CreateTicket(c *gin.Context) {
 	c.JSON(http.StatusCreated, req)
 }
 
+// ticketCreatedAt reads the optional ticket_created_at query parameter. Clients send
+// the ticket's created_at with every per-ticket request so the lookup can be pruned
+// to one tickets partition. A malformed value is answered with 400 and ok=false.
+func ticketCreatedAt(c *gin.Context) (createdAt *time.Time, ok bool) {
+	v, present := c.GetQuery("ticket_created_at")
+	if !present || v == "" {
+		return nil, true
+	}
+	t, err := time.Parse(time.RFC3339Nano, v)
+	if err != nil {
+		c.JSON(http.StatusBadRequest, model.APIError{
+			Code:    "INVALID_TICKET_CREATED_AT",
+			Message: "ticket_created_at must be an RFC 3339 timestamp",
+		})
+		return nil, false
+	}
+	return &t, true
+}
+
 func (h *TicketHandler) GetTicketByID(c *gin.Context) {
 	idStr := c.Param("id")
 	if idStr == "" {
@@ -314,7 +432,12 @@ func (h *TicketHandler) GetTicketByID(c *gin.Context) {
 		return
 	}
 
-	ticket, err := h.TicketRepo.GetByID(id)
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+
+	ticket, err := h.TicketRepo.GetByID(id, createdAt)
 	if err != nil {
 		c.JSON(http.StatusNotFound, model.APIError{
 			Code:    "TICKET_NOT_FOUND",
@@ -344,8 +467,13 @@ func (h *TicketHandler) UpdateTicket(c *gin.Context) {
 		return
 	}
 
-	var req domain.Ticket
-	if err := c.ShouldBindJSON(&req); err != nil {
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+
+	var patch model.TicketPatch
+	if err := c.ShouldBindJSON(&patch); err != nil {
 		c.JSON(http.StatusBadRequest, model.APIError{
 			Code:    "INVALID_JSON",
 			Message: "Invalid request body",
@@ -353,14 +481,7 @@ func (h *TicketHandler) UpdateTicket(c *gin.Context) {
 		return
 	}
 
-	if validationError := h.validateTicket(&req); validationError != nil {
-		c.JSON(http.StatusBadRequest, *validationError)
-		return
-	}
-
-	req.ID = id
-
-	oldTicket, err := h.TicketRepo.GetByID(id)
+	oldTicket, err := h.TicketRepo.GetByID(id, createdAt)
 	if err != nil {
 		c.JSON(http.StatusNotFound, model.APIError{
 			Code:    "TICKET_NOT_FOUND",
@@ -369,13 +490,25 @@ func (h *TicketHandler) UpdateTicket(c *gin.Context) {
 		return
 	}
 
-	if err := h.TicketRepo.Update(&req); err != nil {
+	req := *oldTicket
+	columns := patch.ApplyTo(&req)
+	if validationError := h.validateTicket(&req); validationError != nil {
+		c.JSON(http.StatusBadRequest, *validationError)
+		return
+	}
+	if len(columns) == 0 {
+		c.JSON(http.StatusOK, oldTicket)
+		return
+	}
+
+	if err := h.TicketRepo.Patch(id, &oldTicket.CreatedAt, columns); err != nil {
 		c.JSON(http.StatusInternalServerError, model.APIError{
 			Code:    "DATABASE_ERROR",
 			Message: "Failed to update ticket",
 		})
 		return
 	}
+	req.UpdatedAt = time.Now().UTC()
 
 	userID, _ := c.Get("user_id")
 	userUUID, _ := uuid.Parse(userID.(string))
@@ -442,7 +575,12 @@ func (h *TicketHandler) DeleteTicket(c *gin.Context) {
 		return
 	}
 
-	if err := h.TicketRepo.Delete(id); err != nil {
+	createdAt, ok := ticketCreatedAt(c)
+	if !ok {
+		return
+	}
+
+	if err := h.TicketRepo.Delete(id, createdAt); err != nil {
 		c.JSON(http.StatusInternalServerError, model.APIError{
 			Code:    "DATABASE_ERROR",
 			Message: "Failed to delete ticket",
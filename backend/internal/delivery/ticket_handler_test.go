@@ -1,13 +1,16 @@
 package delivery
 
 import (
+	"encoding/json"
 	"net/http"
 	"net/http/httptest"
+	"net/url"
 	"strings"
 	"testing"
 	"time"
 
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 	"ticket-system/backend/internal/repository"
 
 	"github.com/gin-gonic/gin"
@@ -98,7 +101,7 @@ func (m *mockDepartmentRepoTH) List() ([]interface {
 func setupTestTicketHandler(t *testing.T) *TicketHandler {
 	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
 	require.NoError(t, err)
-	require.NoError(t, db.AutoMigrate(&domain.Ticket{}, &domain.User{}, &domain.TicketStatus{}, &domain.TicketPriority{}, &domain.Department{}, &domain.TicketHistory{}))
+	require.NoError(t, db.AutoMigrate(&domain.Ticket{}, &domain.TicketArchive{}, &domain.User{}, &domain.TicketStatus{}, &domain.TicketPriority{}, &domain.Department{}, &domain.TicketHistory{}))
 
 	user := &domain.User{ID: uuid.New(), Username: "alice", DepartmentID: 1}
 	require.NoError(t, db.Create(user).Error)
@@ -183,6 +186,38 @@ func TestTicketHandler_CreateTicket_OK(t *testing.T) {
 	assert.Contains(t, w.Body.String(), "New Ticket")
 }
 
+func TestTicketHandler_CreateTicket_ClientCreatedAt(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	r := gin.New()
+	creator := uuid.New().String()
+	r.POST("/tickets", func(c *gin.Context) {
+		c.Set("user_id", creator)
+		h.CreateTicket(c)
+	})
+	post := func(id uuid.UUID, createdAt time.Time) *httptest.ResponseRecorder {
+		body := `{"ticket_id":"` + id.String() + `","created_at":"` + createdAt.Format(time.RFC3339Nano) +
+			`","title":"Offline Ticket","description":"Desc","status_id":1,"priority_id":1,"department_id":1,"assignee_id":"` + uuid.New().String() + `"}`
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("POST", "/tickets", strings.NewReader(body))
+		req.Header.Set("Content-Type", "application/json")
+		r.ServeHTTP(w, req)
+		return w
+	}
+
+	now := time.Now().UTC()
+	assert.Equal(t, 400, post(uuid.New(), now.Add(time.Hour)).Code)
+	assert.Equal(t, 400, post(uuid.New(), now.Add(-maxCreatedAtAge-time.Hour)).Code)
+
+	id, createdAt := uuid.New(), now.Add(-time.Hour)
+	w := post(id, createdAt)
+	require.Equal(t, 201, w.Code, w.Body.String())
+	// A replay that got past the idempotency purge gets the stored ticket back.
+	w = post(id, createdAt)
+	assert.Equal(t, 201, w.Code, w.Body.String())
+	assert.Contains(t, w.Body.String(), id.String())
+}
+
 func TestTicketHandler_CreateTicket_InvalidJSON(t *testing.T) {
 	gin.SetMode(gin.TestMode)
 	h := setupTestTicketHandler(t)
@@ -229,3 +264,178 @@ func TestTicketHandler_CreateTicket_ValidationError(t *testing.T) {
 	assert.Equal(t, 400, w.Code)
 	assert.Contains(t, w.Body.String(), "Title is required")
 }
+
+func TestTicketHandler_UpdateTicket_PatchesOnlyChangedFields(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	tickets, err := h.TicketRepo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	require.Len(t, tickets, 1)
+	original := tickets[0]
+
+	r := gin.New()
+	r.PATCH("/tickets/:id", func(c *gin.Context) {
+		c.Set("user_id", original.AssigneeID.String())
+		h.UpdateTicket(c)
+	})
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("PATCH", "/tickets/"+original.ID.String(), strings.NewReader(`{"status_id":2}`))
+	req.Header.Set("Content-Type", "application/json")
+	r.ServeHTTP(w, req)
+	require.Equal(t, 200, w.Code, w.Body.String())
+
+	updated, err := h.TicketRepo.GetByID(original.ID, nil)
+	require.NoError(t, err)
+	assert.Equal(t, int16(2), updated.StatusID)
+	assert.Equal(t, original.Title, updated.Title)
+	assert.Equal(t, original.Description, updated.Description)
+	assert.Equal(t, original.AssigneeID, updated.AssigneeID)
+
+	history, err := h.HistoryRepo.GetByTicketID(original.ID)
+	require.NoError(t, err)
+	require.Len(t, history, 1)
+	assert.Equal(t, "status", history[0].FieldName)
+
+	// Re-sending the stored value is a no-op.
+	w = httptest.NewRecorder()
+	req, _ = http.NewRequest("PATCH", "/tickets/"+original.ID.String(), strings.NewReader(`{"status_id":2,"title":"Test Ticket"}`))
+	req.Header.Set("Content-Type", "application/json")
+	r.ServeHTTP(w, req)
+	require.Equal(t, 200, w.Code)
+	history, err = h.HistoryRepo.GetByTicketID(original.ID)
+	require.NoError(t, err)
+	assert.Len(t, history, 1)
+}
+
+func TestTicketHandler_UpdateTicket_ValidatesPatchedFields(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	tickets, err := h.TicketRepo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	r := gin.New()
+	r.PATCH("/tickets/:id", func(c *gin.Context) {
+		c.Set("user_id", uuid.New().String())
+		h.UpdateTicket(c)
+	})
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("PATCH", "/tickets/"+tickets[0].ID.String(), strings.NewReader(`{"title":"  "}`))
+	req.Header.Set("Content-Type", "application/json")
+	r.ServeHTTP(w, req)
+	assert.Equal(t, 400, w.Code)
+	assert.Contains(t, w.Body.String(), "Title is required")
+}
+
+func TestTicketHandler_BatchTickets_Reassign(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	tickets, err := h.TicketRepo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	newAssignee := uuid.New()
+
+	r := gin.New()
+	r.POST("/tickets/batch", func(c *gin.Context) {
+		c.Set("user_id", uuid.New().String())
+		h.BatchTickets(c)
+	})
+	body := `{"action":"update","ticket_ids":["` + tickets[0].ID.String() + `","` + uuid.New().String() + `"],"patch":{"assignee_id":"` + newAssignee.String() + `"}}`
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("POST", "/tickets/batch", strings.NewReader(body))
+	req.Header.Set("Content-Type", "application/json")
+	r.ServeHTTP(w, req)
+	require.Equal(t, 200, w.Code, w.Body.String())
+
+	var resp model.TicketBatchResponse
+	require.NoError(t, json.Unmarshal(w.Body.Bytes(), &resp))
+	require.Len(t, resp.Results, 2)
+	assert.Equal(t, model.TicketBatchUpdated, resp.Results[0].Status)
+	assert.Equal(t, newAssignee, resp.Results[0].Ticket.AssigneeID)
+	assert.Equal(t, model.TicketBatchNotFound, resp.Results[1].Status)
+
+	updated, err := h.TicketRepo.GetByID(tickets[0].ID, nil)
+	require.NoError(t, err)
+	assert.Equal(t, newAssignee, updated.AssigneeID)
+}
+
+func TestTicketHandler_BatchTickets_RejectsTitleChange(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	r := gin.New()
+	r.POST("/tickets/batch", func(c *gin.Context) {
+		c.Set("user_id", uuid.New().String())
+		h.BatchTickets(c)
+	})
+	body := `{"action":"update","ticket_ids":["` + uuid.New().String() + `"],"patch":{"title":"x"}}`
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("POST", "/tickets/batch", strings.NewReader(body))
+	req.Header.Set("Content-Type", "application/json")
+	r.ServeHTTP(w, req)
+	assert.Equal(t, 400, w.Code)
+	assert.Contains(t, w.Body.String(), "cannot be changed in a batch")
+}
+
+func TestTicketHandler_GetTickets_UpdatedSince(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	r := gin.New()
+	r.GET("/tickets", h.GetTickets)
+
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/tickets", nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, 200, w.Code)
+	watermark := w.Header().Get("X-Sync-Watermark")
+	require.NotEmpty(t, watermark)
+
+	// Nothing has changed since the full load.
+	var delta []map[string]interface{}
+	tickets, err := h.TicketRepo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	w = httptest.NewRecorder()
+	req, _ = http.NewRequest("GET", "/tickets?updated_since="+watermark, nil)
+	r.ServeHTTP(w, req)
+	require.Equal(t, 200, w.Code)
+	assert.Equal(t, "[]", w.Body.String())
+
+	require.NoError(t, h.TicketRepo.Delete(tickets[0].ID, nil))
+	w = httptest.NewRecorder()
+	req, _ = http.NewRequest("GET", "/tickets?updated_since="+watermark, nil)
+	r.ServeHTTP(w, req)
+	require.NoError(t, json.Unmarshal(w.Body.Bytes(), &delta))
+	require.Len(t, delta, 1)
+	assert.Equal(t, true, delta[0]["deleted"])
+	assert.Equal(t, tickets[0].ID.String(), delta[0]["ticket_id"])
+
+	w = httptest.NewRecorder()
+	req, _ = http.NewRequest("GET", "/tickets?updated_since=yesterday", nil)
+	r.ServeHTTP(w, req)
+	assert.Equal(t, 400, w.Code)
+
+	w = httptest.NewRecorder()
+	req, _ = http.NewRequest("GET", "/tickets?updated_since="+watermark+"&held=not-a-uuid", nil)
+	r.ServeHTTP(w, req)
+	assert.Equal(t, 400, w.Code)
+}
+
+func TestTicketHandler_GetTicketByID_CreatedAtHint(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	h := setupTestTicketHandler(t)
+	tickets, err := h.TicketRepo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	require.Len(t, tickets, 1)
+	r := gin.New()
+	r.GET("/tickets/:id", h.GetTicketByID)
+
+	for _, query := range []string{"", "?ticket_created_at=" + url.QueryEscape(tickets[0].CreatedAt.Format(time.RFC3339Nano))} {
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("GET", "/tickets/"+tickets[0].ID.String()+query, nil)
+		r.ServeHTTP(w, req)
+		require.Equal(t, 200, w.Code, query)
+		assert.Contains(t, w.Body.String(), tickets[0].Title)
+	}
+
+	w := httptest.NewRecorder()
+	req, _ := http.NewRequest("GET", "/tickets/"+tickets[0].ID.String()+"?ticket_created_at=yesterday", nil)
+	r.ServeHTTP(w, req)
+	assert.Equal(t, 400, w.Code)
+	assert.Contains(t, w.Body.String(), "INVALID_TICKET_CREATED_AT")
+}
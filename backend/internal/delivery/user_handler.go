@@ -2,6 +2,8 @@ package delivery
 
 import (
 	"net/http"
+	"strconv"
+	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/repository"
 
 	"github.com/gin-gonic/gin"
@@ -15,8 +17,33 @@ func NewUserHandler(repo *repository.UserRepository) *UserHandler {
 	return &UserHandler{Repo: repo}
 }
 
+const (
+	defaultUserSearchLimit = 50
+	maxUserSearchLimit     = 500
+)
+
+// ListUsers returns the whole directory, or with ?q=<prefix> and/or ?department_id=
+// a name-ordered prefix search limited by ?limit= (default 50).
 func (h *UserHandler) ListUsers(c *gin.Context) {
-	users, err := h.Repo.List()
+	var users []*domain.User
+	var err error
+	if c.Query("q") != "" || c.Query("department_id") != "" {
+		departmentID := 0
+		if raw := c.Query("department_id"); raw != "" {
+			var convErr error
+			if departmentID, convErr = strconv.Atoi(raw); convErr != nil || departmentID <= 0 {
+				c.JSON(http.StatusBadRequest, gin.H{"error": "invalid department_id"})
+				return
+			}
+		}
+		limit, convErr := strconv.Atoi(c.DefaultQuery("limit", strconv.Itoa(defaultUserSearchLimit)))
+		if convErr != nil || limit <= 0 || limit > maxUserSearchLimit {
+			limit = defaultUserSearchLimit
+		}
+		users, err = h.Repo.Search(c.Query("q"), departmentID, limit)
+	} else {
+		users, err = h.Repo.List()
+	}
 	if err != nil {
 		c.JSON(http.StatusInternalServerError, gin.H{"error": "failed to fetch users"})
 		return
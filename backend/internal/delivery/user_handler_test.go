@@ -1,6 +1,7 @@
 package delivery
 
 import (
+	"encoding/json"
 	"net/http"
 	"net/http/httptest"
 	"testing"
@@ -53,3 +54,46 @@ func TestUserHandler_ListUsers_Error(t *testing.T) {
 	assert.Equal(t, 500, w.Code)
 	assert.Contains(t, w.Body.String(), "failed to fetch users")
 }
+
+func TestUserHandler_ListUsers_PrefixSearch(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	repo := setupTestUserRepo(t)
+	for _, u := range []*domain.User{
+		{ID: uuid.New(), Username: "Alex", DepartmentID: 2},
+		{ID: uuid.New(), Username: "al_bert", DepartmentID: 1},
+		{ID: uuid.New(), Username: "bob", DepartmentID: 1},
+	} {
+		require.NoError(t, repo.Create(u))
+	}
+	h := &UserHandler{Repo: repo}
+	r := gin.New()
+	r.GET("/users", h.ListUsers)
+
+	search := func(query string) []string {
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("GET", "/users?"+query, nil)
+		r.ServeHTTP(w, req)
+		require.Equal(t, 200, w.Code)
+		var body []struct {
+			Username string `json:"username"`
+		}
+		require.NoError(t, json.Unmarshal(w.Body.Bytes(), &body))
+		names := make([]string, 0, len(body))
+		for _, u := range body {
+			names = append(names, u.Username)
+		}
+		return names
+	}
+
+	assert.Equal(t, []string{"al_bert", "Alex", "alice"}, search("q=AL"))
+	assert.Equal(t, []string{"al_bert", "alice"}, search("q=al&department_id=1"))
+	assert.Equal(t, []string{"al_bert"}, search("q=al_"))
+	assert.Equal(t, []string{"al_bert"}, search("q=a&limit=1"))
+
+	for _, query := range []string{"department_id=it", "q=al&department_id=0", "department_id=-1"} {
+		w := httptest.NewRecorder()
+		req, _ := http.NewRequest("GET", "/users?"+query, nil)
+		r.ServeHTTP(w, req)
+		assert.Equal(t, http.StatusBadRequest, w.Code, query)
+	}
+}
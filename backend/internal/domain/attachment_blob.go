@@ -0,0 +1,13 @@
+package domain
+
+import "time"
+
+// AttachmentBlob is stored file content addressed by its SHA-256. Attachments that
+// carry the same bytes share one blob; RefCount tracks how many rows point at it.
+type AttachmentBlob struct {
+	SHA256      string    `gorm:"column:sha256;primaryKey" json:"sha256"`
+	SizeBytes   int64     `gorm:"column:size_bytes" json:"size_bytes"`
+	StoragePath string    `gorm:"column:storage_path" json:"-"`
+	RefCount    int       `gorm:"column:ref_count" json:"-"`
+	CreatedAt   time.Time `gorm:"column:created_at" json:"created_at"`
+}
@@ -0,0 +1,23 @@
+package domain
+
+import (
+	"time"
+
+	"github.com/google/uuid"
+)
+
+// AttachmentUpload is an in-progress chunked upload. Chunks live on disk until commit.
+type AttachmentUpload struct {
+	ID              uuid.UUID `gorm:"column:upload_id;primaryKey" json:"upload_id"`
+	TicketID        uuid.UUID `gorm:"column:ticket_id" json:"ticket_id"`
+	TicketCreatedAt time.Time `gorm:"column:ticket_created_at" json:"ticket_created_at"`
+	Filename        string    `gorm:"column:filename" json:"filename"`
+	SizeBytes       int64     `gorm:"column:size_bytes" json:"size_bytes"`
+	ChunkSize       int64     `gorm:"column:chunk_size" json:"chunk_size"`
+	SHA256          string    `gorm:"column:sha256" json:"sha256,omitempty"`
+	UploadedBy      uuid.UUID `gorm:"column:uploaded_by" json:"uploaded_by"`
+	CreatedAt       time.Time `gorm:"column:created_at" json:"created_at"`
+	// CommittingAt is set while a commit assembles the file, so a second commit
+	// of the same upload is refused instead of racing it.
+	CommittingAt *time.Time `gorm:"column:committing_at" json:"-"`
+}
@@ -0,0 +1,19 @@
+package domain
+
+import (
+	"time"
+
+	"github.com/google/uuid"
+)
+
+// IdempotencyKey is the stored outcome of a mutating request sent with an
+// Idempotency-Key header. StatusCode is 0 while the first attempt is still running.
+type IdempotencyKey struct {
+	UserID       uuid.UUID `gorm:"column:user_id;primaryKey"`
+	Key          string    `gorm:"column:idempotency_key;primaryKey"`
+	Method       string    `gorm:"column:method"`
+	Path         string    `gorm:"column:path"`
+	StatusCode   int       `gorm:"column:status_code"`
+	ResponseBody []byte    `gorm:"column:response_body"`
+	CreatedAt    time.Time `gorm:"column:created_at"`
+}
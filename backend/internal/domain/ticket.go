@@ -18,4 +18,6 @@ type Ticket struct {
 	CreatedAt    time.Time  `gorm:"column:created_at;primaryKey" json:"created_at"`
 	UpdatedAt    time.Time  `gorm:"column:updated_at" json:"updated_at"`
 	DeletedAt    *time.Time `gorm:"column:deleted_at" json:"deleted_at"`
+	// Archived marks tickets read from tickets_archive (GET /tickets?archived=true).
+	Archived bool `gorm:"-" json:"archived,omitempty"`
 }
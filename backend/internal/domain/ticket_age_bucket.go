@@ -0,0 +1,14 @@
+package domain
+
+import "time"
+
+// TicketAgeBucket is a row of the mv_ticket_age_buckets materialized view: open
+// tickets of a department whose age falls in Bucket ("0-1d", "1-7d", "7-30d", "30d+").
+type TicketAgeBucket struct {
+	DepartmentID int16     `gorm:"column:department_id"`
+	Bucket       string    `gorm:"column:bucket"`
+	TicketCount  int64     `gorm:"column:ticket_count"`
+	RefreshedAt  time.Time `gorm:"column:refreshed_at"`
+}
+
+func (TicketAgeBucket) TableName() string { return "mv_ticket_age_buckets" }
@@ -0,0 +1,12 @@
+package domain
+
+import "time"
+
+// TicketArchive is a ticket moved out of a cold tickets partition. Archived rows
+// stay searchable but are no longer edited.
+type TicketArchive struct {
+	Ticket
+	ArchivedAt time.Time `gorm:"column:archived_at" json:"archived_at"`
+}
+
+func (TicketArchive) TableName() string { return "tickets_archive" }
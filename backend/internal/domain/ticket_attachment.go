@@ -15,6 +15,9 @@ type TicketAttachment struct {
 	Metadata        json.RawMessage `gorm:"column:metadata" json:"metadata,omitempty"`
 	FileData        []byte          `gorm:"column:file_data" json:"file_data,omitempty"`
 	FilePath        *string         `gorm:"column:file_path" json:"file_path,omitempty"`
+	SizeBytes       int64           `gorm:"column:size_bytes" json:"size_bytes"`
+	SHA256          string          `gorm:"column:sha256" json:"sha256,omitempty"`
+	BlobSHA256      *string         `gorm:"column:blob_sha256" json:"blob_sha256,omitempty"`
 	UploadedBy      uuid.UUID       `gorm:"column:uploaded_by" json:"uploaded_by"`
 	UploadedAt      time.Time       `gorm:"column:uploaded_at" json:"uploaded_at"`
 }
@@ -0,0 +1,17 @@
+package domain
+
+import (
+	"time"
+
+	"github.com/google/uuid"
+)
+
+type TicketAttachmentThumbnail struct {
+	AttachmentID uuid.UUID `gorm:"column:attachment_id;primaryKey" json:"attachment_id"`
+	Size         int       `gorm:"column:size;primaryKey" json:"size"`
+	ContentType  string    `gorm:"column:content_type" json:"content_type"`
+	Width        int       `gorm:"column:width" json:"width"`
+	Height       int       `gorm:"column:height" json:"height"`
+	Data         []byte    `gorm:"column:data" json:"-"`
+	CreatedAt    time.Time `gorm:"column:created_at" json:"created_at"`
+}
@@ -0,0 +1,12 @@
+package domain
+
+import "time"
+
+// TicketDailyStats is the ticket throughput of one UTC day.
+type TicketDailyStats struct {
+	Day          time.Time `gorm:"column:day;primaryKey"`
+	CreatedCount int64     `gorm:"column:created_count"`
+	ClosedCount  int64     `gorm:"column:closed_count"`
+}
+
+func (TicketDailyStats) TableName() string { return "ticket_daily_stats" }
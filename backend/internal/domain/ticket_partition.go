@@ -0,0 +1,10 @@
+package domain
+
+import "time"
+
+// TicketPartition is one range partition of tickets, holding rows created in [From, To).
+type TicketPartition struct {
+	Name string
+	From time.Time
+	To   time.Time
+}
@@ -0,0 +1,15 @@
+package domain
+
+import "github.com/google/uuid"
+
+// TicketSummary counts the live tickets sharing a department, priority, status and
+// assignee. Rows are kept current by a trigger on tickets (migration 140).
+type TicketSummary struct {
+	DepartmentID int16      `gorm:"column:department_id"`
+	PriorityID   int16      `gorm:"column:priority_id"`
+	StatusID     int16      `gorm:"column:status_id"`
+	AssigneeID   *uuid.UUID `gorm:"column:assignee_id"`
+	TicketCount  int64      `gorm:"column:ticket_count"`
+}
+
+func (TicketSummary) TableName() string { return "ticket_summary" }
@@ -0,0 +1,147 @@
+package middleware
+
+import (
+	"bytes"
+	"context"
+	"log"
+	"net/http"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+	"ticket-system/backend/internal/usecase"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+)
+
+// IdempotencyKeyTTL is how long a stored response can be replayed.
+const IdempotencyKeyTTL = 24 * time.Hour
+
+// IdempotencyReservationLease is how long an unfinished request holds its key. A
+// process that dies mid-request never completes or releases it; after the lease a
+// retry runs the request instead of getting 409 until the key expires. It is well
+// above any request's running time, so a live attempt is not taken over.
+const IdempotencyReservationLease = time.Minute
+
+const maxIdempotencyKeyLength = 128
+
+// Idempotency makes mutating requests that carry an Idempotency-Key header safe to
+// retry. The first response is stored per user and key, and repeats get it back
+// with Idempotent-Replayed: true instead of running the handler again. Server
+// errors are not stored, so those requests can be retried for real. Must run after JWT.
+func Idempotency(repo usecase.IdempotencyRepository) gin.HandlerFunc {
+	return func(c *gin.Context) {
+		key := c.GetHeader("Idempotency-Key")
+		method := c.Request.Method
+		if key == "" || method == http.MethodGet || method == http.MethodHead || method == http.MethodOptions {
+			c.Next()
+			return
+		}
+		if len(key) > maxIdempotencyKeyLength {
+			c.AbortWithStatusJSON(http.StatusBadRequest, model.APIError{Code: "INVALID_IDEMPOTENCY_KEY", Message: "Idempotency-Key is too long"})
+			return
+		}
+		userIDStr, _ := c.Get("user_id")
+		userID, err := uuid.Parse(toString(userIDStr))
+		if err != nil {
+			c.Next()
+			return
+		}
+
+		record := &domain.IdempotencyKey{UserID: userID, Key: key, Method: method, Path: c.Request.URL.Path}
+		existing, reserved, err := repo.Reserve(record, time.Now().UTC().Add(-IdempotencyReservationLease))
+		if err != nil {
+			c.AbortWithStatusJSON(http.StatusInternalServerError, model.APIError{Code: "DATABASE_ERROR", Message: "Failed to check Idempotency-Key"})
+			return
+		}
+		if !reserved {
+			replay(c, existing)
+			return
+		}
+
+		done := false
+		defer func() {
+			// A panicking handler leaves no response worth replaying.
+			if !done {
+				if err := repo.Release(userID, key); err != nil {
+					log.Printf("idempotency: release %s: %v", key, err)
+				}
+			}
+		}()
+		writer := &recordingWriter{ResponseWriter: c.Writer}
+		c.Writer = writer
+		c.Next()
+
+		status := writer.Status()
+		if status >= http.StatusInternalServerError {
+			return
+		}
+		if err := repo.Complete(userID, key, status, writer.body.Bytes()); err != nil {
+			log.Printf("idempotency: store %s: %v", key, err)
+			return
+		}
+		done = true
+	}
+}
+
+func replay(c *gin.Context, existing *domain.IdempotencyKey) {
+	if existing.Method != c.Request.Method || existing.Path != c.Request.URL.Path {
+		c.AbortWithStatusJSON(http.StatusUnprocessableEntity, model.APIError{
+			Code:    "IDEMPOTENCY_KEY_REUSED",
+			Message: "Idempotency-Key was already used for a different request",
+			Details: existing.Method + " " + existing.Path,
+		})
+		return
+	}
+	if existing.StatusCode == 0 {
+		c.AbortWithStatusJSON(http.StatusConflict, model.APIError{Code: "IDEMPOTENCY_KEY_IN_PROGRESS", Message: "A request with this Idempotency-Key is still being processed"})
+		return
+	}
+	c.Header("Idempotent-Replayed", "true")
+	if len(existing.ResponseBody) == 0 {
+		c.AbortWithStatus(existing.StatusCode)
+		return
+	}
+	c.Data(existing.StatusCode, "application/json; charset=utf-8", existing.ResponseBody)
+	c.Abort()
+}
+
+// PurgeIdempotencyKeys deletes expired keys every interval until ctx is done.
+func PurgeIdempotencyKeys(ctx context.Context, repo usecase.IdempotencyRepository, interval time.Duration) {
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		if n, err := repo.PurgeBefore(time.Now().UTC().Add(-IdempotencyKeyTTL)); err != nil {
+			log.Printf("idempotency: purge: %v", err)
+		} else if n > 0 {
+			log.Printf("idempotency: purged %d expired keys", n)
+		}
+		select {
+		case <-ctx.Done():
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+func toString(v interface{}) string {
+	s, _ := v.(string)
+	return s
+}
+
+// recordingWriter passes the response through and keeps a copy of the body.
+type recordingWriter struct {
+	gin.ResponseWriter
+	body bytes.Buffer
+}
+
+func (w *recordingWriter) Write(b []byte) (int, error) {
+	w.body.Write(b)
+	return w.ResponseWriter.Write(b)
+}
+
+func (w *recordingWriter) WriteString(s string) (int, error) {
+	w.body.WriteString(s)
+	return w.ResponseWriter.WriteString(s)
+}
@@ -0,0 +1,69 @@
+package middleware
+
+import (
+	"net/http"
+	"net/http/httptest"
+	"testing"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/repository"
+
+	"github.com/gin-gonic/gin"
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func TestIdempotency_ReplaysStoredResponse(t *testing.T) {
+	gin.SetMode(gin.TestMode)
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.IdempotencyKey{}))
+	repo := repository.NewIdempotencyRepository(db)
+
+	userID := uuid.New().String()
+	created, failures := 0, 0
+	r := gin.New()
+	r.Use(func(c *gin.Context) { c.Set("user_id", userID); c.Next() })
+	r.Use(Idempotency(repo))
+	r.POST("/tickets", func(c *gin.Context) {
+		created++
+		c.JSON(http.StatusCreated, gin.H{"n": created})
+	})
+	r.POST("/flaky", func(c *gin.Context) {
+		failures++
+		c.JSON(http.StatusInternalServerError, gin.H{"n": failures})
+	})
+	send := func(path, key string) *httptest.ResponseRecorder {
+		req := httptest.NewRequest(http.MethodPost, path, nil)
+		if key != "" {
+			req.Header.Set("Idempotency-Key", key)
+		}
+		w := httptest.NewRecorder()
+		r.ServeHTTP(w, req)
+		return w
+	}
+
+	first := send("/tickets", "k1")
+	second := send("/tickets", "k1")
+	assert.Equal(t, http.StatusCreated, second.Code)
+	assert.JSONEq(t, first.Body.String(), second.Body.String())
+	assert.Equal(t, "true", second.Header().Get("Idempotent-Replayed"))
+	assert.Equal(t, 1, created)
+
+	// Without a key, or with a new one, the handler runs.
+	send("/tickets", "")
+	send("/tickets", "k2")
+	assert.Equal(t, 3, created)
+
+	// The same key on another endpoint is a client bug.
+	assert.Equal(t, http.StatusUnprocessableEntity, send("/flaky", "k1").Code)
+	assert.Equal(t, 0, failures)
+
+	// Server errors are not stored.
+	send("/flaky", "k3")
+	send("/flaky", "k3")
+	assert.Equal(t, 2, failures)
+}
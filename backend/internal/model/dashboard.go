@@ -0,0 +1,36 @@
+package model
+
+import "time"
+
+// Dashboard is the response of GET /dashboard. Counts cover open (not closed, not
+// deleted, not archived) tickets.
+type Dashboard struct {
+	OpenTotal        int64                `json:"open_total"`
+	OpenByDepartment []DashboardCount     `json:"open_by_department"`
+	OpenByPriority   []DashboardCount     `json:"open_by_priority"`
+	OpenByAssignee   []DashboardCount     `json:"open_by_assignee"`
+	AgeBuckets       []DashboardAgeBucket `json:"age_buckets"`
+	// AgeRefreshedAt is when the age buckets were last recomputed; they lag the counts.
+	AgeRefreshedAt *time.Time     `json:"age_refreshed_at,omitempty"`
+	Throughput     []DashboardDay `json:"throughput"`
+}
+
+// DashboardCount is a count per department id, priority id or assignee id; the
+// unassigned tickets have an empty id.
+type DashboardCount struct {
+	ID    string `json:"id"`
+	Count int64  `json:"count"`
+}
+
+type DashboardAgeBucket struct {
+	DepartmentID int16  `json:"department_id"`
+	Bucket       string `json:"bucket"`
+	Count        int64  `json:"count"`
+}
+
+// DashboardDay is one UTC day of throughput, formatted 2006-01-02.
+type DashboardDay struct {
+	Day     string `json:"day"`
+	Created int64  `json:"created"`
+	Closed  int64  `json:"closed"`
+}
@@ -23,6 +23,7 @@ type TicketFilter struct {
 	AssigneeID   *string
 	DepartmentID *int16
 	Q            string
+	Archived     bool // search tickets_archive instead of the hot partitions
 	Limit        int
 	Offset       int
 }
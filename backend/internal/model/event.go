@@ -0,0 +1,40 @@
+package model
+
+import (
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+)
+
+// ChangeNotification is one row change as published by the database triggers.
+type ChangeNotification struct {
+	Table    string    `json:"table"`
+	Op       string    `json:"op"`
+	ID       uuid.UUID `json:"id"`
+	TicketID uuid.UUID `json:"ticket_id"`
+}
+
+// Change event types sent to clients on GET /events.
+const (
+	EventTicketUpdated      = "ticket.updated"
+	EventTicketDeleted      = "ticket.deleted"
+	EventCommentsChanged    = "comments.changed"
+	EventAttachmentsChanged = "attachments.changed"
+)
+
+// RowChange is one comment or attachment row touched by a change; Op is the
+// trigger's INSERT, UPDATE or DELETE.
+type RowChange struct {
+	ID uuid.UUID `json:"id"`
+	Op string    `json:"op"`
+}
+
+// ChangeEvent is what clients receive. ticket.updated carries the current ticket.
+// comments.changed and attachments.changed list the rows that changed, in order,
+// so a client can merge them by id and recognize its own writes.
+type ChangeEvent struct {
+	Type     string         `json:"type"`
+	TicketID uuid.UUID      `json:"ticket_id"`
+	Ticket   *domain.Ticket `json:"ticket,omitempty"`
+	Changes  []RowChange    `json:"changes,omitempty"`
+}
@@ -0,0 +1,81 @@
+package model
+
+import (
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+)
+
+// TicketPatch is the body of PATCH /tickets/:id. Fields left out of the request are
+// nil and keep their stored values.
+type TicketPatch struct {
+	Title        *string    `json:"title"`
+	Description  *string    `json:"description"`
+	StatusID     *int16     `json:"status_id"`
+	PriorityID   *int16     `json:"priority_id"`
+	DepartmentID *int16     `json:"department_id"`
+	AssigneeID   *uuid.UUID `json:"assignee_id"`
+}
+
+// ApplyTo copies the fields present in the patch onto ticket and returns the
+// columns whose value actually changed, keyed by column name.
+func (patch *TicketPatch) ApplyTo(ticket *domain.Ticket) map[string]interface{} {
+	columns := map[string]interface{}{}
+	if patch.Title != nil && *patch.Title != ticket.Title {
+		ticket.Title = *patch.Title
+		columns["title"] = ticket.Title
+	}
+	if patch.Description != nil && *patch.Description != ticket.Description {
+		ticket.Description = *patch.Description
+		columns["description"] = ticket.Description
+	}
+	if patch.StatusID != nil && *patch.StatusID != ticket.StatusID {
+		ticket.StatusID = *patch.StatusID
+		columns["status_id"] = ticket.StatusID
+	}
+	if patch.PriorityID != nil && *patch.PriorityID != ticket.PriorityID {
+		ticket.PriorityID = *patch.PriorityID
+		columns["priority_id"] = ticket.PriorityID
+	}
+	if patch.DepartmentID != nil && *patch.DepartmentID != ticket.DepartmentID {
+		ticket.DepartmentID = *patch.DepartmentID
+		columns["department_id"] = ticket.DepartmentID
+	}
+	if patch.AssigneeID != nil && *patch.AssigneeID != ticket.AssigneeID {
+		ticket.AssigneeID = *patch.AssigneeID
+		columns["assignee_id"] = ticket.AssigneeID
+	}
+	return columns
+}
+
+// Batch actions accepted by POST /tickets/batch.
+const (
+	TicketBatchUpdate = "update"
+	TicketBatchDelete = "delete"
+)
+
+// TicketBatchRequest applies one change to many tickets. For "update" only the
+// status, priority, department and assignee fields of Patch may be set.
+type TicketBatchRequest struct {
+	Action    string      `json:"action" binding:"required,oneof=update delete"`
+	TicketIDs []uuid.UUID `json:"ticket_ids" binding:"required,min=1"`
+	Patch     TicketPatch `json:"patch"`
+}
+
+// Per-ticket outcomes of a batch.
+const (
+	TicketBatchUpdated   = "updated"
+	TicketBatchUnchanged = "unchanged"
+	TicketBatchDeleted   = "deleted"
+	TicketBatchNotFound  = "not_found"
+)
+
+type TicketBatchResult struct {
+	TicketID uuid.UUID      `json:"ticket_id"`
+	Status   string         `json:"status"`
+	Ticket   *domain.Ticket `json:"ticket,omitempty"`
+}
+
+type TicketBatchResponse struct {
+	Results []TicketBatchResult `json:"results"`
+}
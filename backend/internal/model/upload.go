@@ -0,0 +1,28 @@
+package model
+
+import "github.com/google/uuid"
+
+type InitiateUploadRequest struct {
+	Filename  string `json:"filename" binding:"required"`
+	SizeBytes int64  `json:"size_bytes" binding:"min=0"`
+	SHA256    string `json:"sha256"`
+}
+
+type UploadStatus struct {
+	UploadID        uuid.UUID `json:"upload_id"`
+	Filename        string    `json:"filename"`
+	SizeBytes       int64     `json:"size_bytes"`
+	ChunkSize       int64     `json:"chunk_size"`
+	ReceivedOffsets []int64   `json:"received_offsets"`
+	ReceivedBytes   int64     `json:"received_bytes"`
+}
+
+type AttachBlobRequest struct {
+	SHA256   string `json:"sha256" binding:"required,len=64,hexadecimal"`
+	Filename string `json:"filename" binding:"required"`
+}
+
+type BlobInfo struct {
+	SHA256    string `json:"sha256"`
+	SizeBytes int64  `json:"size_bytes"`
+}
@@ -0,0 +1,114 @@
+package repository
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"gorm.io/gorm"
+	"gorm.io/gorm/clause"
+)
+
+// AttachmentBlobRepository is a content-addressed store: files live under
+// Dir/<aa>/<bb>/<sha256> and attachment_blobs counts their references.
+// File moves and removals happen while the blob row is locked by the
+// surrounding transaction, so a concurrent put and release cannot interleave.
+type AttachmentBlobRepository struct {
+	DB  *gorm.DB
+	Dir string
+}
+
+func NewAttachmentBlobRepository(db *gorm.DB, dir string) *AttachmentBlobRepository {
+	return &AttachmentBlobRepository{DB: db, Dir: dir}
+}
+
+func (r *AttachmentBlobRepository) blobPath(sha256 string) string {
+	return filepath.Join(r.Dir, sha256[:2], sha256[2:4], sha256)
+}
+
+func (r *AttachmentBlobRepository) Get(sha256 string) (*domain.AttachmentBlob, error) {
+	var blob domain.AttachmentBlob
+	if err := r.DB.Where("sha256 = ?", sha256).First(&blob).Error; err != nil {
+		return nil, err
+	}
+	return &blob, nil
+}
+
+func (r *AttachmentBlobRepository) GetOwned(sha256 string, uploaderID uuid.UUID) (*domain.AttachmentBlob, error) {
+	var blob domain.AttachmentBlob
+	err := r.DB.Where("sha256 = ? AND EXISTS (SELECT 1 FROM ticket_attachments WHERE blob_sha256 = attachment_blobs.sha256 AND uploaded_by = ?)", sha256, uploaderID).
+		First(&blob).Error
+	if err != nil {
+		return nil, err
+	}
+	return &blob, nil
+}
+
+// PutFile takes ownership of the file at srcPath and adds one reference to its blob.
+// If the content is already stored the file is discarded.
+func (r *AttachmentBlobRepository) PutFile(srcPath, sha256 string, size int64) (*domain.AttachmentBlob, error) {
+	blob := &domain.AttachmentBlob{SHA256: sha256, SizeBytes: size, StoragePath: r.blobPath(sha256), RefCount: 1, CreatedAt: time.Now().UTC()}
+	err := r.DB.Transaction(func(tx *gorm.DB) error {
+		if err := tx.Clauses(clause.OnConflict{
+			Columns:   []clause.Column{{Name: "sha256"}},
+			DoUpdates: clause.Assignments(map[string]interface{}{"ref_count": gorm.Expr("attachment_blobs.ref_count + 1")}),
+		}).Create(blob).Error; err != nil {
+			return err
+		}
+		if _, err := os.Stat(blob.StoragePath); err == nil {
+			return os.Remove(srcPath)
+		}
+		if err := os.MkdirAll(filepath.Dir(blob.StoragePath), 0o750); err != nil {
+			return err
+		}
+		return os.Rename(srcPath, blob.StoragePath)
+	})
+	if err != nil {
+		return nil, err
+	}
+	return r.Get(sha256)
+}
+
+// Acquire adds a reference to an existing blob.
+func (r *AttachmentBlobRepository) Acquire(sha256 string) (*domain.AttachmentBlob, error) {
+	res := r.DB.Model(&domain.AttachmentBlob{}).Where("sha256 = ?", sha256).
+		Update("ref_count", gorm.Expr("ref_count + 1"))
+	if res.Error != nil {
+		return nil, res.Error
+	}
+	if res.RowsAffected == 0 {
+		return nil, gorm.ErrRecordNotFound
+	}
+	return r.Get(sha256)
+}
+
+// Release drops one reference and removes the blob once nothing points at it.
+func (r *AttachmentBlobRepository) Release(sha256 string) error {
+	return r.DB.Transaction(func(tx *gorm.DB) error {
+		return releaseBlob(tx, sha256)
+	})
+}
+
+func releaseBlob(tx *gorm.DB, sha256 string) error {
+	var blob domain.AttachmentBlob
+	if err := tx.Clauses(clause.Locking{Strength: "UPDATE"}).Where("sha256 = ?", sha256).First(&blob).Error; err != nil {
+		if errors.Is(err, gorm.ErrRecordNotFound) {
+			return nil
+		}
+		return err
+	}
+	if blob.RefCount > 1 {
+		return tx.Model(&blob).Update("ref_count", gorm.Expr("ref_count - 1")).Error
+	}
+	if err := tx.Delete(&blob).Error; err != nil {
+		return err
+	}
+	if err := os.Remove(blob.StoragePath); err != nil && !os.IsNotExist(err) {
+		return err
+	}
+	return nil
+}
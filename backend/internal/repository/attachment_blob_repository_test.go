@@ -0,0 +1,72 @@
+package repository
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func TestAttachmentBlobRepository_RefCount_SQLite(t *testing.T) {
+	db := setupAttachmentTestDB_SQLite(t)
+	require.NoError(t, db.AutoMigrate(&domain.AttachmentBlob{}))
+	dir := t.TempDir()
+	blobs := NewAttachmentBlobRepository(db, filepath.Join(dir, "blobs"))
+	attachments := NewTicketAttachmentRepository(db)
+	var ticket domain.Ticket
+	require.NoError(t, db.First(&ticket).Error)
+
+	sha := "abcd456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+	put := func() *domain.AttachmentBlob {
+		src := filepath.Join(dir, uuid.NewString())
+		require.NoError(t, os.WriteFile(src, []byte("payload"), 0o600))
+		blob, err := blobs.PutFile(src, sha, 7)
+		require.NoError(t, err)
+		_, err = os.Stat(src)
+		assert.True(t, os.IsNotExist(err))
+		return blob
+	}
+	first := put()
+	second := put()
+	assert.Equal(t, first.StoragePath, second.StoragePath)
+	assert.Equal(t, 2, second.RefCount)
+
+	acquired, err := blobs.Acquire(sha)
+	require.NoError(t, err)
+	assert.Equal(t, 3, acquired.RefCount)
+	_, err = blobs.Acquire("missing")
+	assert.Error(t, err)
+
+	var ids []uuid.UUID
+	for i := 0; i < 3; i++ {
+		path, blobSHA := first.StoragePath, sha
+		att := &domain.TicketAttachment{ID: uuid.New(), TicketID: ticket.ID, Filename: "payload.bin", FilePath: &path, BlobSHA256: &blobSHA, UploadedBy: ticket.CreatorID, UploadedAt: time.Now()}
+		require.NoError(t, attachments.Create(att))
+		ids = append(ids, att.ID)
+	}
+	owned, err := blobs.GetOwned(sha, ticket.CreatorID)
+	require.NoError(t, err)
+	assert.Equal(t, sha, owned.SHA256)
+	_, err = blobs.GetOwned(sha, uuid.New())
+	assert.Error(t, err, "a user without an attachment of the blob does not see it")
+
+	require.NoError(t, attachments.Delete(ids[0]))
+	require.NoError(t, attachments.Delete(ids[1]))
+	blob, err := blobs.Get(sha)
+	require.NoError(t, err)
+	assert.Equal(t, 1, blob.RefCount)
+	_, err = os.Stat(blob.StoragePath)
+	assert.NoError(t, err)
+
+	require.NoError(t, attachments.Delete(ids[2]))
+	_, err = blobs.Get(sha)
+	assert.Error(t, err)
+	_, err = os.Stat(first.StoragePath)
+	assert.True(t, os.IsNotExist(err))
+}
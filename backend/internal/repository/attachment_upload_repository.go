@@ -0,0 +1,52 @@
+package repository
+
+import (
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"gorm.io/gorm"
+)
+
+type AttachmentUploadRepository struct {
+	DB *gorm.DB
+}
+
+func NewAttachmentUploadRepository(db *gorm.DB) *AttachmentUploadRepository {
+	return &AttachmentUploadRepository{DB: db}
+}
+
+func (r *AttachmentUploadRepository) Create(upload *domain.AttachmentUpload) error {
+	return r.DB.Create(upload).Error
+}
+
+func (r *AttachmentUploadRepository) GetByID(uploadID uuid.UUID) (*domain.AttachmentUpload, error) {
+	var upload domain.AttachmentUpload
+	err := r.DB.Where("upload_id = ?", uploadID).First(&upload).Error
+	if err != nil {
+		return nil, err
+	}
+	return &upload, nil
+}
+
+func (r *AttachmentUploadRepository) Delete(uploadID uuid.UUID) error {
+	return r.DB.Delete(&domain.AttachmentUpload{}, "upload_id = ?", uploadID).Error
+}
+
+func (r *AttachmentUploadRepository) ListCreatedBefore(before time.Time) ([]domain.AttachmentUpload, error) {
+	var uploads []domain.AttachmentUpload
+	err := r.DB.Where("created_at < ?", before).Order("created_at").Find(&uploads).Error
+	return uploads, err
+}
+
+func (r *AttachmentUploadRepository) ClaimCommit(uploadID uuid.UUID, now, staleBefore time.Time) (bool, error) {
+	res := r.DB.Model(&domain.AttachmentUpload{}).
+		Where("upload_id = ? AND (committing_at IS NULL OR committing_at < ?)", uploadID, staleBefore).
+		Update("committing_at", now)
+	return res.RowsAffected == 1, res.Error
+}
+
+func (r *AttachmentUploadRepository) ReleaseCommit(uploadID uuid.UUID) error {
+	return r.DB.Model(&domain.AttachmentUpload{}).Where("upload_id = ?", uploadID).Update("committing_at", nil).Error
+}
@@ -0,0 +1,63 @@
+package repository
+
+import (
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func TestAttachmentUploadRepository_SQLite(t *testing.T) {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.AttachmentUpload{}))
+	repo := NewAttachmentUploadRepository(db)
+
+	upload := &domain.AttachmentUpload{
+		ID:         uuid.New(),
+		TicketID:   uuid.New(),
+		Filename:   "capture.pcap",
+		SizeBytes:  100,
+		ChunkSize:  10,
+		UploadedBy: uuid.New(),
+		CreatedAt:  time.Now(),
+	}
+	require.NoError(t, repo.Create(upload))
+
+	got, err := repo.GetByID(upload.ID)
+	require.NoError(t, err)
+	assert.Equal(t, "capture.pcap", got.Filename)
+	assert.Equal(t, int64(10), got.ChunkSize)
+
+	stale, err := repo.ListCreatedBefore(time.Now().Add(time.Minute))
+	require.NoError(t, err)
+	require.Len(t, stale, 1)
+	stale, err = repo.ListCreatedBefore(time.Now().Add(-time.Hour))
+	require.NoError(t, err)
+	assert.Empty(t, stale)
+
+	now := time.Now().UTC()
+	claimed, err := repo.ClaimCommit(upload.ID, now, now.Add(-time.Minute))
+	require.NoError(t, err)
+	assert.True(t, claimed)
+	claimed, err = repo.ClaimCommit(upload.ID, now, now.Add(-time.Minute))
+	require.NoError(t, err)
+	assert.False(t, claimed, "a fresh claim blocks a second commit")
+	claimed, err = repo.ClaimCommit(upload.ID, now, now.Add(time.Minute))
+	require.NoError(t, err)
+	assert.True(t, claimed, "a stale claim is taken over")
+	require.NoError(t, repo.ReleaseCommit(upload.ID))
+	got, err = repo.GetByID(upload.ID)
+	require.NoError(t, err)
+	assert.Nil(t, got.CommittingAt)
+
+	require.NoError(t, repo.Delete(upload.ID))
+	_, err = repo.GetByID(upload.ID)
+	assert.Error(t, err)
+}
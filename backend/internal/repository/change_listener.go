@@ -0,0 +1,56 @@
+package repository
+
+import (
+	"context"
+	"encoding/json"
+	"log"
+	"time"
+
+	"ticket-system/backend/internal/model"
+
+	"github.com/jackc/pgx/v5"
+)
+
+// ChangeChannel is the NOTIFY channel written by the change triggers (migration 110).
+const ChangeChannel = "ticket_changes"
+
+// ListenForChanges holds a dedicated connection in LISTEN mode and forwards every
+// notification to out until ctx is cancelled, reconnecting after failures.
+func ListenForChanges(ctx context.Context, dsn string, out chan<- model.ChangeNotification) {
+	for ctx.Err() == nil {
+		if err := listen(ctx, dsn, out); err != nil && ctx.Err() == nil {
+			log.Printf("change listener: %v; reconnecting in 5s", err)
+			select {
+			case <-ctx.Done():
+			case <-time.After(5 * time.Second):
+			}
+		}
+	}
+}
+
+func listen(ctx context.Context, dsn string, out chan<- model.ChangeNotification) error {
+	conn, err := pgx.Connect(ctx, dsn)
+	if err != nil {
+		return err
+	}
+	defer conn.Close(context.Background())
+	if _, err := conn.Exec(ctx, "LISTEN "+ChangeChannel); err != nil {
+		return err
+	}
+	for {
+		n, err := conn.WaitForNotification(ctx)
+		if err != nil {
+			return err
+		}
+		var change model.ChangeNotification
+		if err := json.Unmarshal([]byte(n.Payload), &change); err != nil {
+			log.Printf("change listener: bad payload %q: %v", n.Payload, err)
+			continue
+		}
+		select {
+		case out <- change:
+		case <-ctx.Done():
+			return ctx.Err()
+		}
+	}
+}
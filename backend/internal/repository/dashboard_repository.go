@@ -0,0 +1,134 @@
+package repository
+
+import (
+	"sort"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"gorm.io/gorm"
+)
+
+type DashboardRepository struct {
+	DB *gorm.DB
+}
+
+func NewDashboardRepository(db *gorm.DB) *DashboardRepository {
+	return &DashboardRepository{DB: db}
+}
+
+// snapshot runs fn in one transaction that sees a single snapshot, so a fold that
+// commits between its queries is seen either entirely or not at all.
+func (r *DashboardRepository) snapshot(fn func(tx *gorm.DB) error) error {
+	return r.DB.Transaction(func(tx *gorm.DB) error {
+		if tx.Dialector.Name() == "postgres" {
+			if err := tx.Exec("SET TRANSACTION ISOLATION LEVEL REPEATABLE READ, READ ONLY").Error; err != nil {
+				return err
+			}
+		}
+		return fn(tx)
+	})
+}
+
+type summaryKey struct {
+	departmentID, priorityID, statusID int16
+	assigneeID                         uuid.UUID // uuid.Nil for no assignee
+}
+
+// OpenSummary adds the deltas not folded yet (migration 190) to ticket_summary.
+func (r *DashboardRepository) OpenSummary() ([]domain.TicketSummary, error) {
+	var rows, deltas []domain.TicketSummary
+	err := r.snapshot(func(tx *gorm.DB) error {
+		open := func(table string, out *[]domain.TicketSummary) error {
+			return tx.Table(table+" s").
+				Select("s.department_id, s.priority_id, s.status_id, s.assignee_id, s.ticket_count").
+				Joins("JOIN ticket_statuses st ON st.status_id = s.status_id").
+				Where("st.code <> ?", "closed").
+				Find(out).Error
+		}
+		if err := open("ticket_summary", &rows); err != nil {
+			return err
+		}
+		return open("ticket_summary_deltas", &deltas)
+	})
+	if err != nil {
+		return nil, err
+	}
+	key := func(s domain.TicketSummary) summaryKey {
+		k := summaryKey{departmentID: s.DepartmentID, priorityID: s.PriorityID, statusID: s.StatusID}
+		if s.AssigneeID != nil {
+			k.assigneeID = *s.AssigneeID
+		}
+		return k
+	}
+	index := make(map[summaryKey]int, len(rows))
+	for i, row := range rows {
+		index[key(row)] = i
+	}
+	for _, d := range deltas {
+		if i, ok := index[key(d)]; ok {
+			rows[i].TicketCount += d.TicketCount
+		} else {
+			index[key(d)] = len(rows)
+			rows = append(rows, d)
+		}
+	}
+	open := rows[:0]
+	for _, row := range rows {
+		if row.TicketCount > 0 {
+			open = append(open, row)
+		}
+	}
+	return open, nil
+}
+
+func (r *DashboardRepository) AgeBuckets() ([]domain.TicketAgeBucket, error) {
+	var rows []domain.TicketAgeBucket
+	err := r.DB.Find(&rows).Error
+	return rows, err
+}
+
+// Throughput adds the deltas not folded yet (migration 190) to ticket_daily_stats.
+func (r *DashboardRepository) Throughput(since time.Time) ([]domain.TicketDailyStats, error) {
+	var rows, deltas []domain.TicketDailyStats
+	err := r.snapshot(func(tx *gorm.DB) error {
+		if err := tx.Where("day >= ?", since).Order("day").Find(&rows).Error; err != nil {
+			return err
+		}
+		return tx.Table("ticket_daily_stats_deltas").Where("day >= ?", since).Find(&deltas).Error
+	})
+	if err != nil {
+		return nil, err
+	}
+	index := make(map[int64]int, len(rows))
+	for i, row := range rows {
+		index[row.Day.Unix()] = i
+	}
+	added := false
+	for _, d := range deltas {
+		if i, ok := index[d.Day.Unix()]; ok {
+			rows[i].CreatedCount += d.CreatedCount
+			rows[i].ClosedCount += d.ClosedCount
+		} else {
+			index[d.Day.Unix()] = len(rows)
+			rows = append(rows, d)
+			added = true
+		}
+	}
+	if added {
+		sort.Slice(rows, func(i, j int) bool { return rows[i].Day.Before(rows[j].Day) })
+	}
+	return rows, nil
+}
+
+// RefreshAgeBuckets recomputes mv_ticket_age_buckets without blocking readers.
+func (r *DashboardRepository) RefreshAgeBuckets() error {
+	return r.DB.Exec("REFRESH MATERIALIZED VIEW CONCURRENTLY mv_ticket_age_buckets").Error
+}
+
+// FoldDeltas moves the summary deltas written by ticket transactions into the
+// summary tables (fn_fold_ticket_summary, migration 190).
+func (r *DashboardRepository) FoldDeltas() error {
+	return r.DB.Exec("SELECT fn_fold_ticket_summary()").Error
+}
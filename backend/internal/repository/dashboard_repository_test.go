@@ -0,0 +1,152 @@
+package repository
+
+import (
+	"os"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func setupDashboardTestDB(t *testing.T) *gorm.DB {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.TicketStatus{}, &domain.TicketSummary{}, &domain.TicketDailyStats{}, &domain.TicketAgeBucket{}))
+	require.NoError(t, db.Table("ticket_summary_deltas").AutoMigrate(&domain.TicketSummary{}))
+	// Unlike ticket_daily_stats, the deltas hold several rows per day.
+	require.NoError(t, db.Exec(`CREATE TABLE ticket_daily_stats_deltas (
+		day datetime NOT NULL, created_count integer NOT NULL DEFAULT 0, closed_count integer NOT NULL DEFAULT 0)`).Error)
+	require.NoError(t, db.Create(&domain.TicketStatus{ID: 1, Code: "open", Label: "Open"}).Error)
+	require.NoError(t, db.Create(&domain.TicketStatus{ID: 2, Code: "closed", Label: "Closed"}).Error)
+	return db
+}
+
+func TestDashboardRepository_SQLite(t *testing.T) {
+	db := setupDashboardTestDB(t)
+	repo := NewDashboardRepository(db)
+	assignee := uuid.New()
+	require.NoError(t, db.Create(&[]domain.TicketSummary{
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, AssigneeID: &assignee, TicketCount: 3},
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, TicketCount: 2},
+		{DepartmentID: 2, PriorityID: 1, StatusID: 1, TicketCount: 0},
+		{DepartmentID: 1, PriorityID: 1, StatusID: 2, TicketCount: 7},
+	}).Error)
+
+	rows, err := repo.OpenSummary()
+	require.NoError(t, err)
+	require.Len(t, rows, 2, "closed and emptied groups are left out")
+	var total int64
+	for _, r := range rows {
+		total += r.TicketCount
+	}
+	assert.Equal(t, int64(5), total)
+
+	day := time.Date(2026, 10, 1, 0, 0, 0, 0, time.UTC)
+	require.NoError(t, db.Create(&[]domain.TicketDailyStats{
+		{Day: day, CreatedCount: 4, ClosedCount: 1},
+		{Day: day.AddDate(0, 0, 2), CreatedCount: 1},
+	}).Error)
+	stats, err := repo.Throughput(day.AddDate(0, 0, 1))
+	require.NoError(t, err)
+	require.Len(t, stats, 1)
+	assert.Equal(t, int64(1), stats[0].CreatedCount)
+
+	require.NoError(t, db.Create(&domain.TicketAgeBucket{DepartmentID: 1, Bucket: "1-7d", TicketCount: 5, RefreshedAt: time.Now()}).Error)
+	buckets, err := repo.AgeBuckets()
+	require.NoError(t, err)
+	require.Len(t, buckets, 1)
+	assert.Equal(t, "1-7d", buckets[0].Bucket)
+}
+
+func TestDashboardRepository_UnfoldedDeltas_SQLite(t *testing.T) {
+	db := setupDashboardTestDB(t)
+	repo := NewDashboardRepository(db)
+	assignee := uuid.New()
+	require.NoError(t, db.Create(&[]domain.TicketSummary{
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, AssigneeID: &assignee, TicketCount: 3},
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, TicketCount: 1},
+	}).Error)
+	require.NoError(t, db.Table("ticket_summary_deltas").Create(&[]domain.TicketSummary{
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, AssigneeID: &assignee, TicketCount: 1},
+		{DepartmentID: 1, PriorityID: 1, StatusID: 1, TicketCount: -1},
+		{DepartmentID: 2, PriorityID: 1, StatusID: 1, TicketCount: 1},
+		{DepartmentID: 2, PriorityID: 1, StatusID: 2, TicketCount: 1},
+	}).Error)
+
+	rows, err := repo.OpenSummary()
+	require.NoError(t, err)
+	counts := map[int16]int64{}
+	for _, r := range rows {
+		counts[r.DepartmentID] += r.TicketCount
+	}
+	assert.Equal(t, map[int16]int64{1: 4, 2: 1}, counts, "emptied and closed groups are left out")
+
+	day := time.Date(2026, 10, 1, 0, 0, 0, 0, time.UTC)
+	require.NoError(t, db.Create(&domain.TicketDailyStats{Day: day.AddDate(0, 0, 1), CreatedCount: 2}).Error)
+	require.NoError(t, db.Table("ticket_daily_stats_deltas").Create(&[]domain.TicketDailyStats{
+		{Day: day, CreatedCount: 1},
+		{Day: day.AddDate(0, 0, 1), CreatedCount: 1, ClosedCount: 1},
+		{Day: day, ClosedCount: 1},
+	}).Error)
+	stats, err := repo.Throughput(day)
+	require.NoError(t, err)
+	require.Len(t, stats, 2)
+	assert.True(t, stats[0].Day.Equal(day))
+	assert.Equal(t, int64(1), stats[0].CreatedCount)
+	assert.Equal(t, int64(1), stats[0].ClosedCount)
+	assert.Equal(t, int64(3), stats[1].CreatedCount)
+}
+
+// TestDashboardRepository_Trigger_Postgres checks that the summary tables follow
+// ticket writes (migration 140).
+func TestDashboardRepository_Trigger_Postgres(t *testing.T) {
+	if os.Getenv("INTEGRATION_TEST") == "" {
+		t.Skip("set INTEGRATION_TEST=1 to run")
+	}
+	db := setupPostgresTestDB(t)
+	require.NoError(t, db.Exec("TRUNCATE ticket_summary, ticket_daily_stats, ticket_summary_deltas, ticket_daily_stats_deltas").Error)
+	require.NoError(t, db.Create(&domain.TicketStatus{ID: 2, Code: "closed", Label: "Closed"}).Error)
+	repo := NewDashboardRepository(db)
+	tickets := NewTicketRepository(db)
+
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+	ticket := &domain.Ticket{ID: uuid.New(), Title: "Dashboard", StatusID: 1, PriorityID: 1, CreatorID: user.ID,
+		AssigneeID: user.ID, DepartmentID: 1, CreatedAt: time.Now(), UpdatedAt: time.Now()}
+	require.NoError(t, tickets.Create(ticket))
+
+	rows, err := repo.OpenSummary()
+	require.NoError(t, err)
+	require.Len(t, rows, 1)
+	assert.Equal(t, int64(1), rows[0].TicketCount)
+
+	require.NoError(t, tickets.Patch(ticket.ID, &ticket.CreatedAt, map[string]interface{}{"status_id": 2}))
+	rows, err = repo.OpenSummary()
+	require.NoError(t, err)
+	assert.Empty(t, rows)
+
+	today := time.Now().UTC().Truncate(24 * time.Hour)
+	stats, err := repo.Throughput(today)
+	require.NoError(t, err)
+	require.Len(t, stats, 1)
+	assert.Equal(t, int64(1), stats[0].CreatedCount)
+	assert.Equal(t, int64(1), stats[0].ClosedCount)
+
+	// Folded or not, the counts read the same.
+	require.NoError(t, repo.FoldDeltas())
+	stats, err = repo.Throughput(today)
+	require.NoError(t, err)
+	require.Len(t, stats, 1)
+	assert.Equal(t, int64(1), stats[0].CreatedCount)
+	var pending int64
+	require.NoError(t, db.Table("ticket_summary_deltas").Count(&pending).Error)
+	assert.Zero(t, pending)
+
+	require.NoError(t, repo.RefreshAgeBuckets())
+}
@@ -0,0 +1,68 @@
+package repository
+
+import (
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"gorm.io/gorm"
+	"gorm.io/gorm/clause"
+)
+
+type IdempotencyRepository struct {
+	DB *gorm.DB
+}
+
+func NewIdempotencyRepository(db *gorm.DB) *IdempotencyRepository {
+	return &IdempotencyRepository{DB: db}
+}
+
+// Reserve inserts the record unless (user_id, idempotency_key) exists. The insert
+// is the lock: of two concurrent attempts with one key, only one gets the row.
+// A reservation for the same request that is still unfinished and was made
+// before staleBefore belongs to an attempt that died; it is taken over, again by
+// a single conditional update.
+func (r *IdempotencyRepository) Reserve(record *domain.IdempotencyKey, staleBefore time.Time) (*domain.IdempotencyKey, bool, error) {
+	if record.CreatedAt.IsZero() {
+		record.CreatedAt = time.Now().UTC()
+	}
+	res := r.DB.Clauses(clause.OnConflict{DoNothing: true}).Create(record)
+	if res.Error != nil {
+		return nil, false, res.Error
+	}
+	if res.RowsAffected == 1 {
+		return record, true, nil
+	}
+	res = r.DB.Model(&domain.IdempotencyKey{}).
+		Where("user_id = ? AND idempotency_key = ? AND method = ? AND path = ? AND status_code = 0 AND created_at < ?",
+			record.UserID, record.Key, record.Method, record.Path, staleBefore).
+		Update("created_at", record.CreatedAt)
+	if res.Error != nil {
+		return nil, false, res.Error
+	}
+	if res.RowsAffected == 1 {
+		return record, true, nil
+	}
+	var existing domain.IdempotencyKey
+	if err := r.DB.Where("user_id = ? AND idempotency_key = ?", record.UserID, record.Key).First(&existing).Error; err != nil {
+		return nil, false, err
+	}
+	return &existing, false, nil
+}
+
+func (r *IdempotencyRepository) Complete(userID uuid.UUID, key string, statusCode int, body []byte) error {
+	return r.DB.Model(&domain.IdempotencyKey{}).
+		Where("user_id = ? AND idempotency_key = ?", userID, key).
+		Updates(map[string]interface{}{"status_code": statusCode, "response_body": body}).Error
+}
+
+// Release forgets a key whose request failed on our side, so the client may retry it.
+func (r *IdempotencyRepository) Release(userID uuid.UUID, key string) error {
+	return r.DB.Delete(&domain.IdempotencyKey{}, "user_id = ? AND idempotency_key = ?", userID, key).Error
+}
+
+func (r *IdempotencyRepository) PurgeBefore(cutoff time.Time) (int64, error) {
+	res := r.DB.Delete(&domain.IdempotencyKey{}, "created_at < ?", cutoff)
+	return res.RowsAffected, res.Error
+}
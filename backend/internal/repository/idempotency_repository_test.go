@@ -0,0 +1,59 @@
+package repository
+
+import (
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+	"gorm.io/driver/sqlite"
+	"gorm.io/gorm"
+)
+
+func TestIdempotencyRepository_SQLite(t *testing.T) {
+	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
+	require.NoError(t, err)
+	require.NoError(t, db.AutoMigrate(&domain.IdempotencyKey{}))
+	repo := NewIdempotencyRepository(db)
+	userID := uuid.New()
+
+	_, reserved, err := repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(-time.Minute))
+	require.NoError(t, err)
+	assert.True(t, reserved)
+
+	existing, reserved, err := repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(-time.Minute))
+	require.NoError(t, err)
+	assert.False(t, reserved)
+	assert.Equal(t, 0, existing.StatusCode)
+
+	// An unfinished reservation older than the lease is taken over, but only by the same request.
+	_, reserved, err = repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "DELETE", Path: "/tickets"}, time.Now().UTC().Add(time.Minute))
+	require.NoError(t, err)
+	assert.False(t, reserved)
+	_, reserved, err = repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(time.Minute))
+	require.NoError(t, err)
+	assert.True(t, reserved)
+
+	// Keys are per user.
+	_, reserved, err = repo.Reserve(&domain.IdempotencyKey{UserID: uuid.New(), Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(-time.Minute))
+	require.NoError(t, err)
+	assert.True(t, reserved)
+
+	require.NoError(t, repo.Complete(userID, "a", 201, []byte(`{"ok":true}`)))
+	existing, _, err = repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(-time.Minute))
+	require.NoError(t, err)
+	assert.Equal(t, 201, existing.StatusCode)
+	assert.JSONEq(t, `{"ok":true}`, string(existing.ResponseBody))
+
+	require.NoError(t, repo.Release(userID, "a"))
+	_, reserved, err = repo.Reserve(&domain.IdempotencyKey{UserID: userID, Key: "a", Method: "POST", Path: "/tickets"}, time.Now().UTC().Add(-time.Minute))
+	require.NoError(t, err)
+	assert.True(t, reserved)
+
+	n, err := repo.PurgeBefore(time.Now().UTC().Add(time.Minute))
+	require.NoError(t, err)
+	assert.Equal(t, int64(3), n)
+}
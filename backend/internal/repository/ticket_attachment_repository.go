@@ -1,10 +1,13 @@
 package repository
 
 import (
+	"errors"
+
 	"ticket-system/backend/internal/domain"
 
 	"github.com/google/uuid"
 	"gorm.io/gorm"
+	"gorm.io/gorm/clause"
 )
 
 type TicketAttachmentRepository struct {
@@ -17,7 +20,7 @@ func NewTicketAttachmentRepository(db *gorm.DB) *TicketAttachmentRepository {
 
 func (r *TicketAttachmentRepository) GetByTicketID(ticketID uuid.UUID) ([]*domain.TicketAttachment, error) {
 	var atts []*domain.TicketAttachment
-	err := r.DB.Where("ticket_id = ?", ticketID).Order("uploaded_at ASC").Find(&atts).Error
+	err := r.DB.Omit("file_data").Where("ticket_id = ?", ticketID).Order("uploaded_at ASC").Find(&atts).Error
 	if err != nil {
 		return nil, err
 	}
@@ -33,10 +36,60 @@ func (r *TicketAttachmentRepository) GetByID(attID uuid.UUID) (*domain.TicketAtt
 	return &att, nil
 }
 
+// GetMetaByID loads an attachment without its file_data.
+func (r *TicketAttachmentRepository) GetMetaByID(attID uuid.UUID) (*domain.TicketAttachment, error) {
+	var att domain.TicketAttachment
+	err := r.DB.Omit("file_data").Where("attachment_id = ?", attID).First(&att).Error
+	if err != nil {
+		return nil, err
+	}
+	return &att, nil
+}
+
+// ReadDataRange returns up to length bytes of file_data starting at offset.
+func (r *TicketAttachmentRepository) ReadDataRange(attID uuid.UUID, offset int64, length int) ([]byte, error) {
+	var data []byte
+	err := r.DB.Raw("SELECT substr(file_data, ?, ?) FROM ticket_attachments WHERE attachment_id = ?", offset+1, length, attID).
+		Row().Scan(&data)
+	if err != nil {
+		return nil, err
+	}
+	return data, nil
+}
+
 func (r *TicketAttachmentRepository) Create(att *domain.TicketAttachment) error {
 	return r.DB.Create(att).Error
 }
 
+// Delete removes the attachment and releases its content blob, if it has one.
 func (r *TicketAttachmentRepository) Delete(attID uuid.UUID) error {
-	return r.DB.Delete(&domain.TicketAttachment{}, "attachment_id = ?", attID).Error
+	return r.DB.Transaction(func(tx *gorm.DB) error {
+		var att domain.TicketAttachment
+		if err := tx.Omit("file_data").Where("attachment_id = ?", attID).First(&att).Error; err != nil {
+			if errors.Is(err, gorm.ErrRecordNotFound) {
+				return nil
+			}
+			return err
+		}
+		if err := tx.Delete(&domain.TicketAttachment{}, "attachment_id = ?", attID).Error; err != nil {
+			return err
+		}
+		if att.BlobSHA256 != nil {
+			return releaseBlob(tx, *att.BlobSHA256)
+		}
+		return nil
+	})
+}
+
+func (r *TicketAttachmentRepository) GetThumbnail(attID uuid.UUID, size int) (*domain.TicketAttachmentThumbnail, error) {
+	var thumb domain.TicketAttachmentThumbnail
+	err := r.DB.Where("attachment_id = ? AND size = ?", attID, size).First(&thumb).Error
+	if err != nil {
+		return nil, err
+	}
+	return &thumb, nil
+}
+
+func (r *TicketAttachmentRepository) SaveThumbnail(thumb *domain.TicketAttachmentThumbnail) error {
+	return r.DB.Clauses(clause.OnConflict{UpdateAll: true}).Create(thumb).Error
 }
@@ -20,7 +20,7 @@ import (
 func setupAttachmentTestDB_SQLite(t *testing.T) *gorm.DB {
 	db, err := gorm.Open(sqlite.Open(":memory:"), &gorm.Config{})
 	require.NoError(t, err)
-	err = db.AutoMigrate(&domain.Role{}, &domain.Department{}, &domain.User{}, &domain.Ticket{}, &domain.TicketAttachment{})
+	err = db.AutoMigrate(&domain.Role{}, &domain.Department{}, &domain.User{}, &domain.Ticket{}, &domain.TicketAttachment{}, &domain.TicketAttachmentThumbnail{})
 	require.NoError(t, err)
 	role := &domain.Role{ID: uuid.New(), Name: "user"}
 	require.NoError(t, db.Create(role).Error)
@@ -55,6 +55,41 @@ func TestTicketAttachmentRepository_SQLite(t *testing.T) {
 	assert.NoError(t, err)
 }
 
+func TestTicketAttachmentRepository_Thumbnails_SQLite(t *testing.T) {
+	db := setupAttachmentTestDB_SQLite(t)
+	repo := NewTicketAttachmentRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+	var ticket domain.Ticket
+	require.NoError(t, db.First(&ticket).Error)
+	attachment := &domain.TicketAttachment{
+		ID:         uuid.New(),
+		TicketID:   ticket.ID,
+		Filename:   "photo.png",
+		FileData:   []byte("original"),
+		UploadedBy: user.ID,
+		UploadedAt: time.Now(),
+	}
+	require.NoError(t, repo.Create(attachment))
+
+	_, err := repo.GetThumbnail(attachment.ID, 128)
+	assert.Error(t, err)
+
+	thumb := &domain.TicketAttachmentThumbnail{AttachmentID: attachment.ID, Size: 128, ContentType: "image/jpeg", Data: []byte("v1"), CreatedAt: time.Now()}
+	require.NoError(t, repo.SaveThumbnail(thumb))
+	thumb.Data = []byte("v2")
+	require.NoError(t, repo.SaveThumbnail(thumb))
+
+	got, err := repo.GetThumbnail(attachment.ID, 128)
+	require.NoError(t, err)
+	assert.Equal(t, []byte("v2"), got.Data)
+
+	listed, err := repo.GetByTicketID(ticket.ID)
+	require.NoError(t, err)
+	require.Len(t, listed, 1)
+	assert.Nil(t, listed[0].FileData)
+}
+
 func setupAttachmentTestDB_Postgres(t *testing.T) *gorm.DB {
 	dsn := "host=localhost port=5434 user=postgres password=password dbname=ticket_system_test sslmode=disable"
 	if !strings.Contains("ticket_system_test", "_test") {
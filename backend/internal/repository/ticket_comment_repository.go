@@ -2,6 +2,7 @@ package repository
 
 import (
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 
 	"github.com/google/uuid"
 	"gorm.io/gorm"
@@ -24,6 +25,21 @@ func (r *TicketCommentRepository) GetByTicketID(ticketID uuid.UUID) ([]*domain.T
 	return comments, nil
 }
 
+// GetPageByTicketID returns up to limit comments older than before, newest first.
+// Keyset pagination over (created_at, comment_id) keeps every page an index range scan.
+func (r *TicketCommentRepository) GetPageByTicketID(ticketID uuid.UUID, before *model.CommentCursor, limit int) ([]*domain.TicketComment, error) {
+	var comments []*domain.TicketComment
+	db := r.DB.Where("ticket_id = ?", ticketID)
+	if before != nil {
+		db = db.Where("(created_at, comment_id) < (?, ?)", before.CreatedAt, before.ID)
+	}
+	err := db.Order("created_at DESC").Order("comment_id DESC").Limit(limit).Find(&comments).Error
+	if err != nil {
+		return nil, err
+	}
+	return comments, nil
+}
+
 func (r *TicketCommentRepository) Create(comment *domain.TicketComment) error {
 	return r.DB.Create(comment).Error
 }
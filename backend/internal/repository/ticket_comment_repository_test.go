@@ -1,11 +1,13 @@
 package repository
 
 import (
+	"fmt"
 	"os"
 	"testing"
 	"time"
 
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 
 	"github.com/google/uuid"
 	"github.com/stretchr/testify/assert"
@@ -58,6 +60,38 @@ func TestTicketCommentRepository_CRUD_SQLite(t *testing.T) {
 	assert.Error(t, err)
 }
 
+func TestTicketCommentRepository_GetPageByTicketID_SQLite(t *testing.T) {
+	db := setupCommentTestDB_SQLite(t)
+	repo := NewTicketCommentRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+	var ticket domain.Ticket
+	require.NoError(t, db.First(&ticket).Error)
+	base := time.Date(2025, 3, 1, 12, 0, 0, 0, time.UTC)
+	for i := 0; i < 5; i++ {
+		require.NoError(t, repo.Create(&domain.TicketComment{
+			ID:        uuid.New(),
+			TicketID:  ticket.ID,
+			AuthorID:  user.ID,
+			Content:   fmt.Sprintf("comment %d", i),
+			CreatedAt: base.Add(time.Duration(i) * time.Minute),
+		}))
+	}
+
+	first, err := repo.GetPageByTicketID(ticket.ID, nil, 2)
+	assert.NoError(t, err)
+	require.Len(t, first, 2)
+	assert.Equal(t, "comment 4", first[0].Content)
+	assert.Equal(t, "comment 3", first[1].Content)
+
+	last := first[len(first)-1]
+	second, err := repo.GetPageByTicketID(ticket.ID, &model.CommentCursor{CreatedAt: last.CreatedAt, ID: last.ID}, 10)
+	assert.NoError(t, err)
+	require.Len(t, second, 3)
+	assert.Equal(t, "comment 2", second[0].Content)
+	assert.Equal(t, "comment 0", second[2].Content)
+}
+
 func setupCommentTestDB_Postgres(t *testing.T) *gorm.DB {
 	dsn := "host=localhost port=5434 user=postgres password=password dbname=ticket_system sslmode=disable"
 	db, err := gorm.Open(postgres.Open(dsn), &gorm.Config{})
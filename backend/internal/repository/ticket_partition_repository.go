@@ -0,0 +1,221 @@
+package repository
+
+import (
+	"context"
+	"database/sql/driver"
+	"fmt"
+	"regexp"
+	"strings"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/jackc/pgx/v5"
+	"gorm.io/gorm"
+)
+
+// ticketArchiveColumns are copied from a cold partition into tickets_archive
+// (migration 130); archived_at takes its default.
+const ticketArchiveColumns = "ticket_id, title, description, status_id, priority_id, creator_id, assignee_id, " +
+	"department_id, created_at, updated_at, deleted_at, search_vector"
+
+// ticketArchiveUpdates refreshes an archived row from a later copy of the same ticket.
+var ticketArchiveUpdates = func() string {
+	var sets []string
+	for _, col := range strings.Split(ticketArchiveColumns, ", ") {
+		if col != "ticket_id" && col != "created_at" {
+			sets = append(sets, col+" = EXCLUDED."+col)
+		}
+	}
+	return strings.Join(sets, ", ")
+}()
+
+// partitionLockKey is the pg_try_advisory_lock key held during a maintenance pass.
+const partitionLockKey int64 = 0x7469636b6574 // "ticket"
+
+// TicketPartitionRepository reads and changes the partitions of tickets through
+// the Postgres catalog. It has no meaning on other databases.
+type TicketPartitionRepository struct {
+	DB *gorm.DB
+}
+
+func NewTicketPartitionRepository(db *gorm.DB) *TicketPartitionRepository {
+	return &TicketPartitionRepository{DB: db}
+}
+
+func (r *TicketPartitionRepository) List() ([]domain.TicketPartition, error) {
+	var rows []struct {
+		Name  string
+		Bound string
+	}
+	err := r.DB.Raw(`SELECT c.relname AS name, pg_get_expr(c.relpartbound, c.oid) AS bound
+		FROM pg_inherits i JOIN pg_class c ON c.oid = i.inhrelid
+		WHERE i.inhparent = 'tickets'::regclass
+		ORDER BY c.relname`).Scan(&rows).Error
+	if err != nil {
+		return nil, err
+	}
+	partitions := make([]domain.TicketPartition, 0, len(rows))
+	for _, row := range rows {
+		from, to, ok := parsePartitionBound(row.Bound)
+		if !ok {
+			continue // DEFAULT, MINVALUE/MAXVALUE: not ours to manage
+		}
+		partitions = append(partitions, domain.TicketPartition{Name: row.Name, From: from, To: to})
+	}
+	return partitions, nil
+}
+
+func (r *TicketPartitionRepository) Create(partition domain.TicketPartition) error {
+	return r.DB.Exec(fmt.Sprintf("CREATE TABLE IF NOT EXISTS %s PARTITION OF tickets FOR VALUES FROM ('%s') TO ('%s')",
+		pgx.Identifier{partition.Name}.Sanitize(),
+		partition.From.UTC().Format(time.RFC3339), partition.To.UTC().Format(time.RFC3339))).Error
+}
+
+// Archive moves a cold partition into tickets_archive without holding a lock on
+// tickets for the length of the copy:
+//  1. the partition is recorded in ticket_partition_archives (migration 180);
+//  2. the rows are upserted into tickets_archive while the partition is still
+//     attached, so a ticket is briefly in both places but never in neither;
+//  3. DETACH PARTITION CONCURRENTLY waits for running queries instead of blocking
+//     new ones; it cannot run inside a transaction;
+//  4. one transaction on the now-detached table re-copies rows edited during
+//     step 2, takes the rows out of the dashboard counts, drops it and deletes
+//     the record.
+//
+// A crash can stop this at any step. The record outlives the partition's place
+// in pg_inherits, so Unfinished finds a detached table and the next pass calls
+// Archive again. That call resumes: a DETACH left pending is finalized, a table
+// already detached is not detached again, and a record whose table is gone is deleted.
+func (r *TicketPartitionRepository) Archive(partition domain.TicketPartition) (int64, error) {
+	name := pgx.Identifier{partition.Name}.Sanitize()
+	if err := r.DB.Exec("INSERT INTO ticket_partition_archives (name) VALUES (?) ON CONFLICT (name) DO NOTHING",
+		partition.Name).Error; err != nil {
+		return 0, err
+	}
+	var state struct {
+		Present  bool
+		Attached bool
+		Pending  bool
+	}
+	if err := r.DB.Raw(`SELECT to_regclass(?) IS NOT NULL AS present, i.inhrelid IS NOT NULL AS attached,
+			coalesce(i.inhdetachpending, false) AS pending
+		FROM (SELECT 1) one
+		LEFT JOIN pg_inherits i ON i.inhrelid = to_regclass(?) AND i.inhparent = 'tickets'::regclass`,
+		name, name).Scan(&state).Error; err != nil {
+		return 0, err
+	}
+	if !state.Present {
+		return 0, r.DB.Exec("DELETE FROM ticket_partition_archives WHERE name = ?", partition.Name).Error
+	}
+
+	copyRows := "INSERT INTO tickets_archive (" + ticketArchiveColumns + ") SELECT " + ticketArchiveColumns +
+		" FROM " + name + " ON CONFLICT (ticket_id, created_at) DO UPDATE SET " + ticketArchiveUpdates +
+		" WHERE tickets_archive.updated_at IS DISTINCT FROM EXCLUDED.updated_at" +
+		" OR tickets_archive.deleted_at IS DISTINCT FROM EXCLUDED.deleted_at"
+	res := r.DB.Exec(copyRows)
+	if res.Error != nil {
+		return 0, res.Error
+	}
+	moved := res.RowsAffected
+
+	if state.Attached {
+		detach := "ALTER TABLE tickets DETACH PARTITION " + name + " CONCURRENTLY"
+		if state.Pending {
+			detach = "ALTER TABLE tickets DETACH PARTITION " + name + " FINALIZE"
+		}
+		if err := r.DB.Exec(detach).Error; err != nil {
+			return moved, err
+		}
+	}
+
+	err := r.DB.Transaction(func(tx *gorm.DB) error {
+		if err := tx.Exec(copyRows).Error; err != nil {
+			return err
+		}
+		// Detaching fires no row triggers, so take the rows out of the dashboard counts
+		// here, as deltas like the trigger writes (migration 190).
+		if err := tx.Exec(`INSERT INTO ticket_summary_deltas (department_id, priority_id, status_id, assignee_id, ticket_count)
+			SELECT department_id, priority_id, status_id, assignee_id, -count(*) FROM ` + name + `
+			WHERE deleted_at IS NULL GROUP BY department_id, priority_id, status_id, assignee_id`).Error; err != nil {
+			return err
+		}
+		if err := tx.Exec("DROP TABLE " + name).Error; err != nil {
+			return err
+		}
+		return tx.Exec("DELETE FROM ticket_partition_archives WHERE name = ?", partition.Name).Error
+	})
+	return moved, err
+}
+
+// Unfinished lists the recorded archives whose table is no longer a partition of
+// tickets: detached but not dropped, or already gone.
+func (r *TicketPartitionRepository) Unfinished() ([]domain.TicketPartition, error) {
+	var names []string
+	err := r.DB.Raw(`SELECT a.name FROM ticket_partition_archives a
+		WHERE NOT EXISTS (SELECT 1 FROM pg_inherits i
+			WHERE i.inhrelid = to_regclass(quote_ident(a.name)) AND i.inhparent = 'tickets'::regclass)
+		ORDER BY a.name`).Scan(&names).Error
+	if err != nil {
+		return nil, err
+	}
+	partitions := make([]domain.TicketPartition, len(names))
+	for i, name := range names {
+		partitions[i] = domain.TicketPartition{Name: name}
+	}
+	return partitions, nil
+}
+
+// TryLock takes a session-level advisory lock on a connection of its own, held
+// until unlock. If the process dies, the session ends and the lock goes with it.
+func (r *TicketPartitionRepository) TryLock() (func(), bool, error) {
+	sqlDB, err := r.DB.DB()
+	if err != nil {
+		return nil, false, err
+	}
+	ctx := context.Background()
+	conn, err := sqlDB.Conn(ctx)
+	if err != nil {
+		return nil, false, err
+	}
+	var locked bool
+	if err := conn.QueryRowContext(ctx, "SELECT pg_try_advisory_lock($1)", partitionLockKey).Scan(&locked); err != nil || !locked {
+		conn.Close()
+		return nil, false, err
+	}
+	return func() {
+		if _, err := conn.ExecContext(ctx, "SELECT pg_advisory_unlock($1)", partitionLockKey); err != nil {
+			// Discard the connection rather than return it to the pool still locked.
+			_ = conn.Raw(func(interface{}) error { return driver.ErrBadConn })
+		}
+		conn.Close()
+	}, true, nil
+}
+
+var partitionBoundRe = regexp.MustCompile(`^FOR VALUES FROM \('([^']+)'\) TO \('([^']+)'\)$`)
+
+// parsePartitionBound reads pg_get_expr output such as
+// FOR VALUES FROM ('2024-01-01 00:00:00+00') TO ('2025-01-01 00:00:00+00').
+func parsePartitionBound(bound string) (from, to time.Time, ok bool) {
+	m := partitionBoundRe.FindStringSubmatch(bound)
+	if m == nil {
+		return time.Time{}, time.Time{}, false
+	}
+	from, errFrom := parsePgTimestamp(m[1])
+	to, errTo := parsePgTimestamp(m[2])
+	if errFrom != nil || errTo != nil {
+		return time.Time{}, time.Time{}, false
+	}
+	return from.UTC(), to.UTC(), true
+}
+
+func parsePgTimestamp(s string) (time.Time, error) {
+	var err error
+	for _, layout := range []string{"2006-01-02 15:04:05-07", "2006-01-02 15:04:05-07:00", "2006-01-02 15:04:05.999999-07"} {
+		var t time.Time
+		if t, err = time.Parse(layout, s); err == nil {
+			return t, nil
+		}
+	}
+	return time.Time{}, err
+}
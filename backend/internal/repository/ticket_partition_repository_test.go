@@ -0,0 +1,118 @@
+package repository
+
+import (
+	"os"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func TestParsePartitionBound(t *testing.T) {
+	from, to, ok := parsePartitionBound("FOR VALUES FROM ('2024-01-01 00:00:00+00') TO ('2025-01-01 00:00:00+00')")
+	assert.True(t, ok)
+	assert.Equal(t, time.Date(2024, 1, 1, 0, 0, 0, 0, time.UTC), from)
+	assert.Equal(t, time.Date(2025, 1, 1, 0, 0, 0, 0, time.UTC), to)
+
+	// Bounds are printed in the session time zone.
+	from, _, ok = parsePartitionBound("FOR VALUES FROM ('2027-01-01 03:00:00+03') TO ('2027-02-01 05:30:00+05:30')")
+	assert.True(t, ok)
+	assert.Equal(t, time.Date(2027, 1, 1, 0, 0, 0, 0, time.UTC), from)
+
+	_, _, ok = parsePartitionBound("DEFAULT")
+	assert.False(t, ok)
+	_, _, ok = parsePartitionBound("FOR VALUES FROM (MINVALUE) TO ('2024-01-01 00:00:00+00')")
+	assert.False(t, ok)
+}
+
+func TestTicketPartitionRepository_Archive_Postgres(t *testing.T) {
+	if os.Getenv("INTEGRATION_TEST") == "" {
+		t.Skip("set INTEGRATION_TEST=1 to run")
+	}
+	db := setupPostgresTestDB(t)
+	repo := NewTicketPartitionRepository(db)
+	tickets := NewTicketRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+	require.NoError(t, db.Exec("DROP TABLE IF EXISTS tickets_1998, tickets_1999").Error)
+	require.NoError(t, db.Exec("TRUNCATE tickets_archive, ticket_partition_archives").Error)
+
+	addTicket := func(partition domain.TicketPartition) *domain.Ticket {
+		require.NoError(t, repo.Create(partition))
+		ticket := &domain.Ticket{Title: "Old", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID,
+			AssigneeID: user.ID, DepartmentID: 1, CreatedAt: partition.From.Add(24 * time.Hour)}
+		require.NoError(t, tickets.Create(ticket))
+		return ticket
+	}
+	year := func(y int) domain.TicketPartition {
+		from := time.Date(y, 1, 1, 0, 0, 0, 0, time.UTC)
+		return domain.TicketPartition{Name: "tickets_" + from.Format("2006"), From: from, To: from.AddDate(1, 0, 0)}
+	}
+	partitionNames := func() []string {
+		list, err := repo.List()
+		require.NoError(t, err)
+		var names []string
+		for _, p := range list {
+			names = append(names, p.Name)
+		}
+		return names
+	}
+	archivedIDs := func() []string {
+		var ids []string
+		require.NoError(t, db.Raw("SELECT ticket_id::text FROM tickets_archive ORDER BY created_at").Scan(&ids).Error)
+		return ids
+	}
+
+	// A whole pass: the rows move and the partition and its record are gone.
+	p1999 := year(1999)
+	t1999 := addTicket(p1999)
+	moved, err := repo.Archive(p1999)
+	require.NoError(t, err)
+	assert.Equal(t, int64(1), moved)
+	assert.NotContains(t, partitionNames(), "tickets_1999")
+	assert.Equal(t, []string{t1999.ID.String()}, archivedIDs())
+	unfinished, err := repo.Unfinished()
+	require.NoError(t, err)
+	assert.Empty(t, unfinished)
+
+	// A crash after the detach: the table is out of pg_inherits but not dropped.
+	p1998 := year(1998)
+	t1998 := addTicket(p1998)
+	require.NoError(t, db.Exec("INSERT INTO ticket_partition_archives (name) VALUES ('tickets_1998')").Error)
+	require.NoError(t, db.Exec("ALTER TABLE tickets DETACH PARTITION tickets_1998").Error)
+	assert.NotContains(t, partitionNames(), "tickets_1998")
+	unfinished, err = repo.Unfinished()
+	require.NoError(t, err)
+	require.Len(t, unfinished, 1)
+	assert.Equal(t, "tickets_1998", unfinished[0].Name)
+	_, err = repo.Archive(unfinished[0])
+	require.NoError(t, err)
+	assert.Equal(t, []string{t1998.ID.String(), t1999.ID.String()}, archivedIDs())
+	var left int
+	require.NoError(t, db.Raw("SELECT count(*) FROM pg_class WHERE relname = 'tickets_1998'").Scan(&left).Error)
+	assert.Zero(t, left)
+	unfinished, err = repo.Unfinished()
+	require.NoError(t, err)
+	assert.Empty(t, unfinished)
+}
+
+func TestTicketPartitionRepository_TryLock_Postgres(t *testing.T) {
+	if os.Getenv("INTEGRATION_TEST") == "" {
+		t.Skip("set INTEGRATION_TEST=1 to run")
+	}
+	repo := NewTicketPartitionRepository(setupPostgresTestDB(t))
+	unlock, ok, err := repo.TryLock()
+	require.NoError(t, err)
+	require.True(t, ok)
+	_, ok, err = repo.TryLock()
+	require.NoError(t, err)
+	assert.False(t, ok, "a second holder must be refused")
+	unlock()
+	unlock, ok, err = repo.TryLock()
+	require.NoError(t, err)
+	assert.True(t, ok)
+	unlock()
+}
@@ -1,12 +1,15 @@
 package repository
 
 import (
+	"errors"
+	"strconv"
 	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/model"
 	"time"
 
 	"github.com/google/uuid"
 	"gorm.io/gorm"
+	"gorm.io/gorm/clause"
 )
 
 type TicketRepository struct {
@@ -29,9 +32,25 @@ func (r *TicketRepository) Create(ticket *domain.Ticket) error {
 	return r.DB.Create(ticket).Error
 }
 
-func (r *TicketRepository) GetByID(id uuid.UUID) (*domain.Ticket, error) {
+// liveTicket scopes a query to one live ticket. tickets is range-partitioned on
+// created_at, so when the caller knows the creation time it is added to the
+// predicate and the planner scans a single partition instead of probing each one.
+func liveTicket(db *gorm.DB, id uuid.UUID, createdAt *time.Time) *gorm.DB {
+	db = db.Where("ticket_id = ? AND deleted_at IS NULL", id)
+	if createdAt != nil {
+		db = db.Where("created_at = ?", *createdAt)
+	}
+	return db
+}
+
+// GetByID loads a live ticket. createdAt is an optional partition hint; a hint that
+// does not match (a client with a stale copy) falls back to the unpruned lookup.
+func (r *TicketRepository) GetByID(id uuid.UUID, createdAt *time.Time) (*domain.Ticket, error) {
 	var ticket domain.Ticket
-	err := r.DB.Where("ticket_id = ? AND deleted_at IS NULL", id).First(&ticket).Error
+	err := liveTicket(r.DB, id, createdAt).First(&ticket).Error
+	if errors.Is(err, gorm.ErrRecordNotFound) && createdAt != nil {
+		err = liveTicket(r.DB, id, nil).First(&ticket).Error
+	}
 	if err != nil {
 		return nil, err
 	}
@@ -40,33 +59,154 @@ func (r *TicketRepository) GetByID(id uuid.UUID) (*domain.Ticket, error) {
 
 func (r *TicketRepository) Update(ticket *domain.Ticket) error {
 	ticket.UpdatedAt = time.Now().UTC()
-	return r.DB.Model(&domain.Ticket{}).
-		Where("ticket_id = ? AND deleted_at IS NULL", ticket.ID).
-		Updates(ticket).Error
+	var createdAt *time.Time
+	if !ticket.CreatedAt.IsZero() {
+		createdAt = &ticket.CreatedAt
+	}
+	return r.updateLive(ticket.ID, createdAt, ticket).Error
 }
 
-func (r *TicketRepository) Delete(id uuid.UUID) error {
-	return r.DB.Model(&domain.Ticket{}).
-		Where("ticket_id = ? AND deleted_at IS NULL", id).
-		Update("deleted_at", time.Now().UTC()).Error
+// updateLive applies values to one live ticket, retrying without the partition
+// hint when it matched nothing.
+func (r *TicketRepository) updateLive(id uuid.UUID, createdAt *time.Time, values interface{}) *gorm.DB {
+	res := liveTicket(r.DB.Model(&domain.Ticket{}), id, createdAt).Updates(values)
+	if res.Error == nil && res.RowsAffected == 0 && createdAt != nil {
+		res = liveTicket(r.DB.Model(&domain.Ticket{}), id, nil).Updates(values)
+	}
+	return res
 }
 
-func (r *TicketRepository) Search(filter model.TicketFilter) ([]*domain.Ticket, error) {
+// FindByIDs loads tickets by id, soft-deleted ones included, so callers can tell
+// an edit from a deletion.
+func (r *TicketRepository) FindByIDs(ids []uuid.UUID) ([]*domain.Ticket, error) {
 	var tickets []*domain.Ticket
-	db := r.DB.Model(&domain.Ticket{}).Where("deleted_at IS NULL")
-	if filter.StatusID != nil {
-		db = db.Where("status_id = ?", *filter.StatusID)
+	if len(ids) == 0 {
+		return tickets, nil
 	}
-	if filter.AssigneeID != nil {
-		db = db.Where("assignee_id = ?", *filter.AssigneeID)
+	if err := r.DB.Where("ticket_id IN ?", ids).Find(&tickets).Error; err != nil {
+		return nil, err
 	}
-	if filter.DepartmentID != nil {
-		db = db.Where("department_id = ?", *filter.DepartmentID)
+	return tickets, nil
+}
+
+// Patch writes only the given columns (plus updated_at), so untouched columns are
+// neither rewritten nor locked for longer than the single-row update.
+// createdAt is the same optional partition hint as in GetByID.
+func (r *TicketRepository) Patch(id uuid.UUID, createdAt *time.Time, columns map[string]interface{}) error {
+	if len(columns) == 0 {
+		return nil
 	}
-	if filter.Q != "" {
-		db = db.Where("search_vector @@ plainto_tsquery('russian', ?)", filter.Q)
-		db = db.Order("ts_rank(search_vector, plainto_tsquery('russian', '" + filter.Q + "')) DESC")
+	columns["updated_at"] = time.Now().UTC()
+	res := r.updateLive(id, createdAt, columns)
+	if res.Error != nil {
+		return res.Error
+	}
+	if res.RowsAffected == 0 {
+		return gorm.ErrRecordNotFound
+	}
+	return nil
+}
+
+// Batch updates or soft-deletes all tickets in ids within one transaction and reports
+// the outcome per ticket, in request order. Affected rows are locked, written with
+// one UPDATE, and status/priority changes are added to ticket_history in the same
+// transaction, so the batch applies completely or not at all.
+func (r *TicketRepository) Batch(action string, ids []uuid.UUID, patch *model.TicketPatch, changedBy uuid.UUID) ([]model.TicketBatchResult, error) {
+	results := make([]model.TicketBatchResult, 0, len(ids))
+	err := r.DB.Transaction(func(tx *gorm.DB) error {
+		var tickets []*domain.Ticket
+		if err := tx.Clauses(clause.Locking{Strength: "UPDATE"}).
+			Where("ticket_id IN ? AND deleted_at IS NULL", ids).
+			Find(&tickets).Error; err != nil {
+			return err
+		}
+		byID := make(map[uuid.UUID]*domain.Ticket, len(tickets))
+		for _, t := range tickets {
+			byID[t.ID] = t
+		}
+
+		now := time.Now().UTC()
+		columns := map[string]interface{}{}
+		var affected []uuid.UUID
+		var history []*domain.TicketHistory
+		for _, id := range ids {
+			ticket, ok := byID[id]
+			if !ok {
+				results = append(results, model.TicketBatchResult{TicketID: id, Status: model.TicketBatchNotFound})
+				continue
+			}
+			if action == model.TicketBatchDelete {
+				affected = append(affected, id)
+				results = append(results, model.TicketBatchResult{TicketID: id, Status: model.TicketBatchDeleted})
+				continue
+			}
+			old := *ticket
+			changed := patch.ApplyTo(ticket)
+			if len(changed) == 0 {
+				results = append(results, model.TicketBatchResult{TicketID: id, Status: model.TicketBatchUnchanged, Ticket: ticket})
+				continue
+			}
+			for column, value := range changed {
+				columns[column] = value
+			}
+			ticket.UpdatedAt = now
+			affected = append(affected, id)
+			results = append(results, model.TicketBatchResult{TicketID: id, Status: model.TicketBatchUpdated, Ticket: ticket})
+			if old.StatusID != ticket.StatusID {
+				history = append(history, batchHistory(ticket, changedBy, now, "status", old.StatusID, ticket.StatusID))
+			}
+			if old.PriorityID != ticket.PriorityID {
+				history = append(history, batchHistory(ticket, changedBy, now, "priority", old.PriorityID, ticket.PriorityID))
+			}
+		}
+		if len(affected) == 0 {
+			return nil
+		}
+		// The patch holds one value per column, so every changed ticket can share a single UPDATE.
+		if action == model.TicketBatchDelete {
+			columns = map[string]interface{}{"deleted_at": now, "updated_at": now}
+		} else {
+			columns["updated_at"] = now
+		}
+		if err := tx.Model(&domain.Ticket{}).Where("ticket_id IN ?", affected).Updates(columns).Error; err != nil {
+			return err
+		}
+		if len(history) > 0 {
+			return tx.Create(&history).Error
+		}
+		return nil
+	})
+	if err != nil {
+		return nil, err
 	}
+	return results, nil
+}
+
+func batchHistory(ticket *domain.Ticket, changedBy uuid.UUID, at time.Time, field string, oldValue, newValue int16) *domain.TicketHistory {
+	return &domain.TicketHistory{
+		ID:              uuid.New(),
+		TicketID:        ticket.ID,
+		TicketCreatedAt: ticket.CreatedAt,
+		ChangedAt:       at,
+		ChangedBy:       changedBy,
+		FieldName:       field,
+		OldValue:        strconv.Itoa(int(oldValue)),
+		NewValue:        strconv.Itoa(int(newValue)),
+	}
+}
+
+func (r *TicketRepository) Delete(id uuid.UUID, createdAt *time.Time) error {
+	// updated_at moves too, so delta sync (Changes) sees the deletion.
+	now := time.Now().UTC()
+	return r.updateLive(id, createdAt, map[string]interface{}{"deleted_at": now, "updated_at": now}).Error
+}
+
+func (r *TicketRepository) Search(filter model.TicketFilter) ([]*domain.Ticket, error) {
+	if filter.Archived {
+		return r.searchArchive(filter)
+	}
+	var tickets []*domain.Ticket
+	db := applyTicketFilter(r.DB.Model(&domain.Ticket{}).Where("deleted_at IS NULL"), filter)
 	if filter.Limit > 0 {
 		db = db.Limit(filter.Limit)
 	}
@@ -78,3 +218,106 @@ func (r *TicketRepository) Search(filter model.TicketFilter) ([]*domain.Ticket,
 	}
 	return tickets, nil
 }
+
+// searchArchive runs the filter against tickets_archive only, newest first, so the
+// hot partitions are not touched. ticket_id breaks ties, so offset pages are stable.
+func (r *TicketRepository) searchArchive(filter model.TicketFilter) ([]*domain.Ticket, error) {
+	var archived []*domain.TicketArchive
+	db := applyTicketFilter(r.DB.Model(&domain.TicketArchive{}).Where("deleted_at IS NULL"), filter).
+		Order("created_at DESC").Order("ticket_id")
+	if filter.Limit > 0 {
+		db = db.Limit(filter.Limit)
+	}
+	if filter.Offset > 0 {
+		db = db.Offset(filter.Offset)
+	}
+	if err := db.Find(&archived).Error; err != nil {
+		return nil, err
+	}
+	tickets := make([]*domain.Ticket, len(archived))
+	for i, a := range archived {
+		tickets[i] = &a.Ticket
+		tickets[i].Archived = true
+	}
+	return tickets, nil
+}
+
+// Changes returns what happened to the view described by filter after since: the
+// live tickets that match it and were updated, and the ids of tickets the client
+// may hold that left it. Those are the tickets deleted or archived since then whose
+// last state matches the filter, and the tickets among held that changed and no
+// longer match. Without held, a client with a filtered view is not told about
+// tickets edited out of it; an unfiltered view needs no held ids.
+// The queries are range scans on an updated_at or archived_at index.
+func (r *TicketRepository) Changes(filter model.TicketFilter, since time.Time, held []uuid.UUID) ([]*domain.Ticket, []uuid.UUID, error) {
+	var live []*domain.Ticket
+	db := applyTicketFilter(r.DB.Model(&domain.Ticket{}).Where("updated_at > ? AND deleted_at IS NULL", since), filter)
+	if err := db.Order("updated_at").Find(&live).Error; err != nil {
+		return nil, nil, err
+	}
+	var changed []uuid.UUID
+	deleted := applyTicketFilter(r.DB.Model(&domain.Ticket{}).Where("updated_at > ? AND deleted_at IS NOT NULL", since), filter)
+	if err := deleted.Pluck("ticket_id", &changed).Error; err != nil {
+		return nil, nil, err
+	}
+	var archived []uuid.UUID
+	archive := applyTicketFilter(r.DB.Model(&domain.TicketArchive{}).Where("archived_at > ?", since), filter)
+	if err := archive.Pluck("ticket_id", &archived).Error; err != nil {
+		return nil, nil, err
+	}
+	changed = append(changed, archived...)
+	if len(held) > 0 {
+		var heldChanged []uuid.UUID
+		if err := r.DB.Model(&domain.Ticket{}).Where("ticket_id IN ? AND updated_at > ?", held, since).
+			Pluck("ticket_id", &heldChanged).Error; err != nil {
+			return nil, nil, err
+		}
+		changed = append(changed, heldChanged...)
+	}
+	seen := make(map[uuid.UUID]bool, len(live)+len(changed))
+	for _, t := range live {
+		seen[t.ID] = true
+	}
+	gone := make([]uuid.UUID, 0)
+	for _, id := range changed {
+		if !seen[id] {
+			seen[id] = true
+			gone = append(gone, id)
+		}
+	}
+	return live, gone, nil
+}
+
+// SyncWatermark is the point a later delta sync resumes from, on the database
+// clock: the start of the oldest transaction that is still writing, or now() if
+// none is. updated_at is stamped with now() (the writer's transaction start) by
+// trg_update_timestamp, so a row not yet visible to a query that runs after this
+// call has an updated_at at or after the watermark. Deltas overlap a little;
+// clients merge them idempotently. pg_stat_activity shows xact_start only for
+// sessions of the same role, which is the API's own connection pool.
+func (r *TicketRepository) SyncWatermark() (time.Time, error) {
+	if r.DB.Dialector.Name() != "postgres" {
+		return time.Now().UTC(), nil
+	}
+	var watermark time.Time
+	err := r.DB.Raw(`SELECT least(now(), coalesce(min(xact_start), now()))
+		FROM pg_stat_activity WHERE backend_xid IS NOT NULL`).Scan(&watermark).Error
+	return watermark.UTC(), err
+}
+
+func applyTicketFilter(db *gorm.DB, filter model.TicketFilter) *gorm.DB {
+	if filter.StatusID != nil {
+		db = db.Where("status_id = ?", *filter.StatusID)
+	}
+	if filter.AssigneeID != nil {
+		db = db.Where("assignee_id = ?", *filter.AssigneeID)
+	}
+	if filter.DepartmentID != nil {
+		db = db.Where("department_id = ?", *filter.DepartmentID)
+	}
+	if filter.Q != "" {
+		db = db.Where("search_vector @@ plainto_tsquery('russian', ?)", filter.Q)
+		db = db.Order("ts_rank(search_vector, plainto_tsquery('russian', '" + filter.Q + "')) DESC")
+	}
+	return db
+}
@@ -1,11 +1,13 @@
 package repository
 
 import (
+	"fmt"
 	"os"
 	"testing"
 	"time"
 
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 
 	"github.com/google/uuid"
 	"github.com/stretchr/testify/assert"
@@ -26,6 +28,7 @@ func setupTicketTestDB(t *testing.T) *gorm.DB {
 		&domain.TicketStatus{},
 		&domain.TicketPriority{},
 		&domain.Ticket{},
+		&domain.TicketArchive{},
 	)
 	require.NoError(t, err)
 	role := &domain.Role{ID: uuid.New(), Name: "user"}
@@ -74,7 +77,7 @@ func TestTicketRepository_CRUD(t *testing.T) {
 	assert.NoError(t, err)
 
 	// GetByID
-	got, err := repo.GetByID(ticket.ID)
+	got, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, ticket.Title, got.Title)
 
@@ -83,14 +86,14 @@ func TestTicketRepository_CRUD(t *testing.T) {
 	err = repo.Update(got)
 	assert.NoError(t, err)
 
-	updated, err := repo.GetByID(ticket.ID)
+	updated, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, "Updated Title", updated.Title)
 
 	// Delete
-	err = repo.Delete(ticket.ID)
+	err = repo.Delete(ticket.ID, nil)
 	assert.NoError(t, err)
-	_, err = repo.GetByID(ticket.ID)
+	_, err = repo.GetByID(ticket.ID, nil)
 	assert.Error(t, err)
 }
 
@@ -119,7 +122,7 @@ func TestTicketRepository_CRUD_SQLite(t *testing.T) {
 	assert.NoError(t, err)
 
 	// GetByID
-	got, err := repo.GetByID(ticket.ID)
+	got, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, ticket.Title, got.Title)
 
@@ -128,17 +131,169 @@ func TestTicketRepository_CRUD_SQLite(t *testing.T) {
 	err = repo.Update(got)
 	assert.NoError(t, err)
 
-	updated, err := repo.GetByID(ticket.ID)
+	updated, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, "Updated Title", updated.Title)
 
 	// Delete
-	err = repo.Delete(ticket.ID)
+	err = repo.Delete(ticket.ID, nil)
 	assert.NoError(t, err)
-	_, err = repo.GetByID(ticket.ID)
+	_, err = repo.GetByID(ticket.ID, nil)
 	assert.Error(t, err)
 }
 
+func TestTicketRepository_Batch_SQLite(t *testing.T) {
+	db := setupTicketTestDB(t)
+	require.NoError(t, db.AutoMigrate(&domain.TicketHistory{}))
+	repo := NewTicketRepository(db)
+
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+	var ids []uuid.UUID
+	for i := 0; i < 3; i++ {
+		ticket := &domain.Ticket{Title: "T", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID, DepartmentID: 1}
+		require.NoError(t, repo.Create(ticket))
+		ids = append(ids, ticket.ID)
+	}
+	// The third ticket already has the target status.
+	require.NoError(t, repo.Patch(ids[2], nil, map[string]interface{}{"status_id": int16(2)}))
+
+	status := int16(2)
+	missing := uuid.New()
+	results, err := repo.Batch(model.TicketBatchUpdate, append(ids, missing), &model.TicketPatch{StatusID: &status}, user.ID)
+	require.NoError(t, err)
+	require.Len(t, results, 4)
+	assert.Equal(t, model.TicketBatchUpdated, results[0].Status)
+	assert.Equal(t, model.TicketBatchUpdated, results[1].Status)
+	assert.Equal(t, model.TicketBatchUnchanged, results[2].Status)
+	assert.Equal(t, model.TicketBatchNotFound, results[3].Status)
+	assert.Equal(t, missing, results[3].TicketID)
+	for _, id := range ids {
+		got, err := repo.GetByID(id, nil)
+		require.NoError(t, err)
+		assert.Equal(t, int16(2), got.StatusID)
+	}
+	var historyRows int64
+	require.NoError(t, db.Model(&domain.TicketHistory{}).Count(&historyRows).Error)
+	assert.Equal(t, int64(2), historyRows)
+
+	results, err = repo.Batch(model.TicketBatchDelete, ids[:2], nil, user.ID)
+	require.NoError(t, err)
+	assert.Equal(t, model.TicketBatchDeleted, results[0].Status)
+	_, err = repo.GetByID(ids[0], nil)
+	assert.Error(t, err)
+	_, err = repo.GetByID(ids[2], nil)
+	assert.NoError(t, err)
+}
+
+func TestTicketRepository_Changes_SQLite(t *testing.T) {
+	db := setupTicketTestDB(t)
+	repo := NewTicketRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+
+	var ids []uuid.UUID
+	for i := 0; i < 4; i++ {
+		ticket := &domain.Ticket{Title: "T", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID, DepartmentID: 1}
+		require.NoError(t, repo.Create(ticket))
+		ids = append(ids, ticket.ID)
+	}
+	other := &domain.Ticket{Title: "T", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID, DepartmentID: 2}
+	require.NoError(t, repo.Create(other))
+	time.Sleep(5 * time.Millisecond)
+	since := time.Now().UTC()
+	time.Sleep(5 * time.Millisecond)
+
+	require.NoError(t, repo.Patch(ids[0], nil, map[string]interface{}{"title": "Edited"}))
+	require.NoError(t, repo.Patch(ids[1], nil, map[string]interface{}{"department_id": int16(2)}))
+	require.NoError(t, repo.Delete(ids[2], nil))
+	require.NoError(t, repo.Delete(other.ID, nil))
+
+	// Deleted tickets outside the view are not sent; one edited out of it is only
+	// known to have been in it when the client says it holds it.
+	department := int16(1)
+	live, gone, err := repo.Changes(model.TicketFilter{DepartmentID: &department}, since, nil)
+	require.NoError(t, err)
+	require.Len(t, live, 1)
+	assert.Equal(t, ids[0], live[0].ID)
+	assert.Equal(t, "Edited", live[0].Title)
+	assert.ElementsMatch(t, []uuid.UUID{ids[2]}, gone)
+
+	_, gone, err = repo.Changes(model.TicketFilter{DepartmentID: &department}, since, []uuid.UUID{ids[0], ids[1], ids[2], ids[3]})
+	require.NoError(t, err)
+	assert.ElementsMatch(t, []uuid.UUID{ids[1], ids[2]}, gone)
+
+	_, gone, err = repo.Changes(model.TicketFilter{}, since, nil)
+	require.NoError(t, err)
+	assert.ElementsMatch(t, []uuid.UUID{ids[2], other.ID}, gone)
+
+	live, gone, err = repo.Changes(model.TicketFilter{}, time.Now().UTC(), nil)
+	require.NoError(t, err)
+	assert.Empty(t, live)
+	assert.Empty(t, gone)
+}
+
+func TestTicketRepository_CreatedAtHint_SQLite(t *testing.T) {
+	db := setupTicketTestDB(t)
+	repo := NewTicketRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+
+	ticket := &domain.Ticket{Title: "T", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID, DepartmentID: 1}
+	require.NoError(t, repo.Create(ticket))
+	createdAt := ticket.CreatedAt
+	stale := createdAt.Add(-time.Hour)
+
+	got, err := repo.GetByID(ticket.ID, &createdAt)
+	require.NoError(t, err)
+	assert.Equal(t, ticket.ID, got.ID)
+	// A hint that matches no row falls back to the plain lookup.
+	got, err = repo.GetByID(ticket.ID, &stale)
+	require.NoError(t, err)
+	assert.Equal(t, ticket.ID, got.ID)
+
+	require.NoError(t, repo.Patch(ticket.ID, &stale, map[string]interface{}{"title": "Edited"}))
+	got, err = repo.GetByID(ticket.ID, &createdAt)
+	require.NoError(t, err)
+	assert.Equal(t, "Edited", got.Title)
+
+	require.NoError(t, repo.Delete(ticket.ID, &createdAt))
+	_, err = repo.GetByID(ticket.ID, &createdAt)
+	assert.Error(t, err)
+	assert.ErrorIs(t, repo.Patch(ticket.ID, &createdAt, map[string]interface{}{"title": "Gone"}), gorm.ErrRecordNotFound)
+}
+
+func TestTicketRepository_Archive_SQLite(t *testing.T) {
+	db := setupTicketTestDB(t)
+	repo := NewTicketRepository(db)
+	var user domain.User
+	require.NoError(t, db.First(&user).Error)
+
+	hot := &domain.Ticket{Title: "Hot", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID, DepartmentID: 1}
+	require.NoError(t, repo.Create(hot))
+	since := time.Now().UTC().Add(-time.Second)
+	old := domain.Ticket{ID: uuid.New(), Title: "Old", Description: "D", StatusID: 1, PriorityID: 1, CreatorID: user.ID, AssigneeID: user.ID,
+		DepartmentID: 1, CreatedAt: time.Date(2023, 5, 1, 0, 0, 0, 0, time.UTC), UpdatedAt: time.Date(2023, 6, 1, 0, 0, 0, 0, time.UTC)}
+	require.NoError(t, db.Create(&domain.TicketArchive{Ticket: old, ArchivedAt: time.Now().UTC()}).Error)
+
+	tickets, err := repo.Search(model.TicketFilter{})
+	require.NoError(t, err)
+	require.Len(t, tickets, 1)
+	assert.Equal(t, hot.ID, tickets[0].ID)
+	assert.False(t, tickets[0].Archived)
+
+	tickets, err = repo.Search(model.TicketFilter{Archived: true})
+	require.NoError(t, err)
+	require.Len(t, tickets, 1)
+	assert.Equal(t, old.ID, tickets[0].ID)
+	assert.True(t, tickets[0].Archived)
+
+	// Clients holding the ticket learn that it left the hot set.
+	_, gone, err := repo.Changes(model.TicketFilter{}, since, nil)
+	require.NoError(t, err)
+	assert.Equal(t, []uuid.UUID{old.ID}, gone)
+}
+
 func setupPostgresTestDB(t *testing.T) *gorm.DB {
 	dsn := "host=localhost port=5434 user=postgres password=password dbname=ticket_system sslmode=disable"
 	db, err := gorm.Open(postgres.Open(dsn), &gorm.Config{})
@@ -193,7 +348,7 @@ func TestTicketRepository_CRUD_Postgres(t *testing.T) {
 	assert.NoError(t, err)
 
 	// GetByID
-	got, err := repo.GetByID(ticket.ID)
+	got, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, ticket.Title, got.Title)
 
@@ -202,13 +357,73 @@ func TestTicketRepository_CRUD_Postgres(t *testing.T) {
 	err = repo.Update(got)
 	assert.NoError(t, err)
 
-	updated, err := repo.GetByID(ticket.ID)
+	updated, err := repo.GetByID(ticket.ID, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, "Updated Integration Title", updated.Title)
 
 	// Delete
-	err = repo.Delete(ticket.ID)
+	err = repo.Delete(ticket.ID, nil)
 	assert.NoError(t, err)
-	_, err = repo.GetByID(ticket.ID)
+	_, err = repo.GetByID(ticket.ID, nil)
 	assert.Error(t, err)
 }
+
+// BenchmarkTicketLookup_Partitions compares a ticket lookup by id alone with one that
+// also carries created_at, on scratch copies of the tickets layout with a growing
+// number of monthly partitions. Without created_at every partition's primary key
+// index is probed; with it the planner prunes to one.
+//
+//	INTEGRATION_TEST=1 go test ./internal/repository -run '^$' -bench TicketLookup_Partitions
+func BenchmarkTicketLookup_Partitions(b *testing.B) {
+	if os.Getenv("INTEGRATION_TEST") == "" {
+		b.Skip("set INTEGRATION_TEST=1 to run")
+	}
+	dsn := "host=localhost port=5434 user=postgres password=password dbname=ticket_system sslmode=disable"
+	db, err := gorm.Open(postgres.Open(dsn), &gorm.Config{})
+	require.NoError(b, err)
+	const rowsPerPartition = 2000
+	start := time.Date(2000, 1, 1, 0, 0, 0, 0, time.UTC)
+
+	for _, partitions := range []int{3, 12, 48, 192} {
+		table := fmt.Sprintf("bench_tickets_p%d", partitions)
+		require.NoError(b, db.Exec("DROP TABLE IF EXISTS "+table).Error)
+		require.NoError(b, db.Exec(`CREATE TABLE `+table+` (
+			ticket_id UUID NOT NULL,
+			title VARCHAR(255) NOT NULL,
+			created_at TIMESTAMPTZ NOT NULL,
+			deleted_at TIMESTAMPTZ,
+			PRIMARY KEY (ticket_id, created_at)
+		) PARTITION BY RANGE (created_at)`).Error)
+		for i := 0; i < partitions; i++ {
+			require.NoError(b, db.Exec(fmt.Sprintf(
+				"CREATE TABLE %s_%d PARTITION OF %s FOR VALUES FROM ('%s') TO ('%s')",
+				table, i, table,
+				start.AddDate(0, i, 0).Format(time.RFC3339), start.AddDate(0, i+1, 0).Format(time.RFC3339),
+			)).Error)
+			require.NoError(b, db.Exec(`INSERT INTO `+table+` (ticket_id, title, created_at)
+				SELECT gen_random_uuid(), 'bench', ?::timestamptz + g * interval '1 minute'
+				FROM generate_series(0, ?) AS g`, start.AddDate(0, i, 0), rowsPerPartition-1).Error)
+		}
+		require.NoError(b, db.Exec("ANALYZE "+table).Error)
+
+		var keys []domain.Ticket
+		require.NoError(b, db.Table(table).Select("ticket_id, created_at").
+			Order("random()").Limit(512).Find(&keys).Error)
+
+		b.Run(fmt.Sprintf("partitions=%d/id_only", partitions), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				key := keys[i%len(keys)]
+				var ticket domain.Ticket
+				require.NoError(b, liveTicket(db.Table(table), key.ID, nil).First(&ticket).Error)
+			}
+		})
+		b.Run(fmt.Sprintf("partitions=%d/id_and_created_at", partitions), func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				key := keys[i%len(keys)]
+				var ticket domain.Ticket
+				require.NoError(b, liveTicket(db.Table(table), key.ID, &key.CreatedAt).First(&ticket).Error)
+			}
+		})
+		require.NoError(b, db.Exec("DROP TABLE "+table).Error)
+	}
+}
@@ -1,6 +1,8 @@
 package repository
 
 import (
+	"strings"
+
 	"ticket-system/backend/internal/domain"
 
 	"gorm.io/gorm"
@@ -33,3 +35,24 @@ func (r *UserRepository) List() ([]*domain.User, error) {
 	}
 	return users, nil
 }
+
+// likePrefixEscaper escapes LIKE metacharacters so a search prefix matches literally.
+var likePrefixEscaper = strings.NewReplacer(`\`, `\\`, "%", `\%`, "_", `\_`)
+
+// Search returns up to limit active users whose username starts with prefix
+// (case-insensitive), optionally restricted to one department, ordered by name.
+// It is served by the lower(username) text_pattern_ops indexes.
+func (r *UserRepository) Search(prefix string, departmentID int, limit int) ([]*domain.User, error) {
+	var users []*domain.User
+	q := r.DB.Where("deleted_at IS NULL")
+	if prefix != "" {
+		q = q.Where(`lower(username) LIKE ? ESCAPE '\'`, likePrefixEscaper.Replace(strings.ToLower(prefix))+"%")
+	}
+	if departmentID > 0 {
+		q = q.Where("department_id = ?", departmentID)
+	}
+	if err := q.Order("lower(username)").Limit(limit).Find(&users).Error; err != nil {
+		return nil, err
+	}
+	return users, nil
+}
@@ -0,0 +1,16 @@
+package usecase
+
+import (
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+)
+
+type AttachmentBlobRepository interface {
+	Get(sha256 string) (*domain.AttachmentBlob, error)
+	// GetOwned returns the blob only if the uploader already has an attachment referencing it.
+	GetOwned(sha256 string, uploaderID uuid.UUID) (*domain.AttachmentBlob, error)
+	PutFile(srcPath, sha256 string, size int64) (*domain.AttachmentBlob, error)
+	Acquire(sha256 string) (*domain.AttachmentBlob, error)
+	Release(sha256 string) error
+}
@@ -0,0 +1,22 @@
+package usecase
+
+import (
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+)
+
+type AttachmentUploadRepository interface {
+	Create(upload *domain.AttachmentUpload) error
+	GetByID(uploadID uuid.UUID) (*domain.AttachmentUpload, error)
+	Delete(uploadID uuid.UUID) error
+	// ListCreatedBefore returns the uploads started before the given time.
+	ListCreatedBefore(before time.Time) ([]domain.AttachmentUpload, error)
+	// ClaimCommit sets committing_at to now unless another commit set it after
+	// staleBefore, and reports whether this caller got the claim.
+	ClaimCommit(uploadID uuid.UUID, now, staleBefore time.Time) (bool, error)
+	// ReleaseCommit clears the claim after a commit that did not complete.
+	ReleaseCommit(uploadID uuid.UUID) error
+}
@@ -0,0 +1,127 @@
+package usecase
+
+import (
+	"context"
+	"log"
+	"time"
+
+	"ticket-system/backend/internal/model"
+
+	"github.com/google/uuid"
+)
+
+// ChangeFeed turns raw row notifications into client events. Notifications that
+// arrive within Window of each other are coalesced: a ticket touched many times
+// yields one event with its latest state, fetched in a single query per batch.
+type ChangeFeed struct {
+	Tickets  TicketRepository
+	Hub      *EventHub
+	Window   time.Duration
+	MaxBatch int
+}
+
+func NewChangeFeed(tickets TicketRepository, hub *EventHub) *ChangeFeed {
+	return &ChangeFeed{Tickets: tickets, Hub: hub, Window: 200 * time.Millisecond, MaxBatch: 1000}
+}
+
+// Run consumes notifications until ctx is done or in is closed.
+func (f *ChangeFeed) Run(ctx context.Context, in <-chan model.ChangeNotification) {
+	for {
+		var batch []model.ChangeNotification
+		select {
+		case <-ctx.Done():
+			return
+		case n, ok := <-in:
+			if !ok {
+				return
+			}
+			batch = append(batch, n)
+		}
+		timer := time.NewTimer(f.Window)
+	collect:
+		for len(batch) < f.MaxBatch {
+			select {
+			case n, ok := <-in:
+				if !ok {
+					break collect
+				}
+				batch = append(batch, n)
+			case <-timer.C:
+				break collect
+			case <-ctx.Done():
+				timer.Stop()
+				return
+			}
+		}
+		timer.Stop()
+		f.Hub.Publish(f.Events(batch))
+	}
+}
+
+// Events coalesces a batch of notifications into client events, in first-seen order.
+func (f *ChangeFeed) Events(batch []model.ChangeNotification) []model.ChangeEvent {
+	type key struct {
+		kind     string
+		ticketID uuid.UUID
+	}
+	seen := map[key]bool{}
+	rows := map[key][]model.RowChange{}
+	var order []key
+	var ticketIDs []uuid.UUID
+	for _, n := range batch {
+		var k key
+		switch n.Table {
+		case "tickets":
+			k = key{model.EventTicketUpdated, n.TicketID}
+		case "ticket_comments":
+			k = key{model.EventCommentsChanged, n.TicketID}
+		case "ticket_attachments":
+			k = key{model.EventAttachmentsChanged, n.TicketID}
+		default:
+			continue
+		}
+		if k.kind != model.EventTicketUpdated {
+			rows[k] = append(rows[k], model.RowChange{ID: n.ID, Op: n.Op})
+		}
+		if seen[k] {
+			continue
+		}
+		seen[k] = true
+		order = append(order, k)
+		if k.kind == model.EventTicketUpdated {
+			ticketIDs = append(ticketIDs, k.ticketID)
+		}
+	}
+
+	current := map[uuid.UUID]*model.ChangeEvent{}
+	lookupFailed := false
+	if len(ticketIDs) > 0 {
+		tickets, err := f.Tickets.FindByIDs(ticketIDs)
+		if err != nil {
+			log.Printf("change feed: loading tickets: %v", err)
+			lookupFailed = true
+		}
+		for _, t := range tickets {
+			if t.DeletedAt != nil {
+				current[t.ID] = &model.ChangeEvent{Type: model.EventTicketDeleted, TicketID: t.ID}
+			} else {
+				current[t.ID] = &model.ChangeEvent{Type: model.EventTicketUpdated, TicketID: t.ID, Ticket: t}
+			}
+		}
+	}
+
+	events := make([]model.ChangeEvent, 0, len(order))
+	for _, k := range order {
+		if k.kind != model.EventTicketUpdated {
+			events = append(events, model.ChangeEvent{Type: k.kind, TicketID: k.ticketID, Changes: rows[k]})
+			continue
+		}
+		if ev, ok := current[k.ticketID]; ok {
+			events = append(events, *ev)
+		} else if !lookupFailed {
+			// No row at all: the ticket was hard-deleted.
+			events = append(events, model.ChangeEvent{Type: model.EventTicketDeleted, TicketID: k.ticketID})
+		}
+	}
+	return events
+}
@@ -0,0 +1,110 @@
+package usecase
+
+import (
+	"context"
+	"errors"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func TestChangeFeed_EventsCoalescesPerTicket(t *testing.T) {
+	edited, deleted, gone := uuid.New(), uuid.New(), uuid.New()
+	comment1, comment2, attachment := uuid.New(), uuid.New(), uuid.New()
+	now := time.Now()
+	var lookups int
+	feed := NewChangeFeed(&mockTicketRepo{
+		FindFunc: func(ids []uuid.UUID) ([]*domain.Ticket, error) {
+			lookups++
+			assert.ElementsMatch(t, []uuid.UUID{edited, deleted, gone}, ids)
+			return []*domain.Ticket{
+				{ID: edited, Title: "latest"},
+				{ID: deleted, DeletedAt: &now},
+			}, nil
+		},
+	}, NewEventHub())
+
+	events := feed.Events([]model.ChangeNotification{
+		{Table: "tickets", Op: "UPDATE", ID: edited, TicketID: edited},
+		{Table: "ticket_comments", Op: "INSERT", ID: comment1, TicketID: edited},
+		{Table: "tickets", Op: "UPDATE", ID: edited, TicketID: edited},
+		{Table: "ticket_comments", Op: "DELETE", ID: comment2, TicketID: edited},
+		{Table: "tickets", Op: "UPDATE", ID: deleted, TicketID: deleted},
+		{Table: "tickets", Op: "DELETE", ID: gone, TicketID: gone},
+		{Table: "ticket_attachments", Op: "DELETE", ID: attachment, TicketID: deleted},
+	})
+
+	assert.Equal(t, 1, lookups)
+	require.Len(t, events, 5)
+	assert.Equal(t, model.EventTicketUpdated, events[0].Type)
+	assert.Equal(t, "latest", events[0].Ticket.Title)
+	assert.Equal(t, model.ChangeEvent{Type: model.EventCommentsChanged, TicketID: edited, Changes: []model.RowChange{
+		{ID: comment1, Op: "INSERT"},
+		{ID: comment2, Op: "DELETE"},
+	}}, events[1])
+	assert.Equal(t, model.ChangeEvent{Type: model.EventTicketDeleted, TicketID: deleted}, events[2])
+	assert.Equal(t, model.ChangeEvent{Type: model.EventTicketDeleted, TicketID: gone}, events[3])
+	assert.Equal(t, model.ChangeEvent{Type: model.EventAttachmentsChanged, TicketID: deleted, Changes: []model.RowChange{
+		{ID: attachment, Op: "DELETE"},
+	}}, events[4])
+}
+
+func TestChangeFeed_EventsSkipsTicketsWhenLookupFails(t *testing.T) {
+	id, commentID := uuid.New(), uuid.New()
+	feed := NewChangeFeed(&mockTicketRepo{
+		FindFunc: func(ids []uuid.UUID) ([]*domain.Ticket, error) { return nil, errors.New("fail") },
+	}, NewEventHub())
+	events := feed.Events([]model.ChangeNotification{
+		{Table: "tickets", Op: "UPDATE", ID: id, TicketID: id},
+		{Table: "ticket_comments", Op: "INSERT", ID: commentID, TicketID: id},
+	})
+	assert.Equal(t, []model.ChangeEvent{{Type: model.EventCommentsChanged, TicketID: id,
+		Changes: []model.RowChange{{ID: commentID, Op: "INSERT"}}}}, events)
+}
+
+func TestChangeFeed_RunPublishesOneBatchPerWindow(t *testing.T) {
+	hub := NewEventHub()
+	sub, unsubscribe := hub.Subscribe(4)
+	defer unsubscribe()
+	feed := NewChangeFeed(&mockTicketRepo{}, hub)
+	feed.Window = 50 * time.Millisecond
+
+	in := make(chan model.ChangeNotification, 10)
+	ticketID := uuid.New()
+	for i := 0; i < 5; i++ {
+		in <- model.ChangeNotification{Table: "ticket_comments", Op: "INSERT", ID: uuid.New(), TicketID: ticketID}
+	}
+	ctx, cancel := context.WithCancel(context.Background())
+	defer cancel()
+	go feed.Run(ctx, in)
+
+	select {
+	case batch := <-sub:
+		assert.Equal(t, []model.ChangeEvent{{Type: model.EventCommentsChanged, TicketID: ticketID}}, batch)
+	case <-time.After(time.Second):
+		t.Fatal("no batch published")
+	}
+}
+
+func TestEventHub_DropsSlowSubscriber(t *testing.T) {
+	hub := NewEventHub()
+	slow, _ := hub.Subscribe(1)
+	fast, unsubscribe := hub.Subscribe(4)
+	defer unsubscribe()
+
+	batch := []model.ChangeEvent{{Type: model.EventCommentsChanged, TicketID: uuid.New()}}
+	hub.Publish(batch)
+	hub.Publish(batch)
+
+	assert.Equal(t, 1, hub.Subscribers())
+	<-slow
+	_, open := <-slow
+	assert.False(t, open)
+	assert.Len(t, fast, 2)
+}
@@ -0,0 +1,20 @@
+package usecase
+
+import (
+	"time"
+
+	"ticket-system/backend/internal/domain"
+)
+
+// DashboardRepository reads the dashboard summary tables.
+type DashboardRepository interface {
+	// OpenSummary returns the non-empty summary rows of statuses other than closed.
+	OpenSummary() ([]domain.TicketSummary, error)
+	AgeBuckets() ([]domain.TicketAgeBucket, error)
+	// Throughput returns the recorded days from since on, oldest first.
+	Throughput(since time.Time) ([]domain.TicketDailyStats, error)
+	RefreshAgeBuckets() error
+	// FoldDeltas moves the count changes written by ticket transactions into the
+	// summary tables. Reads include unfolded changes, so this only bounds their number.
+	FoldDeltas() error
+}
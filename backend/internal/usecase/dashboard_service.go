@@ -0,0 +1,141 @@
+package usecase
+
+import (
+	"context"
+	"log"
+	"sort"
+	"strconv"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
+)
+
+// ageBucketOrder is the display order of the buckets computed by mv_ticket_age_buckets.
+var ageBucketOrder = map[string]int{"0-1d": 0, "1-7d": 1, "7-30d": 2, "30d+": 3}
+
+// DashboardService builds GET /dashboard from the summary tables, which the database
+// maintains as tickets change, and keeps the age-bucket view refreshed.
+type DashboardService struct {
+	Repo DashboardRepository
+	Now  func() time.Time
+}
+
+func NewDashboardService(repo DashboardRepository) *DashboardService {
+	return &DashboardService{Repo: repo, Now: time.Now}
+}
+
+// Run refreshes the age buckets once right away and then at every interval until ctx is done.
+func (s *DashboardService) Run(ctx context.Context, interval time.Duration) {
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		if err := s.Repo.RefreshAgeBuckets(); err != nil {
+			log.Printf("dashboard: refreshing age buckets: %v", err)
+		}
+		select {
+		case <-ctx.Done():
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+// RunFold folds the summary deltas at every interval until ctx is done. Ticket
+// writes only append deltas (migration 190); folding often keeps reads cheap.
+func (s *DashboardService) RunFold(ctx context.Context, interval time.Duration) {
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		select {
+		case <-ctx.Done():
+			return
+		case <-ticker.C:
+		}
+		if err := s.Repo.FoldDeltas(); err != nil {
+			log.Printf("dashboard: folding summary deltas: %v", err)
+		}
+	}
+}
+
+// Dashboard rolls the summary rows up per department, priority and assignee and
+// returns throughput for the last `days` UTC days, today included, with empty days
+// filled in.
+func (s *DashboardService) Dashboard(days int) (*model.Dashboard, error) {
+	summary, err := s.Repo.OpenSummary()
+	if err != nil {
+		return nil, err
+	}
+	buckets, err := s.Repo.AgeBuckets()
+	if err != nil {
+		return nil, err
+	}
+	today := s.Now().UTC().Truncate(24 * time.Hour)
+	since := today.AddDate(0, 0, 1-days)
+	stats, err := s.Repo.Throughput(since)
+	if err != nil {
+		return nil, err
+	}
+
+	d := &model.Dashboard{}
+	byDepartment := map[string]int64{}
+	byPriority := map[string]int64{}
+	byAssignee := map[string]int64{}
+	for _, row := range summary {
+		d.OpenTotal += row.TicketCount
+		byDepartment[strconv.Itoa(int(row.DepartmentID))] += row.TicketCount
+		byPriority[strconv.Itoa(int(row.PriorityID))] += row.TicketCount
+		assignee := ""
+		if row.AssigneeID != nil {
+			assignee = row.AssigneeID.String()
+		}
+		byAssignee[assignee] += row.TicketCount
+	}
+	d.OpenByDepartment = sortedCounts(byDepartment)
+	d.OpenByPriority = sortedCounts(byPriority)
+	d.OpenByAssignee = sortedCounts(byAssignee)
+
+	sort.Slice(buckets, func(i, j int) bool {
+		if buckets[i].DepartmentID != buckets[j].DepartmentID {
+			return buckets[i].DepartmentID < buckets[j].DepartmentID
+		}
+		return ageBucketOrder[buckets[i].Bucket] < ageBucketOrder[buckets[j].Bucket]
+	})
+	d.AgeBuckets = make([]model.DashboardAgeBucket, 0, len(buckets))
+	for _, b := range buckets {
+		d.AgeBuckets = append(d.AgeBuckets, model.DashboardAgeBucket{DepartmentID: b.DepartmentID, Bucket: b.Bucket, Count: b.TicketCount})
+		if d.AgeRefreshedAt == nil || b.RefreshedAt.After(*d.AgeRefreshedAt) {
+			refreshed := b.RefreshedAt
+			d.AgeRefreshedAt = &refreshed
+		}
+	}
+
+	recorded := make(map[string]domain.TicketDailyStats, len(stats))
+	for _, st := range stats {
+		recorded[st.Day.UTC().Format("2006-01-02")] = st
+	}
+	d.Throughput = make([]model.DashboardDay, 0, days)
+	for day := since; !day.After(today); day = day.AddDate(0, 0, 1) {
+		key := day.Format("2006-01-02")
+		st := recorded[key]
+		d.Throughput = append(d.Throughput, model.DashboardDay{Day: key, Created: st.CreatedCount, Closed: st.ClosedCount})
+	}
+	return d, nil
+}
+
+// sortedCounts lists the non-zero counts, largest first.
+func sortedCounts(counts map[string]int64) []model.DashboardCount {
+	res := make([]model.DashboardCount, 0, len(counts))
+	for id, n := range counts {
+		if n > 0 {
+			res = append(res, model.DashboardCount{ID: id, Count: n})
+		}
+	}
+	sort.Slice(res, func(i, j int) bool {
+		if res[i].Count != res[j].Count {
+			return res[i].Count > res[j].Count
+		}
+		return res[i].ID < res[j].ID
+	})
+	return res
+}
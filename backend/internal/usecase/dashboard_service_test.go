@@ -0,0 +1,93 @@
+package usecase
+
+import (
+	"errors"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+type mockDashboardRepo struct {
+	OpenSummaryFunc       func() ([]domain.TicketSummary, error)
+	AgeBucketsFunc        func() ([]domain.TicketAgeBucket, error)
+	ThroughputFunc        func(since time.Time) ([]domain.TicketDailyStats, error)
+	RefreshAgeBucketsFunc func() error
+	FoldDeltasFunc        func() error
+}
+
+func (m *mockDashboardRepo) OpenSummary() ([]domain.TicketSummary, error) { return m.OpenSummaryFunc() }
+func (m *mockDashboardRepo) AgeBuckets() ([]domain.TicketAgeBucket, error) {
+	return m.AgeBucketsFunc()
+}
+func (m *mockDashboardRepo) Throughput(since time.Time) ([]domain.TicketDailyStats, error) {
+	return m.ThroughputFunc(since)
+}
+func (m *mockDashboardRepo) RefreshAgeBuckets() error { return m.RefreshAgeBucketsFunc() }
+func (m *mockDashboardRepo) FoldDeltas() error        { return m.FoldDeltasFunc() }
+
+func TestDashboardService_Dashboard(t *testing.T) {
+	alice := uuid.New()
+	refreshed := time.Date(2026, 10, 19, 11, 55, 0, 0, time.UTC)
+	var gotSince time.Time
+	repo := &mockDashboardRepo{
+		OpenSummaryFunc: func() ([]domain.TicketSummary, error) {
+			return []domain.TicketSummary{
+				{DepartmentID: 1, PriorityID: 5, StatusID: 1, AssigneeID: &alice, TicketCount: 2},
+				{DepartmentID: 1, PriorityID: 1, StatusID: 1, TicketCount: 1},
+				{DepartmentID: 2, PriorityID: 5, StatusID: 3, AssigneeID: &alice, TicketCount: 4},
+			}, nil
+		},
+		AgeBucketsFunc: func() ([]domain.TicketAgeBucket, error) {
+			return []domain.TicketAgeBucket{
+				{DepartmentID: 2, Bucket: "30d+", TicketCount: 4, RefreshedAt: refreshed},
+				{DepartmentID: 1, Bucket: "7-30d", TicketCount: 1, RefreshedAt: refreshed},
+				{DepartmentID: 1, Bucket: "0-1d", TicketCount: 2, RefreshedAt: refreshed},
+			}, nil
+		},
+		ThroughputFunc: func(since time.Time) ([]domain.TicketDailyStats, error) {
+			gotSince = since
+			return []domain.TicketDailyStats{{Day: time.Date(2026, 10, 18, 0, 0, 0, 0, time.UTC), CreatedCount: 3, ClosedCount: 1}}, nil
+		},
+	}
+	svc := NewDashboardService(repo)
+	svc.Now = func() time.Time { return time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC) }
+
+	d, err := svc.Dashboard(3)
+	require.NoError(t, err)
+	assert.Equal(t, int64(7), d.OpenTotal)
+	assert.Equal(t, "2", d.OpenByDepartment[0].ID)
+	assert.Equal(t, int64(4), d.OpenByDepartment[0].Count)
+	assert.Equal(t, "5", d.OpenByPriority[0].ID)
+	assert.Equal(t, int64(6), d.OpenByPriority[0].Count)
+	require.Len(t, d.OpenByAssignee, 2)
+	assert.Equal(t, alice.String(), d.OpenByAssignee[0].ID)
+	assert.Equal(t, "", d.OpenByAssignee[1].ID, "unassigned tickets have an empty id")
+
+	require.Len(t, d.AgeBuckets, 3)
+	assert.Equal(t, "0-1d", d.AgeBuckets[0].Bucket)
+	assert.Equal(t, "7-30d", d.AgeBuckets[1].Bucket)
+	assert.Equal(t, int16(2), d.AgeBuckets[2].DepartmentID)
+	require.NotNil(t, d.AgeRefreshedAt)
+	assert.Equal(t, refreshed, *d.AgeRefreshedAt)
+
+	assert.Equal(t, time.Date(2026, 10, 17, 0, 0, 0, 0, time.UTC), gotSince)
+	require.Len(t, d.Throughput, 3, "days without writes are filled in")
+	assert.Equal(t, "2026-10-17", d.Throughput[0].Day)
+	assert.Equal(t, int64(0), d.Throughput[0].Created)
+	assert.Equal(t, int64(3), d.Throughput[1].Created)
+	assert.Equal(t, int64(1), d.Throughput[1].Closed)
+	assert.Equal(t, "2026-10-19", d.Throughput[2].Day)
+}
+
+func TestDashboardService_Dashboard_Error(t *testing.T) {
+	repo := &mockDashboardRepo{
+		OpenSummaryFunc: func() ([]domain.TicketSummary, error) { return nil, errors.New("db down") },
+	}
+	_, err := NewDashboardService(repo).Dashboard(30)
+	assert.Error(t, err)
+}
@@ -0,0 +1,57 @@
+package usecase
+
+import (
+	"sync"
+
+	"ticket-system/backend/internal/model"
+)
+
+// EventHub fans batches of change events out to subscribers (one per open /events
+// stream). Publishing never blocks: a subscriber whose buffer is full is dropped
+// and its channel closed, and the client reloads when it reconnects.
+type EventHub struct {
+	mu   sync.Mutex
+	subs map[chan []model.ChangeEvent]struct{}
+}
+
+func NewEventHub() *EventHub {
+	return &EventHub{subs: make(map[chan []model.ChangeEvent]struct{})}
+}
+
+// Subscribe returns a channel of event batches and a function that ends the subscription.
+func (h *EventHub) Subscribe(buffer int) (<-chan []model.ChangeEvent, func()) {
+	ch := make(chan []model.ChangeEvent, buffer)
+	h.mu.Lock()
+	h.subs[ch] = struct{}{}
+	h.mu.Unlock()
+	return ch, func() {
+		h.mu.Lock()
+		if _, ok := h.subs[ch]; ok {
+			delete(h.subs, ch)
+			close(ch)
+		}
+		h.mu.Unlock()
+	}
+}
+
+func (h *EventHub) Publish(events []model.ChangeEvent) {
+	if len(events) == 0 {
+		return
+	}
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	for ch := range h.subs {
+		select {
+		case ch <- events:
+		default:
+			delete(h.subs, ch)
+			close(ch)
+		}
+	}
+}
+
+func (h *EventHub) Subscribers() int {
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	return len(h.subs)
+}
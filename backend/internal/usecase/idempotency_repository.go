@@ -0,0 +1,19 @@
+package usecase
+
+import (
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+)
+
+type IdempotencyRepository interface {
+	// Reserve claims the key for a new request. When the key is already taken it
+	// returns the existing record and false, unless the holder is an unfinished
+	// attempt at the same request reserved before staleBefore, which is taken over.
+	Reserve(record *domain.IdempotencyKey, staleBefore time.Time) (*domain.IdempotencyKey, bool, error)
+	Complete(userID uuid.UUID, key string, statusCode int, body []byte) error
+	Release(userID uuid.UUID, key string) error
+	PurgeBefore(cutoff time.Time) (int64, error)
+}
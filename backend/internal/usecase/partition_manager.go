@@ -0,0 +1,172 @@
+package usecase
+
+import (
+	"context"
+	"fmt"
+	"log"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+)
+
+const (
+	PartitionYearly  = "year"
+	PartitionMonthly = "month"
+)
+
+// PartitionManager keeps tickets partitioned ahead of the clock and moves cold
+// partitions into tickets_archive. Each pass creates the partitions for the current
+// period and the Ahead periods after it, skipping ranges an existing partition
+// already covers (so yearly partitions can give way to monthly ones), then archives
+// every partition that ends more than HotMonths before the current period.
+// Every API instance runs a manager; a database lock lets only one pass run at a time.
+type PartitionManager struct {
+	Repo        TicketPartitionRepository
+	Granularity string // PartitionYearly or PartitionMonthly
+	Ahead       int
+	HotMonths   int // 0 keeps everything hot
+	Now         func() time.Time
+}
+
+func NewPartitionManager(repo TicketPartitionRepository, granularity string, ahead, hotMonths int) *PartitionManager {
+	if granularity != PartitionMonthly {
+		granularity = PartitionYearly
+	}
+	return &PartitionManager{Repo: repo, Granularity: granularity, Ahead: ahead, HotMonths: hotMonths, Now: time.Now}
+}
+
+// Run maintains the partitions once right away and then at every interval until ctx is done.
+func (m *PartitionManager) Run(ctx context.Context, interval time.Duration) {
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		m.maintainLocked()
+		select {
+		case <-ctx.Done():
+			return
+		case <-ticker.C:
+		}
+	}
+}
+
+// maintainLocked runs a pass unless another instance is running one. Two passes
+// at once would detach the same partition twice and subtract its rows from the
+// dashboard counts twice.
+func (m *PartitionManager) maintainLocked() {
+	unlock, ok, err := m.Repo.TryLock()
+	if err != nil {
+		log.Printf("partitions: lock: %v", err)
+		return
+	}
+	if !ok {
+		return
+	}
+	defer unlock()
+	if err := m.Maintain(); err != nil {
+		log.Printf("partitions: %v", err)
+	}
+}
+
+// Maintain runs one pass. Creation goes first: a missing partition makes inserts
+// fail, while archiving can wait for the next pass. Archives interrupted by a
+// crash are finished before new ones start.
+func (m *PartitionManager) Maintain() error {
+	existing, err := m.Repo.List()
+	if err != nil {
+		return fmt.Errorf("list: %w", err)
+	}
+	for _, p := range m.Missing(existing) {
+		if err := m.Repo.Create(p); err != nil {
+			return fmt.Errorf("create %s: %w", p.Name, err)
+		}
+		log.Printf("partitions: created %s [%s, %s)", p.Name, p.From.Format("2006-01-02"), p.To.Format("2006-01-02"))
+	}
+	unfinished, err := m.Repo.Unfinished()
+	if err != nil {
+		return fmt.Errorf("unfinished archives: %w", err)
+	}
+	for _, p := range append(unfinished, m.Cold(existing)...) {
+		n, err := m.Repo.Archive(p)
+		if err != nil {
+			return fmt.Errorf("archive %s: %w", p.Name, err)
+		}
+		log.Printf("partitions: archived %s (%d tickets)", p.Name, n)
+	}
+	return nil
+}
+
+// Missing returns the partitions to create so that the current period and the
+// Ahead periods after it are covered.
+func (m *PartitionManager) Missing(existing []domain.TicketPartition) []domain.TicketPartition {
+	var missing []domain.TicketPartition
+	from := m.periodStart(m.Now().UTC())
+	for i := 0; i <= m.Ahead; i++ {
+		to := m.next(from)
+		switch {
+		case !covered(existing, from, to):
+			missing = append(missing, domain.TicketPartition{Name: m.name(from), From: from, To: to})
+		case m.Granularity == PartitionYearly:
+			// Partly covered, e.g. by monthly partitions from an earlier setting:
+			// fill the gaps month by month.
+			for month := from; month.Before(to); month = month.AddDate(0, 1, 0) {
+				if !covered(existing, month, month.AddDate(0, 1, 0)) {
+					missing = append(missing, domain.TicketPartition{Name: monthlyName(month), From: month, To: month.AddDate(0, 1, 0)})
+				}
+			}
+		}
+		from = to
+	}
+	return missing
+}
+
+// Cold returns the partitions that lie entirely before the hot window.
+func (m *PartitionManager) Cold(existing []domain.TicketPartition) []domain.TicketPartition {
+	if m.HotMonths <= 0 {
+		return nil
+	}
+	cutoff := m.periodStart(m.Now().UTC()).AddDate(0, -m.HotMonths, 0)
+	var cold []domain.TicketPartition
+	for _, p := range existing {
+		if !p.To.After(cutoff) {
+			cold = append(cold, p)
+		}
+	}
+	return cold
+}
+
+func (m *PartitionManager) periodStart(t time.Time) time.Time {
+	if m.Granularity == PartitionMonthly {
+		return time.Date(t.Year(), t.Month(), 1, 0, 0, 0, 0, time.UTC)
+	}
+	return time.Date(t.Year(), 1, 1, 0, 0, 0, 0, time.UTC)
+}
+
+func (m *PartitionManager) next(t time.Time) time.Time {
+	if m.Granularity == PartitionMonthly {
+		return t.AddDate(0, 1, 0)
+	}
+	return t.AddDate(1, 0, 0)
+}
+
+// name follows the existing tickets_2024 style: tickets_2027, or tickets_2027_01.
+func (m *PartitionManager) name(from time.Time) string {
+	if m.Granularity == PartitionMonthly {
+		return monthlyName(from)
+	}
+	return fmt.Sprintf("tickets_%04d", from.Year())
+}
+
+func monthlyName(from time.Time) string {
+	return fmt.Sprintf("tickets_%04d_%02d", from.Year(), from.Month())
+}
+
+// covered reports whether [from, to) overlaps an existing partition. Range
+// partitions may not overlap, so such a range cannot be created as a whole.
+func covered(existing []domain.TicketPartition, from, to time.Time) bool {
+	for _, p := range existing {
+		if p.From.Before(to) && from.Before(p.To) {
+			return true
+		}
+	}
+	return false
+}
@@ -0,0 +1,177 @@
+package usecase
+
+import (
+	"errors"
+	"fmt"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+type mockTicketPartitionRepo struct {
+	ListFunc       func() ([]domain.TicketPartition, error)
+	CreateFunc     func(partition domain.TicketPartition) error
+	ArchiveFunc    func(partition domain.TicketPartition) (int64, error)
+	UnfinishedFunc func() ([]domain.TicketPartition, error)
+	locked         bool
+}
+
+func (m *mockTicketPartitionRepo) List() ([]domain.TicketPartition, error) { return m.ListFunc() }
+func (m *mockTicketPartitionRepo) Create(partition domain.TicketPartition) error {
+	return m.CreateFunc(partition)
+}
+func (m *mockTicketPartitionRepo) Archive(partition domain.TicketPartition) (int64, error) {
+	return m.ArchiveFunc(partition)
+}
+func (m *mockTicketPartitionRepo) Unfinished() ([]domain.TicketPartition, error) {
+	if m.UnfinishedFunc == nil {
+		return nil, nil
+	}
+	return m.UnfinishedFunc()
+}
+func (m *mockTicketPartitionRepo) TryLock() (func(), bool, error) {
+	if m.locked {
+		return nil, false, nil
+	}
+	m.locked = true
+	return func() { m.locked = false }, true, nil
+}
+
+func yearPartition(year int) domain.TicketPartition {
+	from := time.Date(year, 1, 1, 0, 0, 0, 0, time.UTC)
+	return domain.TicketPartition{Name: fmt.Sprintf("tickets_%d", year), From: from, To: from.AddDate(1, 0, 0)}
+}
+
+func partitionNames(partitions []domain.TicketPartition) []string {
+	names := make([]string, len(partitions))
+	for i, p := range partitions {
+		names[i] = p.Name
+	}
+	return names
+}
+
+func managerAt(granularity string, ahead, hotMonths int, now time.Time) *PartitionManager {
+	m := NewPartitionManager(nil, granularity, ahead, hotMonths)
+	m.Now = func() time.Time { return now }
+	return m
+}
+
+func TestPartitionManager_MissingYearly(t *testing.T) {
+	existing := []domain.TicketPartition{yearPartition(2024), yearPartition(2025), yearPartition(2026)}
+	m := managerAt(PartitionYearly, 2, 0, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	missing := m.Missing(existing)
+	assert.Equal(t, []string{"tickets_2027", "tickets_2028"}, partitionNames(missing))
+	assert.Equal(t, time.Date(2027, 1, 1, 0, 0, 0, 0, time.UTC), missing[0].From)
+	assert.Equal(t, time.Date(2028, 1, 1, 0, 0, 0, 0, time.UTC), missing[0].To)
+}
+
+func TestPartitionManager_MissingMonthlyAfterYearly(t *testing.T) {
+	existing := []domain.TicketPartition{yearPartition(2025), yearPartition(2026)}
+	m := managerAt(PartitionMonthly, 4, 0, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	// October to December are inside tickets_2026.
+	assert.Equal(t, []string{"tickets_2027_01", "tickets_2027_02"}, partitionNames(m.Missing(existing)))
+}
+
+func TestPartitionManager_MissingYearlyFillsMonthlyGaps(t *testing.T) {
+	jan := time.Date(2027, 1, 1, 0, 0, 0, 0, time.UTC)
+	existing := []domain.TicketPartition{
+		yearPartition(2026),
+		{Name: "tickets_2027_01", From: jan, To: jan.AddDate(0, 1, 0)},
+	}
+	m := managerAt(PartitionYearly, 1, 0, time.Date(2026, 12, 1, 0, 0, 0, 0, time.UTC))
+	missing := m.Missing(existing)
+	require.Len(t, missing, 11)
+	assert.Equal(t, "tickets_2027_02", missing[0].Name)
+	assert.Equal(t, "tickets_2027_12", missing[10].Name)
+	assert.Equal(t, time.Date(2028, 1, 1, 0, 0, 0, 0, time.UTC), missing[10].To)
+}
+
+func TestPartitionManager_Cold(t *testing.T) {
+	existing := []domain.TicketPartition{yearPartition(2024), yearPartition(2025), yearPartition(2026)}
+	now := time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC)
+	assert.Equal(t, []string{"tickets_2024"}, partitionNames(managerAt(PartitionMonthly, 0, 12, now).Cold(existing)))
+	assert.Equal(t, []string{"tickets_2024", "tickets_2025"}, partitionNames(managerAt(PartitionMonthly, 0, 9, now).Cold(existing)))
+	assert.Empty(t, managerAt(PartitionMonthly, 0, 0, now).Cold(existing))
+}
+
+func TestPartitionManager_Maintain(t *testing.T) {
+	var created, archived []string
+	m := managerAt(PartitionYearly, 1, 12, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	m.Repo = &mockTicketPartitionRepo{
+		ListFunc: func() ([]domain.TicketPartition, error) {
+			return []domain.TicketPartition{yearPartition(2024), yearPartition(2025), yearPartition(2026)}, nil
+		},
+		CreateFunc: func(p domain.TicketPartition) error {
+			created = append(created, p.Name)
+			return nil
+		},
+		ArchiveFunc: func(p domain.TicketPartition) (int64, error) {
+			archived = append(archived, p.Name)
+			return 3, nil
+		},
+	}
+	require.NoError(t, m.Maintain())
+	assert.Equal(t, []string{"tickets_2027"}, created)
+	assert.Equal(t, []string{"tickets_2024"}, archived)
+}
+
+func TestPartitionManager_MaintainFinishesInterruptedArchives(t *testing.T) {
+	var archived []string
+	m := managerAt(PartitionYearly, 0, 12, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	m.Repo = &mockTicketPartitionRepo{
+		ListFunc: func() ([]domain.TicketPartition, error) {
+			return []domain.TicketPartition{yearPartition(2024), yearPartition(2025), yearPartition(2026)}, nil
+		},
+		CreateFunc: func(p domain.TicketPartition) error { return nil },
+		ArchiveFunc: func(p domain.TicketPartition) (int64, error) {
+			archived = append(archived, p.Name)
+			return 0, nil
+		},
+		UnfinishedFunc: func() ([]domain.TicketPartition, error) {
+			return []domain.TicketPartition{{Name: "tickets_2023"}}, nil
+		},
+	}
+	require.NoError(t, m.Maintain())
+	assert.Equal(t, []string{"tickets_2023", "tickets_2024"}, archived)
+}
+
+func TestPartitionManager_MaintainLockedSkipsWhileLocked(t *testing.T) {
+	repo := &mockTicketPartitionRepo{
+		ListFunc: func() ([]domain.TicketPartition, error) {
+			t.Fatal("no pass may run while another instance holds the lock")
+			return nil, nil
+		},
+		locked: true,
+	}
+	m := managerAt(PartitionYearly, 0, 12, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	m.Repo = repo
+	m.maintainLocked()
+
+	var listed int
+	repo.locked = false
+	repo.ListFunc = func() ([]domain.TicketPartition, error) {
+		listed++
+		return nil, nil
+	}
+	repo.CreateFunc = func(p domain.TicketPartition) error { return nil }
+	m.maintainLocked()
+	assert.Equal(t, 1, listed)
+	assert.False(t, repo.locked, "the lock is released after the pass")
+}
+
+func TestPartitionManager_MaintainStopsOnCreateError(t *testing.T) {
+	m := managerAt(PartitionYearly, 1, 12, time.Date(2026, 10, 19, 12, 0, 0, 0, time.UTC))
+	m.Repo = &mockTicketPartitionRepo{
+		ListFunc:   func() ([]domain.TicketPartition, error) { return []domain.TicketPartition{yearPartition(2024)}, nil },
+		CreateFunc: func(p domain.TicketPartition) error { return errors.New("fail") },
+		ArchiveFunc: func(p domain.TicketPartition) (int64, error) {
+			t.Fatal("archive must not run after a failed create")
+			return 0, nil
+		},
+	}
+	assert.Error(t, m.Maintain())
+}
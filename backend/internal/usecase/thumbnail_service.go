@@ -0,0 +1,149 @@
+package usecase
+
+import (
+	"bytes"
+	"errors"
+	"image"
+	"image/color"
+	"image/draw"
+	_ "image/gif"
+	"image/jpeg"
+	_ "image/png"
+	"strings"
+	"time"
+
+	"github.com/google/uuid"
+
+	"ticket-system/backend/internal/domain"
+)
+
+// ThumbnailSizes lists the bounding boxes, in pixels, generated for every image attachment.
+var ThumbnailSizes = []int{128, 512}
+
+const (
+	ThumbnailContentType = "image/jpeg"
+	thumbnailJPEGQuality = 80
+
+	// MaxThumbnailSourcePixels caps width*height of a source image. The decoder
+	// holds the whole image, 4 to 8 bytes per pixel, so a small PNG declaring
+	// huge dimensions would otherwise allocate gigabytes.
+	MaxThumbnailSourcePixels = 40_000_000
+)
+
+var (
+	ErrUnsupportedImage = errors.New("attachment is not a supported image")
+	ErrImageTooLarge    = errors.New("image dimensions exceed the thumbnail pixel budget")
+)
+
+// IsThumbnailable reports whether thumbnails can be produced for the given filename.
+func IsThumbnailable(filename string) bool {
+	lower := strings.ToLower(filename)
+	return strings.HasSuffix(lower, ".jpg") || strings.HasSuffix(lower, ".jpeg") ||
+		strings.HasSuffix(lower, ".png") || strings.HasSuffix(lower, ".gif")
+}
+
+// ThumbnailSizeFor returns the smallest generated size that covers the requested one.
+func ThumbnailSizeFor(requested int) int {
+	for _, size := range ThumbnailSizes {
+		if requested <= size {
+			return size
+		}
+	}
+	return ThumbnailSizes[len(ThumbnailSizes)-1]
+}
+
+// GenerateThumbnail decodes an image and encodes a JPEG that fits into size x size.
+func GenerateThumbnail(attachmentID uuid.UUID, data []byte, size int) (*domain.TicketAttachmentThumbnail, error) {
+	thumbs, err := GenerateThumbnails(attachmentID, data, []int{size})
+	if err != nil {
+		return nil, err
+	}
+	return thumbs[0], nil
+}
+
+// GenerateThumbnails decodes an image once and encodes a JPEG for each size.
+func GenerateThumbnails(attachmentID uuid.UUID, data []byte, sizes []int) ([]*domain.TicketAttachmentThumbnail, error) {
+	cfg, _, err := image.DecodeConfig(bytes.NewReader(data))
+	if err != nil {
+		return nil, ErrUnsupportedImage
+	}
+	if cfg.Width <= 0 || cfg.Height <= 0 || int64(cfg.Width)*int64(cfg.Height) > MaxThumbnailSourcePixels {
+		return nil, ErrImageTooLarge
+	}
+	src, _, err := image.Decode(bytes.NewReader(data))
+	if err != nil {
+		return nil, ErrUnsupportedImage
+	}
+	thumbs := make([]*domain.TicketAttachmentThumbnail, 0, len(sizes))
+	for _, size := range sizes {
+		dst := scaleToFit(src, size)
+		var buf bytes.Buffer
+		if err := jpeg.Encode(&buf, dst, &jpeg.Options{Quality: thumbnailJPEGQuality}); err != nil {
+			return nil, err
+		}
+		thumbs = append(thumbs, &domain.TicketAttachmentThumbnail{
+			AttachmentID: attachmentID,
+			Size:         size,
+			ContentType:  ThumbnailContentType,
+			Width:        dst.Bounds().Dx(),
+			Height:       dst.Bounds().Dy(),
+			Data:         buf.Bytes(),
+			CreatedAt:    time.Now().UTC(),
+		})
+	}
+	return thumbs, nil
+}
+
+// scaleToFit downscales with an area average, flattening transparency onto white.
+// Source rows are converted one at a time into a single scratch row.
+func scaleToFit(src image.Image, size int) *image.RGBA {
+	b := src.Bounds()
+	sw, sh := b.Dx(), b.Dy()
+	dw, dh := sw, sh
+	if sw > size || sh > size {
+		if sw >= sh {
+			dw, dh = size, sh*size/sw
+		} else {
+			dw, dh = sw*size/sh, size
+		}
+	}
+	if dw < 1 {
+		dw = 1
+	}
+	if dh < 1 {
+		dh = 1
+	}
+	dst := image.NewRGBA(image.Rect(0, 0, dw, dh))
+	row := image.NewRGBA(image.Rect(0, 0, sw, 1))
+	white := image.NewUniform(color.White)
+	acc := make([]uint64, dw*3)
+	count := make([]uint64, dw)
+	for sy := 0; sy < sh; sy++ {
+		draw.Draw(row, row.Bounds(), white, image.Point{}, draw.Src)
+		draw.Draw(row, row.Bounds(), src, image.Pt(b.Min.X, b.Min.Y+sy), draw.Over)
+		for sx := 0; sx < sw; sx++ {
+			dx := sx * dw / sw
+			p := row.Pix[sx*4 : sx*4+3]
+			acc[dx*3] += uint64(p[0])
+			acc[dx*3+1] += uint64(p[1])
+			acc[dx*3+2] += uint64(p[2])
+			count[dx]++
+		}
+		dy := sy * dh / sh
+		if sy == sh-1 || (sy+1)*dh/sh != dy {
+			out := dst.Pix[dy*dst.Stride:]
+			for dx := 0; dx < dw; dx++ {
+				n := count[dx]
+				if n == 0 {
+					n = 1
+				}
+				out[dx*4] = uint8(acc[dx*3] / n)
+				out[dx*4+1] = uint8(acc[dx*3+1] / n)
+				out[dx*4+2] = uint8(acc[dx*3+2] / n)
+				out[dx*4+3] = 0xff
+				acc[dx*3], acc[dx*3+1], acc[dx*3+2], count[dx] = 0, 0, 0, 0
+			}
+		}
+	}
+	return dst
+}
@@ -0,0 +1,75 @@
+package usecase
+
+import (
+	"bytes"
+	"image"
+	"image/color"
+	"image/jpeg"
+	"image/png"
+	"testing"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+func encodeTestPNG(t *testing.T, w, h int) []byte {
+	img := image.NewRGBA(image.Rect(0, 0, w, h))
+	for y := 0; y < h; y++ {
+		for x := 0; x < w; x++ {
+			img.Set(x, y, color.RGBA{R: uint8(x), G: uint8(y), B: 128, A: 255})
+		}
+	}
+	var buf bytes.Buffer
+	require.NoError(t, png.Encode(&buf, img))
+	return buf.Bytes()
+}
+
+func TestGenerateThumbnail_FitsBoundingBox(t *testing.T) {
+	attID := uuid.New()
+	thumb, err := GenerateThumbnail(attID, encodeTestPNG(t, 1000, 500), 128)
+	require.NoError(t, err)
+	assert.Equal(t, attID, thumb.AttachmentID)
+	assert.Equal(t, 128, thumb.Size)
+	assert.Equal(t, ThumbnailContentType, thumb.ContentType)
+	decoded, err := jpeg.Decode(bytes.NewReader(thumb.Data))
+	require.NoError(t, err)
+	assert.Equal(t, 128, decoded.Bounds().Dx())
+	assert.Equal(t, 64, decoded.Bounds().Dy())
+	assert.Equal(t, 128, thumb.Width)
+	assert.Equal(t, 64, thumb.Height)
+}
+
+func TestGenerateThumbnail_DoesNotUpscale(t *testing.T) {
+	thumb, err := GenerateThumbnail(uuid.New(), encodeTestPNG(t, 40, 90), 512)
+	require.NoError(t, err)
+	assert.Equal(t, 40, thumb.Width)
+	assert.Equal(t, 90, thumb.Height)
+}
+
+func TestGenerateThumbnail_NotAnImage(t *testing.T) {
+	_, err := GenerateThumbnail(uuid.New(), []byte("plain text"), 128)
+	assert.ErrorIs(t, err, ErrUnsupportedImage)
+}
+
+func TestGenerateThumbnails_OneDecodeAllSizes(t *testing.T) {
+	thumbs, err := GenerateThumbnails(uuid.New(), encodeTestPNG(t, 1000, 500), ThumbnailSizes)
+	require.NoError(t, err)
+	require.Len(t, thumbs, 2)
+	assert.Equal(t, 128, thumbs[0].Width)
+	assert.Equal(t, 512, thumbs[1].Width)
+}
+
+func TestGenerateThumbnail_RejectsHugeDimensions(t *testing.T) {
+	// A bare GIF header declaring a 65535x65535 screen; nothing is decoded past it.
+	header := []byte("GIF89a\xff\xff\xff\xff\x00\x00\x00")
+	_, err := GenerateThumbnail(uuid.New(), header, 128)
+	assert.ErrorIs(t, err, ErrImageTooLarge)
+}
+
+func TestThumbnailSizeFor(t *testing.T) {
+	assert.Equal(t, 128, ThumbnailSizeFor(64))
+	assert.Equal(t, 128, ThumbnailSizeFor(128))
+	assert.Equal(t, 512, ThumbnailSizeFor(256))
+	assert.Equal(t, 512, ThumbnailSizeFor(4096))
+}
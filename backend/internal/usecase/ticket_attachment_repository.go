@@ -9,6 +9,10 @@ import (
 type TicketAttachmentRepository interface {
 	GetByTicketID(ticketID uuid.UUID) ([]*domain.TicketAttachment, error)
 	GetByID(attID uuid.UUID) (*domain.TicketAttachment, error)
+	GetMetaByID(attID uuid.UUID) (*domain.TicketAttachment, error)
+	ReadDataRange(attID uuid.UUID, offset int64, length int) ([]byte, error)
 	Create(att *domain.TicketAttachment) error
 	Delete(attID uuid.UUID) error
+	GetThumbnail(attID uuid.UUID, size int) (*domain.TicketAttachmentThumbnail, error)
+	SaveThumbnail(thumb *domain.TicketAttachmentThumbnail) error
 }
@@ -13,8 +13,12 @@ import (
 type mockTicketAttachmentRepo struct {
 	GetByTicketIDFunc func(ticketID uuid.UUID) ([]*domain.TicketAttachment, error)
 	GetByIDFunc       func(attID uuid.UUID) (*domain.TicketAttachment, error)
+	GetMetaByIDFunc   func(attID uuid.UUID) (*domain.TicketAttachment, error)
+	ReadDataRangeFunc func(attID uuid.UUID, offset int64, length int) ([]byte, error)
 	CreateFunc        func(att *domain.TicketAttachment) error
 	DeleteFunc        func(attID uuid.UUID) error
+	GetThumbnailFunc  func(attID uuid.UUID, size int) (*domain.TicketAttachmentThumbnail, error)
+	SaveThumbnailFunc func(thumb *domain.TicketAttachmentThumbnail) error
 }
 
 func (m *mockTicketAttachmentRepo) GetByTicketID(ticketID uuid.UUID) ([]*domain.TicketAttachment, error) {
@@ -23,12 +27,24 @@ func (m *mockTicketAttachmentRepo) GetByTicketID(ticketID uuid.UUID) ([]*domain.
 func (m *mockTicketAttachmentRepo) GetByID(attID uuid.UUID) (*domain.TicketAttachment, error) {
 	return m.GetByIDFunc(attID)
 }
+func (m *mockTicketAttachmentRepo) GetMetaByID(attID uuid.UUID) (*domain.TicketAttachment, error) {
+	return m.GetMetaByIDFunc(attID)
+}
+func (m *mockTicketAttachmentRepo) ReadDataRange(attID uuid.UUID, offset int64, length int) ([]byte, error) {
+	return m.ReadDataRangeFunc(attID, offset, length)
+}
 func (m *mockTicketAttachmentRepo) Create(att *domain.TicketAttachment) error {
 	return m.CreateFunc(att)
 }
 func (m *mockTicketAttachmentRepo) Delete(attID uuid.UUID) error {
 	return m.DeleteFunc(attID)
 }
+func (m *mockTicketAttachmentRepo) GetThumbnail(attID uuid.UUID, size int) (*domain.TicketAttachmentThumbnail, error) {
+	return m.GetThumbnailFunc(attID, size)
+}
+func (m *mockTicketAttachmentRepo) SaveThumbnail(thumb *domain.TicketAttachmentThumbnail) error {
+	return m.SaveThumbnailFunc(thumb)
+}
 
 func TestTicketAttachmentRepository_GetByTicketID_OK(t *testing.T) {
 	repo := &mockTicketAttachmentRepo{
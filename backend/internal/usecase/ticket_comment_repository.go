@@ -2,12 +2,14 @@ package usecase
 
 import (
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 
 	"github.com/google/uuid"
 )
 
 type TicketCommentRepository interface {
 	GetByTicketID(ticketID uuid.UUID) ([]*domain.TicketComment, error)
+	GetPageByTicketID(ticketID uuid.UUID, before *model.CommentCursor, limit int) ([]*domain.TicketComment, error)
 	GetByID(commentID uuid.UUID) (*domain.TicketComment, error)
 	Create(comment *domain.TicketComment) error
 	Delete(commentID uuid.UUID) error
@@ -3,8 +3,10 @@ package usecase
 import (
 	"errors"
 	"testing"
+	"time"
 
 	"ticket-system/backend/internal/domain"
+	"ticket-system/backend/internal/model"
 
 	"github.com/google/uuid"
 	"github.com/stretchr/testify/assert"
@@ -12,6 +14,7 @@ import (
 
 type mockTicketCommentRepo struct {
 	GetByTicketIDFunc func(ticketID uuid.UUID) ([]*domain.TicketComment, error)
+	GetPageFunc       func(ticketID uuid.UUID, before *model.CommentCursor, limit int) ([]*domain.TicketComment, error)
 	GetByIDFunc       func(commentID uuid.UUID) (*domain.TicketComment, error)
 	CreateFunc        func(comment *domain.TicketComment) error
 	DeleteFunc        func(commentID uuid.UUID) error
@@ -20,6 +23,9 @@ type mockTicketCommentRepo struct {
 func (m *mockTicketCommentRepo) GetByTicketID(ticketID uuid.UUID) ([]*domain.TicketComment, error) {
 	return m.GetByTicketIDFunc(ticketID)
 }
+func (m *mockTicketCommentRepo) GetPageByTicketID(ticketID uuid.UUID, before *model.CommentCursor, limit int) ([]*domain.TicketComment, error) {
+	return m.GetPageFunc(ticketID, before, limit)
+}
 func (m *mockTicketCommentRepo) GetByID(commentID uuid.UUID) (*domain.TicketComment, error) {
 	return m.GetByIDFunc(commentID)
 }
@@ -53,6 +59,28 @@ func TestTicketCommentRepository_GetByTicketID_Error(t *testing.T) {
 	assert.Error(t, err)
 }
 
+func TestTicketCommentRepository_GetPageByTicketID_OK(t *testing.T) {
+	repo := &mockTicketCommentRepo{
+		GetPageFunc: func(ticketID uuid.UUID, before *model.CommentCursor, limit int) ([]*domain.TicketComment, error) {
+			return make([]*domain.TicketComment, limit), nil
+		},
+	}
+	cursor := &model.CommentCursor{CreatedAt: time.Now(), ID: uuid.New()}
+	comments, err := repo.GetPageByTicketID(uuid.New(), cursor, 3)
+	assert.NoError(t, err)
+	assert.Len(t, comments, 3)
+}
+
+func TestCommentCursor_RoundTrip(t *testing.T) {
+	cursor := model.CommentCursor{CreatedAt: time.Date(2025, 1, 2, 3, 4, 5, 6000, time.UTC), ID: uuid.New()}
+	decoded, err := model.DecodeCommentCursor(cursor.Encode())
+	assert.NoError(t, err)
+	assert.True(t, cursor.CreatedAt.Equal(decoded.CreatedAt))
+	assert.Equal(t, cursor.ID, decoded.ID)
+	_, err = model.DecodeCommentCursor("not-a-cursor")
+	assert.Error(t, err)
+}
+
 func TestTicketCommentRepository_GetByID_OK(t *testing.T) {
 	repo := &mockTicketCommentRepo{
 		GetByIDFunc: func(commentID uuid.UUID) (*domain.TicketComment, error) {
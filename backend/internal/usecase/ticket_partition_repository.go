@@ -0,0 +1,19 @@
+package usecase
+
+import "ticket-system/backend/internal/domain"
+
+// TicketPartitionRepository manages the range partitions of tickets.
+type TicketPartitionRepository interface {
+	List() ([]domain.TicketPartition, error)
+	Create(partition domain.TicketPartition) error
+	// Archive copies the partition's rows into tickets_archive, detaches the
+	// partition and drops it. It returns the number of rows moved. It also finishes
+	// an earlier, interrupted archive of the same partition.
+	Archive(partition domain.TicketPartition) (int64, error)
+	// Unfinished returns the partitions whose archiving was interrupted after they
+	// were detached, so List no longer shows them. Only Name is set.
+	Unfinished() ([]domain.TicketPartition, error)
+	// TryLock takes the lock that lets one API instance at a time maintain the
+	// partitions. ok is false if another instance holds it; unlock releases it.
+	TryLock() (unlock func(), ok bool, err error)
+}
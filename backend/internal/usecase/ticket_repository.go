@@ -1,6 +1,8 @@
 package usecase
 
 import (
+	"time"
+
 	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/model"
 
@@ -9,8 +11,16 @@ import (
 
 type TicketRepository interface {
 	Create(ticket *domain.Ticket) error
-	GetByID(id uuid.UUID) (*domain.Ticket, error)
+	// createdAt, when known, lets the lookup touch a single tickets partition.
+	GetByID(id uuid.UUID, createdAt *time.Time) (*domain.Ticket, error)
+	FindByIDs(ids []uuid.UUID) ([]*domain.Ticket, error)
 	Update(ticket *domain.Ticket) error
-	Delete(id uuid.UUID) error
+	Patch(id uuid.UUID, createdAt *time.Time, columns map[string]interface{}) error
+	Delete(id uuid.UUID, createdAt *time.Time) error
+	Batch(action string, ids []uuid.UUID, patch *model.TicketPatch, changedBy uuid.UUID) ([]model.TicketBatchResult, error)
 	Search(filter model.TicketFilter) ([]*domain.Ticket, error)
+	// held are the ids the client has in a filtered view, so tickets edited out of it
+	// can be told apart from tickets it never had.
+	Changes(filter model.TicketFilter, since time.Time, held []uuid.UUID) ([]*domain.Ticket, []uuid.UUID, error)
+	SyncWatermark() (time.Time, error)
 }
@@ -3,6 +3,7 @@ package usecase
 import (
 	"errors"
 	"testing"
+	"time"
 
 	"ticket-system/backend/internal/domain"
 	"ticket-system/backend/internal/model"
@@ -13,20 +14,42 @@ import (
 
 type mockTicketRepo struct {
 	CreateFunc  func(ticket *domain.Ticket) error
-	GetByIDFunc func(id uuid.UUID) (*domain.Ticket, error)
+	GetByIDFunc func(id uuid.UUID, createdAt *time.Time) (*domain.Ticket, error)
+	FindFunc    func(ids []uuid.UUID) ([]*domain.Ticket, error)
 	UpdateFunc  func(ticket *domain.Ticket) error
-	DeleteFunc  func(id uuid.UUID) error
+	PatchFunc   func(id uuid.UUID, createdAt *time.Time, columns map[string]interface{}) error
+	DeleteFunc  func(id uuid.UUID, createdAt *time.Time) error
 	SearchFunc  func(filter model.TicketFilter) ([]*domain.Ticket, error)
+	ChangesFunc func(filter model.TicketFilter, since time.Time, held []uuid.UUID) ([]*domain.Ticket, []uuid.UUID, error)
+	BatchFunc   func(action string, ids []uuid.UUID, patch *model.TicketPatch, changedBy uuid.UUID) ([]model.TicketBatchResult, error)
 }
 
-func (m *mockTicketRepo) Create(ticket *domain.Ticket) error           { return m.CreateFunc(ticket) }
-func (m *mockTicketRepo) GetByID(id uuid.UUID) (*domain.Ticket, error) { return m.GetByIDFunc(id) }
-func (m *mockTicketRepo) Update(ticket *domain.Ticket) error           { return m.UpdateFunc(ticket) }
-func (m *mockTicketRepo) Delete(id uuid.UUID) error                    { return m.DeleteFunc(id) }
+func (m *mockTicketRepo) Create(ticket *domain.Ticket) error { return m.CreateFunc(ticket) }
+func (m *mockTicketRepo) GetByID(id uuid.UUID, createdAt *time.Time) (*domain.Ticket, error) {
+	return m.GetByIDFunc(id, createdAt)
+}
+func (m *mockTicketRepo) FindByIDs(ids []uuid.UUID) ([]*domain.Ticket, error) {
+	return m.FindFunc(ids)
+}
+func (m *mockTicketRepo) Update(ticket *domain.Ticket) error { return m.UpdateFunc(ticket) }
+func (m *mockTicketRepo) Patch(id uuid.UUID, createdAt *time.Time, columns map[string]interface{}) error {
+	return m.PatchFunc(id, createdAt, columns)
+}
+func (m *mockTicketRepo) Delete(id uuid.UUID, createdAt *time.Time) error {
+	return m.DeleteFunc(id, createdAt)
+}
 func (m *mockTicketRepo) Search(filter model.TicketFilter) ([]*domain.Ticket, error) {
 	return m.SearchFunc(filter)
 }
 
+func (m *mockTicketRepo) Changes(filter model.TicketFilter, since time.Time, held []uuid.UUID) ([]*domain.Ticket, []uuid.UUID, error) {
+	return m.ChangesFunc(filter, since, held)
+}
+func (m *mockTicketRepo) SyncWatermark() (time.Time, error) { return time.Now().UTC(), nil }
+func (m *mockTicketRepo) Batch(action string, ids []uuid.UUID, patch *model.TicketPatch, changedBy uuid.UUID) ([]model.TicketBatchResult, error) {
+	return m.BatchFunc(action, ids, patch, changedBy)
+}
+
 func TestTicketRepository_Create_OK(t *testing.T) {
 	repo := &mockTicketRepo{
 		CreateFunc: func(ticket *domain.Ticket) error { return nil },
@@ -46,21 +69,21 @@ func TestTicketRepository_Create_Error(t *testing.T) {
 func TestTicketRepository_GetByID_OK(t *testing.T) {
 	id := uuid.New()
 	repo := &mockTicketRepo{
-		GetByIDFunc: func(got uuid.UUID) (*domain.Ticket, error) {
+		GetByIDFunc: func(got uuid.UUID, createdAt *time.Time) (*domain.Ticket, error) {
 			assert.Equal(t, id, got)
 			return &domain.Ticket{ID: id}, nil
 		},
 	}
-	ticket, err := repo.GetByID(id)
+	ticket, err := repo.GetByID(id, nil)
 	assert.NoError(t, err)
 	assert.Equal(t, id, ticket.ID)
 }
 
 func TestTicketRepository_GetByID_Error(t *testing.T) {
 	repo := &mockTicketRepo{
-		GetByIDFunc: func(id uuid.UUID) (*domain.Ticket, error) { return nil, errors.New("fail") },
+		GetByIDFunc: func(id uuid.UUID, createdAt *time.Time) (*domain.Ticket, error) { return nil, errors.New("fail") },
 	}
-	_, err := repo.GetByID(uuid.New())
+	_, err := repo.GetByID(uuid.New(), nil)
 	assert.Error(t, err)
 }
 
@@ -78,18 +101,28 @@ func TestTicketRepository_Update_Error(t *testing.T) {
 	assert.Error(t, repo.Update(&domain.Ticket{}))
 }
 
+func TestTicketRepository_Patch_OK(t *testing.T) {
+	repo := &mockTicketRepo{
+		PatchFunc: func(id uuid.UUID, createdAt *time.Time, columns map[string]interface{}) error {
+			assert.Equal(t, map[string]interface{}{"status_id": int16(2)}, columns)
+			return nil
+		},
+	}
+	assert.NoError(t, repo.Patch(uuid.New(), nil, map[string]interface{}{"status_id": int16(2)}))
+}
+
 func TestTicketRepository_Delete_OK(t *testing.T) {
 	repo := &mockTicketRepo{
-		DeleteFunc: func(id uuid.UUID) error { return nil },
+		DeleteFunc: func(id uuid.UUID, createdAt *time.Time) error { return nil },
 	}
-	assert.NoError(t, repo.Delete(uuid.New()))
+	assert.NoError(t, repo.Delete(uuid.New(), nil))
 }
 
 func TestTicketRepository_Delete_Error(t *testing.T) {
 	repo := &mockTicketRepo{
-		DeleteFunc: func(id uuid.UUID) error { return errors.New("fail") },
+		DeleteFunc: func(id uuid.UUID, createdAt *time.Time) error { return errors.New("fail") },
 	}
-	assert.Error(t, repo.Delete(uuid.New()))
+	assert.Error(t, repo.Delete(uuid.New(), nil))
 }
 
 func TestTicketRepository_Search_OK(t *testing.T) {
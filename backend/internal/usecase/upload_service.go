@@ -0,0 +1,344 @@
+package usecase
+
+import (
+	"context"
+	"crypto/sha256"
+	"encoding/hex"
+	"errors"
+	"fmt"
+	"io"
+	"log"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"time"
+
+	"github.com/google/uuid"
+
+	"ticket-system/backend/internal/domain"
+)
+
+var (
+	ErrUploadChunkOffset     = errors.New("chunk offset is not a chunk boundary inside the file")
+	ErrUploadChunkSize       = errors.New("chunk has the wrong length")
+	ErrUploadIncomplete      = errors.New("upload is missing chunks")
+	ErrUploadChecksum        = errors.New("assembled file does not match the expected sha256")
+	ErrUploadInvalidFilename = errors.New("invalid filename")
+	ErrUploadTooLarge        = errors.New("file is larger than the upload size limit")
+	ErrUploadCommitting      = errors.New("upload is already being committed")
+	ErrBlobNotFound          = errors.New("no stored content with this sha256")
+)
+
+// UploadSessionTTL is how long an upload may go without a chunk before it is
+// considered abandoned and purged together with its chunks.
+const UploadSessionTTL = 24 * time.Hour
+
+// uploadCommitClaimTTL is how long a commit claim blocks others. A claim older
+// than this belongs to a commit that died with its process and is taken over.
+const uploadCommitClaimTTL = 15 * time.Minute
+
+// UploadService implements chunked uploads: chunks are written to UploadDir/<upload_id>/
+// and assembled on commit into the content-addressed blob store, so identical
+// content is stored once however many attachments reference it.
+type UploadService struct {
+	Uploads       AttachmentUploadRepository
+	Attachments   TicketAttachmentRepository
+	Blobs         AttachmentBlobRepository
+	UploadDir     string
+	AttachmentDir string
+	ChunkSize     int64
+	// MaxSize is the largest size_bytes Initiate accepts.
+	MaxSize int64
+}
+
+func NewUploadService(uploads AttachmentUploadRepository, attachments TicketAttachmentRepository, blobs AttachmentBlobRepository, uploadDir, attachmentDir string, chunkSize, maxSize int64) *UploadService {
+	return &UploadService{Uploads: uploads, Attachments: attachments, Blobs: blobs, UploadDir: uploadDir, AttachmentDir: attachmentDir, ChunkSize: chunkSize, MaxSize: maxSize}
+}
+
+func (s *UploadService) Initiate(ticket *domain.Ticket, filename string, size int64, expectedSHA256 string, userID uuid.UUID) (*domain.AttachmentUpload, error) {
+	filename = filepath.Base(strings.TrimSpace(filename))
+	if filename == "" || filename == "." || filename == string(filepath.Separator) {
+		return nil, ErrUploadInvalidFilename
+	}
+	if size > s.MaxSize {
+		return nil, ErrUploadTooLarge
+	}
+	upload := &domain.AttachmentUpload{
+		ID:              uuid.New(),
+		TicketID:        ticket.ID,
+		TicketCreatedAt: ticket.CreatedAt,
+		Filename:        filename,
+		SizeBytes:       size,
+		ChunkSize:       s.ChunkSize,
+		SHA256:          strings.ToLower(expectedSHA256),
+		UploadedBy:      userID,
+		CreatedAt:       time.Now().UTC(),
+	}
+	if err := os.MkdirAll(s.uploadPath(upload.ID), 0o750); err != nil {
+		return nil, err
+	}
+	if err := s.Uploads.Create(upload); err != nil {
+		os.RemoveAll(s.uploadPath(upload.ID))
+		return nil, err
+	}
+	return upload, nil
+}
+
+func (s *UploadService) uploadPath(uploadID uuid.UUID) string {
+	return filepath.Join(s.UploadDir, uploadID.String())
+}
+
+func chunkName(offset int64) string {
+	return fmt.Sprintf("%020d.chunk", offset)
+}
+
+func expectedChunkLength(upload *domain.AttachmentUpload, offset int64) int64 {
+	if rest := upload.SizeBytes - offset; rest < upload.ChunkSize {
+		return rest
+	}
+	return upload.ChunkSize
+}
+
+// WriteChunk stores the chunk at offset. A chunk only becomes visible once it is
+// complete, so a dropped connection never leaves a half-written chunk behind.
+func (s *UploadService) WriteChunk(upload *domain.AttachmentUpload, offset int64, body io.Reader) error {
+	if offset < 0 || offset%upload.ChunkSize != 0 || (offset >= upload.SizeBytes && !(offset == 0 && upload.SizeBytes == 0)) {
+		return ErrUploadChunkOffset
+	}
+	want := expectedChunkLength(upload, offset)
+	dir := s.uploadPath(upload.ID)
+	tmp, err := os.CreateTemp(dir, "incoming-*")
+	if err != nil {
+		return err
+	}
+	defer os.Remove(tmp.Name())
+	n, err := io.Copy(tmp, io.LimitReader(body, want+1))
+	if closeErr := tmp.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		return err
+	}
+	if n != want {
+		return ErrUploadChunkSize
+	}
+	return os.Rename(tmp.Name(), filepath.Join(dir, chunkName(offset)))
+}
+
+// ReceivedOffsets lists the offsets of chunks that have been stored completely.
+func (s *UploadService) ReceivedOffsets(upload *domain.AttachmentUpload) ([]int64, error) {
+	entries, err := os.ReadDir(s.uploadPath(upload.ID))
+	if err != nil {
+		return nil, err
+	}
+	offsets := []int64{}
+	for _, e := range entries {
+		name := e.Name()
+		if !strings.HasSuffix(name, ".chunk") {
+			continue
+		}
+		offset, err := strconv.ParseInt(strings.TrimSuffix(name, ".chunk"), 10, 64)
+		if err != nil {
+			continue
+		}
+		offsets = append(offsets, offset)
+	}
+	sort.Slice(offsets, func(i, j int) bool { return offsets[i] < offsets[j] })
+	return offsets, nil
+}
+
+// Commit assembles the chunks into the blob store and records the attachment.
+// Commits of one upload are serialized: while one runs, others get ErrUploadCommitting.
+func (s *UploadService) Commit(upload *domain.AttachmentUpload) (*domain.TicketAttachment, error) {
+	now := time.Now().UTC()
+	claimed, err := s.Uploads.ClaimCommit(upload.ID, now, now.Add(-uploadCommitClaimTTL))
+	if err != nil {
+		return nil, err
+	}
+	if !claimed {
+		return nil, ErrUploadCommitting
+	}
+	att, err := s.commit(upload)
+	if err != nil {
+		if releaseErr := s.Uploads.ReleaseCommit(upload.ID); releaseErr != nil {
+			log.Printf("uploads: release commit claim %s: %v", upload.ID, releaseErr)
+		}
+		return nil, err
+	}
+	return att, nil
+}
+
+func (s *UploadService) commit(upload *domain.AttachmentUpload) (*domain.TicketAttachment, error) {
+	offsets, err := s.ReceivedOffsets(upload)
+	if err != nil {
+		return nil, err
+	}
+	chunks := int((upload.SizeBytes + upload.ChunkSize - 1) / upload.ChunkSize)
+	if chunks == 0 {
+		chunks = 1
+	}
+	if len(offsets) != chunks {
+		return nil, ErrUploadIncomplete
+	}
+
+	if err := os.MkdirAll(s.AttachmentDir, 0o750); err != nil {
+		return nil, err
+	}
+	tmpPath := filepath.Join(s.AttachmentDir, upload.ID.String()+".assembling")
+	checksum, err := s.assemble(upload, offsets, tmpPath)
+	if err != nil {
+		return nil, err
+	}
+	if upload.SHA256 != "" && upload.SHA256 != checksum {
+		os.Remove(tmpPath)
+		return nil, ErrUploadChecksum
+	}
+	blob, err := s.Blobs.PutFile(tmpPath, checksum, upload.SizeBytes)
+	if err != nil {
+		os.Remove(tmpPath)
+		return nil, err
+	}
+	att, err := s.createAttachment(upload.TicketID, upload.TicketCreatedAt, upload.Filename, upload.UploadedBy, blob)
+	if err != nil {
+		return nil, err
+	}
+	s.Abort(upload)
+	return att, nil
+}
+
+// FindBlob reports whether content with the given sha256 is already stored for
+// this user. Attachment hashes are visible to every reader of a ticket, so a
+// blob is only offered to users who uploaded it themselves: knowing a hash is
+// not proof of having the file, and other users' blobs are not even confirmed
+// to exist.
+func (s *UploadService) FindBlob(sha256 string, userID uuid.UUID) (*domain.AttachmentBlob, error) {
+	blob, err := s.Blobs.GetOwned(strings.ToLower(sha256), userID)
+	if err != nil {
+		return nil, ErrBlobNotFound
+	}
+	return blob, nil
+}
+
+// AttachBlob creates an attachment that references content the user already
+// uploaded, without any transfer.
+func (s *UploadService) AttachBlob(ticket *domain.Ticket, sha256, filename string, userID uuid.UUID) (*domain.TicketAttachment, error) {
+	filename = filepath.Base(strings.TrimSpace(filename))
+	if filename == "" || filename == "." || filename == string(filepath.Separator) {
+		return nil, ErrUploadInvalidFilename
+	}
+	if _, err := s.FindBlob(sha256, userID); err != nil {
+		return nil, err
+	}
+	blob, err := s.Blobs.Acquire(strings.ToLower(sha256))
+	if err != nil {
+		return nil, ErrBlobNotFound
+	}
+	return s.createAttachment(ticket.ID, ticket.CreatedAt, filename, userID, blob)
+}
+
+// createAttachment records an attachment for a blob that already holds a reference for it.
+func (s *UploadService) createAttachment(ticketID uuid.UUID, ticketCreatedAt time.Time, filename string, userID uuid.UUID, blob *domain.AttachmentBlob) (*domain.TicketAttachment, error) {
+	path, sha := blob.StoragePath, blob.SHA256
+	att := &domain.TicketAttachment{
+		ID:              uuid.New(),
+		TicketID:        ticketID,
+		TicketCreatedAt: ticketCreatedAt,
+		Filename:        filename,
+		FilePath:        &path,
+		SizeBytes:       blob.SizeBytes,
+		SHA256:          sha,
+		BlobSHA256:      &sha,
+		UploadedBy:      userID,
+		UploadedAt:      time.Now().UTC(),
+	}
+	if err := s.Attachments.Create(att); err != nil {
+		s.Blobs.Release(sha)
+		return nil, err
+	}
+	return att, nil
+}
+
+func (s *UploadService) assemble(upload *domain.AttachmentUpload, offsets []int64, tmpPath string) (string, error) {
+	out, err := os.OpenFile(tmpPath, os.O_CREATE|os.O_TRUNC|os.O_WRONLY, 0o640)
+	if err != nil {
+		return "", err
+	}
+	hash := sha256.New()
+	w := io.MultiWriter(out, hash)
+	for _, offset := range offsets {
+		if err = appendFile(w, filepath.Join(s.uploadPath(upload.ID), chunkName(offset))); err != nil {
+			break
+		}
+	}
+	if err == nil {
+		err = out.Sync()
+	}
+	if closeErr := out.Close(); err == nil {
+		err = closeErr
+	}
+	if err != nil {
+		os.Remove(tmpPath)
+		return "", err
+	}
+	return hex.EncodeToString(hash.Sum(nil)), nil
+}
+
+func appendFile(w io.Writer, path string) error {
+	f, err := os.Open(path)
+	if err != nil {
+		return err
+	}
+	defer f.Close()
+	_, err = io.Copy(w, f)
+	return err
+}
+
+// Abort drops an upload and its stored chunks.
+func (s *UploadService) Abort(upload *domain.AttachmentUpload) error {
+	if err := os.RemoveAll(s.uploadPath(upload.ID)); err != nil {
+		return err
+	}
+	return s.Uploads.Delete(upload.ID)
+}
+
+// PurgeAbandoned drops uploads started before `before` whose chunk directory has
+// not been written to since, and returns how many were dropped.
+func (s *UploadService) PurgeAbandoned(before time.Time) (int, error) {
+	uploads, err := s.Uploads.ListCreatedBefore(before)
+	if err != nil {
+		return 0, err
+	}
+	purged := 0
+	for i := range uploads {
+		upload := &uploads[i]
+		// Storing a chunk renames it into the directory, which bumps its mtime.
+		if info, err := os.Stat(s.uploadPath(upload.ID)); err == nil && info.ModTime().After(before) {
+			continue
+		}
+		if err := s.Abort(upload); err != nil {
+			return purged, err
+		}
+		purged++
+	}
+	return purged, nil
+}
+
+// RunPurge purges abandoned uploads every interval until ctx is done.
+func (s *UploadService) RunPurge(ctx context.Context, interval time.Duration) {
+	ticker := time.NewTicker(interval)
+	defer ticker.Stop()
+	for {
+		if n, err := s.PurgeAbandoned(time.Now().Add(-UploadSessionTTL)); err != nil {
+			log.Printf("uploads: purge: %v", err)
+		} else if n > 0 {
+			log.Printf("uploads: purged %d abandoned uploads", n)
+		}
+		select {
+		case <-ctx.Done():
+			return
+		case <-ticker.C:
+		}
+	}
+}
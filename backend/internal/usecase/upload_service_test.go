@@ -0,0 +1,281 @@
+package usecase
+
+import (
+	"bytes"
+	"crypto/sha256"
+	"encoding/hex"
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"ticket-system/backend/internal/domain"
+
+	"github.com/google/uuid"
+	"github.com/stretchr/testify/assert"
+	"github.com/stretchr/testify/require"
+)
+
+type mockAttachmentUploadRepo struct {
+	uploads map[uuid.UUID]*domain.AttachmentUpload
+}
+
+func (m *mockAttachmentUploadRepo) ClaimCommit(uploadID uuid.UUID, now, staleBefore time.Time) (bool, error) {
+	upload := m.uploads[uploadID]
+	if upload == nil || (upload.CommittingAt != nil && !upload.CommittingAt.Before(staleBefore)) {
+		return false, nil
+	}
+	upload.CommittingAt = &now
+	return true, nil
+}
+func (m *mockAttachmentUploadRepo) ReleaseCommit(uploadID uuid.UUID) error {
+	if upload := m.uploads[uploadID]; upload != nil {
+		upload.CommittingAt = nil
+	}
+	return nil
+}
+
+func (m *mockAttachmentUploadRepo) Create(upload *domain.AttachmentUpload) error {
+	m.uploads[upload.ID] = upload
+	return nil
+}
+func (m *mockAttachmentUploadRepo) GetByID(uploadID uuid.UUID) (*domain.AttachmentUpload, error) {
+	return m.uploads[uploadID], nil
+}
+func (m *mockAttachmentUploadRepo) Delete(uploadID uuid.UUID) error {
+	delete(m.uploads, uploadID)
+	return nil
+}
+func (m *mockAttachmentUploadRepo) ListCreatedBefore(before time.Time) ([]domain.AttachmentUpload, error) {
+	var res []domain.AttachmentUpload
+	for _, u := range m.uploads {
+		if u.CreatedAt.Before(before) {
+			res = append(res, *u)
+		}
+	}
+	return res, nil
+}
+
+type mockAttachmentBlobRepo struct {
+	dir         string
+	blobs       map[string]*domain.AttachmentBlob
+	attachments *[]*domain.TicketAttachment
+}
+
+func (m *mockAttachmentBlobRepo) GetOwned(sha string, uploaderID uuid.UUID) (*domain.AttachmentBlob, error) {
+	for _, att := range *m.attachments {
+		if att.BlobSHA256 != nil && *att.BlobSHA256 == sha && att.UploadedBy == uploaderID {
+			return m.Get(sha)
+		}
+	}
+	return nil, os.ErrNotExist
+}
+
+func (m *mockAttachmentBlobRepo) Get(sha string) (*domain.AttachmentBlob, error) {
+	if blob, ok := m.blobs[sha]; ok {
+		return blob, nil
+	}
+	return nil, os.ErrNotExist
+}
+func (m *mockAttachmentBlobRepo) PutFile(srcPath, sha string, size int64) (*domain.AttachmentBlob, error) {
+	if blob, ok := m.blobs[sha]; ok {
+		blob.RefCount++
+		return blob, os.Remove(srcPath)
+	}
+	blob := &domain.AttachmentBlob{SHA256: sha, SizeBytes: size, StoragePath: filepath.Join(m.dir, sha), RefCount: 1}
+	if err := os.Rename(srcPath, blob.StoragePath); err != nil {
+		return nil, err
+	}
+	m.blobs[sha] = blob
+	return blob, nil
+}
+func (m *mockAttachmentBlobRepo) Acquire(sha string) (*domain.AttachmentBlob, error) {
+	blob, err := m.Get(sha)
+	if err != nil {
+		return nil, err
+	}
+	blob.RefCount++
+	return blob, nil
+}
+func (m *mockAttachmentBlobRepo) Release(sha string) error {
+	if blob, ok := m.blobs[sha]; ok {
+		if blob.RefCount--; blob.RefCount == 0 {
+			delete(m.blobs, sha)
+		}
+	}
+	return nil
+}
+
+func newTestUploadService(t *testing.T, created *[]*domain.TicketAttachment) (*UploadService, *mockAttachmentUploadRepo) {
+	uploads := &mockAttachmentUploadRepo{uploads: map[uuid.UUID]*domain.AttachmentUpload{}}
+	attachments := &mockTicketAttachmentRepo{
+		CreateFunc: func(att *domain.TicketAttachment) error {
+			*created = append(*created, att)
+			return nil
+		},
+	}
+	blobs := &mockAttachmentBlobRepo{dir: t.TempDir(), blobs: map[string]*domain.AttachmentBlob{}, attachments: created}
+	return NewUploadService(uploads, attachments, blobs, t.TempDir(), t.TempDir(), 4, 64), uploads
+}
+
+func TestUploadService_ChunksAssembleOutOfOrder(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, uploads := newTestUploadService(t, &created)
+	data := []byte("0123456789")
+	sum := sha256.Sum256(data)
+	ticket := &domain.Ticket{ID: uuid.New(), CreatedAt: time.Now()}
+	upload, err := s.Initiate(ticket, "../capture.pcap", int64(len(data)), hex.EncodeToString(sum[:]), uuid.New())
+	require.NoError(t, err)
+	assert.Equal(t, "capture.pcap", upload.Filename)
+
+	require.NoError(t, s.WriteChunk(upload, 8, bytes.NewReader(data[8:])))
+	require.NoError(t, s.WriteChunk(upload, 0, bytes.NewReader(data[0:4])))
+	_, err = s.Commit(upload)
+	assert.ErrorIs(t, err, ErrUploadIncomplete)
+
+	offsets, err := s.ReceivedOffsets(upload)
+	require.NoError(t, err)
+	assert.Equal(t, []int64{0, 8}, offsets)
+
+	require.NoError(t, s.WriteChunk(upload, 4, bytes.NewReader(data[4:8])))
+	att, err := s.Commit(upload)
+	require.NoError(t, err)
+	require.Len(t, created, 1)
+	require.NotNil(t, att.FilePath)
+	stored, err := os.ReadFile(*att.FilePath)
+	require.NoError(t, err)
+	assert.Equal(t, data, stored)
+	assert.Equal(t, hex.EncodeToString(sum[:]), att.SHA256)
+	assert.Equal(t, int64(len(data)), att.SizeBytes)
+	assert.Empty(t, uploads.uploads)
+}
+
+func TestUploadService_RejectsBadChunks(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, _ := newTestUploadService(t, &created)
+	upload, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "log.txt", 10, "", uuid.New())
+	require.NoError(t, err)
+	assert.ErrorIs(t, s.WriteChunk(upload, 3, bytes.NewReader([]byte("abcd"))), ErrUploadChunkOffset)
+	assert.ErrorIs(t, s.WriteChunk(upload, 12, bytes.NewReader([]byte("ab"))), ErrUploadChunkOffset)
+	assert.ErrorIs(t, s.WriteChunk(upload, 0, bytes.NewReader([]byte("abc"))), ErrUploadChunkSize)
+	assert.ErrorIs(t, s.WriteChunk(upload, 8, bytes.NewReader([]byte("abc"))), ErrUploadChunkSize)
+	offsets, err := s.ReceivedOffsets(upload)
+	require.NoError(t, err)
+	assert.Empty(t, offsets)
+}
+
+func TestUploadService_RejectsOversizedUpload(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, uploads := newTestUploadService(t, &created)
+	_, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "huge.bin", s.MaxSize+1, "", uuid.New())
+	assert.ErrorIs(t, err, ErrUploadTooLarge)
+	assert.Empty(t, uploads.uploads)
+}
+
+func TestUploadService_CommitIsSerialized(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, _ := newTestUploadService(t, &created)
+	upload, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "a.bin", 3, "", uuid.New())
+	require.NoError(t, err)
+	require.NoError(t, s.WriteChunk(upload, 0, bytes.NewReader([]byte("abc"))))
+
+	running := time.Now().UTC()
+	upload.CommittingAt = &running
+	_, err = s.Commit(upload)
+	assert.ErrorIs(t, err, ErrUploadCommitting)
+	assert.Empty(t, created)
+
+	// A claim left behind by a commit that died is taken over once it is stale.
+	dead := running.Add(-2 * uploadCommitClaimTTL)
+	upload.CommittingAt = &dead
+	_, err = s.Commit(upload)
+	require.NoError(t, err)
+	assert.Len(t, created, 1)
+}
+
+func TestUploadService_FailedCommitReleasesClaim(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, _ := newTestUploadService(t, &created)
+	upload, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "a.bin", 8, "", uuid.New())
+	require.NoError(t, err)
+	_, err = s.Commit(upload)
+	assert.ErrorIs(t, err, ErrUploadIncomplete)
+	assert.Nil(t, upload.CommittingAt)
+}
+
+func TestUploadService_ChecksumMismatch(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, _ := newTestUploadService(t, &created)
+	upload, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "a.bin", 3, "deadbeef", uuid.New())
+	require.NoError(t, err)
+	require.NoError(t, s.WriteChunk(upload, 0, bytes.NewReader([]byte("abc"))))
+	_, err = s.Commit(upload)
+	assert.ErrorIs(t, err, ErrUploadChecksum)
+	assert.Empty(t, created)
+}
+
+func TestUploadService_AttachBlobReusesStoredContent(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, _ := newTestUploadService(t, &created)
+	data := []byte("same bytes")
+	sum := sha256.Sum256(data)
+	checksum := hex.EncodeToString(sum[:])
+
+	uploader := uuid.New()
+	_, err := s.FindBlob(checksum, uploader)
+	assert.ErrorIs(t, err, ErrBlobNotFound)
+	_, err = s.AttachBlob(&domain.Ticket{ID: uuid.New()}, checksum, "a.bin", uploader)
+	assert.ErrorIs(t, err, ErrBlobNotFound)
+
+	upload, err := s.Initiate(&domain.Ticket{ID: uuid.New()}, "a.bin", int64(len(data)), checksum, uploader)
+	require.NoError(t, err)
+	for offset := int64(0); offset < int64(len(data)); offset += 4 {
+		end := min(offset+4, int64(len(data)))
+		require.NoError(t, s.WriteChunk(upload, offset, bytes.NewReader(data[offset:end])))
+	}
+	first, err := s.Commit(upload)
+	require.NoError(t, err)
+
+	blob, err := s.FindBlob(checksum, uploader)
+	require.NoError(t, err)
+	assert.Equal(t, int64(len(data)), blob.SizeBytes)
+
+	// Another user who only knows the hash neither sees nor gets the content.
+	stranger := uuid.New()
+	_, err = s.FindBlob(checksum, stranger)
+	assert.ErrorIs(t, err, ErrBlobNotFound)
+	_, err = s.AttachBlob(&domain.Ticket{ID: uuid.New()}, checksum, "stolen.bin", stranger)
+	assert.ErrorIs(t, err, ErrBlobNotFound)
+
+	second, err := s.AttachBlob(&domain.Ticket{ID: uuid.New()}, checksum, "copy.bin", uploader)
+	require.NoError(t, err)
+	assert.Equal(t, *first.FilePath, *second.FilePath)
+	assert.Equal(t, "copy.bin", second.Filename)
+	assert.Equal(t, 2, blob.RefCount)
+	require.Len(t, created, 2)
+}
+
+func TestUploadService_PurgeAbandoned(t *testing.T) {
+	var created []*domain.TicketAttachment
+	s, uploads := newTestUploadService(t, &created)
+	ticket := &domain.Ticket{ID: uuid.New(), CreatedAt: time.Now()}
+	stale, err := s.Initiate(ticket, "stale.bin", 8, "", uuid.New())
+	require.NoError(t, err)
+	active, err := s.Initiate(ticket, "active.bin", 8, "", uuid.New())
+	require.NoError(t, err)
+	fresh, err := s.Initiate(ticket, "fresh.bin", 8, "", uuid.New())
+	require.NoError(t, err)
+
+	old := time.Now().Add(-2 * UploadSessionTTL)
+	stale.CreatedAt, active.CreatedAt = old, old
+	require.NoError(t, os.Chtimes(s.uploadPath(stale.ID), old, old))
+	require.NoError(t, s.WriteChunk(active, 0, bytes.NewReader([]byte("0123"))))
+
+	n, err := s.PurgeAbandoned(time.Now().Add(-UploadSessionTTL))
+	require.NoError(t, err)
+	assert.Equal(t, 1, n)
+	assert.NotContains(t, uploads.uploads, stale.ID)
+	assert.NoDirExists(t, s.uploadPath(stale.ID))
+	assert.Contains(t, uploads.uploads, active.ID, "an upload still receiving chunks is kept")
+	assert.Contains(t, uploads.uploads, fresh.ID)
+}
@@ -0,0 +1,2 @@
+CREATE INDEX idx_ticket_comments_ticket_page
+    ON ticket_comments(ticket_id, created_at DESC, comment_id DESC);
@@ -0,0 +1,10 @@
+CREATE TABLE ticket_attachment_thumbnails (
+    attachment_id UUID NOT NULL REFERENCES ticket_attachments(attachment_id) ON DELETE CASCADE,
+    size INT NOT NULL,
+    content_type TEXT NOT NULL,
+    width INT NOT NULL,
+    height INT NOT NULL,
+    data BYTEA NOT NULL,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    PRIMARY KEY (attachment_id, size)
+);
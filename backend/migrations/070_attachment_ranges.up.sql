@@ -0,0 +1,12 @@
+-- Downloads are served in ranges with substr(file_data, ...). EXTERNAL keeps the
+-- TOAST value uncompressed so a slice only reads the chunks it covers.
+ALTER TABLE ticket_attachments ALTER COLUMN file_data SET STORAGE EXTERNAL;
+
+ALTER TABLE ticket_attachments
+    ADD COLUMN size_bytes BIGINT NOT NULL DEFAULT 0,
+    ADD COLUMN sha256 TEXT NOT NULL DEFAULT '';
+
+UPDATE ticket_attachments
+SET size_bytes = octet_length(file_data),
+    sha256 = encode(sha256(file_data), 'hex')
+WHERE file_data IS NOT NULL;
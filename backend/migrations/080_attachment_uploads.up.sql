@@ -0,0 +1,14 @@
+CREATE TABLE attachment_uploads (
+    upload_id UUID PRIMARY KEY DEFAULT uuid_generate_v4(),
+    ticket_id UUID NOT NULL,
+    ticket_created_at TIMESTAMPTZ NOT NULL,
+    filename TEXT NOT NULL,
+    size_bytes BIGINT NOT NULL CHECK (size_bytes >= 0),
+    chunk_size BIGINT NOT NULL CHECK (chunk_size > 0),
+    sha256 TEXT NOT NULL DEFAULT '',
+    uploaded_by UUID NOT NULL REFERENCES users(user_id),
+    created_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    FOREIGN KEY (ticket_id, ticket_created_at) REFERENCES tickets(ticket_id, created_at)
+);
+
+CREATE INDEX idx_attachment_uploads_created_at ON attachment_uploads(created_at);
@@ -0,0 +1,11 @@
+CREATE TABLE attachment_blobs (
+    sha256 TEXT PRIMARY KEY,
+    size_bytes BIGINT NOT NULL CHECK (size_bytes >= 0),
+    storage_path TEXT NOT NULL,
+    ref_count INT NOT NULL CHECK (ref_count > 0),
+    created_at TIMESTAMPTZ NOT NULL DEFAULT now()
+);
+
+ALTER TABLE ticket_attachments ADD COLUMN blob_sha256 TEXT REFERENCES attachment_blobs(sha256);
+
+CREATE INDEX idx_ticket_attachments_blob_sha256 ON ticket_attachments(blob_sha256) WHERE blob_sha256 IS NOT NULL;
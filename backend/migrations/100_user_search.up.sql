@@ -0,0 +1,3 @@
+-- Prefix search for the assignee picker: lower(username) LIKE 'abc%'.
+CREATE INDEX idx_users_username_prefix ON users (lower(username) text_pattern_ops) WHERE deleted_at IS NULL;
+CREATE INDEX idx_users_department_username_prefix ON users (department_id, lower(username) text_pattern_ops) WHERE deleted_at IS NULL;
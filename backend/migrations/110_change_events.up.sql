@@ -0,0 +1,40 @@
+-- Publish row changes on the ticket_changes channel so API instances can push them
+-- to connected clients. The payload carries ids only (NOTIFY payloads are capped
+-- at 8000 bytes); listeners read the current row themselves.
+CREATE OR REPLACE FUNCTION fn_notify_ticket_change()
+RETURNS TRIGGER AS $$
+DECLARE
+  rec RECORD;
+  row_id UUID;
+BEGIN
+  IF TG_OP = 'DELETE' THEN
+    rec := OLD;
+  ELSE
+    rec := NEW;
+  END IF;
+  IF TG_TABLE_NAME = 'tickets' THEN
+    row_id := rec.ticket_id;
+  ELSIF TG_TABLE_NAME = 'ticket_comments' THEN
+    row_id := rec.comment_id;
+  ELSE
+    row_id := rec.attachment_id;
+  END IF;
+  PERFORM pg_notify('ticket_changes', json_build_object(
+    'table', TG_TABLE_NAME,
+    'op', TG_OP,
+    'id', row_id,
+    'ticket_id', rec.ticket_id
+  )::text);
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER trg_tickets_notify_change
+  AFTER INSERT OR UPDATE OR DELETE ON tickets
+  FOR EACH ROW EXECUTE FUNCTION fn_notify_ticket_change();
+CREATE TRIGGER trg_ticket_comments_notify_change
+  AFTER INSERT OR UPDATE OR DELETE ON ticket_comments
+  FOR EACH ROW EXECUTE FUNCTION fn_notify_ticket_change();
+CREATE TRIGGER trg_ticket_attachments_notify_change
+  AFTER INSERT OR UPDATE OR DELETE ON ticket_attachments
+  FOR EACH ROW EXECUTE FUNCTION fn_notify_ticket_change();
@@ -0,0 +1,15 @@
+-- Outcomes of mutating requests sent with an Idempotency-Key header, so a client
+-- replaying its offline journal gets the original response instead of a duplicate
+-- write. Rows older than a day are purged by the API.
+CREATE TABLE IF NOT EXISTS idempotency_keys (
+  user_id UUID NOT NULL,
+  idempotency_key VARCHAR(128) NOT NULL,
+  method VARCHAR(10) NOT NULL,
+  path TEXT NOT NULL,
+  status_code INTEGER NOT NULL DEFAULT 0,
+  response_body BYTEA,
+  created_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+  PRIMARY KEY (user_id, idempotency_key)
+);
+
+CREATE INDEX IF NOT EXISTS idx_idempotency_keys_created_at ON idempotency_keys (created_at);
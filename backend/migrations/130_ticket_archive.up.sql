@@ -0,0 +1,64 @@
+-- Cold tickets partitions are detached by the API's partition manager and their
+-- rows moved here. The table is written once per partition and then only read:
+-- pages are packed full, and text goes to lz4-compressed TOAST early. The
+-- search_vector GIN index keeps archived tickets searchable (GET /tickets?archived=true).
+CREATE TABLE IF NOT EXISTS tickets_archive (
+    ticket_id UUID NOT NULL,
+    title TEXT COMPRESSION lz4 NOT NULL,
+    description TEXT COMPRESSION lz4,
+    status_id SMALLINT NOT NULL,
+    priority_id SMALLINT NOT NULL,
+    creator_id UUID NOT NULL,
+    assignee_id UUID,
+    department_id SMALLINT NOT NULL,
+    created_at TIMESTAMPTZ NOT NULL,
+    updated_at TIMESTAMPTZ NOT NULL,
+    deleted_at TIMESTAMPTZ,
+    search_vector tsvector COMPRESSION lz4,
+    archived_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    PRIMARY KEY (ticket_id, created_at)
+) WITH (fillfactor = 100, toast_tuple_target = 128);
+
+CREATE INDEX IF NOT EXISTS idx_tickets_archive_created_at ON tickets_archive (created_at);
+CREATE INDEX IF NOT EXISTS idx_tickets_archive_archived_at ON tickets_archive (archived_at);
+CREATE INDEX IF NOT EXISTS idx_tickets_archive_assignee_id ON tickets_archive (assignee_id);
+CREATE INDEX IF NOT EXISTS idx_tickets_archive_department_id ON tickets_archive (department_id);
+CREATE INDEX IF NOT EXISTS idx_tickets_archive_search_vector ON tickets_archive USING GIN (search_vector);
+
+-- A partition referenced by a foreign key cannot be detached, and the referenced
+-- ticket may now live in either table. The foreign keys to tickets are replaced by
+-- constraint triggers that accept both. Tickets are only soft-deleted, so only the
+-- referencing side needs checking.
+CREATE OR REPLACE FUNCTION fn_check_ticket_exists()
+RETURNS TRIGGER AS $$
+BEGIN
+  IF NOT EXISTS (SELECT 1 FROM tickets WHERE ticket_id = NEW.ticket_id AND created_at = NEW.ticket_created_at)
+     AND NOT EXISTS (SELECT 1 FROM tickets_archive WHERE ticket_id = NEW.ticket_id AND created_at = NEW.ticket_created_at) THEN
+    RAISE EXCEPTION 'ticket % created at % does not exist', NEW.ticket_id, NEW.ticket_created_at
+      USING ERRCODE = 'foreign_key_violation', TABLE = TG_TABLE_NAME;
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+ALTER TABLE ticket_history DROP CONSTRAINT IF EXISTS ticket_history_ticket_id_ticket_created_at_fkey;
+ALTER TABLE ticket_comments DROP CONSTRAINT IF EXISTS ticket_comments_ticket_id_ticket_created_at_fkey;
+ALTER TABLE ticket_attachments DROP CONSTRAINT IF EXISTS ticket_attachments_ticket_id_ticket_created_at_fkey;
+ALTER TABLE attachment_uploads DROP CONSTRAINT IF EXISTS attachment_uploads_ticket_id_ticket_created_at_fkey;
+
+CREATE CONSTRAINT TRIGGER trg_ticket_history_ticket_exists
+  AFTER INSERT OR UPDATE OF ticket_id, ticket_created_at ON ticket_history
+  FOR EACH ROW EXECUTE FUNCTION fn_check_ticket_exists();
+CREATE CONSTRAINT TRIGGER trg_ticket_comments_ticket_exists
+  AFTER INSERT OR UPDATE OF ticket_id, ticket_created_at ON ticket_comments
+  FOR EACH ROW EXECUTE FUNCTION fn_check_ticket_exists();
+CREATE CONSTRAINT TRIGGER trg_ticket_attachments_ticket_exists
+  AFTER INSERT OR UPDATE OF ticket_id, ticket_created_at ON ticket_attachments
+  FOR EACH ROW EXECUTE FUNCTION fn_check_ticket_exists();
+CREATE CONSTRAINT TRIGGER trg_attachment_uploads_ticket_exists
+  AFTER INSERT OR UPDATE OF ticket_id, ticket_created_at ON attachment_uploads
+  FOR EACH ROW EXECUTE FUNCTION fn_check_ticket_exists();
+
+-- Until the API has run once, inserts dated 2027 would have no partition.
+CREATE TABLE IF NOT EXISTS tickets_2027 PARTITION OF tickets
+    FOR VALUES FROM ('2027-01-01') TO ('2028-01-01');
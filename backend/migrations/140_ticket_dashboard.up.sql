@@ -0,0 +1,103 @@
+-- Dashboard aggregates. Counts and daily throughput are maintained row by row by a
+-- trigger on tickets, so GET /dashboard reads a few hundred summary rows instead of
+-- scanning tickets. Ticket age changes with the clock rather than with writes, so
+-- the age buckets are a materialized view refreshed by the API on a timer.
+
+-- Live (not deleted) tickets per department, priority, status and assignee.
+CREATE TABLE ticket_summary (
+    department_id SMALLINT NOT NULL,
+    priority_id SMALLINT NOT NULL,
+    status_id SMALLINT NOT NULL,
+    assignee_id UUID,
+    ticket_count BIGINT NOT NULL DEFAULT 0,
+    UNIQUE NULLS NOT DISTINCT (department_id, priority_id, status_id, assignee_id)
+);
+
+-- Tickets created per UTC day, and tickets moved into the closed status that day.
+CREATE TABLE ticket_daily_stats (
+    day DATE PRIMARY KEY,
+    created_count BIGINT NOT NULL DEFAULT 0,
+    closed_count BIGINT NOT NULL DEFAULT 0
+);
+
+CREATE OR REPLACE FUNCTION fn_ticket_is_closed(status SMALLINT)
+RETURNS BOOLEAN AS $$
+  SELECT EXISTS (SELECT 1 FROM ticket_statuses WHERE status_id = status AND code = 'closed');
+$$ LANGUAGE sql STABLE;
+
+CREATE OR REPLACE FUNCTION fn_ticket_summary()
+RETURNS TRIGGER AS $$
+BEGIN
+  -- Most updates touch the title or description; they leave the counts alone.
+  IF TG_OP <> 'UPDATE'
+     OR (OLD.department_id, OLD.priority_id, OLD.status_id, OLD.assignee_id, OLD.deleted_at IS NULL)
+        IS DISTINCT FROM
+        (NEW.department_id, NEW.priority_id, NEW.status_id, NEW.assignee_id, NEW.deleted_at IS NULL) THEN
+    IF TG_OP <> 'INSERT' AND OLD.deleted_at IS NULL THEN
+      UPDATE ticket_summary SET ticket_count = ticket_count - 1
+       WHERE department_id = OLD.department_id AND priority_id = OLD.priority_id
+         AND status_id = OLD.status_id AND assignee_id IS NOT DISTINCT FROM OLD.assignee_id;
+    END IF;
+    IF TG_OP <> 'DELETE' AND NEW.deleted_at IS NULL THEN
+      INSERT INTO ticket_summary (department_id, priority_id, status_id, assignee_id, ticket_count)
+      VALUES (NEW.department_id, NEW.priority_id, NEW.status_id, NEW.assignee_id, 1)
+      ON CONFLICT (department_id, priority_id, status_id, assignee_id)
+      DO UPDATE SET ticket_count = ticket_summary.ticket_count + 1;
+    END IF;
+  END IF;
+
+  IF TG_OP = 'INSERT' THEN
+    INSERT INTO ticket_daily_stats (day, created_count)
+    VALUES ((NEW.created_at AT TIME ZONE 'UTC')::date, 1)
+    ON CONFLICT (day) DO UPDATE SET created_count = ticket_daily_stats.created_count + 1;
+  ELSIF TG_OP = 'UPDATE' AND NEW.status_id <> OLD.status_id AND NEW.deleted_at IS NULL
+        AND fn_ticket_is_closed(NEW.status_id) AND NOT fn_ticket_is_closed(OLD.status_id) THEN
+    INSERT INTO ticket_daily_stats (day, closed_count)
+    VALUES ((now() AT TIME ZONE 'UTC')::date, 1)
+    ON CONFLICT (day) DO UPDATE SET closed_count = ticket_daily_stats.closed_count + 1;
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+CREATE TRIGGER trg_tickets_summary
+  AFTER INSERT OR UPDATE OR DELETE ON tickets
+  FOR EACH ROW EXECUTE FUNCTION fn_ticket_summary();
+
+-- Backfill from the rows already there. Past closings are not recorded anywhere
+-- except ticket_history, so throughput starts with what the history shows.
+INSERT INTO ticket_summary (department_id, priority_id, status_id, assignee_id, ticket_count)
+SELECT department_id, priority_id, status_id, assignee_id, count(*)
+  FROM tickets
+ WHERE deleted_at IS NULL
+ GROUP BY department_id, priority_id, status_id, assignee_id;
+
+INSERT INTO ticket_daily_stats (day, created_count)
+SELECT (created_at AT TIME ZONE 'UTC')::date, count(*)
+  FROM tickets
+ GROUP BY 1;
+
+INSERT INTO ticket_daily_stats (day, closed_count)
+SELECT (h.changed_at AT TIME ZONE 'UTC')::date, count(*)
+  FROM ticket_history h
+  JOIN ticket_statuses st ON st.status_id::text = h.new_value
+ WHERE h.field_name = 'status' AND st.code = 'closed'
+ GROUP BY 1
+ON CONFLICT (day) DO UPDATE SET closed_count = EXCLUDED.closed_count;
+
+-- Open tickets per department by age. The unique index allows REFRESH ... CONCURRENTLY,
+-- so readers are not blocked while it runs.
+CREATE MATERIALIZED VIEW mv_ticket_age_buckets AS
+SELECT t.department_id,
+       CASE
+         WHEN t.created_at > now() - interval '1 day' THEN '0-1d'
+         WHEN t.created_at > now() - interval '7 days' THEN '1-7d'
+         WHEN t.created_at > now() - interval '30 days' THEN '7-30d'
+         ELSE '30d+'
+       END AS bucket,
+       count(*) AS ticket_count,
+       now() AS refreshed_at
+  FROM tickets t
+ WHERE t.deleted_at IS NULL AND NOT fn_ticket_is_closed(t.status_id)
+ GROUP BY 1, 2;
+CREATE UNIQUE INDEX idx_mv_ticket_age_buckets ON mv_ticket_age_buckets (department_id, bucket);
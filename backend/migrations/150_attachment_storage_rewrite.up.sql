@@ -0,0 +1,17 @@
+-- 070 set file_data to STORAGE EXTERNAL, which only applies to values written
+-- after it: rows stored before keep their compressed TOAST, and a range read of
+-- one of those still detoasts the whole value. Concatenating an empty bytea
+-- forces a fresh datum, which is re-toasted uncompressed under the new storage.
+-- pg_column_compression limits the rewrite to values that are still compressed.
+--
+-- The rewrite is not a change clients need to hear about, so the notify trigger
+-- is off while it runs. The table is locked for the duration; run this off-hours
+-- on large installations.
+ALTER TABLE ticket_attachments DISABLE TRIGGER trg_ticket_attachments_notify_change;
+
+UPDATE ticket_attachments
+SET file_data = file_data || ''::bytea
+WHERE file_data IS NOT NULL
+  AND pg_column_compression(file_data) IS NOT NULL;
+
+ALTER TABLE ticket_attachments ENABLE TRIGGER trg_ticket_attachments_notify_change;
@@ -0,0 +1,4 @@
+-- Set while a commit assembles an upload's chunks, so concurrent commits of the
+-- same upload do not both assemble it and create two attachments. A claim older
+-- than the API's claim TTL is from a commit that died and may be taken over.
+ALTER TABLE attachment_uploads ADD COLUMN committing_at TIMESTAMPTZ;
@@ -0,0 +1,7 @@
+-- updated_at is the delta sync cursor, compared with a watermark read from the
+-- database clock (X-Sync-Watermark on GET /tickets). Updates were already stamped
+-- with now(); inserts are now too, instead of carrying the API host's clock.
+DROP TRIGGER IF EXISTS trg_update_timestamp ON tickets;
+CREATE TRIGGER trg_update_timestamp
+  BEFORE INSERT OR UPDATE ON tickets
+  FOR EACH ROW EXECUTE FUNCTION fn_update_timestamp();
@@ -0,0 +1,8 @@
+-- Partitions the API's partition manager is moving into tickets_archive. A row is
+-- added before the partition is detached and deleted in the transaction that drops
+-- it, so a pass cut short by a crash is finished by a later one even after the
+-- partition has left pg_inherits (and with it the list of partitions).
+CREATE TABLE IF NOT EXISTS ticket_partition_archives (
+    name TEXT PRIMARY KEY,
+    started_at TIMESTAMPTZ NOT NULL DEFAULT now()
+);
@@ -0,0 +1,81 @@
+-- Migration 140's trigger updated the shared ticket_summary rows and today's
+-- ticket_daily_stats row in place, so every writing transaction held those row
+-- locks until it committed: a 1000-ticket batch stalled ticket creation for its
+-- whole length, and two batches touching the same groups in a different order
+-- could deadlock. The trigger now only appends delta rows, which lock nothing
+-- shared. The API folds them into the summary tables every few seconds
+-- (fn_fold_ticket_summary), and the dashboard adds the unfolded deltas when it reads.
+CREATE TABLE IF NOT EXISTS ticket_summary_deltas (
+    department_id SMALLINT NOT NULL,
+    priority_id SMALLINT NOT NULL,
+    status_id SMALLINT NOT NULL,
+    assignee_id UUID,
+    ticket_count BIGINT NOT NULL
+);
+
+CREATE TABLE IF NOT EXISTS ticket_daily_stats_deltas (
+    day DATE NOT NULL,
+    created_count BIGINT NOT NULL DEFAULT 0,
+    closed_count BIGINT NOT NULL DEFAULT 0
+);
+
+CREATE OR REPLACE FUNCTION fn_ticket_summary()
+RETURNS TRIGGER AS $$
+BEGIN
+  -- Most updates touch the title or description; they leave the counts alone.
+  IF TG_OP <> 'UPDATE'
+     OR (OLD.department_id, OLD.priority_id, OLD.status_id, OLD.assignee_id, OLD.deleted_at IS NULL)
+        IS DISTINCT FROM
+        (NEW.department_id, NEW.priority_id, NEW.status_id, NEW.assignee_id, NEW.deleted_at IS NULL) THEN
+    IF TG_OP <> 'INSERT' AND OLD.deleted_at IS NULL THEN
+      INSERT INTO ticket_summary_deltas (department_id, priority_id, status_id, assignee_id, ticket_count)
+      VALUES (OLD.department_id, OLD.priority_id, OLD.status_id, OLD.assignee_id, -1);
+    END IF;
+    IF TG_OP <> 'DELETE' AND NEW.deleted_at IS NULL THEN
+      INSERT INTO ticket_summary_deltas (department_id, priority_id, status_id, assignee_id, ticket_count)
+      VALUES (NEW.department_id, NEW.priority_id, NEW.status_id, NEW.assignee_id, 1);
+    END IF;
+  END IF;
+
+  IF TG_OP = 'INSERT' THEN
+    INSERT INTO ticket_daily_stats_deltas (day, created_count)
+    VALUES ((NEW.created_at AT TIME ZONE 'UTC')::date, 1);
+  ELSIF TG_OP = 'UPDATE' AND NEW.status_id <> OLD.status_id AND NEW.deleted_at IS NULL
+        AND fn_ticket_is_closed(NEW.status_id) AND NOT fn_ticket_is_closed(OLD.status_id) THEN
+    INSERT INTO ticket_daily_stats_deltas (day, closed_count)
+    VALUES ((now() AT TIME ZONE 'UTC')::date, 1);
+  END IF;
+  RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+-- Moves the committed deltas into the summary tables in one short transaction.
+-- Only one fold runs at a time, and it touches each summary row once, in key
+-- order, so folds neither wait on ticket writes nor deadlock with each other.
+CREATE OR REPLACE FUNCTION fn_fold_ticket_summary()
+RETURNS void AS $$
+BEGIN
+  IF NOT pg_try_advisory_xact_lock(hashtext('fn_fold_ticket_summary')) THEN
+    RETURN;
+  END IF;
+
+  WITH folded AS (DELETE FROM ticket_summary_deltas RETURNING *)
+  INSERT INTO ticket_summary (department_id, priority_id, status_id, assignee_id, ticket_count)
+  SELECT department_id, priority_id, status_id, assignee_id, sum(ticket_count)
+    FROM folded
+   GROUP BY department_id, priority_id, status_id, assignee_id
+   ORDER BY department_id, priority_id, status_id, assignee_id
+  ON CONFLICT (department_id, priority_id, status_id, assignee_id)
+  DO UPDATE SET ticket_count = ticket_summary.ticket_count + EXCLUDED.ticket_count;
+
+  WITH folded AS (DELETE FROM ticket_daily_stats_deltas RETURNING *)
+  INSERT INTO ticket_daily_stats (day, created_count, closed_count)
+  SELECT day, sum(created_count), sum(closed_count)
+    FROM folded
+   GROUP BY day
+   ORDER BY day
+  ON CONFLICT (day) DO UPDATE SET
+    created_count = ticket_daily_stats.created_count + EXCLUDED.created_count,
+    closed_count = ticket_daily_stats.closed_count + EXCLUDED.closed_count;
+END;
+$$ LANGUAGE plpgsql;
@@ -24,6 +24,10 @@ Config::Config() {
     if (m_apiBaseUrl.endsWith('/')) {
         m_apiBaseUrl.chop(1);
     }
+
+    QSettings settings(QCoreApplication::applicationDirPath() + "/config.ini", QSettings::IniFormat);
+    m_uploadMaxConcurrent = qMax(1, settings.value("upload/max_concurrent", 2).toInt());
+    m_viewCacheBytes = qint64(qMax(1, settings.value("cache/view_cache_mb", 32).toInt())) << 20;
 }
 
 QString Config::apiBaseUrl() const {
@@ -38,6 +42,27 @@ QString Config::fullApiUrl() const {
     return m_apiBaseUrl + "/api/" + m_apiVersion;
 }
 
+int Config::uploadMaxConcurrent() const {
+    return m_uploadMaxConcurrent;
+}
+
+qint64 Config::viewCacheBytes() const {
+    return m_viewCacheBytes;
+}
+
+ImageUploadSettings Config::imageUploadSettings(int departmentId) const {
+    QSettings settings(QCoreApplication::applicationDirPath() + "/config.ini", QSettings::IniFormat);
+    ImageUploadSettings result;
+    for (const QString &group : {QString("upload"), QString("upload_department_%1").arg(departmentId)}) {
+        settings.beginGroup(group);
+        result.optimize = settings.value("optimize_images", result.optimize).toBool();
+        result.maxDimension = qMax(64, settings.value("max_image_dimension", result.maxDimension).toInt());
+        result.quality = qBound(1, settings.value("image_quality", result.quality).toInt(), 100);
+        settings.endGroup();
+    }
+    return result;
+}
+
 void Config::setApiBaseUrl(const QString& url) {
     m_apiBaseUrl = url;
     if (m_apiBaseUrl.endsWith('/')) {
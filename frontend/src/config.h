@@ -2,6 +2,13 @@
 #include <QString>
 #include <QObject>
 
+// Optional downscaling and recompression of images before they are uploaded.
+struct ImageUploadSettings {
+    bool optimize = false;
+    int maxDimension = 2560;
+    int quality = 85;
+};
+
 class Config : public QObject {
     Q_OBJECT
 public:
@@ -10,6 +17,12 @@ public:
     QString apiBaseUrl() const;
     QString apiVersion() const;
     QString fullApiUrl() const;
+    // How many files an upload queue sends at the same time.
+    int uploadMaxConcurrent() const;
+    // [upload] defaults, overridden per department by [upload_department_<id>].
+    ImageUploadSettings imageUploadSettings(int departmentId) const;
+    // Memory budget for decoded ticket lists of recently shown views ([cache] view_cache_mb).
+    qint64 viewCacheBytes() const;
     
     void setApiBaseUrl(const QString& url);
     
@@ -21,4 +34,6 @@ private:
     
     QString m_apiBaseUrl;
     QString m_apiVersion;
+    int m_uploadMaxConcurrent = 2;
+    qint64 m_viewCacheBytes = 32 << 20;
 }; 
\ No newline at end of file
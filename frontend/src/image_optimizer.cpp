@@ -0,0 +1,78 @@
+#include "image_optimizer.h"
+#include <QImageReader>
+#include <QImageWriter>
+#include <QImage>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QUuid>
+#include <QDebug>
+
+static bool hasTransparentPixels(const QImage &image) {
+    if (!image.hasAlphaChannel()) return false;
+    const QImage argb = image.convertToFormat(QImage::Format_ARGB32);
+    for (int y = 0; y < argb.height(); ++y) {
+        const QRgb *line = reinterpret_cast<const QRgb *>(argb.constScanLine(y));
+        for (int x = 0; x < argb.width(); ++x) {
+            if (qAlpha(line[x]) != 255) return true;
+        }
+    }
+    return false;
+}
+
+OptimizedImage optimizeImageForUpload(const QString &path, const ImageUploadSettings &settings, const QString &tempDir) {
+    QFileInfo info(path);
+    OptimizedImage result;
+    result.path = path;
+    result.uploadName = info.fileName();
+    result.originalBytes = info.size();
+    result.optimizedBytes = result.originalBytes;
+    if (!settings.optimize) return result;
+
+    QImageReader reader(path);
+    const QByteArray format = reader.format().toLower();
+    if (!reader.canRead() || format == "gif" || reader.imageCount() > 1) return result;
+    reader.setAutoTransform(true);
+    QSize size = reader.size();
+    if (size.isValid() && qMax(size.width(), size.height()) > settings.maxDimension) {
+        // Let the decoder scale (JPEG does it while decoding), so the full image is never held.
+        reader.setScaledSize(size.scaled(settings.maxDimension, settings.maxDimension, Qt::KeepAspectRatio));
+    }
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Cannot decode" << path << "for optimization:" << reader.errorString();
+        return result;
+    }
+    if (qMax(image.width(), image.height()) > settings.maxDimension) {
+        image = image.scaled(settings.maxDimension, settings.maxDimension, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    const bool transparent = hasTransparentPixels(image);
+    const QByteArray outFormat = transparent ? "png" : "jpg";
+    if (!transparent && image.hasAlphaChannel()) image = image.convertToFormat(QImage::Format_RGB32);
+    QDir().mkpath(tempDir);
+    const QString outPath = QDir(tempDir).filePath(QUuid::createUuid().toString(QUuid::WithoutBraces) + "." + outFormat);
+    QImageWriter writer(outPath, outFormat);
+    if (!transparent) {
+        writer.setQuality(settings.quality);
+        writer.setOptimizedWrite(true);
+        writer.setProgressiveScanWrite(true);
+    } else {
+        writer.setCompression(9);
+    }
+    if (!writer.write(image)) {
+        qWarning() << "Cannot write optimized image" << outPath << ":" << writer.errorString();
+        QFile::remove(outPath);
+        return result;
+    }
+    const qint64 optimizedBytes = QFileInfo(outPath).size();
+    if (optimizedBytes >= result.originalBytes) {
+        QFile::remove(outPath);
+        return result;
+    }
+    result.path = outPath;
+    result.uploadName = info.completeBaseName() + "." + outFormat;
+    result.optimizedBytes = optimizedBytes;
+    result.optimized = true;
+    return result;
+}
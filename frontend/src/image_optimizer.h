@@ -0,0 +1,17 @@
+#pragma once
+#include <QString>
+#include "config.h"
+
+struct OptimizedImage {
+    QString path;           // file to upload: the original or a temporary re-encoded copy
+    QString uploadName;     // file name to store on the server
+    qint64 originalBytes = 0;
+    qint64 optimizedBytes = 0;
+    bool optimized = false; // false when the file is not an image or re-encoding did not help
+};
+
+// Decodes the image at path, downscales it to settings.maxDimension and re-encodes it
+// (JPEG at settings.quality, or PNG when it has transparency) into tempDir. Files that
+// are not still images, or that would not get smaller, are passed through untouched.
+// Blocking; run it on a worker thread.
+OptimizedImage optimizeImageForUpload(const QString &path, const ImageUploadSettings &settings, const QString &tempDir);
@@ -5,8 +5,17 @@
 #include "views/ticket_dialog.h"
 #include "config.h"
 #include "ticket_table_view.h"
+#include "network/download_manager.h"
+#include "models/user_directory.h"
+#include "views/bulk_edit_dialog.h"
+#include "network/event_stream.h"
+#include "models/local_replica.h"
+#include "models/view_snapshot.h"
+#include "network/mutation_journal.h"
+#include "views/dashboard_view.h"
 
 #include <QSplitter>
+#include <QTabWidget>
 #include <QTreeView>
 #include <QStandardItemModel>
 #include <QHeaderView>
@@ -29,15 +38,48 @@
 #include <QDebug>
 #include <QVBoxLayout>
 #include <QWidget>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QDir>
+#include <QStandardPaths>
+#include <QElapsedTimer>
+#include <QSignalBlocker>
+#include <algorithm>
 
 QNetworkAccessManager *networkManager = nullptr;
 
 const int FilterTypeRole = Qt::UserRole + 1;
 const int FilterValueRole = Qt::UserRole + 2;
 
+namespace {
+
+// The archive can hold years of tickets; it is listed a page at a time.
+const int ArchivePageSize = 200;
+
+// Orders archived rows like LocalReplica orders the replica's rows for the same
+// column (ties and the unsorted view fall back to newest first).
+void sortArchived(QVector<TicketItem> &rows, int column, Qt::SortOrder order) {
+    std::stable_sort(rows.begin(), rows.end(), [column, order](const TicketItem &a, const TicketItem &b) {
+        int cmp = 0;
+        switch (column) {
+        case 0: cmp = QString::compare(a.id, b.id); break;
+        case 1: cmp = QString::compare(a.title, b.title, Qt::CaseInsensitive); break;
+        case 2: cmp = a.statusId - b.statusId; break;
+        case 3: cmp = a.priorityId - b.priorityId; break;
+        case 4: cmp = a.departmentId - b.departmentId; break;
+        case 5: cmp = QString::compare(a.assignee, b.assignee, Qt::CaseInsensitive); break;
+        case 6: cmp = a.createdAt < b.createdAt ? -1 : (b.createdAt < a.createdAt ? 1 : 0); break;
+        case 7: cmp = a.updatedAt < b.updatedAt ? -1 : (b.updatedAt < a.updatedAt ? 1 : 0); break;
+        }
+        if (cmp != 0) return order == Qt::DescendingOrder ? cmp > 0 : cmp < 0;
+        return b.createdAt < a.createdAt;
+    });
+}
+
+} // namespace
 
 MainWindow::MainWindow(const QString &jwt, QWidget *parent)
-    : QMainWindow(parent), jwtToken(jwt)
+    : QMainWindow(parent), jwtToken(jwt), m_viewCache(Config::instance().viewCacheBytes())
 {
     QStringList parts = jwtToken.split('.');
     if (parts.size() >= 2) {
@@ -51,11 +93,86 @@ MainWindow::MainWindow(const QString &jwt, QWidget *parent)
     
     apiBaseUrl = Config::instance().fullApiUrl();
     networkManager = new QNetworkAccessManager(this);
+    m_downloads = new DownloadManager(jwtToken, this);
+    m_events = new EventStream(jwtToken, this);
+    connect(m_events, &EventStream::ticketsChanged, this, &MainWindow::applyRemoteChanges);
+    connect(m_events, &EventStream::resyncNeeded, this, &MainWindow::syncTickets);
+
+    m_journal = new MutationJournal(dataPath("journal-%1.jsonl"), jwtToken, this);
+    connect(m_journal, &MutationJournal::succeeded, this, &MainWindow::onJournalSucceeded);
+    connect(m_journal, &MutationJournal::failed, this, &MainWindow::onJournalFailed);
+    // The event stream coming back is the first sign the network is back.
+    connect(m_events, &EventStream::resyncNeeded, m_journal, &MutationJournal::retryNow);
+
+    m_replica = new LocalReplica(this);
+    connect(m_replica, &LocalReplica::opened, this, [this](int, const QString &watermark) {
+        m_replicaWatermark = watermark;
+    });
+    connect(m_replica, &LocalReplica::failed, this, [this]() {
+        // Whatever the replica holds now is suspect; the next sync reloads everything.
+        m_replicaWatermark.clear();
+    });
+    connect(m_replica, &LocalReplica::queryFinished, this, [this](int requestId, const QVector<TicketItem> &tickets) {
+        if (requestId != m_viewRequest) return;
+        m_hotRows = tickets;
+        showRows();
+    });
+    connect(m_replica, &LocalReplica::dictionaryLoaded, this, [this](const QString &kind, const QJsonArray &items) {
+        applyDictionary(kind, items);
+        onInitialDataLoaded();
+    });
+    connect(&UserDirectory::instance(), &UserDirectory::loaded, this, [this]() {
+        const UserDirectory &directory = UserDirectory::instance();
+        const UserDirectory::Range all = directory.find(QString(), 0);
+        QVector<UserInfo> users;
+        users.reserve(all.size());
+        for (int i = 0; i < all.size(); ++i) users.append(directory.at(all, i));
+        m_replica->storeUsers(users);
+    });
+    m_replica->open(dataPath("replica-%1.sqlite"), apiBaseUrl);
 
     setupUi();
+    restoreSnapshot();
     loadDictionaries();
 }
 
+// Per-user file in the application data directory; %1 is replaced by the user id.
+QString MainWindow::dataPath(const QString &pattern) const {
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/" + pattern.arg(userId.isEmpty() ? QString("default") : userId);
+}
+
+// Shows the view saved on the last close, greyed out, until the first replica query
+// replaces it.
+void MainWindow::restoreSnapshot() {
+    QElapsedTimer timer;
+    timer.start();
+    ViewSnapshot snapshot;
+    if (!ViewSnapshot::load(dataPath("view-%1.snapshot"), &snapshot)) return;
+
+    for (const QString &key : {QStringLiteral("department_id"), QStringLiteral("q")}) {
+        if (snapshot.query.contains(key)) m_currentQueryItems.insert(key, snapshot.query.value(key));
+    }
+    if (snapshot.query.value("assignee_id") == userId && !userId.isEmpty()) {
+        m_currentQueryItems.insert("assignee_id", userId);
+        m_filterView->setCurrentIndex(m_filterModel->index(1, 0));
+        setWindowTitle("Ticket System - My Tickets");
+    }
+    m_searchEdit->setText(m_currentQueryItems.value("q"));
+    m_sortColumn = snapshot.sortColumn;
+    m_sortOrder = snapshot.sortOrder;
+    {
+        const QSignalBlocker blocker(m_tableView->horizontalHeader());
+        m_tableView->horizontalHeader()->setSortIndicator(m_sortColumn, m_sortOrder);
+    }
+    m_ticketModel->setTickets(snapshot.tickets);
+    m_ticketModel->setStale(true);
+    m_tableView->resizeColumnsToContents();
+    m_statusBar->showMessage(QString("Showing %1 tickets from the last session, updating...").arg(snapshot.tickets.size()));
+    qDebug() << "View snapshot restored:" << snapshot.tickets.size() << "tickets in" << timer.elapsed() << "ms";
+}
+
 void MainWindow::setupUi() {
     setWindowTitle("Ticket System");
     
@@ -72,7 +189,17 @@ void MainWindow::setupUi() {
     m_addAction = m_toolBar->addAction("➕ Add");
     m_editAction = m_toolBar->addAction("✏️ Edit");
     m_deleteAction = m_toolBar->addAction("🗑️ Delete");
+    m_bulkEditAction = m_toolBar->addAction("🗂️ Bulk edit");
+    m_bulkEditAction->setToolTip("Change status, priority or assignee of the selected tickets");
     m_refreshAction = m_toolBar->addAction("🔄 Refresh");
+    m_exportAttachmentsAction = m_toolBar->addAction("📦 Export attachments");
+    m_exportAttachmentsAction->setToolTip("Download the attachments of the selected tickets as one zip");
+    m_includeArchiveAction = m_toolBar->addAction("🗄️ Include archive");
+    m_includeArchiveAction->setCheckable(true);
+    m_includeArchiveAction->setToolTip("Also list archived tickets (older than the server's hot window, read-only)");
+    m_moreArchiveAction = m_toolBar->addAction("⏬ More archived");
+    m_moreArchiveAction->setToolTip(QString("List the next %1 archived tickets").arg(ArchivePageSize));
+    m_moreArchiveAction->setEnabled(false);
     m_toolBar->addSeparator();
 
     m_searchEdit = new QLineEdit(this);
@@ -83,9 +210,16 @@ void MainWindow::setupUi() {
     m_searchButton = new QPushButton("Search", this);
     m_toolBar->addWidget(m_searchButton);
 
-    // --- Main Layout (Splitter) ---
-    m_splitter = new QSplitter(Qt::Horizontal, this);
-    setCentralWidget(m_splitter);
+    // --- Main Layout (Tickets and Dashboard tabs) ---
+    m_tabs = new QTabWidget(this);
+    setCentralWidget(m_tabs);
+    m_splitter = new QSplitter(Qt::Horizontal, m_tabs);
+    m_tabs->addTab(m_splitter, "Tickets");
+    // Refetched on ticket change events, so it follows edits without polling lists.
+    m_dashboard = new DashboardView(jwtToken, m_tabs);
+    m_tabs->addTab(m_dashboard, "Dashboard");
+    connect(m_events, &EventStream::ticketsChanged, m_dashboard, &DashboardView::invalidate);
+    connect(m_events, &EventStream::resyncNeeded, m_dashboard, &DashboardView::invalidate);
 
     // --- Left Panel (Filters) ---
     m_filterView = new QTreeView(m_splitter);
@@ -113,7 +247,7 @@ void MainWindow::setupUi() {
     m_ticketModel = new TicketModel(this);
     m_tableView->setModel(m_ticketModel);
     m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
     m_tableView->horizontalHeader()->setStretchLastSection(true);
     m_tableView->setAlternatingRowColors(true);
     m_tableView->verticalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
@@ -121,7 +255,7 @@ void MainWindow::setupUi() {
     m_tableView->setStyleSheet("QTableView { gridline-color: #e0e0e0; font-size: 13px } QHeaderView::section { font-weight: bold; font-size: 14px; text-align: center; }");
     m_tableView->horizontalHeader()->setDefaultAlignment(Qt::AlignCenter);
     m_tableView->setWordWrap(false);
-    m_tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_tableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
     m_tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_tableView->setContentsMargins(8, 4, 8, 4);
     m_tableView->verticalHeader()->setDefaultSectionSize(36);
@@ -131,6 +265,10 @@ void MainWindow::setupUi() {
     m_tableView->setItemDelegateForColumn(3, new TicketPriorityDelegate(this));
     m_tableView->setColumnHidden(6, true);
     m_tableView->setColumnHidden(0, true);
+    // Sorting is an ORDER BY on the local replica; no indicator means newest first.
+    m_tableView->horizontalHeader()->setSectionsClickable(true);
+    m_tableView->horizontalHeader()->setSortIndicatorShown(true);
+    m_tableView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
 
     QWidget *tableViewContainer = new QWidget(this);
     QVBoxLayout *tableViewLayout = new QVBoxLayout(tableViewContainer);
@@ -145,12 +283,43 @@ void MainWindow::setupUi() {
     m_statusBar = new QStatusBar(this);
     setStatusBar(m_statusBar);
     m_statusBar->showMessage("Ready");
+    m_cacheLabel = new QLabel(this);
+    m_cacheLabel->setToolTip("Ticket lists of recently shown views kept in memory");
+    m_statusBar->addPermanentWidget(m_cacheLabel);
+    m_journalLabel = new QLabel(this);
+    m_statusBar->addPermanentWidget(m_journalLabel);
+    m_journalLabel->hide();
+    connect(m_journal, &MutationJournal::stateChanged, this, [this](int pending, bool online) {
+        m_journalLabel->setVisible(pending > 0 || !online);
+        if (m_journal->isAuthExpired()) {
+            m_journalLabel->setText(QString("Session expired - %1 changes queued").arg(pending));
+        } else if (!online) {
+            m_journalLabel->setText(QString("Offline - %1 changes queued").arg(pending));
+        } else {
+            m_journalLabel->setText(QString("Saving %1 changes...").arg(pending));
+        }
+    });
+    connect(m_journal, &MutationJournal::authExpired, this, [this]() {
+        QMessageBox::warning(this, "Session expired",
+            QString("Your session has expired. %1 changes are saved locally and will be sent "
+                    "after you restart the application and log in again.").arg(m_journal->pendingCount()));
+    });
     
     // --- Connections ---
     connect(m_addAction, &QAction::triggered, this, &MainWindow::onAddTicket);
     connect(m_editAction, &QAction::triggered, this, &MainWindow::onEditTicket);
     connect(m_deleteAction, &QAction::triggered, this, &MainWindow::onDeleteTicket);
-    connect(m_refreshAction, &QAction::triggered, this, &MainWindow::loadTickets);
+    connect(m_bulkEditAction, &QAction::triggered, this, &MainWindow::onBulkEdit);
+    connect(m_refreshAction, &QAction::triggered, this, &MainWindow::syncTickets);
+    connect(m_tableView->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this,
+            [this](int column, Qt::SortOrder order) {
+        m_sortColumn = column;
+        m_sortOrder = order;
+        showView();
+    });
+    connect(m_exportAttachmentsAction, &QAction::triggered, this, &MainWindow::onExportAttachments);
+    connect(m_includeArchiveAction, &QAction::toggled, this, &MainWindow::showView);
+    connect(m_moreArchiveAction, &QAction::triggered, this, [this]() { fetchArchive(m_archivedRows.size()); });
     connect(m_searchButton, &QPushButton::clicked, this, &MainWindow::onSearchTriggered);
     connect(m_searchEdit, &QLineEdit::returnPressed, this, &MainWindow::onSearchTriggered);
     connect(m_filterView, &QTreeView::clicked, this, &MainWindow::onFilterChanged);
@@ -161,53 +330,34 @@ void MainWindow::setupUi() {
 void MainWindow::loadDictionaries() {
     m_statusBar->showMessage("Loading initial data...");
 
-    // Statuses
-    QNetworkRequest statusReq(QUrl(apiBaseUrl + "/ticket_statuses"));
-    QNetworkReply *statusReply = networkManager->get(statusReq);
-    connect(statusReply, &QNetworkReply::finished, this, [this, statusReply](){
-        if (statusReply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(statusReply->readAll());
-            if (doc.isArray()) {
-                for (const QJsonValue &v : doc.array()) {
-                    QJsonObject o = v.toObject();
-                    TicketItem::statusLabels[o.value("id").toInt()] = o.value("label").toString();
-                }
+    for (const QString &kind : {QStringLiteral("ticket_statuses"), QStringLiteral("ticket_priorities"), QStringLiteral("departments")}) {
+        QNetworkReply *reply = networkManager->get(QNetworkRequest(QUrl(apiBaseUrl + "/" + kind)));
+        connect(reply, &QNetworkReply::finished, this, [this, reply, kind]() {
+            reply->deleteLater();
+            const QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+            if (reply->error() == QNetworkReply::NoError && doc.isArray()) {
+                m_replica->storeDictionary(kind, doc.array());
+                applyDictionary(kind, doc.array());
+                onInitialDataLoaded();
+            } else {
+                // Use the copy from the last session; dictionaryLoaded completes this step.
+                qWarning() << "Loading" << kind << "failed, using the local copy:" << reply->errorString();
+                m_replica->loadDictionary(kind);
             }
-        } else { handleNetworkError(statusReply, "ticket statuses"); }
-        onInitialDataLoaded();
-        statusReply->deleteLater();
-    });
+        });
+    }
+}
 
-    // Priorities
-    QNetworkRequest prioReq(QUrl(apiBaseUrl + "/ticket_priorities"));
-    QNetworkReply *prioReply = networkManager->get(prioReq);
-    connect(prioReply, &QNetworkReply::finished, this, [this, prioReply](){
-        if (prioReply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(prioReply->readAll());
-             if (doc.isArray()) {
-                for (const QJsonValue &v : doc.array()) {
-                    QJsonObject o = v.toObject();
-                    TicketItem::priorityLabels[o.value("id").toInt()] = o.value("label").toString();
-                }
-            }
-        } else { handleNetworkError(prioReply, "ticket priorities"); }
-        onInitialDataLoaded();
-        prioReply->deleteLater();
-    });
-    
-    // Departments
-    QNetworkRequest depReq(QUrl(apiBaseUrl + "/departments"));
-    QNetworkReply *depReply = networkManager->get(depReq);
-    connect(depReply, &QNetworkReply::finished, this, [this, depReply](){
-        if (depReply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(depReply->readAll());
-            if (doc.isArray()) {
-                populateDepartments(doc.array());
-            }
-        } else { handleNetworkError(depReply, "departments"); }
-        onInitialDataLoaded();
-        depReply->deleteLater();
-    });
+void MainWindow::applyDictionary(const QString &kind, const QJsonArray &items) {
+    if (kind == "departments") {
+        populateDepartments(items);
+        return;
+    }
+    QMap<int, QString> &labels = kind == "ticket_statuses" ? TicketItem::statusLabels : TicketItem::priorityLabels;
+    for (const QJsonValue &v : items) {
+        QJsonObject o = v.toObject();
+        labels[o.value("id").toInt()] = o.value("label").toString();
+    }
 }
 
 void MainWindow::populateDepartments(const QJsonArray &departments) {
@@ -224,6 +374,12 @@ void MainWindow::populateDepartments(const QJsonArray &departments) {
             item->setData("department", FilterTypeRole);
             item->setData(id, FilterValueRole);
             departmentsItem->appendRow(item);
+            // The department view restored from the snapshot.
+            if (m_currentQueryItems.value("department_id").toInt() == id) {
+                m_filterView->expand(departmentsItem->index());
+                m_filterView->setCurrentIndex(item->index());
+                setWindowTitle(QString("Ticket System - %1").arg(name));
+            }
         }
     }
 }
@@ -232,50 +388,185 @@ void MainWindow::onInitialDataLoaded() {
     m_dictionariesToLoad--;
     if (m_dictionariesToLoad == 0) {
         m_statusBar->showMessage("Ready");
-        loadTickets();
+        // Show the local copy right away, then bring it up to date.
+        showView();
+        syncTickets();
+        m_events->start();
+        UserDirectory::instance().ensureLoaded();
     }
 }
 
-void MainWindow::loadTickets() {
+// Brings the local replica up to date: a full load the first time, after that only
+// the tickets changed since the last watermark. The table is then re-queried locally.
+void MainWindow::syncTickets() {
     if (userId.isEmpty()) {
         QMessageBox::warning(this, "Error", "User ID is not available. Please re-login.");
         return;
     }
-    m_statusBar->showMessage("Loading tickets...");
+    if (m_syncing) return;
+    m_syncing = true;
 
     QUrl url(apiBaseUrl + "/tickets");
-    QUrlQuery query;
-
-    for (auto it = m_currentQueryItems.constBegin(); it != m_currentQueryItems.constEnd(); ++it) {
-        query.addQueryItem(it.key(), it.value());
+    const QString since = m_replicaWatermark;
+    if (!since.isEmpty()) {
+        QUrlQuery query;
+        query.addQueryItem("updated_since", since);
+        url.setQuery(query);
     }
-
-    url.setQuery(query);
+    m_statusBar->showMessage(since.isEmpty() ? "Loading tickets..." : "Checking for changes...");
 
     QNetworkRequest req(url);
     req.setRawHeader("Authorization", "Bearer " + jwtToken.toUtf8());
     QNetworkReply *reply = networkManager->get(req);
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            if (doc.isArray()) {
-                m_ticketModel->loadTickets(doc.array());
-                m_statusBar->showMessage(QString("Loaded %1 tickets").arg(m_ticketModel->rowCount()));
-                m_tableView->resizeColumnsToContents();
-                m_tableView->viewport()->update();
-                m_tableView->update();
+    connect(reply, &QNetworkReply::finished, this, [this, reply, since]() {
+        reply->deleteLater();
+        m_syncing = false;
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Ticket sync failed:" << reply->errorString();
+            m_statusBar->showMessage(QString("Server unreachable, showing the local copy (%1 tickets)")
+                                         .arg(m_ticketModel->rowCount()));
+            return;
+        }
+        const QString watermark = QString::fromUtf8(reply->rawHeader("X-Sync-Watermark"));
+        const QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+        if (!doc.isArray()) {
+            qDebug() << "Invalid JSON response for tickets:" << doc;
+            m_statusBar->showMessage("Error: Invalid response from server.");
+            return;
+        }
+
+        // Without a filter, a tombstone ({ticket_id, deleted: true}) means the ticket is gone.
+        QVector<TicketItem> live;
+        QStringList gone;
+        for (const QJsonValue &v : doc.array()) {
+            const QJsonObject obj = v.toObject();
+            if (obj.value("deleted").toBool()) {
+                gone.append(obj.value("ticket_id").toString());
             } else {
-                qDebug() << "Invalid JSON response for tickets:" << doc;
-                m_statusBar->showMessage("Error: Invalid response from server.");
+                live.append(TicketItem::fromJson(obj));
             }
+        }
+        if (since.isEmpty()) {
+            m_replica->replaceTickets(live, watermark);
         } else {
-            handleNetworkError(reply, "loading tickets");
+            m_replica->applyTickets(live, gone, watermark);
         }
+        if (!watermark.isEmpty()) m_replicaWatermark = watermark;
+        m_statusBar->showMessage(since.isEmpty() ? QString("Loaded %1 tickets").arg(live.size())
+                                                 : QString("%1 changes applied").arg(live.size() + gone.size()));
+        showView();
+    });
+}
+
+// Fills the table from the local replica for the current filter, search and sort.
+void MainWindow::showView() {
+    ReplicaQuery query;
+    query.assigneeId = m_currentQueryItems.value("assignee_id");
+    query.departmentId = m_currentQueryItems.value("department_id").toInt();
+    query.text = m_currentQueryItems.value("q");
+    query.sortColumn = m_sortColumn;
+    query.sortOrder = m_sortOrder;
+
+    // On a hit the cached rows are shown at once and the query below revalidates them.
+    const bool includeArchive = m_includeArchiveAction->isChecked();
+    const QString key = ViewCache::key(query) + (includeArchive ? "|archive" : "");
+    if (key != m_viewKey) {
+        if (!m_viewKey.isEmpty() && m_modelKey == m_viewKey && !m_ticketModel->isStale())
+            m_viewCache.insert(m_viewKey, m_ticketModel->tickets());
+        m_hotRows.clear();
+        m_archivedRows.clear();
+        if (const QVector<TicketItem> *cached = m_viewCache.find(key)) {
+            m_ticketModel->mergeTickets(*cached);
+            m_modelKey = key;
+            for (const TicketItem &t : *cached) {
+                if (t.archived) m_archivedRows.append(t);
+                else m_hotRows.append(t);
+            }
+        }
+        m_viewKey = key;
+        m_cacheLabel->setText(QString("View cache: %1 hits, %2 misses, %3 KB")
+            .arg(m_viewCache.hits()).arg(m_viewCache.misses()).arg(m_viewCache.usedBytes() / 1024));
+        // The archive only changes when the server moves a partition, so it is
+        // fetched once per view rather than on every sync.
+        ++m_archiveRequest;
+        m_moreArchiveAction->setEnabled(false);
+        if (includeArchive) fetchArchive();
+    }
+    m_viewRequest = m_replica->query(query);
+}
+
+// Asks the server for a page of the archived tickets matching the current filter
+// and search, newest first.
+void MainWindow::fetchArchive(int offset) {
+    m_moreArchiveAction->setEnabled(false);
+    QUrl url(apiBaseUrl + "/tickets");
+    QUrlQuery query;
+    query.addQueryItem("archived", "true");
+    query.addQueryItem("limit", QString::number(ArchivePageSize));
+    if (offset > 0) query.addQueryItem("offset", QString::number(offset));
+    for (const QString &key : {QString("assignee_id"), QString("department_id"), QString("q")}) {
+        if (m_currentQueryItems.contains(key)) query.addQueryItem(key, m_currentQueryItems.value(key));
+    }
+    url.setQuery(query);
+
+    QNetworkRequest req(url);
+    req.setRawHeader("Authorization", "Bearer " + jwtToken.toUtf8());
+    QNetworkReply *reply = networkManager->get(req);
+    const int requestId = m_archiveRequest;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, requestId, offset]() {
         reply->deleteLater();
+        if (requestId != m_archiveRequest) return;
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Archive fetch failed:" << reply->errorString();
+            m_statusBar->showMessage("Archive unavailable, showing current tickets only");
+            m_moreArchiveAction->setEnabled(offset > 0);
+            return;
+        }
+        if (offset == 0) m_archivedRows.clear();
+        const QJsonArray page = QJsonDocument::fromJson(reply->readAll()).array();
+        for (const QJsonValue &v : page) {
+            TicketItem t = TicketItem::fromJson(v.toObject());
+            t.archived = true;
+            m_archivedRows.append(t);
+        }
+        m_moreArchiveAction->setEnabled(page.size() >= ArchivePageSize);
+        sortArchived(m_archivedRows, m_sortColumn, m_sortOrder);
+        // Before the replica has answered for this view there are no hot rows to
+        // show them with; its answer picks the archived rows up.
+        if (m_modelKey == m_viewKey) showRows();
     });
 }
 
+// Puts the replica's rows, followed by any archived ones, into the table and the cache.
+void MainWindow::showRows() {
+    QVector<TicketItem> rows = m_hotRows;
+    rows += m_archivedRows;
+    const bool first = m_ticketModel->isStale() || m_ticketModel->rowCount() == 0;
+    m_viewCache.insert(m_viewKey, rows);
+    m_ticketModel->mergeTickets(rows);
+    m_modelKey = m_viewKey;
+    if (first) m_tableView->resizeColumnsToContents();
+    if (m_syncing) return;
+    if (m_archivedRows.isEmpty()) {
+        m_statusBar->showMessage(QString("%1 tickets").arg(rows.size()));
+    } else {
+        m_statusBar->showMessage(QString("%1 tickets, %2 of them archived%3").arg(rows.size()).arg(m_archivedRows.size())
+                                     .arg(m_moreArchiveAction->isEnabled() ? " (more in the archive)" : ""));
+    }
+}
+
+// Archived tickets cannot be changed; says so and returns true if any are selected.
+bool MainWindow::refuseArchived(const QVector<TicketItem> &tickets) {
+    for (const TicketItem &t : tickets) {
+        if (t.archived) {
+            QMessageBox::information(this, "Info", "Archived tickets are read-only");
+            return true;
+        }
+    }
+    return false;
+}
+
 void MainWindow::onFilterChanged(const QModelIndex &index) {
     if (!index.isValid()) return;
 
@@ -298,7 +589,7 @@ void MainWindow::onFilterChanged(const QModelIndex &index) {
         return;
     }
 
-    loadTickets();
+    showView();
 }
 
 void MainWindow::onSearchTriggered() {
@@ -308,17 +599,135 @@ void MainWindow::onSearchTriggered() {
     } else {
         m_currentQueryItems.remove("q");
     }
-    loadTickets();
+    showView();
 }
 
 
 void MainWindow::onAddTicket() {
     TicketItem t;
     TicketDialog dlg(t, jwtToken, this, TicketDialog::Create);
-    connect(&dlg, &TicketDialog::ticketSaved, this, &MainWindow::loadTickets);
+    connectTicketDialog(&dlg);
     dlg.exec();
 }
 
+void MainWindow::connectTicketDialog(TicketDialog *dlg) {
+    dlg->setEventStream(m_events);
+    dlg->setJournal(m_journal);
+    connect(dlg, &TicketDialog::ticketChangePending, this, &MainWindow::applyTicket);
+}
+
+void MainWindow::onJournalSucceeded(const JournalEntry &entry, const QJsonObject &response) {
+    if (entry.kind == "create_ticket" || entry.kind == "patch_ticket") {
+        // Later queued edits of the same ticket are already on screen; the server's
+        // copy is applied once the last of them is through.
+        if (!m_journal->hasPending(entry.ticketId)) {
+            TicketItem saved = TicketItem::fromJson(response);
+            if (!saved.id.isEmpty()) applyTicket(saved);
+        }
+        m_statusBar->showMessage("Ticket saved");
+    } else if (entry.kind == "delete_ticket") {
+        m_statusBar->showMessage("Ticket deleted");
+    }
+}
+
+// A queued write was refused. The row is brought back to the server's state and the
+// user is told which change was lost, without blocking the window.
+void MainWindow::onJournalFailed(const JournalEntry &entry, const QString &error) {
+    QString what;
+    if (entry.kind == "create_ticket") {
+        what = QString("Creating ticket \"%1\"").arg(entry.body.value("title").toString());
+    } else if (entry.kind == "patch_ticket") {
+        what = "Saving changes to a ticket";
+    } else if (entry.kind == "delete_ticket") {
+        what = "Deleting a ticket";
+    } else if (entry.kind == "add_comment") {
+        what = "Posting a comment";
+    } else {
+        what = entry.kind;
+    }
+    if (entry.kind != "add_comment" && !entry.ticketId.isEmpty()) {
+        // A create carries the creation time in its body, edits and deletes in the path.
+        QString createdAt = entry.body.value("created_at").toString();
+        if (createdAt.isEmpty()) createdAt = QUrlQuery(QUrl(entry.path)).queryItemValue("ticket_created_at", QUrl::FullyDecoded);
+        refreshTicket(entry.ticketId, createdAt);
+    }
+
+    QMessageBox *box = new QMessageBox(QMessageBox::Warning, "Change not saved",
+        QString("%1 failed (queued %2):\n%3").arg(what, entry.queuedAt.toLocalTime().toString("HH:mm:ss"), error),
+        QMessageBox::Ok, this);
+    box->setAttribute(Qt::WA_DeleteOnClose);
+    box->setModal(false);
+    box->show();
+}
+
+// Replaces the row with the server's copy of the ticket, or drops it if it is gone.
+void MainWindow::refreshTicket(const QString &ticketId, const QString &createdAtRaw) {
+    QNetworkRequest req(QUrl(apiBaseUrl + TicketItem::apiPath(ticketId, createdAtRaw)));
+    req.setRawHeader("Authorization", "Bearer " + jwtToken.toUtf8());
+    QNetworkReply *reply = networkManager->get(req);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, ticketId]() {
+        reply->deleteLater();
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() == QNetworkReply::NoError) {
+            applyTicket(TicketItem::fromJson(QJsonDocument::fromJson(reply->readAll()).object()));
+        } else if (status == 404) {
+            m_ticketModel->removeTicket(ticketId);
+            m_replica->applyTickets({}, {ticketId});
+        }
+    });
+}
+
+// Puts a created or edited ticket into the table without refetching the list. A
+// ticket that no longer matches the current filter is taken out instead.
+void MainWindow::applyTicket(const TicketItem &ticket) {
+    if (ticket.id.isEmpty()) return;
+    TicketItem item = ticket;
+    if (item.assignee.isEmpty()) {
+        if (const UserInfo *user = UserDirectory::instance().userById(item.assigneeId))
+            item.assignee = user->username;
+    }
+    m_replica->applyTickets({item}, {});
+    if (matchesCurrentFilter(item)) {
+        m_ticketModel->upsertTicket(item);
+    } else {
+        m_ticketModel->removeTicket(item.id);
+    }
+}
+
+// Folds pushed changes from other users into the table: known rows are replaced,
+// new matching tickets are added at the top, everything else is dropped.
+void MainWindow::applyRemoteChanges(const QVector<TicketItem> &updated, const QStringList &deletedIds) {
+    QVector<TicketItem> changed;
+    QStringList removed = deletedIds;
+    QVector<TicketItem> resolved = updated;
+    for (TicketItem &ticket : resolved) {
+        if (ticket.assignee.isEmpty()) {
+            if (const UserInfo *user = UserDirectory::instance().userById(ticket.assigneeId))
+                ticket.assignee = user->username;
+        }
+    }
+    m_replica->applyTickets(resolved, deletedIds);
+    for (const TicketItem &ticket : resolved) {
+        if (!matchesCurrentFilter(ticket)) {
+            removed.append(ticket.id);
+        } else if (m_ticketModel->rowOf(ticket.id) >= 0) {
+            changed.append(ticket);
+        } else if (!m_currentQueryItems.contains("q")) {
+            m_ticketModel->upsertTicket(ticket);
+        }
+    }
+    m_ticketModel->applyChanges(changed, removed);
+}
+
+bool MainWindow::matchesCurrentFilter(const TicketItem &ticket) const {
+    if (m_currentQueryItems.contains("assignee_id") && m_currentQueryItems.value("assignee_id") != ticket.assigneeId)
+        return false;
+    if (m_currentQueryItems.contains("department_id") && m_currentQueryItems.value("department_id").toInt() != ticket.departmentId)
+        return false;
+    // Full-text matches are decided by the replica query; keep the row until the view is re-queried.
+    return true;
+}
+
 void MainWindow::onEditTicket() {
     QModelIndex currentIndex = m_tableView->currentIndex();
     if (!currentIndex.isValid()) {
@@ -327,39 +736,141 @@ void MainWindow::onEditTicket() {
     }
 
     TicketItem ticket = m_ticketModel->getTicket(currentIndex.row());
+    if (refuseArchived({ticket})) return;
     TicketDialog dlg(ticket, jwtToken, this, TicketDialog::Edit);
-    connect(&dlg, &TicketDialog::ticketSaved, this, &MainWindow::loadTickets);
+    connectTicketDialog(&dlg);
     dlg.exec();
 }
 
 void MainWindow::onDeleteTicket() {
-    QModelIndex currentIndex = m_tableView->currentIndex();
-    if (!currentIndex.isValid()) {
+    const QVector<TicketItem> selected = selectedTickets();
+    if (selected.isEmpty()) {
         QMessageBox::information(this, "Info", "Select a ticket to delete");
         return;
     }
+    if (refuseArchived(selected)) return;
+    if (selected.size() > 1) {
+        if (QMessageBox::question(this, "Confirmation",
+                QString("Are you sure you want to delete %1 tickets?").arg(selected.size()),
+                QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes) {
+            sendBatch("delete", selected, QJsonObject());
+        }
+        return;
+    }
 
-    TicketItem ticket = m_ticketModel->getTicket(currentIndex.row());
+    TicketItem ticket = selected.first();
     QMessageBox::StandardButton reply = QMessageBox::question(this, "Confirmation", 
         QString("Are you sure you want to delete ticket '%1'?").arg(ticket.title),
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
-        QUrl url(apiBaseUrl + "/tickets/" + ticket.id);
-        QNetworkRequest req(url);
-        req.setRawHeader("Authorization", "Bearer " + jwtToken.toUtf8());
-        QNetworkReply *reply = networkManager->sendCustomRequest(req, "DELETE");
-
-        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-            if (reply->error() == QNetworkReply::NoError) {
-                loadTickets();
-                m_statusBar->showMessage("Ticket deleted successfully");
+        // Gone from the table now; refreshTicket puts it back if the server refuses.
+        m_ticketModel->removeTicket(ticket.id);
+        m_replica->applyTickets({}, {ticket.id});
+        m_journal->enqueue("delete_ticket", "DELETE", ticket.apiPath(), QJsonObject(), ticket.id);
+    }
+}
+
+void MainWindow::onBulkEdit() {
+    const QVector<TicketItem> selected = selectedTickets();
+    if (selected.isEmpty()) {
+        QMessageBox::information(this, "Info", "Select the tickets to change");
+        return;
+    }
+    if (refuseArchived(selected)) return;
+    BulkEditDialog dlg(selected.size(), this);
+    if (dlg.exec() != QDialog::Accepted) return;
+    sendBatch("update", selected, dlg.patch());
+}
+
+QVector<TicketItem> MainWindow::selectedTickets() const {
+    QVector<TicketItem> tickets;
+    for (const QModelIndex &index : m_tableView->selectionModel()->selectedRows()) {
+        tickets.append(m_ticketModel->getTicket(index.row()));
+    }
+    return tickets;
+}
+
+// Sends one POST /tickets/batch for all tickets and folds the per-ticket results into
+// the table with a single model update.
+void MainWindow::sendBatch(const QString &action, const QVector<TicketItem> &tickets, const QJsonObject &patch) {
+    QJsonArray ids;
+    for (const TicketItem &ticket : tickets) ids.append(ticket.id);
+    QJsonObject body;
+    body["action"] = action;
+    body["ticket_ids"] = ids;
+    if (!patch.isEmpty()) body["patch"] = patch;
+
+    QNetworkRequest req(QUrl(apiBaseUrl + "/tickets/batch"));
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    req.setRawHeader("Authorization", "Bearer " + jwtToken.toUtf8());
+    QNetworkReply *reply = networkManager->post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    m_statusBar->showMessage(QString("Updating %1 tickets...").arg(tickets.size()));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            handleNetworkError(reply, "applying batch");
+            return;
+        }
+        QVector<TicketItem> changed;
+        QVector<TicketItem> saved;
+        QStringList removed;
+        int updated = 0, deleted = 0, missing = 0;
+        const QJsonArray results = QJsonDocument::fromJson(reply->readAll()).object().value("results").toArray();
+        for (const QJsonValue &v : results) {
+            const QJsonObject result = v.toObject();
+            const QString status = result.value("status").toString();
+            const QString id = result.value("ticket_id").toString();
+            if (status == "deleted" || status == "not_found") {
+                removed.append(id);
+                (status == "deleted" ? deleted : missing)++;
+                continue;
+            }
+            if (status != "updated") continue;
+            ++updated;
+            TicketItem ticket = TicketItem::fromJson(result.value("ticket").toObject());
+            if (const UserInfo *user = UserDirectory::instance().userById(ticket.assigneeId))
+                ticket.assignee = user->username;
+            saved.append(ticket);
+            if (matchesCurrentFilter(ticket)) {
+                changed.append(ticket);
             } else {
-                handleNetworkError(reply, "deleting ticket");
+                removed.append(id);
             }
-            reply->deleteLater();
-        });
+        }
+        m_replica->applyTickets(saved, removed);
+        m_ticketModel->applyChanges(changed, removed);
+        QString message = deleted > 0 ? QString("%1 tickets deleted").arg(deleted)
+                                      : QString("%1 tickets updated").arg(updated);
+        if (missing > 0) message += QString(", %1 no longer exist").arg(missing);
+        m_statusBar->showMessage(message);
+    });
+}
+
+void MainWindow::onExportAttachments() {
+    QStringList ticketIds;
+    for (const TicketItem &ticket : selectedTickets()) {
+        ticketIds.append(ticket.id);
     }
+    if (ticketIds.isEmpty()) {
+        QMessageBox::information(this, "Info", "Select one or more tickets to export");
+        return;
+    }
+    const QString defaultName = ticketIds.size() == 1
+        ? QString("ticket-%1-attachments.zip").arg(ticketIds.first())
+        : QString("attachments-%1-tickets.zip").arg(ticketIds.size());
+    QString path = QFileDialog::getSaveFileName(this, "Export attachments", QDir::home().filePath(defaultName), "Zip archives (*.zip)");
+    if (path.isEmpty()) return;
+    QUrl url(apiBaseUrl + "/attachments/archive");
+    QUrlQuery query;
+    query.addQueryItem("ticket_ids", ticketIds.join(','));
+    url.setQuery(query);
+    DownloadTask *task = m_downloads->download(url, path);
+    TicketDialog::showDownloadProgress(task, QFileInfo(path).fileName(), this);
+    connect(task, &DownloadTask::finished, this, [this](const QString &savedPath) {
+        m_statusBar->showMessage("Attachments exported to " + savedPath);
+    });
 }
 
 void MainWindow::handleNetworkError(QNetworkReply *reply, const QString& context) {
@@ -373,6 +884,17 @@ void MainWindow::handleNetworkError(QNetworkReply *reply, const QString& context
 void MainWindow::closeEvent(QCloseEvent *event) {
     QSettings settings("MyCompany", "TicketSystem");
     settings.setValue("geometry", saveGeometry());
+    if (!m_ticketModel->isStale()) {
+        ViewSnapshot snapshot;
+        snapshot.query = m_currentQueryItems;
+        snapshot.sortColumn = m_sortColumn;
+        snapshot.sortOrder = m_sortOrder;
+        // Archived rows are fetched on demand, not restored with the snapshot.
+        for (const TicketItem &t : m_ticketModel->tickets()) {
+            if (!t.archived) snapshot.tickets.append(t);
+        }
+        snapshot.save(dataPath("view-%1.snapshot"));
+    }
     QMainWindow::closeEvent(event);
 }
 
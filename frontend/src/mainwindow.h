@@ -1,8 +1,10 @@
 #pragma once
 #include "models/ticket_model.h"
+#include "models/view_cache.h"
 #include <QMainWindow>
 #include <QString>
 #include <QUrlQuery>
+#include <QJsonArray>
 #include <QMetaType>
 #include <QListWidget>
 #include <QTreeView>
@@ -16,12 +18,20 @@ class QStatusBar;
 class QLineEdit;
 class QPushButton;
 class QSplitter;
+class QTabWidget;
 class QTreeView;
 class QStandardItemModel;
 class QNetworkReply;
 class QCloseEvent;
 class QModelIndex;
 class QJsonArray;
+class DownloadManager;
+class TicketDialog;
+class EventStream;
+class LocalReplica;
+class MutationJournal;
+class DashboardView;
+struct JournalEntry;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -34,6 +44,23 @@ private:
     void setupUi();
     void loadDictionaries();
     void handleNetworkError(QNetworkReply* reply, const QString& context);
+    void connectTicketDialog(TicketDialog *dlg);
+    void applyTicket(const TicketItem &ticket);
+    bool matchesCurrentFilter(const TicketItem &ticket) const;
+    QVector<TicketItem> selectedTickets() const;
+    void applyDictionary(const QString &kind, const QJsonArray &items);
+    void showView();
+    // offset 0 replaces the archived rows with the first page; later pages are appended.
+    void fetchArchive(int offset = 0);
+    void showRows();
+    bool refuseArchived(const QVector<TicketItem> &tickets);
+    QString dataPath(const QString &pattern) const;
+    void restoreSnapshot();
+    void onJournalSucceeded(const JournalEntry &entry, const QJsonObject &response);
+    void onJournalFailed(const JournalEntry &entry, const QString &error);
+    void refreshTicket(const QString &ticketId, const QString &createdAtRaw = QString());
+    void applyRemoteChanges(const QVector<TicketItem> &updated, const QStringList &deletedIds);
+    void sendBatch(const QString &action, const QVector<TicketItem> &tickets, const QJsonObject &patch);
 
     // Auth & API
     QString jwtToken;
@@ -41,7 +68,9 @@ private:
     QString apiBaseUrl;
 
     // UI Widgets
+    QTabWidget *m_tabs;
     QSplitter *m_splitter;
+    DashboardView *m_dashboard;
     QTreeView *m_filterView;
     QStandardItemModel *m_filterModel;
     QTableView *m_tableView;
@@ -50,19 +79,49 @@ private:
     QAction *m_addAction;
     QAction *m_editAction;
     QAction *m_deleteAction;
+    QAction *m_bulkEditAction;
     QAction *m_refreshAction;
+    QAction *m_exportAttachmentsAction;
+    QAction *m_includeArchiveAction;
+    QAction *m_moreArchiveAction;   // enabled while the last archive page came back full
     QLineEdit *m_searchEdit;
     QPushButton *m_searchButton;
     QStatusBar *m_statusBar;
+    DownloadManager *m_downloads;
+    EventStream *m_events;
+    MutationJournal *m_journal;
+    QLabel *m_journalLabel;
     
     // State management
     QMap<QString, QString> m_currentQueryItems;
     int m_dictionariesToLoad = 3;
+    // The table is filled from the replica; the server is only asked for deltas.
+    LocalReplica *m_replica;
+    QString m_replicaWatermark;
+    bool m_syncing = false;
+    int m_viewRequest = 0;
+    // Key of the view in the table (and of m_viewRequest); its rows go back into the
+    // cache when the user switches away, local edits included.
+    QString m_viewKey;
+    // Key of the rows the model actually holds. Until the replica answers a cache
+    // miss the model still shows the previous view, which must not be cached as this one.
+    QString m_modelKey;
+    // Archived tickets are not in the replica; with "Include archive" on they are
+    // fetched per view and shown after the replica's rows.
+    QVector<TicketItem> m_hotRows;
+    QVector<TicketItem> m_archivedRows;
+    int m_archiveRequest = 0;
+    ViewCache m_viewCache;
+    QLabel *m_cacheLabel;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
 private slots:
-    void loadTickets(); 
+    void syncTickets();
     void onAddTicket();
     void onEditTicket();
     void onDeleteTicket();
+    void onBulkEdit();
+    void onExportAttachments();
     void onFilterChanged(const QModelIndex &index);
     void onSearchTriggered();
     void onInitialDataLoaded();
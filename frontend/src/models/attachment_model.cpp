@@ -1,7 +1,13 @@
 #include "attachment_model.h"
 #include <QJsonDocument>
+#include <QMimeDatabase>
 #include <QDebug>
 
+bool AttachmentItem::isKnownBinary() const {
+    const QMimeType type = QMimeDatabase().mimeTypeForFile(filename, QMimeDatabase::MatchExtension);
+    return !type.isDefault() && !type.inherits("text/plain");
+}
+
 QJsonObject AttachmentItem::toJson() const {
     QJsonObject obj;
     if (!id.isEmpty()) obj["attachment_id"] = id;
@@ -14,6 +20,18 @@ QJsonObject AttachmentItem::toJson() const {
     return obj;
 }
 
+AttachmentItem AttachmentItem::fromJson(const QJsonObject &obj) {
+    AttachmentItem a;
+    a.id = obj.value("attachment_id").toString();
+    a.ticketId = obj.value("ticket_id").toString();
+    a.ticketCreatedAt = QDateTime::fromString(obj.value("ticket_created_at").toString(), Qt::ISODate);
+    a.filename = obj.value("filename").toString();
+    a.filePath = obj.value("file_path").toString();
+    a.uploadedBy = obj.value("uploaded_by").toString();
+    a.uploadedAt = QDateTime::fromString(obj.value("uploaded_at").toString(), Qt::ISODate);
+    return a;
+}
+
 AttachmentModel::AttachmentModel(QObject *parent)
     : QAbstractListModel(parent) {}
 
@@ -58,21 +76,13 @@ void AttachmentModel::loadAttachments(const QJsonArray& array) {
     beginResetModel();
     m_attachments.clear();
     for (const QJsonValue &value : array) {
-        QJsonObject obj = value.toObject();
-        AttachmentItem a;
-        a.id = obj.value("attachment_id").toString();
-        a.ticketId = obj.value("ticket_id").toString();
-        a.ticketCreatedAt = QDateTime::fromString(obj.value("ticket_created_at").toString(), Qt::ISODate);
-        a.filename = obj.value("filename").toString();
-        a.filePath = obj.value("file_path").toString();
-        a.uploadedBy = obj.value("uploaded_by").toString();
-        a.uploadedAt = QDateTime::fromString(obj.value("uploaded_at").toString(), Qt::ISODate);
-        m_attachments.append(a);
+        m_attachments.append(AttachmentItem::fromJson(value.toObject()));
     }
     endResetModel();
 }
 
 void AttachmentModel::addAttachment(const AttachmentItem& attachment) {
+    if (!attachment.id.isEmpty() && rowOf(attachment.id) >= 0) return;
     beginInsertRows(QModelIndex(), m_attachments.size(), m_attachments.size());
     m_attachments.append(attachment);
     endInsertRows();
@@ -85,6 +95,13 @@ AttachmentItem AttachmentModel::getAttachment(int row) const {
     return m_attachments[row];
 }
 
+int AttachmentModel::rowOf(const QString &attachmentId) const {
+    for (int i = 0; i < m_attachments.size(); ++i) {
+        if (m_attachments[i].id == attachmentId) return i;
+    }
+    return -1;
+}
+
 void AttachmentModel::clearAttachments() {
     beginResetModel();
     m_attachments.clear();
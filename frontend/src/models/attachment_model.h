@@ -17,10 +17,14 @@ struct AttachmentItem {
     QDateTime uploadedAt;
 
     QJsonObject toJson() const;
+    static AttachmentItem fromJson(const QJsonObject &obj);
     bool isImage() const {
         QString lower = filename.toLower();
         return lower.endsWith(".jpg") || lower.endsWith(".jpeg") || lower.endsWith(".png") || lower.endsWith(".gif");
     }
+    // Whether the extension names a MIME type that is not text (PDF, zip, ...).
+    // Unknown extensions are not binary by this test; their content has to tell.
+    bool isKnownBinary() const;
 };
 
 Q_DECLARE_METATYPE(AttachmentItem)
@@ -43,8 +47,11 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
     void loadAttachments(const QJsonArray& array);
+    // Ignored when an attachment with the same id is already listed.
     void addAttachment(const AttachmentItem& attachment);
     AttachmentItem getAttachment(int row) const;
+    // Row of the attachment with this id, or -1.
+    int rowOf(const QString &attachmentId) const;
     void clearAttachments();
     void removeAttachment(int row);
 private:
@@ -13,6 +13,24 @@ QJsonObject CommentItem::toJson() const {
     return obj;
 }
 
+CommentItem CommentItem::fromJson(const QJsonObject &obj) {
+    CommentItem c;
+    c.id = obj.value("comment_id").toString();
+    c.ticketId = obj.value("ticket_id").toString();
+    c.ticketCreatedAt = QDateTime::fromString(obj.value("ticket_created_at").toString(), Qt::ISODate);
+    c.authorId = obj.value("author_id").toString();
+    c.authorName = obj.value("author_name").toString();
+    c.content = obj.value("content").toString();
+    c.createdAt = QDateTime::fromString(obj.value("created_at").toString(), Qt::ISODate);
+    c.updateDisplayText();
+    return c;
+}
+
+void CommentItem::updateDisplayText() {
+    displayText = QStringLiteral("[%1] %2: %3")
+                      .arg(createdAt.toString("hh:mm dd.MM.yyyy"), authorName, content);
+}
+
 CommentModel::CommentModel(QObject *parent)
     : QAbstractListModel(parent) {}
 
@@ -32,11 +50,7 @@ QVariant CommentModel::data(const QModelIndex &index, int role) const {
         case AuthorNameRole: return comment.authorName;
         case ContentRole: return comment.content;
         case CreatedAtRole: return comment.createdAt;
-        case Qt::DisplayRole:
-            return QString("[%1] %2: %3")
-                   .arg(comment.createdAt.toString("hh:mm dd.MM.yyyy"))
-                   .arg(comment.authorName)
-                   .arg(comment.content);
+        case Qt::DisplayRole: return comment.displayText;
         default: return QVariant();
     }
 }
@@ -59,28 +73,66 @@ QHash<int, QByteArray> CommentModel::roleNames() const {
     return roles;
 }
 
-void CommentModel::loadComments(const QJsonArray& array) {
+bool CommentModel::canFetchMore(const QModelIndex &parent) const {
+    if (parent.isValid()) return false;
+    return !m_nextCursor.isEmpty() && !m_fetching;
+}
+
+void CommentModel::fetchMore(const QModelIndex &parent) {
+    if (!canFetchMore(parent)) return;
+    m_fetching = true;
+    emit fetchMoreRequested(m_nextCursor);
+}
+
+void CommentModel::loadComments(const QJsonArray& newestFirstPage, const QString& nextCursor) {
     beginResetModel();
     m_comments.clear();
-    for (const QJsonValue &value : array) {
-        QJsonObject obj = value.toObject();
-        CommentItem c;
-        c.id = obj.value("comment_id").toString();
-        c.ticketId = obj.value("ticket_id").toString();
-        c.ticketCreatedAt = QDateTime::fromString(obj.value("ticket_created_at").toString(), Qt::ISODate);
-        c.authorId = obj.value("author_id").toString();
-        c.authorName = obj.value("author_name").toString();
-        c.content = obj.value("content").toString();
-        c.createdAt = QDateTime::fromString(obj.value("created_at").toString(), Qt::ISODate);
-        m_comments.append(c);
+    m_comments.reserve(newestFirstPage.size());
+    for (int i = newestFirstPage.size() - 1; i >= 0; --i) {
+        m_comments.append(CommentItem::fromJson(newestFirstPage.at(i).toObject()));
     }
+    m_nextCursor = nextCursor;
+    m_fetching = false;
     endResetModel();
 }
 
+void CommentModel::prependComments(const QJsonArray& newestFirstPage, const QString& nextCursor) {
+    m_fetching = false;
+    m_nextCursor = nextCursor;
+    if (newestFirstPage.isEmpty()) return;
+    QVector<CommentItem> older;
+    older.reserve(newestFirstPage.size());
+    for (int i = newestFirstPage.size() - 1; i >= 0; --i) {
+        older.append(CommentItem::fromJson(newestFirstPage.at(i).toObject()));
+    }
+    beginInsertRows(QModelIndex(), 0, older.size() - 1);
+    m_comments = older + m_comments;
+    endInsertRows();
+}
+
+void CommentModel::mergeNewest(const QJsonArray& newestFirstPage) {
+    for (int i = newestFirstPage.size() - 1; i >= 0; --i) {
+        CommentItem c = CommentItem::fromJson(newestFirstPage.at(i).toObject());
+        const int existing = rowOf(c.id);
+        if (existing >= 0) {
+            updateComment(existing, c);
+            continue;
+        }
+        int row = m_comments.size();
+        while (row > 0 && m_comments[row - 1].createdAt > c.createdAt) --row;
+        beginInsertRows(QModelIndex(), row, row);
+        m_comments.insert(row, c);
+        endInsertRows();
+    }
+}
+
+void CommentModel::fetchFailed() {
+    m_fetching = false;
+}
+
 void CommentModel::addComment(const CommentItem& comment) {
     CommentItem c = comment;
-    if (c.authorId.isEmpty()) {
-    }
+    c.updateDisplayText();
     beginInsertRows(QModelIndex(), m_comments.size(), m_comments.size());
     m_comments.append(c);
     endInsertRows();
@@ -96,15 +148,25 @@ CommentItem CommentModel::getComment(int row) const {
 void CommentModel::clearComments() {
     beginResetModel();
     m_comments.clear();
+    m_nextCursor.clear();
+    m_fetching = false;
     endResetModel();
 }
 
 void CommentModel::updateComment(int row, const CommentItem& updatedComment) {
     if (row < 0 || row >= m_comments.size()) return;
     m_comments[row] = updatedComment;
+    m_comments[row].updateDisplayText();
     emit dataChanged(index(row), index(row));
 }
 
+int CommentModel::rowOf(const QString &commentId) const {
+    for (int i = 0; i < m_comments.size(); ++i) {
+        if (m_comments[i].id == commentId) return i;
+    }
+    return -1;
+}
+
 void CommentModel::removeComment(int row) {
     if (row < 0 || row >= m_comments.size()) return;
     beginRemoveRows(QModelIndex(), row, row);
@@ -16,8 +16,11 @@ struct CommentItem {
     QString authorName;
     QString content;
     QDateTime createdAt;
+    QString displayText;
 
     QJsonObject toJson() const;
+    static CommentItem fromJson(const QJsonObject &obj);
+    void updateDisplayText();
 };
 
 Q_DECLARE_METATYPE(CommentItem)
@@ -40,12 +43,26 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
     QHash<int, QByteArray> roleNames() const override;
-    void loadComments(const QJsonArray& array);
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+    // Pages arrive newest-first from the server; rows are kept oldest-first for display.
+    void loadComments(const QJsonArray& newestFirstPage, const QString& nextCursor);
+    void prependComments(const QJsonArray& newestFirstPage, const QString& nextCursor);
+    // Adds the comments of a newest page that are not loaded yet, in createdAt order,
+    // and refreshes those that are; older pages already loaded are kept.
+    void mergeNewest(const QJsonArray& newestFirstPage);
+    void fetchFailed();
     void addComment(const CommentItem& comment);
     CommentItem getComment(int row) const;
+    // Row of the comment with this id, or -1; rows shift as pages are prepended.
+    int rowOf(const QString &commentId) const;
     void clearComments();
     void updateComment(int row, const CommentItem& updatedComment);
     void removeComment(int row);
+signals:
+    void fetchMoreRequested(const QString &cursor);
 private:
     QVector<CommentItem> m_comments;
+    QString m_nextCursor;
+    bool m_fetching = false;
 }; 
\ No newline at end of file
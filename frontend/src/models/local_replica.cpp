@@ -0,0 +1,377 @@
+#include "local_replica.h"
+#include "models/user_directory.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QMetaObject>
+#include <QDebug>
+
+namespace {
+
+// Turns free text into an FTS5 query: every word must match, as a prefix.
+QString ftsExpression(const QString &text) {
+    static const QRegularExpression spaces("\\s+");
+    QStringList terms;
+    for (QString word : text.split(spaces, Qt::SkipEmptyParts)) {
+        word.replace('"', "\"\"");
+        terms.append('"' + word + "\"*");
+    }
+    return terms.join(' ');
+}
+
+QString likePattern(QString text) {
+    text.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+    return '%' + text + '%';
+}
+
+// ORDER BY term for a TicketModel column.
+QString sortExpression(int column) {
+    switch (column) {
+    case 0: return "t.ticket_id";
+    case 1: return "t.title COLLATE NOCASE";
+    case 2: return "t.status_id";
+    case 3: return "t.priority_id";
+    case 4: return "t.department_id";
+    case 5: return "assignee COLLATE NOCASE";
+    case 6: return "t.created_ms";
+    case 7: return "t.updated_ms";
+    }
+    return QString();
+}
+
+} // namespace
+
+LocalReplica::LocalReplica(QObject *parent)
+    : QObject(parent),
+      m_context(new QObject),
+      m_connection(QString("local_replica_%1").arg(quintptr(this), 0, 16))
+{
+    qRegisterMetaType<QVector<TicketItem>>("QVector<TicketItem>");
+    m_context->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_context, &QObject::deleteLater);
+    m_thread.setObjectName("LocalReplica");
+    m_thread.start();
+}
+
+LocalReplica::~LocalReplica() {
+    QMetaObject::invokeMethod(m_context, [this] {
+        {
+            QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+            db.close();
+        }
+        QSqlDatabase::removeDatabase(m_connection);
+    }, Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+}
+
+template <typename Job>
+void LocalReplica::post(Job &&job) {
+    QMetaObject::invokeMethod(m_context, std::forward<Job>(job), Qt::QueuedConnection);
+}
+
+void LocalReplica::open(const QString &path, const QString &apiUrl) {
+    post([this, path, apiUrl] {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connection);
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            reportFailure("opening " + path, db.lastError().text());
+            return;
+        }
+        QSqlQuery pragma(db);
+        pragma.exec("PRAGMA journal_mode=WAL");
+        pragma.exec("PRAGMA synchronous=NORMAL");
+        if (!createSchema()) return;
+
+        if (meta("api_url") != apiUrl) {
+            QSqlQuery wipe(db);
+            db.transaction();
+            for (const char *table : {"tickets", "users", "dictionaries"})
+                wipe.exec(QString("DELETE FROM %1").arg(table));
+            setMeta("watermark", QString());
+            setMeta("api_url", apiUrl);
+            db.commit();
+        }
+
+        QSqlQuery count(db);
+        count.exec("SELECT COUNT(*) FROM tickets");
+        const int tickets = count.next() ? count.value(0).toInt() : 0;
+        qDebug() << "Local replica" << path << "opened with" << tickets << "tickets, full-text:" << m_fullText;
+        emit opened(tickets, meta("watermark"));
+    });
+}
+
+bool LocalReplica::createSchema() {
+    QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+    QSqlQuery q(db);
+    const char *statements[] = {
+        "CREATE TABLE IF NOT EXISTS meta (key TEXT PRIMARY KEY, value TEXT NOT NULL)",
+        "CREATE TABLE IF NOT EXISTS tickets ("
+        " ticket_id TEXT PRIMARY KEY, title TEXT NOT NULL, description TEXT NOT NULL,"
+        " status_id INTEGER, priority_id INTEGER, department_id INTEGER,"
+        " assignee_id TEXT, assignee_name TEXT, creator_id TEXT,"
+        " created_at TEXT, created_ms INTEGER, updated_at TEXT, updated_ms INTEGER)",
+        "CREATE INDEX IF NOT EXISTS idx_replica_tickets_assignee ON tickets (assignee_id, created_ms)",
+        "CREATE INDEX IF NOT EXISTS idx_replica_tickets_department ON tickets (department_id, created_ms)",
+        "CREATE INDEX IF NOT EXISTS idx_replica_tickets_created ON tickets (created_ms)",
+        "CREATE TABLE IF NOT EXISTS users (user_id TEXT PRIMARY KEY, username TEXT NOT NULL, department_id INTEGER)",
+        "CREATE TABLE IF NOT EXISTS dictionaries (kind TEXT PRIMARY KEY, items TEXT NOT NULL)",
+    };
+    for (const char *sql : statements) {
+        if (!q.exec(sql)) {
+            reportFailure("creating schema", q.lastError().text());
+            return false;
+        }
+    }
+
+    // External-content index over tickets, kept in step by triggers. Without FTS5 in
+    // the SQLite build, search falls back to LIKE.
+    m_fullText = q.exec("CREATE VIRTUAL TABLE IF NOT EXISTS tickets_fts USING fts5("
+                        "title, description, content='tickets', content_rowid='rowid',"
+                        " tokenize='unicode61 remove_diacritics 2')");
+    if (!m_fullText) {
+        qWarning() << "Local replica: FTS5 unavailable, searching with LIKE:" << q.lastError().text();
+        return true;
+    }
+    const char *triggers[] = {
+        "CREATE TRIGGER IF NOT EXISTS tickets_fts_insert AFTER INSERT ON tickets BEGIN"
+        " INSERT INTO tickets_fts (rowid, title, description) VALUES (new.rowid, new.title, new.description); END",
+        "CREATE TRIGGER IF NOT EXISTS tickets_fts_delete AFTER DELETE ON tickets BEGIN"
+        " INSERT INTO tickets_fts (tickets_fts, rowid, title, description) VALUES ('delete', old.rowid, old.title, old.description); END",
+        "CREATE TRIGGER IF NOT EXISTS tickets_fts_update AFTER UPDATE OF title, description ON tickets BEGIN"
+        " INSERT INTO tickets_fts (tickets_fts, rowid, title, description) VALUES ('delete', old.rowid, old.title, old.description);"
+        " INSERT INTO tickets_fts (rowid, title, description) VALUES (new.rowid, new.title, new.description); END",
+    };
+    for (const char *sql : triggers) {
+        if (!q.exec(sql)) {
+            reportFailure("creating full-text triggers", q.lastError().text());
+            return false;
+        }
+    }
+    return true;
+}
+
+void LocalReplica::replaceTickets(const QVector<TicketItem> &tickets, const QString &watermark) {
+    post([this, tickets, watermark] {
+        QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+        if (!db.isOpen()) return;
+        db.transaction();
+        QSqlQuery q(db);
+        if (!q.exec("DELETE FROM tickets") || !upsertTickets(tickets) || !setMeta("watermark", watermark)) {
+            db.rollback();
+            reportFailure("replacing tickets", q.lastError().text());
+            return;
+        }
+        db.commit();
+    });
+}
+
+void LocalReplica::applyTickets(const QVector<TicketItem> &upserted, const QStringList &deletedIds,
+                                const QString &watermark) {
+    if (upserted.isEmpty() && deletedIds.isEmpty() && watermark.isEmpty()) return;
+    post([this, upserted, deletedIds, watermark] {
+        QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+        if (!db.isOpen()) return;
+        db.transaction();
+        bool ok = upsertTickets(upserted);
+        QSqlQuery del(db);
+        del.prepare("DELETE FROM tickets WHERE ticket_id = ?");
+        for (int i = 0; ok && i < deletedIds.size(); ++i) {
+            del.addBindValue(deletedIds[i]);
+            ok = del.exec();
+        }
+        if (ok && !watermark.isEmpty()) ok = setMeta("watermark", watermark);
+        if (!ok) {
+            db.rollback();
+            reportFailure("applying ticket changes", del.lastError().text());
+            return;
+        }
+        db.commit();
+    });
+}
+
+// Runs inside the caller's transaction.
+bool LocalReplica::upsertTickets(const QVector<TicketItem> &tickets) {
+    QSqlQuery q(QSqlDatabase::database(m_connection, false));
+    q.prepare("INSERT INTO tickets (ticket_id, title, description, status_id, priority_id, department_id,"
+              " assignee_id, assignee_name, creator_id, created_at, created_ms, updated_at, updated_ms)"
+              " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"
+              " ON CONFLICT (ticket_id) DO UPDATE SET title = excluded.title, description = excluded.description,"
+              " status_id = excluded.status_id, priority_id = excluded.priority_id, department_id = excluded.department_id,"
+              " assignee_id = excluded.assignee_id, assignee_name = excluded.assignee_name, creator_id = excluded.creator_id,"
+              " created_at = excluded.created_at, created_ms = excluded.created_ms,"
+              " updated_at = excluded.updated_at, updated_ms = excluded.updated_ms");
+    for (const TicketItem &t : tickets) {
+        if (t.id.isEmpty()) continue;
+        q.addBindValue(t.id);
+        q.addBindValue(t.title);
+        q.addBindValue(t.description);
+        q.addBindValue(t.statusId);
+        q.addBindValue(t.priorityId);
+        q.addBindValue(t.departmentId);
+        q.addBindValue(t.assigneeId);
+        q.addBindValue(t.assignee);
+        q.addBindValue(t.creatorId);
+        q.addBindValue(t.createdAtRaw);
+        q.addBindValue(t.createdAt.isValid() ? t.createdAt.toMSecsSinceEpoch() : 0);
+        q.addBindValue(t.updatedAt.toString(Qt::ISODateWithMs));
+        q.addBindValue(t.updatedAt.isValid() ? t.updatedAt.toMSecsSinceEpoch() : 0);
+        if (!q.exec()) {
+            qWarning() << "Local replica: upsert of" << t.id << "failed:" << q.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+void LocalReplica::storeUsers(const QVector<UserInfo> &users) {
+    post([this, users] {
+        QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+        if (!db.isOpen()) return;
+        db.transaction();
+        QSqlQuery q(db);
+        bool ok = q.exec("DELETE FROM users");
+        q.prepare("INSERT INTO users (user_id, username, department_id) VALUES (?, ?, ?)");
+        for (int i = 0; ok && i < users.size(); ++i) {
+            q.addBindValue(users[i].userId);
+            q.addBindValue(users[i].username);
+            q.addBindValue(users[i].departmentId);
+            ok = q.exec();
+        }
+        if (!ok) {
+            db.rollback();
+            qWarning() << "Local replica: storing users failed:" << q.lastError().text();
+            return;
+        }
+        db.commit();
+    });
+}
+
+void LocalReplica::storeDictionary(const QString &kind, const QJsonArray &items) {
+    post([this, kind, items] {
+        QSqlQuery q(QSqlDatabase::database(m_connection, false));
+        q.prepare("INSERT INTO dictionaries (kind, items) VALUES (?, ?)"
+                  " ON CONFLICT (kind) DO UPDATE SET items = excluded.items");
+        q.addBindValue(kind);
+        q.addBindValue(QString::fromUtf8(QJsonDocument(items).toJson(QJsonDocument::Compact)));
+        if (!q.exec()) qWarning() << "Local replica: storing" << kind << "failed:" << q.lastError().text();
+    });
+}
+
+void LocalReplica::loadDictionary(const QString &kind) {
+    post([this, kind] {
+        QSqlQuery q(QSqlDatabase::database(m_connection, false));
+        q.prepare("SELECT items FROM dictionaries WHERE kind = ?");
+        q.addBindValue(kind);
+        QJsonArray items;
+        if (q.exec() && q.next())
+            items = QJsonDocument::fromJson(q.value(0).toString().toUtf8()).array();
+        emit dictionaryLoaded(kind, items);
+    });
+}
+
+int LocalReplica::query(const ReplicaQuery &query) {
+    const int id = ++m_nextRequest;
+    post([this, id, query] {
+        QVector<TicketItem> tickets = runQuery(query);
+        // Labels come from the dictionaries, which belong to the GUI thread.
+        QMetaObject::invokeMethod(this, [this, id, tickets]() mutable {
+            for (TicketItem &t : tickets) {
+                t.status = TicketItem::statusLabels.value(t.statusId, QString::number(t.statusId));
+                t.priority = TicketItem::priorityLabels.value(t.priorityId, QString::number(t.priorityId));
+                t.department = TicketItem::departmentNames.value(t.departmentId, QString::number(t.departmentId));
+            }
+            emit queryFinished(id, tickets);
+        }, Qt::QueuedConnection);
+    });
+    return id;
+}
+
+QVector<TicketItem> LocalReplica::runQuery(const ReplicaQuery &query) const {
+    QVector<TicketItem> tickets;
+    QSqlDatabase db = QSqlDatabase::database(m_connection, false);
+    if (!db.isOpen()) return tickets;
+
+    const QString text = query.text.trimmed();
+    const bool matchFts = m_fullText && !text.isEmpty();
+    QString sql = "SELECT t.ticket_id, t.title, t.description, t.status_id, t.priority_id, t.department_id,"
+                  " t.assignee_id, COALESCE(NULLIF(t.assignee_name, ''), u.username, '') AS assignee,"
+                  " t.creator_id, t.created_at, t.updated_at"
+                  " FROM tickets t LEFT JOIN users u ON u.user_id = t.assignee_id";
+    QStringList where;
+    QVariantList binds;
+    if (matchFts) {
+        sql += " JOIN tickets_fts ON tickets_fts.rowid = t.rowid";
+        where << "tickets_fts MATCH ?";
+        binds << ftsExpression(text);
+    } else if (!text.isEmpty()) {
+        where << "(t.title LIKE ? ESCAPE '\\' OR t.description LIKE ? ESCAPE '\\')";
+        binds << likePattern(text) << likePattern(text);
+    }
+    if (!query.assigneeId.isEmpty()) {
+        where << "t.assignee_id = ?";
+        binds << query.assigneeId;
+    }
+    if (query.departmentId > 0) {
+        where << "t.department_id = ?";
+        binds << query.departmentId;
+    }
+    if (!where.isEmpty()) sql += " WHERE " + where.join(" AND ");
+
+    const QString sortBy = sortExpression(query.sortColumn);
+    if (!sortBy.isEmpty()) {
+        sql += " ORDER BY " + sortBy + (query.sortOrder == Qt::DescendingOrder ? " DESC" : " ASC") + ", t.ticket_id";
+    } else if (matchFts) {
+        sql += " ORDER BY bm25(tickets_fts), t.created_ms DESC";
+    } else {
+        sql += " ORDER BY t.created_ms DESC, t.ticket_id";
+    }
+
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    q.prepare(sql);
+    for (const QVariant &value : binds) q.addBindValue(value);
+    if (!q.exec()) {
+        qWarning() << "Local replica: query failed:" << q.lastError().text();
+        return tickets;
+    }
+    while (q.next()) {
+        TicketItem t;
+        t.id = q.value(0).toString();
+        t.title = q.value(1).toString();
+        t.description = q.value(2).toString();
+        t.statusId = q.value(3).toInt();
+        t.priorityId = q.value(4).toInt();
+        t.departmentId = q.value(5).toInt();
+        t.assigneeId = q.value(6).toString();
+        t.assignee = q.value(7).toString();
+        t.creatorId = q.value(8).toString();
+        t.createdAtRaw = q.value(9).toString();
+        t.createdAt = QDateTime::fromString(t.createdAtRaw, Qt::ISODateWithMs);
+        t.updatedAt = QDateTime::fromString(q.value(10).toString(), Qt::ISODateWithMs);
+        tickets.append(t);
+    }
+    return tickets;
+}
+
+bool LocalReplica::setMeta(const QString &key, const QString &value) {
+    QSqlQuery q(QSqlDatabase::database(m_connection, false));
+    q.prepare("INSERT INTO meta (key, value) VALUES (?, ?) ON CONFLICT (key) DO UPDATE SET value = excluded.value");
+    q.addBindValue(key);
+    q.addBindValue(value);
+    return q.exec();
+}
+
+QString LocalReplica::meta(const QString &key) const {
+    QSqlQuery q(QSqlDatabase::database(m_connection, false));
+    q.prepare("SELECT value FROM meta WHERE key = ?");
+    q.addBindValue(key);
+    return q.exec() && q.next() ? q.value(0).toString() : QString();
+}
+
+void LocalReplica::reportFailure(const QString &what, const QString &error) {
+    qWarning() << "Local replica:" << what << "failed:" << error;
+    emit failed(what + ": " + error);
+}
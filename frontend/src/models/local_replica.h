@@ -0,0 +1,71 @@
+#pragma once
+#include <QObject>
+#include <QThread>
+#include <QJsonArray>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include "models/ticket_model.h"
+
+struct UserInfo;
+
+// One table view: the filter tree selection, the search text and the sort column.
+struct ReplicaQuery {
+    QString assigneeId;
+    int departmentId = 0;
+    QString text;
+    // A TicketModel column, or -1 for the server's order (best match first when searching).
+    int sortColumn = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+};
+
+// On-disk SQLite copy of the tickets, users and dictionaries, kept current by
+// GET /tickets?updated_since= and by pushed events. Titles and descriptions are
+// indexed with FTS5, so switching views, searching and sorting are local queries
+// that take milliseconds and keep working while the backend is unreachable.
+// All SQL runs on one worker thread that owns the connection; calls only queue
+// work there, and results come back as signals on the caller's thread.
+class LocalReplica : public QObject {
+    Q_OBJECT
+public:
+    explicit LocalReplica(QObject *parent = nullptr);
+    ~LocalReplica() override;
+
+    // Opens or creates the replica file. A file filled from another server is emptied.
+    void open(const QString &path, const QString &apiUrl);
+    // Replaces every ticket, after a full load.
+    void replaceTickets(const QVector<TicketItem> &tickets, const QString &watermark);
+    // Applies a delta or pushed changes. The watermark is only advanced when given.
+    void applyTickets(const QVector<TicketItem> &upserted, const QStringList &deletedIds,
+                      const QString &watermark = QString());
+    void storeUsers(const QVector<UserInfo> &users);
+    void storeDictionary(const QString &kind, const QJsonArray &items);
+    // Emits dictionaryLoaded with the stored copy, empty if there is none.
+    void loadDictionary(const QString &kind);
+    // Returns the id queryFinished reports; callers apply only their latest request.
+    int query(const ReplicaQuery &query);
+
+signals:
+    // watermark is where the next delta sync starts, empty if a full load is needed.
+    void opened(int ticketCount, const QString &watermark);
+    void queryFinished(int requestId, const QVector<TicketItem> &tickets);
+    void dictionaryLoaded(const QString &kind, const QJsonArray &items);
+    // A write failed; the replica can no longer be trusted and needs a full load.
+    void failed(const QString &message);
+
+private:
+    template <typename Job> void post(Job &&job);
+    bool createSchema();
+    bool upsertTickets(const QVector<TicketItem> &tickets);
+    bool setMeta(const QString &key, const QString &value);
+    QString meta(const QString &key) const;
+    QVector<TicketItem> runQuery(const ReplicaQuery &query) const;
+    void reportFailure(const QString &what, const QString &error);
+
+    QThread m_thread;
+    QObject *m_context;             // lives on m_thread; every job is queued to it
+    const QString m_connection;     // QSqlDatabase name, only used on m_thread
+    bool m_fullText = false;        // FTS5 is available (worker thread only)
+    std::atomic<int> m_nextRequest{0};
+};
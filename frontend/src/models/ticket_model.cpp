@@ -6,6 +6,9 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPainterPath>
+#include <QHash>
+#include <QUrl>
+#include <algorithm>
 
 TicketModel::TicketModel(QObject *parent)
     : QAbstractTableModel(parent) {}
@@ -38,6 +41,9 @@ QVariant TicketModel::data(const QModelIndex &index, int role) const {
     if (role == Qt::TextAlignmentRole) {
         return Qt::AlignCenter;
     }
+    if (role == Qt::ForegroundRole && (m_stale || t.archived)) {
+        return QBrush(QColor(140, 140, 140));
+    }
     if (role == Qt::UserRole) {
         return QVariant::fromValue(t);
     }
@@ -190,24 +196,7 @@ void TicketModel::loadTickets(const QJsonArray& array) {
     m_tickets.clear();
     for (const QJsonValue& val : array) {
         if (!val.isObject()) continue;
-        QJsonObject obj = val.toObject();
-        TicketItem t;
-        t.id = obj.value("ticket_id").toString();
-        t.title = obj.value("title").toString();
-        t.description = obj.value("description").toString();
-        t.statusId = obj.value("status_id").toInt(-1);
-        t.status = TicketItem::statusLabels.value(t.statusId, QString::number(t.statusId));
-        t.priorityId = obj.value("priority_id").toInt(-1);
-        t.priority = TicketItem::priorityLabels.value(t.priorityId, QString::number(t.priorityId));
-        t.departmentId = obj.value("department_id").toInt(-1);
-        t.department = TicketItem::departmentNames.value(t.departmentId, QString::number(t.departmentId));
-        t.assignee = obj.value("assignee_name").toString();
-        t.assigneeId = obj.value("assignee_id").toString();
-        t.creatorId = obj.value("creator_id").toString();
-        t.createdAtRaw = obj.value("created_at").toString();
-        t.createdAt = QDateTime::fromString(t.createdAtRaw, Qt::ISODateWithMs);
-        t.updatedAt = QDateTime::fromString(obj.value("updated_at").toString(), Qt::ISODate);
-        m_tickets.append(t);
+        m_tickets.append(TicketItem::fromJson(val.toObject()));
     }
     endResetModel();
 }
@@ -221,6 +210,14 @@ TicketItem TicketModel::getTicket(int row) const {
     return m_tickets[row];
 }
 
+QString TicketItem::apiPath(const QString &id, const QString &createdAtRaw, const QString &suffix) {
+    QString path = "/tickets/" + id + suffix;
+    // Encoded by hand: a '+' in the UTC offset would otherwise arrive as a space.
+    if (!createdAtRaw.isEmpty())
+        path += "?ticket_created_at=" + QString::fromLatin1(QUrl::toPercentEncoding(createdAtRaw));
+    return path;
+}
+
 QJsonObject TicketItem::toJson() const {
     QJsonObject obj;
     if (!id.isEmpty()) obj["ticket_id"] = id;
@@ -234,8 +231,140 @@ QJsonObject TicketItem::toJson() const {
     return obj;
 }
 
+TicketItem TicketItem::fromJson(const QJsonObject &obj) {
+    TicketItem t;
+    t.id = obj.value("ticket_id").toString();
+    t.title = obj.value("title").toString();
+    t.description = obj.value("description").toString();
+    t.statusId = obj.value("status_id").toInt(-1);
+    t.status = TicketItem::statusLabels.value(t.statusId, QString::number(t.statusId));
+    t.priorityId = obj.value("priority_id").toInt(-1);
+    t.priority = TicketItem::priorityLabels.value(t.priorityId, QString::number(t.priorityId));
+    t.departmentId = obj.value("department_id").toInt(-1);
+    t.department = TicketItem::departmentNames.value(t.departmentId, QString::number(t.departmentId));
+    t.assignee = obj.value("assignee_name").toString();
+    t.assigneeId = obj.value("assignee_id").toString();
+    t.creatorId = obj.value("creator_id").toString();
+    t.createdAtRaw = obj.value("created_at").toString();
+    t.createdAt = QDateTime::fromString(t.createdAtRaw, Qt::ISODateWithMs);
+    t.updatedAt = QDateTime::fromString(obj.value("updated_at").toString(), Qt::ISODate);
+    t.archived = obj.value("archived").toBool();
+    return t;
+}
+
 void TicketModel::setTickets(const QVector<TicketItem> &tickets) {
     beginResetModel();
     m_tickets = tickets;
     endResetModel();
-}
\ No newline at end of file
+}
+
+int TicketModel::rowOf(const QString &ticketId) const {
+    for (int i = 0; i < m_tickets.size(); ++i) {
+        if (m_tickets[i].id == ticketId) return i;
+    }
+    return -1;
+}
+
+void TicketModel::upsertTicket(const TicketItem &ticket, int row) {
+    int existing = rowOf(ticket.id);
+    if (existing >= 0) {
+        TicketItem merged = ticket;
+        // Save responses carry ids only; keep the name already shown for an unchanged assignee.
+        if (merged.assignee.isEmpty() && merged.assigneeId == m_tickets[existing].assigneeId)
+            merged.assignee = m_tickets[existing].assignee;
+        m_tickets[existing] = merged;
+        emit dataChanged(index(existing, 0), index(existing, columnCount() - 1));
+        return;
+    }
+    row = qBound(0, row, m_tickets.size());
+    beginInsertRows(QModelIndex(), row, row);
+    m_tickets.insert(row, ticket);
+    endInsertRows();
+}
+
+int TicketModel::removeTicket(const QString &ticketId) {
+    int row = rowOf(ticketId);
+    if (row < 0) return -1;
+    beginRemoveRows(QModelIndex(), row, row);
+    m_tickets.removeAt(row);
+    endRemoveRows();
+    return row;
+}
+
+void TicketModel::applyChanges(const QVector<TicketItem> &changed, const QStringList &removedIds) {
+    QHash<QString, int> rows;
+    rows.reserve(m_tickets.size());
+    for (int i = 0; i < m_tickets.size(); ++i) rows.insert(m_tickets[i].id, i);
+
+    int first = m_tickets.size();
+    int last = -1;
+    for (const TicketItem &ticket : changed) {
+        auto it = rows.constFind(ticket.id);
+        if (it == rows.cend()) continue;
+        TicketItem &row = m_tickets[it.value()];
+        const QString assignee = row.assignee;
+        const QString assigneeId = row.assigneeId;
+        row = ticket;
+        if (row.assignee.isEmpty() && row.assigneeId == assigneeId) row.assignee = assignee;
+        first = qMin(first, it.value());
+        last = qMax(last, it.value());
+    }
+    if (last >= 0) emit dataChanged(index(first, 0), index(last, columnCount() - 1));
+
+    QVector<int> doomed;
+    for (const QString &id : removedIds) {
+        auto it = rows.constFind(id);
+        if (it != rows.cend()) doomed.append(it.value());
+    }
+    std::sort(doomed.begin(), doomed.end());
+    doomed.erase(std::unique(doomed.begin(), doomed.end()), doomed.end());
+    // Remove contiguous runs from the bottom up so earlier row numbers stay valid.
+    int end = doomed.size() - 1;
+    while (end >= 0) {
+        int start = end;
+        while (start > 0 && doomed[start - 1] == doomed[start] - 1) --start;
+        beginRemoveRows(QModelIndex(), doomed[start], doomed[end]);
+        m_tickets.erase(m_tickets.begin() + doomed[start], m_tickets.begin() + doomed[end] + 1);
+        endRemoveRows();
+        end = start - 1;
+    }
+}
+
+static bool sameRow(const TicketItem &a, const TicketItem &b) {
+    return a.id == b.id && a.title == b.title && a.description == b.description
+        && a.statusId == b.statusId && a.status == b.status
+        && a.priorityId == b.priorityId && a.priority == b.priority
+        && a.departmentId == b.departmentId && a.department == b.department
+        && a.assigneeId == b.assigneeId && a.assignee == b.assignee
+        && a.createdAtRaw == b.createdAtRaw && a.updatedAt == b.updatedAt;
+}
+
+void TicketModel::mergeTickets(const QVector<TicketItem> &tickets) {
+    bool sameIds = tickets.size() == m_tickets.size();
+    for (int i = 0; sameIds && i < tickets.size(); ++i) sameIds = tickets[i].id == m_tickets[i].id;
+    if (!sameIds) {
+        m_stale = false;
+        setTickets(tickets);
+        return;
+    }
+    const bool wasStale = m_stale;
+    m_stale = false;
+    int first = -1;
+    for (int i = 0; i <= tickets.size(); ++i) {
+        const bool differs = i < tickets.size() && (wasStale || !sameRow(tickets[i], m_tickets[i]));
+        if (differs) {
+            m_tickets[i] = tickets[i];
+            if (first < 0) first = i;
+        } else if (first >= 0) {
+            emit dataChanged(index(first, 0), index(i - 1, columnCount() - 1));
+            first = -1;
+        }
+    }
+}
+
+void TicketModel::setStale(bool stale) {
+    if (m_stale == stale) return;
+    m_stale = stale;
+    if (!m_tickets.isEmpty())
+        emit dataChanged(index(0, 0), index(m_tickets.size() - 1, columnCount() - 1), {Qt::ForegroundRole});
+}
@@ -25,12 +25,21 @@ struct TicketItem {
     QDateTime createdAt;
     QString createdAtRaw;
     QDateTime updatedAt;
+    // Moved to tickets_archive on the server: listed on request only, read-only.
+    bool archived = false;
 
     static QMap<int, QString> statusLabels;
     static QMap<int, QString> priorityLabels;
     static QMap<int, QString> departmentNames;
 
     QJsonObject toJson() const;
+    static TicketItem fromJson(const QJsonObject &obj);
+
+    // Path of a per-ticket endpoint below the API base URL, e.g. apiPath("/history").
+    // It carries created_at as ticket_created_at: tickets is partitioned by creation
+    // time on the server, and the hint lets it look in one partition only.
+    QString apiPath(const QString &suffix = QString()) const { return apiPath(id, createdAtRaw, suffix); }
+    static QString apiPath(const QString &id, const QString &createdAtRaw, const QString &suffix = QString());
 };
 
 Q_DECLARE_METATYPE(TicketItem)
@@ -49,9 +58,27 @@ public:
     void loadTickets(const QJsonArray& array);
     TicketItem getTicket(int row) const;
     void setTickets(const QVector<TicketItem> &tickets);
+    // Single-row edits, so a save or delete touches one row instead of reloading the list.
+    int rowOf(const QString &ticketId) const;
+    // Replaces the row with the same id in place, or inserts the ticket at `row`.
+    void upsertTicket(const TicketItem &ticket, int row = 0);
+    // Removes the ticket and returns the row it was at, or -1.
+    int removeTicket(const QString &ticketId);
+    // Applies the outcome of a batch in one pass: rows of `changed` are replaced in
+    // place and `removedIds` are taken out, with one dataChanged for the replaced span.
+    void applyChanges(const QVector<TicketItem> &changed, const QStringList &removedIds);
+    // Replaces the contents with a fresh result. When the rows are the same tickets in
+    // the same order only the differing rows are updated, so selection and scroll
+    // position survive; otherwise the model is reset. Clears the stale mark.
+    void mergeTickets(const QVector<TicketItem> &tickets);
+    const QVector<TicketItem> &tickets() const { return m_tickets; }
+    // Stale rows (from the startup snapshot) and archived rows are drawn greyed out.
+    void setStale(bool stale);
+    bool isStale() const { return m_stale; }
 
 private:
     QVector<TicketItem> m_tickets;
+    bool m_stale = false;
 };
 
 class TicketBadgeDelegate : public QStyledItemDelegate {
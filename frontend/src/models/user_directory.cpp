@@ -0,0 +1,165 @@
+#include "user_directory.h"
+#include "../config.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QDebug>
+#include <algorithm>
+
+UserDirectory &UserDirectory::instance() {
+    static UserDirectory directory;
+    return directory;
+}
+
+UserDirectory::UserDirectory() {}
+
+void UserDirectory::ensureLoaded() {
+    if (m_loading || (m_loaded && m_loadedAt.elapsed() < MaxAgeMs)) return;
+    m_loading = true;
+    QNetworkReply *reply = m_network.get(QNetworkRequest(QUrl(Config::instance().fullApiUrl() + "/users")));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        m_loading = false;
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Failed to load user directory:" << reply->errorString();
+            emit loadFailed(reply->errorString());
+            return;
+        }
+        const QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
+        QVector<UserInfo> users;
+        users.reserve(arr.size());
+        for (const QJsonValue &v : arr) {
+            const QJsonObject o = v.toObject();
+            QString userId = o.value("user_id").toString();
+            if (userId.isEmpty()) userId = o.value("id").toString();
+            const QString username = o.value("username").toString();
+            const int deptId = o.value("department_id").toInt(-1);
+            if (userId.isEmpty() || username.isEmpty() || deptId <= 0) {
+                qWarning() << "Skipping user directory record without id, username or department:" << o;
+                continue;
+            }
+            users.append({username, userId, deptId});
+        }
+        setUsers(std::move(users));
+        qDebug() << "User directory loaded:" << m_users.size() << "users";
+        emit loaded();
+    });
+}
+
+void UserDirectory::setUsers(QVector<UserInfo> users) {
+    std::sort(users.begin(), users.end(), [](const UserInfo &a, const UserInfo &b) {
+        return a.username.compare(b.username, Qt::CaseInsensitive) < 0;
+    });
+    m_users = std::move(users);
+    m_keys.clear();
+    m_keys.reserve(m_users.size());
+    m_byDepartment.clear();
+    m_byId.clear();
+    m_byId.reserve(m_users.size());
+    for (int i = 0; i < m_users.size(); ++i) {
+        m_keys.append(m_users[i].username.toLower());
+        m_byDepartment[m_users[i].departmentId].append(i);
+        m_byId.insert(m_users[i].userId, i);
+    }
+    m_loaded = true;
+    m_loadedAt.start();
+}
+
+UserDirectory::Range UserDirectory::find(const QString &prefix, int departmentId) const {
+    Range range;
+    range.departmentId = departmentId > 0 ? departmentId : 0;
+    const QString key = prefix.trimmed().toLower();
+    // Keys are sorted, so everything starting with key lies in [key, key + U+FFFF).
+    const QString upper = key + QChar(0xFFFF);
+    if (range.departmentId > 0) {
+        auto it = m_byDepartment.constFind(range.departmentId);
+        if (it == m_byDepartment.cend()) return range;
+        const QVector<int> &list = it.value();
+        auto keyOf = [this](int index) -> const QString & { return m_keys[index]; };
+        auto lo = std::lower_bound(list.begin(), list.end(), key, [&](int index, const QString &k) { return keyOf(index) < k; });
+        auto hi = std::lower_bound(lo, list.end(), upper, [&](int index, const QString &k) { return keyOf(index) < k; });
+        range.begin = int(lo - list.begin());
+        range.end = int(hi - list.begin());
+    } else {
+        auto lo = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+        auto hi = std::lower_bound(lo, m_keys.end(), upper);
+        range.begin = int(lo - m_keys.begin());
+        range.end = int(hi - m_keys.begin());
+    }
+    return range;
+}
+
+const UserInfo &UserDirectory::at(const Range &range, int row) const {
+    const int position = range.begin + row;
+    if (range.departmentId > 0) return m_users[m_byDepartment[range.departmentId][position]];
+    return m_users[position];
+}
+
+const UserInfo *UserDirectory::userById(const QString &userId) const {
+    auto it = m_byId.constFind(userId);
+    return it == m_byId.cend() ? nullptr : &m_users[it.value()];
+}
+
+AssigneeModel::AssigneeModel(QObject *parent) : QAbstractListModel(parent) {}
+
+void AssigneeModel::setFilter(const QString &prefix, int departmentId) {
+    beginResetModel();
+    m_useRemote = false;
+    m_remote.clear();
+    m_range = UserDirectory::instance().find(prefix, departmentId);
+    m_fetched = qMin(PageSize, m_range.size());
+    endResetModel();
+}
+
+void AssigneeModel::setRemoteUsers(const QVector<UserInfo> &users) {
+    beginResetModel();
+    m_useRemote = true;
+    m_remote = users;
+    m_range = UserDirectory::Range();
+    m_fetched = m_remote.size();
+    endResetModel();
+}
+
+int AssigneeModel::available() const {
+    return m_useRemote ? m_remote.size() : m_range.size();
+}
+
+UserInfo AssigneeModel::userAt(int row) const {
+    if (row < 0 || row >= m_fetched) return UserInfo{QString(), QString(), -1};
+    return m_useRemote ? m_remote[row] : UserDirectory::instance().at(m_range, row);
+}
+
+int AssigneeModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_fetched;
+}
+
+QVariant AssigneeModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_fetched) return QVariant();
+    const UserInfo user = userAt(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return user.username;
+    case UserIdRole:
+        return user.userId;
+    case DepartmentIdRole:
+        return user.departmentId;
+    default:
+        return QVariant();
+    }
+}
+
+bool AssigneeModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && m_fetched < available();
+}
+
+void AssigneeModel::fetchMore(const QModelIndex &parent) {
+    if (parent.isValid()) return;
+    const int next = qMin(m_fetched + PageSize, available());
+    if (next <= m_fetched) return;
+    beginInsertRows(QModelIndex(), m_fetched, next - 1);
+    m_fetched = next;
+    endInsertRows();
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <QObject>
+#include <QAbstractListModel>
+#include <QNetworkAccessManager>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVector>
+#include <QString>
+
+struct UserInfo {
+    QString username;
+    QString userId;
+    int departmentId;
+};
+
+// Process-wide copy of the user directory, fetched once and shared by every dialog.
+// Users are kept sorted by lower-cased name, with a per-department list of indexes
+// in the same order, so a name-prefix lookup (optionally within a department) is
+// two binary searches and yields a contiguous range.
+class UserDirectory : public QObject {
+    Q_OBJECT
+public:
+    // The directory is refetched when it is older than this.
+    static const int MaxAgeMs = 10 * 60 * 1000;
+
+    // A contiguous run of matches: positions [begin, end) of either the department
+    // list (department > 0) or the whole name-sorted directory.
+    struct Range {
+        int departmentId = 0;
+        int begin = 0;
+        int end = 0;
+        int size() const { return end - begin; }
+    };
+
+    static UserDirectory &instance();
+    // Starts a fetch unless a fresh copy is loaded or a fetch is already running.
+    void ensureLoaded();
+    bool isLoaded() const { return m_loaded; }
+    Range find(const QString &prefix, int departmentId) const;
+    const UserInfo &at(const Range &range, int row) const;
+    const UserInfo *userById(const QString &userId) const;
+signals:
+    void loaded();
+    void loadFailed(const QString &error);
+private:
+    UserDirectory();
+    void setUsers(QVector<UserInfo> users);
+
+    QNetworkAccessManager m_network;
+    QVector<UserInfo> m_users;
+    QVector<QString> m_keys;
+    QHash<int, QVector<int>> m_byDepartment;
+    QHash<QString, int> m_byId;
+    QElapsedTimer m_loadedAt;
+    bool m_loaded = false;
+    bool m_loading = false;
+};
+
+// Assignee candidates for a name prefix and department. Rows come straight from a
+// UserDirectory::Range and are exposed in pages through fetchMore, so a popup over
+// 20k users only ever creates the rows that were scrolled into view. Until the
+// directory is loaded, rows can instead be filled from a server-side search.
+class AssigneeModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles { UserIdRole = Qt::UserRole + 1, DepartmentIdRole };
+    static const int PageSize = 100;
+
+    explicit AssigneeModel(QObject *parent = nullptr);
+    void setFilter(const QString &prefix, int departmentId);
+    void setRemoteUsers(const QVector<UserInfo> &users);
+    UserInfo userAt(int row) const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+private:
+    int available() const;
+
+    UserDirectory::Range m_range;
+    QVector<UserInfo> m_remote;
+    bool m_useRemote = false;
+    int m_fetched = 0;
+};
@@ -0,0 +1,36 @@
+#include "view_cache.h"
+#include "local_replica.h"
+
+ViewCache::ViewCache(qint64 budgetBytes) {
+    m_cache.setMaxCost(budgetBytes);
+}
+
+QString ViewCache::key(const ReplicaQuery &query) {
+    return QString("assignee=%1|department=%2|q=%3|sort=%4:%5")
+        .arg(query.assigneeId)
+        .arg(query.departmentId > 0 ? query.departmentId : 0)
+        .arg(query.text.simplified().toLower())
+        .arg(query.sortColumn)
+        .arg(query.sortColumn < 0 ? 0 : int(query.sortOrder));
+}
+
+const QVector<TicketItem> *ViewCache::find(const QString &key) {
+    const QVector<TicketItem> *tickets = m_cache.object(key);
+    ++(tickets ? m_hits : m_misses);
+    return tickets;
+}
+
+void ViewCache::insert(const QString &key, const QVector<TicketItem> &tickets) {
+    // QCache takes ownership, and drops the entry right away if it alone is over budget.
+    m_cache.insert(key, new QVector<TicketItem>(tickets), estimateBytes(tickets));
+}
+
+qint64 ViewCache::estimateBytes(const QVector<TicketItem> &tickets) {
+    qint64 bytes = qint64(tickets.size()) * qint64(sizeof(TicketItem));
+    for (const TicketItem &t : tickets) {
+        bytes += 2 * (t.id.size() + t.title.size() + t.description.size() + t.status.size()
+                      + t.priority.size() + t.department.size() + t.assignee.size()
+                      + t.assigneeId.size() + t.creatorId.size() + t.createdAtRaw.size());
+    }
+    return bytes;
+}
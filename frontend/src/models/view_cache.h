@@ -0,0 +1,29 @@
+#pragma once
+#include <QCache>
+#include <QString>
+#include <QVector>
+#include "models/ticket_model.h"
+
+struct ReplicaQuery;
+
+// Decoded ticket lists of recently shown views, keyed by the normalized view query.
+// Entries are charged their estimated size in bytes and the least recently used ones
+// are dropped once the total passes the budget. A hit is only a first paint: callers
+// still run the query and put the fresh result back.
+class ViewCache {
+public:
+    explicit ViewCache(qint64 budgetBytes);
+    static QString key(const ReplicaQuery &query);
+    // The cached rows or nullptr; counts a hit or a miss.
+    const QVector<TicketItem> *find(const QString &key);
+    void insert(const QString &key, const QVector<TicketItem> &tickets);
+    int hits() const { return m_hits; }
+    int misses() const { return m_misses; }
+    qint64 usedBytes() const { return m_cache.totalCost(); }
+private:
+    static qint64 estimateBytes(const QVector<TicketItem> &tickets);
+
+    QCache<QString, QVector<TicketItem>> m_cache;
+    int m_hits = 0;
+    int m_misses = 0;
+};
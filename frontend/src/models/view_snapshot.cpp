@@ -0,0 +1,193 @@
+#include "view_snapshot.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QHash>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+const quint32 Magic = 0x504e5354; // "TSNP"
+
+struct Header {
+    quint32 magic;
+    quint16 version;
+    quint16 flags;
+    quint32 rowCount;
+    quint32 stringCount;
+    quint32 queryCount;     // key/value index records after the rows
+    quint32 payloadSize;    // uncompressed
+    qint32 sortColumn;
+    qint32 sortOrder;
+};
+
+enum RowField {
+    Id, Title, Description, Status, Priority, Department, Assignee, AssigneeId, CreatorId, CreatedAt,
+    StringFields
+};
+
+// String indexes, then status, priority and department ids, then updated_at in ms.
+const qint64 RowSize = StringFields * 4 + 3 * 4 + 8;
+const qint64 QueryPairSize = 2 * 4;
+
+class StringTable {
+public:
+    quint32 add(const QString &s) {
+        auto it = m_index.constFind(s);
+        if (it != m_index.constEnd()) return it.value();
+        const quint32 index = quint32(m_offsets.size());
+        m_offsets.append(quint32(m_bytes.size()));
+        m_bytes += s.toUtf8();
+        m_index.insert(s, index);
+        return index;
+    }
+    quint32 size() const { return quint32(m_offsets.size()); }
+    void appendTo(QByteArray &out) const {
+        for (quint32 offset : m_offsets) appendLe(out, offset);
+        appendLe(out, quint32(m_bytes.size()));
+        out += m_bytes;
+    }
+    template <typename T> static void appendLe(QByteArray &out, T value) {
+        value = qToLittleEndian(value);
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+private:
+    QHash<QString, quint32> m_index;
+    QVector<quint32> m_offsets;
+    QByteArray m_bytes;
+};
+
+template <typename T> T readLe(const char *p) {
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    return qFromLittleEndian(value);
+}
+
+} // namespace
+
+bool ViewSnapshot::save(const QString &path) const {
+    StringTable strings;
+    QByteArray rows;
+    rows.reserve(int(tickets.size() * RowSize));
+    for (const TicketItem &t : tickets) {
+        const QString fields[StringFields] = {
+            t.id, t.title, t.description, t.status, t.priority, t.department,
+            t.assignee, t.assigneeId, t.creatorId, t.createdAtRaw,
+        };
+        for (const QString &field : fields) StringTable::appendLe(rows, strings.add(field));
+        StringTable::appendLe(rows, qint32(t.statusId));
+        StringTable::appendLe(rows, qint32(t.priorityId));
+        StringTable::appendLe(rows, qint32(t.departmentId));
+        StringTable::appendLe(rows, qint64(t.updatedAt.isValid() ? t.updatedAt.toMSecsSinceEpoch() : 0));
+    }
+    QByteArray payload = rows;
+    for (auto it = query.constBegin(); it != query.constEnd(); ++it) {
+        StringTable::appendLe(payload, strings.add(it.key()));
+        StringTable::appendLe(payload, strings.add(it.value()));
+    }
+    strings.appendTo(payload);
+
+    Header header;
+    header.magic = qToLittleEndian(Magic);
+    header.version = qToLittleEndian(Version);
+    header.flags = 0;
+    header.queryCount = qToLittleEndian(quint32(query.size()));
+    header.rowCount = qToLittleEndian(quint32(tickets.size()));
+    header.stringCount = qToLittleEndian(strings.size());
+    header.payloadSize = qToLittleEndian(quint32(payload.size()));
+    header.sortColumn = qToLittleEndian(qint32(sortColumn));
+    header.sortOrder = qToLittleEndian(qint32(sortOrder));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "View snapshot: cannot write" << path << file.errorString();
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(qCompress(payload, 1));
+    return file.commit();
+}
+
+bool ViewSnapshot::load(const QString &path, ViewSnapshot *snapshot) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < qint64(sizeof(Header))) return false;
+    const uchar *mapped = file.map(0, file.size());
+    if (!mapped) return false;
+
+    Header header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (qFromLittleEndian(header.magic) != Magic || qFromLittleEndian(header.version) != Version) {
+        qWarning() << "View snapshot: ignoring" << path << "(unknown format)";
+        return false;
+    }
+    const quint32 rowCount = qFromLittleEndian(header.rowCount);
+    const quint32 stringCount = qFromLittleEndian(header.stringCount);
+    const quint32 queryCount = qFromLittleEndian(header.queryCount);
+    const QByteArray payload = qUncompress(mapped + sizeof(Header), file.size() - qint64(sizeof(Header)));
+    file.unmap(const_cast<uchar *>(mapped));
+
+    const qint64 rowsSize = qint64(rowCount) * RowSize;
+    const qint64 querySize = qint64(queryCount) * QueryPairSize;
+    const qint64 offsetsSize = (qint64(stringCount) + 1) * sizeof(quint32);
+    if (payload.size() != qint64(qFromLittleEndian(header.payloadSize))
+        || payload.size() < rowsSize + querySize + offsetsSize) {
+        qWarning() << "View snapshot: ignoring" << path << "(truncated)";
+        return false;
+    }
+    const char *rows = payload.constData();
+    const char *queryPairs = rows + rowsSize;
+    const char *offsets = queryPairs + querySize;
+    const char *bytes = offsets + offsetsSize;
+    const qint64 bytesSize = payload.size() - rowsSize - querySize - offsetsSize;
+
+    // Decode each string once; rows share labels and assignees.
+    QVector<QString> strings(int(stringCount));
+    for (quint32 i = 0; i < stringCount; ++i) {
+        const quint32 begin = readLe<quint32>(offsets + i * sizeof(quint32));
+        const quint32 end = readLe<quint32>(offsets + (i + 1) * sizeof(quint32));
+        if (begin > end || end > bytesSize) return false;
+        strings[int(i)] = QString::fromUtf8(bytes + begin, int(end - begin));
+    }
+
+    snapshot->query.clear();
+    for (quint32 i = 0; i < queryCount; ++i) {
+        const quint32 key = readLe<quint32>(queryPairs + i * QueryPairSize);
+        const quint32 value = readLe<quint32>(queryPairs + i * QueryPairSize + 4);
+        if (key >= stringCount || value >= stringCount) return false;
+        snapshot->query.insert(strings[int(key)], strings[int(value)]);
+    }
+    snapshot->sortColumn = qFromLittleEndian(header.sortColumn);
+    snapshot->sortOrder = Qt::SortOrder(qFromLittleEndian(header.sortOrder));
+    snapshot->tickets.clear();
+    snapshot->tickets.reserve(int(rowCount));
+    for (quint32 r = 0; r < rowCount; ++r) {
+        const char *p = rows + r * RowSize;
+        QString fields[StringFields];
+        for (int f = 0; f < StringFields; ++f) {
+            const quint32 index = readLe<quint32>(p + f * 4);
+            if (index >= stringCount) return false;
+            fields[f] = strings[int(index)];
+        }
+        p += StringFields * 4;
+        TicketItem t;
+        t.id = fields[Id];
+        t.title = fields[Title];
+        t.description = fields[Description];
+        t.status = fields[Status];
+        t.priority = fields[Priority];
+        t.department = fields[Department];
+        t.assignee = fields[Assignee];
+        t.assigneeId = fields[AssigneeId];
+        t.creatorId = fields[CreatorId];
+        t.createdAtRaw = fields[CreatedAt];
+        t.createdAt = QDateTime::fromString(t.createdAtRaw, Qt::ISODateWithMs);
+        t.statusId = readLe<qint32>(p);
+        t.priorityId = readLe<qint32>(p + 4);
+        t.departmentId = readLe<qint32>(p + 8);
+        const qint64 updatedMs = readLe<qint64>(p + 12);
+        if (updatedMs != 0) t.updatedAt = QDateTime::fromMSecsSinceEpoch(updatedMs, Qt::UTC);
+        snapshot->tickets.append(t);
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include "models/ticket_model.h"
+
+// The table as it was when the window was closed, shown (marked stale) at the next
+// start before dictionaries and the first sync arrive. File layout, little-endian:
+//   header   magic "TSNP", version, flags, row count, string count, query pair
+//            count, payload size, sort column, sort order
+//   payload  qCompress(rows[row count] | query pairs[query pair count] |
+//            string offsets[string count + 1] | UTF-8 bytes)
+// Rows are fixed-width records of string-table indexes and integers, labels included,
+// so loading is one mapping, one inflate and a linear pass with no lookups. A query
+// pair is the key and value string indexes; the table is deduplicated, so a value
+// equal to an earlier string shares its index.
+struct ViewSnapshot {
+    static const quint16 Version = 2;
+
+    QMap<QString, QString> query;   // MainWindow's filter/search query items
+    int sortColumn = -1;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+    QVector<TicketItem> tickets;
+
+    bool save(const QString &path) const;
+    // Returns false for a missing, truncated or other-version file.
+    static bool load(const QString &path, ViewSnapshot *snapshot);
+};
@@ -157,7 +157,7 @@ void APIClient::updateTicket(const QString &token, const QString &ticketId, cons
     QNetworkReply *reply = manager.sendCustomRequest(req, "PATCH", QJsonDocument(ticketData).toJson());
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         if (reply->error() == QNetworkReply::NoError) {
-            emit ticketCreated(reply->readAll());
+            emit ticketUpdated(reply->readAll());
         } else {
             emit apiError(reply->errorString());
         }
@@ -30,6 +30,7 @@ signals:
     void statusesReceived(const QByteArray &data);
     void prioritiesReceived(const QByteArray &data);
     void ticketCreated(const QByteArray &data);
+    void ticketUpdated(const QByteArray &data);
     void apiError(const QString &error);
     void historyLoaded(const QByteArray &data);
     void attachmentDeleted(const QString &attachmentId);
@@ -0,0 +1,321 @@
+#include "download_manager.h"
+#include "file_hash.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSaveFile>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+#include <memory>
+
+static const qint64 SegmentThreshold = 8 * 1024 * 1024;
+static const qint64 MinSegmentSize = 4 * 1024 * 1024;
+static const int MaxSegments = 4;
+static const int MaxRetries = 3;
+static const qint64 ReadBufferSize = 256 * 1024;
+
+DownloadTask::DownloadTask(QNetworkAccessManager *network, const QUrl &url, const QByteArray &authorization,
+                           const QString &targetPath, QObject *parent)
+    : QObject(parent), m_network(network), m_url(url), m_authorization(authorization), m_targetPath(targetPath) {
+    m_partPath = targetPath + ".part";
+    m_statePath = m_partPath + ".json";
+    m_stateTimer.setInterval(1000);
+    connect(&m_stateTimer, &QTimer::timeout, this, &DownloadTask::saveState);
+}
+
+DownloadTask::~DownloadTask() {
+    abortAll();
+}
+
+QNetworkRequest DownloadTask::makeRequest() const {
+    QNetworkRequest req(m_url);
+    req.setRawHeader("Authorization", m_authorization);
+    return req;
+}
+
+void DownloadTask::start() {
+    QDir().mkpath(QFileInfo(m_targetPath).absolutePath());
+    // The probe asks for one byte: a 206 reveals size and Range support; a 200 is simply adopted.
+    QNetworkRequest req = makeRequest();
+    req.setRawHeader("Range", "bytes=0-0");
+    QNetworkReply *reply = m_network->get(req);
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, reply]() { onProbeMetaData(reply); });
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        if (reply->error() != QNetworkReply::NoError && reply->error() != QNetworkReply::OperationCanceledError) {
+            fail(reply->errorString());
+        }
+        reply->deleteLater();
+    });
+}
+
+void DownloadTask::onProbeMetaData(QNetworkReply *reply) {
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 416 && reply->rawHeader("Content-Range").endsWith("/0")) {
+        // An empty file has no byte 0 to probe (Content-Range: bytes */0): nothing to fetch.
+        m_sha256 = reply->rawHeader("X-Content-SHA256").toLower();
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+        m_total = 0;
+        m_segments.clear();
+        QFile part(m_partPath);
+        if (!part.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            fail(QString("Cannot write %1: %2").arg(m_partPath, part.errorString()));
+            return;
+        }
+        part.close();
+        QFile::remove(m_statePath);
+        emitProgress();
+        verifyAndFinish();
+        return;
+    }
+    if (status != 200 && status != 206) return;
+    m_etag = reply->rawHeader("ETag");
+    m_sha256 = reply->rawHeader("X-Content-SHA256").toLower();
+    if (status == 206) {
+        // Content-Range: bytes 0-0/<total>
+        const QByteArray range = reply->rawHeader("Content-Range");
+        m_total = range.mid(range.lastIndexOf('/') + 1).toLongLong();
+        m_rangeSupported = true;
+        reply->abort();
+        if (!loadState()) planSegments();
+        for (int i = 0; i < m_segments.size(); ++i) {
+            if (!m_segments[i].done()) startSegment(i);
+        }
+        m_stateTimer.start();
+        emitProgress();
+        if (m_segments.isEmpty() || std::all_of(m_segments.begin(), m_segments.end(), [](const Segment &s) { return s.done(); })) {
+            verifyAndFinish();
+        }
+        return;
+    }
+    // No Range support: stream the probe reply itself from the beginning.
+    disconnect(reply, nullptr, this, nullptr);
+    const QVariant length = reply->header(QNetworkRequest::ContentLengthHeader);
+    m_total = length.isValid() ? length.toLongLong() : -1;
+    if (m_total < 0 && reply->hasRawHeader("X-Archive-Uncompressed-Size")) {
+        m_expectedTotal = reply->rawHeader("X-Archive-Uncompressed-Size").toLongLong();
+    }
+    QFile::remove(m_statePath);
+    Segment segment;
+    segment.end = m_total > 0 ? m_total - 1 : -1;
+    m_segments = { segment };
+    startSegment(0, reply);
+}
+
+void DownloadTask::planSegments() {
+    m_segments.clear();
+    {
+        QFile part(m_partPath);
+        if (part.open(QIODevice::WriteOnly | QIODevice::Truncate)) part.resize(m_total);
+    }
+    int count = 1;
+    if (m_rangeSupported && m_total >= SegmentThreshold) {
+        count = int(qMin<qint64>(MaxSegments, m_total / MinSegmentSize));
+    }
+    const qint64 step = m_total / count;
+    for (int i = 0; i < count; ++i) {
+        Segment segment;
+        segment.start = i * step;
+        segment.end = (i == count - 1) ? m_total - 1 : (i + 1) * step - 1;
+        m_segments.append(segment);
+    }
+}
+
+void DownloadTask::startSegment(int index, QNetworkReply *adopted) {
+    Segment &segment = m_segments[index];
+    if (!segment.file) {
+        segment.file = new QFile(m_partPath, this);
+        QIODevice::OpenMode mode = QIODevice::ReadWrite;
+        if (adopted) mode |= QIODevice::Truncate;
+        if (!segment.file->open(mode)) {
+            fail(QString("Cannot write %1: %2").arg(m_partPath, segment.file->errorString()));
+            return;
+        }
+    }
+    QNetworkReply *reply = adopted;
+    if (!reply) {
+        QNetworkRequest req = makeRequest();
+        const QByteArray end = segment.end >= 0 ? QByteArray::number(segment.end) : QByteArray();
+        req.setRawHeader("Range", "bytes=" + QByteArray::number(segment.start + segment.written) + "-" + end);
+        if (!m_etag.isEmpty()) req.setRawHeader("If-Range", m_etag);
+        reply = m_network->get(req);
+    }
+    // Keep at most a small window in memory; the rest stays in the socket until written out.
+    reply->setReadBufferSize(ReadBufferSize);
+    segment.reply = reply;
+    connect(reply, &QNetworkReply::readyRead, this, [this, index]() { onSegmentData(index); });
+    connect(reply, &QNetworkReply::finished, this, [this, index]() { onSegmentFinished(index); });
+    if (adopted && adopted->bytesAvailable() > 0) onSegmentData(index);
+}
+
+void DownloadTask::onSegmentData(int index) {
+    Segment &segment = m_segments[index];
+    if (!segment.reply) return;
+    if (m_rangeSupported && segment.reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200) {
+        fail("The attachment changed on the server");
+        return;
+    }
+    const QByteArray chunk = segment.reply->readAll();
+    if (chunk.isEmpty()) return;
+    if (!segment.file->seek(segment.start + segment.written) || segment.file->write(chunk) != chunk.size()) {
+        fail(QString("Cannot write %1: %2").arg(m_partPath, segment.file->errorString()));
+        return;
+    }
+    segment.written += chunk.size();
+    emitProgress();
+}
+
+void DownloadTask::onSegmentFinished(int index) {
+    Segment &segment = m_segments[index];
+    QNetworkReply *reply = segment.reply;
+    if (!reply) return;
+    onSegmentData(index);
+    segment.reply = nullptr;
+    reply->deleteLater();
+    if (m_finished) return;
+    if (reply->error() != QNetworkReply::NoError) {
+        if (reply->error() == QNetworkReply::OperationCanceledError) return;
+        if (m_rangeSupported && ++segment.retries <= MaxRetries) {
+            qDebug() << "Download segment" << index << "failed, retrying:" << reply->errorString();
+            startSegment(index);
+            return;
+        }
+        fail(reply->errorString());
+        return;
+    }
+    if (segment.end < 0) segment.end = segment.start + segment.written - 1;
+    if (!segment.done()) {
+        startSegment(index);
+        return;
+    }
+    segment.file->close();
+    for (const Segment &s : std::as_const(m_segments)) {
+        if (!s.done()) return;
+    }
+    verifyAndFinish();
+}
+
+bool DownloadTask::loadState() {
+    QFile stateFile(m_statePath);
+    if (!QFile::exists(m_partPath) || !stateFile.open(QIODevice::ReadOnly)) return false;
+    const QJsonObject state = QJsonDocument::fromJson(stateFile.readAll()).object();
+    if (state.value("url").toString() != m_url.toString() || state.value("etag").toString().toUtf8() != m_etag
+        || state.value("size").toInteger() != m_total) {
+        return false;
+    }
+    m_segments.clear();
+    for (const QJsonValue &value : state.value("segments").toArray()) {
+        const QJsonArray s = value.toArray();
+        Segment segment;
+        segment.start = s.at(0).toInteger();
+        segment.end = s.at(1).toInteger();
+        segment.written = s.at(2).toInteger();
+        m_segments.append(segment);
+    }
+    qDebug() << "Resuming download of" << m_targetPath;
+    return !m_segments.isEmpty();
+}
+
+void DownloadTask::saveState() {
+    if (!m_rangeSupported || m_segments.isEmpty()) return;
+    QJsonArray segments;
+    for (Segment &segment : m_segments) {
+        // Only bytes that reached the OS count as written.
+        if (segment.file && segment.file->isOpen()) segment.file->flush();
+        segments.append(QJsonArray{ segment.start, segment.end, segment.written });
+    }
+    QJsonObject state;
+    state["url"] = m_url.toString();
+    state["etag"] = QString::fromUtf8(m_etag);
+    state["size"] = m_total;
+    state["segments"] = segments;
+    QSaveFile file(m_statePath);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+}
+
+void DownloadTask::verifyAndFinish() {
+    m_stateTimer.stop();
+    for (Segment &segment : m_segments) {
+        if (segment.file) segment.file->close();
+    }
+    const QString partPath = m_partPath;
+    auto digest = std::make_shared<QByteArray>();
+    QThread *thread = QThread::create([partPath, digest, verify = !m_sha256.isEmpty()]() {
+        if (verify) *digest = sha256OfFile(partPath);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    connect(thread, &QThread::finished, this, [this, digest]() {
+        if (!m_sha256.isEmpty() && *digest != m_sha256) {
+            m_segments.clear();
+            QFile::remove(m_partPath);
+            QFile::remove(m_statePath);
+            fail("Checksum mismatch");
+            return;
+        }
+        QFile::remove(m_targetPath);
+        if (!QFile::rename(m_partPath, m_targetPath)) {
+            fail(QString("Cannot move download to %1").arg(m_targetPath));
+            return;
+        }
+        QFile::remove(m_statePath);
+        m_finished = true;
+        emit finished(m_targetPath);
+        deleteLater();
+    });
+    thread->start();
+}
+
+void DownloadTask::fail(const QString &error) {
+    if (m_finished) return;
+    m_finished = true;
+    abortAll();
+    saveState();
+    qWarning() << "Download of" << m_url.toString() << "failed:" << error;
+    emit failed(error);
+    deleteLater();
+}
+
+void DownloadTask::cancel() {
+    fail("Cancelled");
+}
+
+void DownloadTask::abortAll() {
+    m_stateTimer.stop();
+    for (Segment &segment : m_segments) {
+        if (QNetworkReply *reply = segment.reply) {
+            segment.reply = nullptr;
+            reply->abort();
+            reply->deleteLater();
+        }
+    }
+}
+
+void DownloadTask::emitProgress() {
+    qint64 received = 0;
+    for (const Segment &segment : std::as_const(m_segments)) received += segment.written;
+    qint64 total = m_total;
+    if (total < 0 && m_expectedTotal >= 0) total = qMax(m_expectedTotal, received);
+    emit progress(received, total);
+}
+
+DownloadManager::DownloadManager(const QString &jwtToken, QObject *parent)
+    : QObject(parent), m_jwtToken(jwtToken) {}
+
+DownloadTask *DownloadManager::download(const QUrl &url, const QString &targetPath) {
+    if (DownloadTask *active = m_active.value(targetPath)) return active;
+    auto *task = new DownloadTask(&m_network, url, "Bearer " + m_jwtToken.toUtf8(), targetPath, this);
+    m_active.insert(targetPath, task);
+    connect(task, &QObject::destroyed, this, [this, targetPath]() { m_active.remove(targetPath); });
+    QTimer::singleShot(0, task, &DownloadTask::start);
+    return task;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QUrl>
+#include <QVector>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+
+class QFile;
+class QNetworkReply;
+
+// Streams one file to "<target>.part", optionally as several parallel Range requests.
+// Progress is recorded in "<target>.part.json" so an interrupted download resumes
+// where it stopped. The result is checked against the server's SHA-256 before it
+// is renamed into place.
+class DownloadTask : public QObject {
+    Q_OBJECT
+public:
+    DownloadTask(QNetworkAccessManager *network, const QUrl &url, const QByteArray &authorization,
+                 const QString &targetPath, QObject *parent = nullptr);
+    ~DownloadTask() override;
+    void start();
+    void cancel();
+    QString targetPath() const { return m_targetPath; }
+signals:
+    // total is -1 when unknown; for generated bodies (zip exports) it may be an estimate.
+    void progress(qint64 received, qint64 total);
+    void finished(const QString &path);
+    void failed(const QString &error);
+private:
+    struct Segment {
+        qint64 start = 0;
+        qint64 end = -1;        // inclusive; -1 while the size is unknown
+        qint64 written = 0;
+        int retries = 0;
+        QNetworkReply *reply = nullptr;
+        QFile *file = nullptr;
+        bool done() const { return end >= 0 && start + written > end; }
+    };
+
+    QNetworkRequest makeRequest() const;
+    void onProbeMetaData(QNetworkReply *reply);
+    void planSegments();
+    void startSegment(int index, QNetworkReply *adopted = nullptr);
+    void onSegmentData(int index);
+    void onSegmentFinished(int index);
+    bool loadState();
+    void saveState();
+    void verifyAndFinish();
+    void fail(const QString &error);
+    void abortAll();
+    void emitProgress();
+
+    QNetworkAccessManager *m_network;
+    QUrl m_url;
+    QByteArray m_authorization;
+    QString m_targetPath;
+    QString m_partPath;
+    QString m_statePath;
+    qint64 m_total = -1;
+    qint64 m_expectedTotal = -1;    // size hint for streamed bodies without Content-Length
+    bool m_rangeSupported = false;
+    QByteArray m_etag;
+    QByteArray m_sha256;
+    QVector<Segment> m_segments;
+    QTimer m_stateTimer;
+    bool m_finished = false;
+};
+
+class DownloadManager : public QObject {
+    Q_OBJECT
+public:
+    explicit DownloadManager(const QString &jwtToken, QObject *parent = nullptr);
+    // Starts (or joins) a download of url into targetPath. The task deletes itself when done.
+    DownloadTask *download(const QUrl &url, const QString &targetPath);
+private:
+    QString m_jwtToken;
+    QNetworkAccessManager m_network;
+    QHash<QString, QPointer<DownloadTask>> m_active;
+};
@@ -0,0 +1,150 @@
+#include "event_stream.h"
+#include "../config.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QDebug>
+
+// Folds the server's {id, op} list into pending; the last op for an id wins.
+static void mergeRowChanges(RowChanges &pending, const QJsonValue &changes) {
+    if (!changes.isArray()) {
+        pending.unknown = true;
+        return;
+    }
+    for (const QJsonValue &v : changes.toArray()) {
+        const QJsonObject change = v.toObject();
+        const QString id = change.value("id").toString();
+        if (id.isEmpty()) {
+            pending.unknown = true;
+        } else if (change.value("op").toString() == "DELETE") {
+            pending.upserted.remove(id);
+            pending.deleted.insert(id);
+        } else {
+            pending.deleted.remove(id);
+            pending.upserted.insert(id);
+        }
+    }
+}
+
+EventStream::EventStream(const QString &jwt, QObject *parent)
+    : QObject(parent), m_jwt(jwt) {
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(CoalesceMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &EventStream::flush);
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &EventStream::connectStream);
+}
+
+EventStream::~EventStream() {
+    stop();
+}
+
+void EventStream::start() {
+    if (m_running) return;
+    m_running = true;
+    connectStream();
+}
+
+void EventStream::stop() {
+    m_running = false;
+    m_reconnectTimer.stop();
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+    }
+}
+
+void EventStream::connectStream() {
+    if (!m_running) return;
+    QNetworkRequest req(QUrl(Config::instance().fullApiUrl() + "/events"));
+    req.setRawHeader("Authorization", "Bearer " + m_jwt.toUtf8());
+    req.setRawHeader("Accept", "text/event-stream");
+    req.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    req.setTransferTimeout(0);
+    m_buffer.clear();
+    m_eventName.clear();
+    m_data.clear();
+    m_reply = m_network.get(req);
+    connect(m_reply, &QNetworkReply::readyRead, this, &EventStream::onReadyRead);
+    connect(m_reply, &QNetworkReply::finished, this, &EventStream::onFinished);
+    connect(m_reply, &QNetworkReply::metaDataChanged, this, [this]() {
+        if (!m_reply || m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200) return;
+        m_reconnectDelayMs = 1000;
+        if (m_connectedOnce) emit resyncNeeded();
+        m_connectedOnce = true;
+    });
+}
+
+void EventStream::onReadyRead() {
+    m_buffer += m_reply->readAll();
+    // SSE framing: "field: value" lines, events separated by a blank line.
+    int newline;
+    while ((newline = m_buffer.indexOf('\n')) >= 0) {
+        QByteArray line = m_buffer.left(newline);
+        m_buffer.remove(0, newline + 1);
+        if (line.endsWith('\r')) line.chop(1);
+        if (line.isEmpty()) {
+            if (!m_data.isEmpty()) dispatch(m_eventName.isEmpty() ? QByteArray("message") : m_eventName, m_data);
+            m_eventName.clear();
+            m_data.clear();
+        } else if (line.startsWith(':')) {
+            continue;  // heartbeat
+        } else if (line.startsWith("event:")) {
+            m_eventName = line.mid(6).trimmed();
+        } else if (line.startsWith("data:")) {
+            if (!m_data.isEmpty()) m_data += '\n';
+            m_data += line.mid(5).trimmed();
+        }
+    }
+}
+
+void EventStream::onFinished() {
+    QNetworkReply *reply = m_reply;
+    if (reply) {
+        if (reply->error() != QNetworkReply::NoError)
+            qWarning() << "Event stream closed:" << reply->errorString();
+        reply->deleteLater();
+    }
+    m_reply = nullptr;
+    if (!m_running) return;
+    m_reconnectTimer.start(m_reconnectDelayMs);
+    m_reconnectDelayMs = qMin(m_reconnectDelayMs * 2, MaxReconnectDelayMs);
+}
+
+void EventStream::dispatch(const QByteArray &eventName, const QByteArray &data) {
+    if (eventName != "changes") return;
+    const QJsonArray events = QJsonDocument::fromJson(data).array();
+    for (const QJsonValue &v : events) {
+        const QJsonObject event = v.toObject();
+        const QString type = event.value("type").toString();
+        const QString ticketId = event.value("ticket_id").toString();
+        if (type == "ticket.updated") {
+            m_deleted.remove(ticketId);
+            m_updated.insert(ticketId, TicketItem::fromJson(event.value("ticket").toObject()));
+        } else if (type == "ticket.deleted") {
+            m_updated.remove(ticketId);
+            m_deleted.insert(ticketId);
+        } else if (type == "comments.changed") {
+            mergeRowChanges(m_comments[ticketId], event.value("changes"));
+        } else if (type == "attachments.changed") {
+            mergeRowChanges(m_attachments[ticketId], event.value("changes"));
+        }
+    }
+    if (!m_flushTimer.isActive()) m_flushTimer.start();
+}
+
+void EventStream::flush() {
+    if (!m_updated.isEmpty() || !m_deleted.isEmpty()) {
+        emit ticketsChanged(QVector<TicketItem>(m_updated.cbegin(), m_updated.cend()),
+                            QStringList(m_deleted.cbegin(), m_deleted.cend()));
+    }
+    for (auto it = m_comments.cbegin(); it != m_comments.cend(); ++it) emit commentsChanged(it.key(), it.value());
+    for (auto it = m_attachments.cbegin(); it != m_attachments.cend(); ++it) emit attachmentsChanged(it.key(), it.value());
+    m_updated.clear();
+    m_deleted.clear();
+    m_comments.clear();
+    m_attachments.clear();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QTimer>
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+#include "models/ticket_model.h"
+
+class QNetworkReply;
+
+// Comment or attachment rows of one ticket changed since the last flush. Ids are
+// final: a row inserted and then deleted is only in deleted. unknown is set when
+// the server did not list the rows, and the receiver has to refetch.
+struct RowChanges {
+    QSet<QString> upserted;
+    QSet<QString> deleted;
+    bool unknown = false;
+};
+
+// Client side of GET /events (Server-Sent Events). Incoming changes are buffered and
+// delivered every CoalesceMs, so a burst of edits ends up as one model update: the
+// latest state per ticket, plus the comment and attachment rows that changed per
+// ticket. After a reconnect resyncNeeded() is emitted because events may have been
+// missed while the stream was down.
+class EventStream : public QObject {
+    Q_OBJECT
+public:
+    static const int CoalesceMs = 250;
+    static const int MaxReconnectDelayMs = 30000;
+
+    explicit EventStream(const QString &jwt, QObject *parent = nullptr);
+    ~EventStream() override;
+    void start();
+    void stop();
+signals:
+    void ticketsChanged(const QVector<TicketItem> &updated, const QStringList &deletedIds);
+    void commentsChanged(const QString &ticketId, const RowChanges &changes);
+    void attachmentsChanged(const QString &ticketId, const RowChanges &changes);
+    void resyncNeeded();
+private:
+    void connectStream();
+    void onReadyRead();
+    void onFinished();
+    void dispatch(const QByteArray &eventName, const QByteArray &data);
+    void flush();
+
+    QNetworkAccessManager m_network;
+    QString m_jwt;
+    QPointer<QNetworkReply> m_reply;
+    QByteArray m_buffer;
+    QByteArray m_eventName;
+    QByteArray m_data;
+    QTimer m_flushTimer;
+    QTimer m_reconnectTimer;
+    int m_reconnectDelayMs = 1000;
+    bool m_running = false;
+    bool m_connectedOnce = false;
+
+    // Pending changes, keyed by ticket id; the newest event for a ticket wins.
+    QHash<QString, TicketItem> m_updated;
+    QSet<QString> m_deleted;
+    QHash<QString, RowChanges> m_comments;
+    QHash<QString, RowChanges> m_attachments;
+};
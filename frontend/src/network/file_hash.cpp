@@ -0,0 +1,24 @@
+#include "file_hash.h"
+#include <QFile>
+#include <QCryptographicHash>
+
+static const qint64 MapWindowSize = 64 * 1024 * 1024;
+
+QByteArray sha256OfFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    const qint64 size = file.size();
+    // Map in windows so a multi-gigabyte file does not need that much address space at once.
+    for (qint64 offset = 0; offset < size; offset += MapWindowSize) {
+        const qint64 length = qMin(MapWindowSize, size - offset);
+        uchar *data = file.map(offset, length);
+        if (!data) {
+            if (!file.seek(offset) || !hash.addData(&file)) return QByteArray();
+            break;
+        }
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(data), length));
+        file.unmap(data);
+    }
+    return hash.result().toHex();
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+
+// Lower-case hex SHA-256 of the file, or an empty array if it cannot be read.
+// The file is hashed through a memory mapping when possible; call it off the GUI thread.
+QByteArray sha256OfFile(const QString &path);
@@ -0,0 +1,206 @@
+#include "mutation_journal.h"
+#include "../config.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QUuid>
+#include <QDebug>
+
+QJsonObject JournalEntry::toJson() const {
+    QJsonObject obj;
+    obj["op"] = "add";
+    obj["key"] = key;
+    obj["kind"] = kind;
+    obj["method"] = QString::fromLatin1(method);
+    obj["path"] = path;
+    obj["body"] = body;
+    obj["ticket_id"] = ticketId;
+    obj["queued_at"] = queuedAt.toString(Qt::ISODateWithMs);
+    return obj;
+}
+
+JournalEntry JournalEntry::fromJson(const QJsonObject &obj) {
+    JournalEntry e;
+    e.key = obj.value("key").toString();
+    e.kind = obj.value("kind").toString();
+    e.method = obj.value("method").toString().toLatin1();
+    e.path = obj.value("path").toString();
+    e.body = obj.value("body").toObject();
+    e.ticketId = obj.value("ticket_id").toString();
+    e.queuedAt = QDateTime::fromString(obj.value("queued_at").toString(), Qt::ISODateWithMs);
+    return e;
+}
+
+MutationJournal::MutationJournal(const QString &path, const QString &jwt, QObject *parent)
+    : QObject(parent), m_file(path), m_jwt(jwt)
+{
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &MutationJournal::sendNext);
+    load();
+    if (!m_pending.isEmpty()) {
+        qDebug() << "Mutation journal:" << m_pending.size() << "writes left from the last session";
+        QTimer::singleShot(0, this, &MutationJournal::sendNext);
+    }
+}
+
+// The file is a log of {"op":"add",...} and {"op":"done","key":...} lines. Replaying
+// it gives the pending queue; a torn last line from a crash is skipped.
+void MutationJournal::load() {
+    if (m_file.open(QIODevice::ReadOnly)) {
+        while (!m_file.atEnd()) {
+            const QJsonObject record = QJsonDocument::fromJson(m_file.readLine()).object();
+            const QString op = record.value("op").toString();
+            if (op == "add") {
+                m_pending.append(JournalEntry::fromJson(record));
+            } else if (op == "done") {
+                const QString key = record.value("key").toString();
+                for (int i = 0; i < m_pending.size(); ++i) {
+                    if (m_pending[i].key == key) {
+                        m_pending.removeAt(i);
+                        break;
+                    }
+                }
+            }
+        }
+        m_file.close();
+    }
+    compact();
+}
+
+// Rewrites the file with only the pending entries and reopens it for appending.
+void MutationJournal::compact() {
+    m_file.close();
+    QSaveFile out(m_file.fileName());
+    if (out.open(QIODevice::WriteOnly)) {
+        for (const JournalEntry &e : m_pending)
+            out.write(QJsonDocument(e.toJson()).toJson(QJsonDocument::Compact) + '\n');
+        out.commit();
+    }
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+        qWarning() << "Mutation journal: cannot open" << m_file.fileName() << m_file.errorString();
+}
+
+void MutationJournal::append(const QJsonObject &record) {
+    m_file.write(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+    m_file.flush();
+}
+
+QString MutationJournal::enqueue(const QString &kind, const QByteArray &method, const QString &path,
+                                 const QJsonObject &body, const QString &ticketId) {
+    JournalEntry e;
+    e.key = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    e.kind = kind;
+    e.method = method;
+    e.path = path;
+    e.body = body;
+    e.ticketId = ticketId;
+    e.queuedAt = QDateTime::currentDateTimeUtc();
+    append(e.toJson());
+    m_pending.append(e);
+    emit stateChanged(m_pending.size(), m_online);
+    if (!m_inFlight && !m_retryTimer.isActive()) sendNext();
+    return e.key;
+}
+
+bool MutationJournal::hasPending(const QString &ticketId) const {
+    for (const JournalEntry &e : m_pending) {
+        if (e.ticketId == ticketId) return true;
+    }
+    return false;
+}
+
+void MutationJournal::retryNow() {
+    if (m_inFlight || m_pending.isEmpty() || m_authExpired) return;
+    m_retryTimer.stop();
+    m_retryDelayMs = 1000;
+    sendNext();
+}
+
+void MutationJournal::sendNext() {
+    if (m_inFlight || m_pending.isEmpty() || m_authExpired) return;
+    const JournalEntry &e = m_pending.first();
+    QNetworkRequest req(QUrl(Config::instance().fullApiUrl() + e.path));
+    req.setRawHeader("Authorization", "Bearer " + m_jwt.toUtf8());
+    req.setRawHeader("Idempotency-Key", e.key.toUtf8());
+    req.setTransferTimeout(RequestTimeoutMs);
+    QByteArray payload;
+    if (!e.body.isEmpty()) {
+        req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+        payload = QJsonDocument(e.body).toJson(QJsonDocument::Compact);
+    }
+    QNetworkReply *reply = m_network.sendCustomRequest(req, e.method, payload);
+    m_inFlight = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onFinished(reply); });
+}
+
+void MutationJournal::onFinished(QNetworkReply *reply) {
+    reply->deleteLater();
+    m_inFlight = nullptr;
+    if (m_pending.isEmpty()) return;
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QByteArray data = reply->readAll();
+
+    if (status == 0) {
+        // No answer at all: offline, VPN down, timed out. Keep the entry and wait.
+        qWarning() << "Mutation journal:" << m_pending.first().kind << "not sent:" << reply->errorString();
+        setOnline(false);
+        scheduleRetry();
+        return;
+    }
+    setOnline(true);
+    // Retrying with the same token cannot help. The entry stays queued and is sent
+    // after the next login, since the journal is reloaded at startup.
+    if (status == 401) {
+        qWarning() << "Mutation journal: token rejected, holding" << m_pending.size() << "writes until the next login";
+        m_authExpired = true;
+        emit authExpired();
+        emit stateChanged(m_pending.size(), m_online);
+        return;
+    }
+    // Server trouble, rate limiting, or the same key still running: the write may yet
+    // succeed. A write that keeps failing is given up on, so it cannot hold back the
+    // entries queued after it forever.
+    if (status >= 500 || status == 408 || status == 409 || status == 429) {
+        if (++m_headAttempts < MaxServerAttempts) {
+            qWarning() << "Mutation journal:" << m_pending.first().kind << "got HTTP" << status << ", retrying";
+            scheduleRetry();
+            return;
+        }
+        qWarning() << "Mutation journal:" << m_pending.first().kind << "got HTTP" << status
+                   << "after" << m_headAttempts << "attempts, giving up";
+    }
+
+    const JournalEntry entry = m_pending.first();
+    finishHead();
+    const QJsonObject response = QJsonDocument::fromJson(data).object();
+    if (status >= 200 && status < 300) {
+        emit succeeded(entry, response);
+    } else {
+        QString message = response.value("message").toString();
+        if (message.isEmpty()) message = QString("HTTP %1: %2").arg(status).arg(reply->errorString());
+        qWarning() << "Mutation journal:" << entry.kind << entry.path << "rejected:" << message;
+        emit failed(entry, message);
+    }
+    sendNext();
+}
+
+void MutationJournal::finishHead() {
+    append(QJsonObject{{"op", "done"}, {"key", m_pending.first().key}});
+    m_pending.removeFirst();
+    m_retryDelayMs = 1000;
+    m_headAttempts = 0;
+    if (m_pending.isEmpty()) compact();
+    emit stateChanged(m_pending.size(), m_online);
+}
+
+void MutationJournal::scheduleRetry() {
+    m_retryTimer.start(m_retryDelayMs);
+    m_retryDelayMs = qMin(m_retryDelayMs * 2, MaxRetryDelayMs);
+}
+
+void MutationJournal::setOnline(bool online) {
+    if (m_online == online) return;
+    m_online = online;
+    emit stateChanged(m_pending.size(), m_online);
+}
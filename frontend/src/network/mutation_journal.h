@@ -0,0 +1,81 @@
+#pragma once
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QTimer>
+#include <QFile>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QVector>
+
+class QNetworkReply;
+
+// One queued write. `key` is also sent as Idempotency-Key, so a replay of a request
+// whose response was lost is answered from the server's record instead of applied twice.
+struct JournalEntry {
+    QString key;
+    QString kind;           // create_ticket, patch_ticket, delete_ticket, add_comment
+    QByteArray method;
+    QString path;           // below the API base URL, e.g. /tickets/<id>
+    QJsonObject body;
+    QString ticketId;
+    QDateTime queuedAt;
+
+    QJsonObject toJson() const;
+    static JournalEntry fromJson(const QJsonObject &obj);
+};
+
+// Durable, ordered queue of ticket and comment writes. Callers apply an edit to
+// their models right away and enqueue it; the journal appends it to a JSON-lines
+// file and sends entries one at a time, in order. While the server is unreachable
+// the head entry is retried with backoff, and the queue survives a restart.
+// An entry the server rejects is dropped and reported through failed(), and so is
+// one the server answered with a retryable error MaxServerAttempts times. A 401
+// means the session token has expired: the queue stops, keeps its entries for the
+// next login and reports authExpired().
+class MutationJournal : public QObject {
+    Q_OBJECT
+public:
+    static const int RequestTimeoutMs = 15000;
+    static const int MaxRetryDelayMs = 60000;
+    // Answers such as 5xx or 429 count; being offline does not.
+    static const int MaxServerAttempts = 8;
+
+    MutationJournal(const QString &path, const QString &jwt, QObject *parent = nullptr);
+    // Records the write and returns its key; it is sent after everything queued before it.
+    QString enqueue(const QString &kind, const QByteArray &method, const QString &path,
+                    const QJsonObject &body, const QString &ticketId);
+    int pendingCount() const { return m_pending.size(); }
+    bool isOnline() const { return m_online; }
+    bool isAuthExpired() const { return m_authExpired; }
+    bool hasPending(const QString &ticketId) const;
+    // Sends the head entry now instead of waiting out the backoff.
+    void retryNow();
+signals:
+    void succeeded(const JournalEntry &entry, const QJsonObject &response);
+    // The server refused the write; callers undo its local effect.
+    void failed(const JournalEntry &entry, const QString &error);
+    void stateChanged(int pending, bool online);
+    // The server refused the token; nothing more is sent until the next login.
+    void authExpired();
+private:
+    void load();
+    void append(const QJsonObject &record);
+    void compact();
+    void sendNext();
+    void onFinished(QNetworkReply *reply);
+    void finishHead();
+    void scheduleRetry();
+    void setOnline(bool online);
+
+    QFile m_file;
+    QString m_jwt;
+    QNetworkAccessManager m_network;
+    QVector<JournalEntry> m_pending;
+    QPointer<QNetworkReply> m_inFlight;
+    QTimer m_retryTimer;
+    int m_retryDelayMs = 1000;
+    int m_headAttempts = 0;     // retryable answers for the head entry, this session
+    bool m_online = true;
+    bool m_authExpired = false;
+};
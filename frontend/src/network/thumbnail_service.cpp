@@ -0,0 +1,174 @@
+#include "thumbnail_service.h"
+#include "../config.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QImageReader>
+#include <QBuffer>
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+#include <QtMath>
+#include <QDebug>
+
+static const qsizetype MemoryBudgetBytes = 32 * 1024 * 1024;
+static const int MaxDownloadRetries = 3;
+
+ThumbnailService::ThumbnailService(const QString &jwtToken, qreal devicePixelRatio, QObject *parent)
+    : QObject(parent), m_jwtToken(jwtToken), m_devicePixelRatio(devicePixelRatio), m_memory(MemoryBudgetBytes) {
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+    m_diskCacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+    QDir().mkpath(m_diskCacheDir);
+}
+
+ThumbnailService::~ThumbnailService() {
+    for (const Job &job : std::as_const(m_pending)) {
+        *job.cancelled = true;
+    }
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+QPixmap ThumbnailService::thumbnail(const QString &attachmentId) const {
+    const QPixmap *pix = m_memory.object(attachmentId);
+    return pix ? *pix : QPixmap();
+}
+
+QString ThumbnailService::diskCachePath(const QString &attachmentId) const {
+    const int px = qCeil(ThumbnailSize * m_devicePixelRatio);
+    return QString("%1/%2_%3.png").arg(m_diskCacheDir, attachmentId).arg(px);
+}
+
+QImage ThumbnailService::decodeScaled(const QByteArray &data) const {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    reader.setAutoTransform(true);
+    const QSize full = reader.size();
+    if (full.isValid()) {
+        const int px = qCeil(ThumbnailSize * m_devicePixelRatio);
+        if (full.width() > px || full.height() > px) {
+            reader.setScaledSize(full.scaled(px, px, Qt::KeepAspectRatio));
+        }
+    }
+    return reader.read();
+}
+
+void ThumbnailService::request(const QString &ticketId, const QString &attachmentId) {
+    if (m_memory.contains(attachmentId) || m_pending.contains(attachmentId) || m_failed.contains(attachmentId)) return;
+    Job job;
+    job.ticketId = ticketId;
+    job.cancelled = CancelFlag::create(false);
+    m_pending.insert(attachmentId, job);
+
+    const CancelFlag cancelled = job.cancelled;
+    const QString path = diskCachePath(attachmentId);
+    m_pool.start([this, attachmentId, cancelled, path]() {
+        if (*cancelled) return;
+        QImage image;
+        if (QFile::exists(path)) {
+            QImageReader reader(path);
+            image = reader.read();
+        }
+        if (image.isNull()) {
+            QMetaObject::invokeMethod(this, [this, attachmentId, cancelled]() {
+                startDownload(attachmentId, cancelled);
+            }, Qt::QueuedConnection);
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, attachmentId, cancelled, image]() {
+            finishJob(attachmentId, cancelled, image);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ThumbnailService::startDownload(const QString &attachmentId, const CancelFlag &cancelled, bool fromThumbnailEndpoint) {
+    if (*cancelled) return;
+    auto it = m_pending.find(attachmentId);
+    if (it == m_pending.end()) return;
+    // The server keeps ready-made thumbnails; the original is only fetched when it has none.
+    QString url = QString("%1/tickets/%2/attachments/%3/").arg(Config::instance().fullApiUrl(), it->ticketId, attachmentId);
+    if (fromThumbnailEndpoint) {
+        url += QString("thumbnail?size=%1").arg(qCeil(ThumbnailSize * m_devicePixelRatio));
+    } else {
+        url += "download";
+    }
+    QNetworkRequest req{QUrl(url)};
+    req.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
+    QNetworkReply *reply = m_network.get(req);
+    it->reply = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, attachmentId, cancelled, fromThumbnailEndpoint]() {
+        reply->deleteLater();
+        if (*cancelled) return;
+        if (fromThumbnailEndpoint && reply->error() == QNetworkReply::ContentNotFoundError) {
+            startDownload(attachmentId, cancelled, false);
+            return;
+        }
+        auto it = m_pending.find(attachmentId);
+        if (it == m_pending.end()) return;
+        it->reply = nullptr;
+        if (reply->error() != QNetworkReply::NoError) {
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            qDebug() << "Failed to load thumbnail source for" << attachmentId << ":" << reply->errorString();
+            if (status >= 400 && status < 500 && status != 408 && status != 429) {
+                finishJob(attachmentId, cancelled, QImage());
+                return;
+            }
+            // Connection errors, 5xx, 408 and 429 may pass; they are retried and, failing
+            // that, left out of m_failed so the next request tries again.
+            const int attempt = ++it->attempts;
+            if (attempt > MaxDownloadRetries) {
+                m_pending.erase(it);
+                return;
+            }
+            QTimer::singleShot(1000 << (attempt - 1), this, [this, attachmentId, cancelled, fromThumbnailEndpoint]() {
+                startDownload(attachmentId, cancelled, fromThumbnailEndpoint);
+            });
+            return;
+        }
+        const QByteArray data = reply->readAll();
+        const QString path = diskCachePath(attachmentId);
+        m_pool.start([this, attachmentId, cancelled, data, path]() {
+            if (*cancelled) return;
+            QImage image = decodeScaled(data);
+            if (!image.isNull()) {
+                QSaveFile file(path);
+                if (file.open(QIODevice::WriteOnly) && image.save(&file, "PNG")) {
+                    file.commit();
+                }
+            }
+            QMetaObject::invokeMethod(this, [this, attachmentId, cancelled, image]() {
+                finishJob(attachmentId, cancelled, image);
+            }, Qt::QueuedConnection);
+        });
+    });
+}
+
+void ThumbnailService::finishJob(const QString &attachmentId, const CancelFlag &cancelled, const QImage &image) {
+    if (*cancelled) return;
+    m_pending.remove(attachmentId);
+    if (image.isNull()) {
+        m_failed.insert(attachmentId);
+        return;
+    }
+    auto *pix = new QPixmap(QPixmap::fromImage(image));
+    pix->setDevicePixelRatio(m_devicePixelRatio);
+    const qsizetype cost = qsizetype(pix->width()) * pix->height() * qMax(1, pix->depth() / 8);
+    m_memory.insert(attachmentId, pix, cost);
+    emit thumbnailReady(attachmentId);
+}
+
+void ThumbnailService::retainOnly(const QSet<QString> &attachmentIds) {
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (attachmentIds.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        *it->cancelled = true;
+        if (it->reply) it->reply->abort();
+        it = m_pending.erase(it);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
+#include <QImage>
+#include <QThreadPool>
+#include <QSharedPointer>
+#include <QNetworkAccessManager>
+#include <atomic>
+
+class QNetworkReply;
+
+// Produces attachment thumbnails off the GUI thread. Decoded thumbnails live in a
+// byte-budgeted LRU backed by an on-disk cache; the GUI only ever reads ready pixmaps.
+class ThumbnailService : public QObject {
+    Q_OBJECT
+public:
+    static const int ThumbnailSize = 128;
+
+    ThumbnailService(const QString &jwtToken, qreal devicePixelRatio, QObject *parent = nullptr);
+    ~ThumbnailService() override;
+
+    // Returns a ready thumbnail or a null pixmap. Never starts any work.
+    QPixmap thumbnail(const QString &attachmentId) const;
+    // Starts loading a thumbnail unless it is cached, in flight or known to be
+    // missing or undecodable. Transient network errors are not remembered.
+    void request(const QString &ticketId, const QString &attachmentId);
+    // Cancels every in-flight request whose attachment is not in the given set.
+    void retainOnly(const QSet<QString> &attachmentIds);
+signals:
+    void thumbnailReady(const QString &attachmentId);
+private:
+    using CancelFlag = QSharedPointer<std::atomic_bool>;
+    struct Job {
+        QString ticketId;
+        CancelFlag cancelled;
+        QNetworkReply *reply = nullptr;
+        int attempts = 0;
+    };
+
+    void startDownload(const QString &attachmentId, const CancelFlag &cancelled, bool fromThumbnailEndpoint = true);
+    void finishJob(const QString &attachmentId, const CancelFlag &cancelled, const QImage &image);
+    QString diskCachePath(const QString &attachmentId) const;
+    QImage decodeScaled(const QByteArray &data) const;
+
+    QString m_jwtToken;
+    qreal m_devicePixelRatio;
+    QString m_diskCacheDir;
+    QNetworkAccessManager m_network;
+    QThreadPool m_pool;
+    QHash<QString, Job> m_pending;
+    QSet<QString> m_failed;
+    QCache<QString, QPixmap> m_memory;
+};
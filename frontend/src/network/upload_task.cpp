@@ -0,0 +1,302 @@
+#include "upload_task.h"
+#include "file_hash.h"
+#include "../config.h"
+#include "../models/ticket_model.h"
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QFileInfo>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QSet>
+#include <QThread>
+#include <QDebug>
+#include <memory>
+
+static const int MaxChunkRetries = 3;
+
+static QSettings &resumeStore() {
+    static QSettings settings(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/uploads.ini", QSettings::IniFormat);
+    return settings;
+}
+
+UploadTask::UploadTask(const QString &jwtToken, const QString &ticketId, const QString &ticketCreatedAt,
+                       const QString &filePath, QObject *parent)
+    : QObject(parent), m_jwtToken(jwtToken), m_ticketId(ticketId), m_ticketCreatedAt(ticketCreatedAt),
+      m_filePath(filePath), m_file(filePath) {
+    m_sampleTimer.setInterval(500);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &UploadTask::sampleThroughput);
+}
+
+QString UploadTask::fileName() const {
+    if (!m_uploadName.isEmpty()) return m_uploadName;
+    return QFileInfo(m_filePath).fileName();
+}
+
+QNetworkRequest UploadTask::makeApiRequest(const QString &path) const {
+    QNetworkRequest req(QUrl(Config::instance().fullApiUrl() + path));
+    req.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
+    return req;
+}
+
+QNetworkRequest UploadTask::makeRequest(const QString &path) const {
+    return makeApiRequest(TicketItem::apiPath(m_ticketId, m_ticketCreatedAt, "/uploads" + path));
+}
+
+// Same ticket, same file, same size and mtime: the server-side chunks still apply.
+QString UploadTask::resumeKey() const {
+    QFileInfo info(m_filePath);
+    QByteArray identity = (m_ticketId + '|' + info.absoluteFilePath() + '|' + QString::number(info.size()) + '|'
+        + QString::number(info.lastModified().toMSecsSinceEpoch())).toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex());
+}
+
+void UploadTask::rememberUpload() {
+    resumeStore().setValue("uploads/" + resumeKey(), m_uploadId);
+}
+
+void UploadTask::forgetUpload() {
+    resumeStore().remove("uploads/" + resumeKey());
+}
+
+void UploadTask::start() {
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        fail("Failed to open file for reading");
+        return;
+    }
+    m_total = m_file.size();
+    m_clock.start();
+    m_uploadId = resumeStore().value("uploads/" + resumeKey()).toString();
+    if (m_uploadId.isEmpty()) {
+        hashFile();
+    } else {
+        qDebug() << "Resuming upload" << m_uploadId << "for" << m_filePath;
+        queryStatus();
+    }
+}
+
+void UploadTask::hashFile() {
+    const QString path = m_filePath;
+    auto digest = std::make_shared<QByteArray>();
+    QThread *thread = QThread::create([path, digest]() { *digest = sha256OfFile(path); });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    connect(thread, &QThread::finished, this, [this, digest]() {
+        if (m_stopped) return;
+        m_sha256 = *digest;
+        if (m_sha256.isEmpty()) {
+            initiate();
+        } else {
+            lookupBlob();
+        }
+    });
+    thread->start();
+}
+
+// A 404 (or any other failure) just means the content has to be sent.
+void UploadTask::lookupBlob() {
+    QNetworkReply *reply = m_network.head(makeApiRequest("/blobs/" + QString::fromLatin1(m_sha256)));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (m_stopped) return;
+        if (reply->error() == QNetworkReply::NoError) {
+            attachByHash();
+        } else {
+            initiate();
+        }
+    });
+}
+
+void UploadTask::attachByHash() {
+    QNetworkRequest req = makeApiRequest(TicketItem::apiPath(m_ticketId, m_ticketCreatedAt, "/attachments/by-hash"));
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    QJsonObject body;
+    body["sha256"] = QString::fromLatin1(m_sha256);
+    body["filename"] = fileName();
+    QNetworkReply *reply = m_network.post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (m_stopped) return;
+        if (reply->error() != QNetworkReply::NoError) {
+            // The blob may have been released in the meantime; fall back to a real upload.
+            qDebug() << "Attach by hash failed, uploading" << m_filePath << ":" << reply->errorString();
+            initiate();
+            return;
+        }
+        qDebug() << "Attached" << m_filePath << "by hash, no transfer needed";
+        m_stopped = true;
+        emit progress(m_total, m_total, 0, 0);
+        emit finished(QJsonDocument::fromJson(reply->readAll()).object());
+        deleteLater();
+    });
+}
+
+void UploadTask::initiate() {
+    QNetworkRequest req = makeRequest(QString());
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    QJsonObject body;
+    body["filename"] = fileName();
+    body["size_bytes"] = m_total;
+    if (!m_sha256.isEmpty()) body["sha256"] = QString::fromLatin1(m_sha256);
+    QNetworkReply *reply = m_network.post(req, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (m_stopped) return;
+        if (reply->error() != QNetworkReply::NoError) {
+            fail(reply->errorString());
+            return;
+        }
+        const QJsonObject status = QJsonDocument::fromJson(reply->readAll()).object();
+        m_uploadId = status.value("upload_id").toString();
+        rememberUpload();
+        onStatus(status);
+    });
+}
+
+void UploadTask::queryStatus() {
+    QNetworkReply *reply = m_network.get(makeRequest("/" + m_uploadId));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (m_stopped) return;
+        if (reply->error() == QNetworkReply::ContentNotFoundError) {
+            // The server dropped the session; start over.
+            forgetUpload();
+            hashFile();
+            return;
+        }
+        if (reply->error() != QNetworkReply::NoError) {
+            fail(reply->errorString());
+            return;
+        }
+        onStatus(QJsonDocument::fromJson(reply->readAll()).object());
+    });
+}
+
+void UploadTask::onStatus(const QJsonObject &status) {
+    m_chunkSize = status.value("chunk_size").toInteger();
+    if (m_chunkSize <= 0) {
+        fail("Server returned an invalid chunk size");
+        return;
+    }
+    QSet<qint64> received;
+    for (const QJsonValue &value : status.value("received_offsets").toArray()) {
+        received.insert(value.toInteger());
+    }
+    m_acked = status.value("received_bytes").toInteger();
+    m_queue.clear();
+    for (qint64 offset = 0; offset < m_total || (offset == 0 && m_total == 0); offset += m_chunkSize) {
+        if (!received.contains(offset)) m_queue.append(offset);
+        if (m_total == 0) break;
+    }
+    m_lastSampleBytes = m_acked;
+    m_lastSampleMs = m_clock.elapsed();
+    m_sampleTimer.start();
+    sampleThroughput();
+    pump();
+}
+
+void UploadTask::pump() {
+    if (m_stopped) return;
+    while (m_inflightSent.size() < MaxConcurrentChunks && !m_queue.isEmpty()) {
+        sendChunk(m_queue.takeFirst());
+    }
+    if (m_inflightSent.isEmpty() && m_queue.isEmpty()) commit();
+}
+
+void UploadTask::sendChunk(qint64 offset) {
+    const qint64 length = qMin(m_chunkSize, m_total - offset);
+    if (!m_file.seek(offset)) {
+        fail(m_file.errorString());
+        return;
+    }
+    const QByteArray data = m_file.read(length);
+    if (data.size() != length) {
+        fail("The file changed while it was being uploaded");
+        return;
+    }
+    QNetworkRequest req = makeRequest(QString("/%1/chunks/%2").arg(m_uploadId).arg(offset));
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
+    QNetworkReply *reply = m_network.put(req, data);
+    m_inflightSent.insert(reply, 0);
+    connect(reply, &QNetworkReply::uploadProgress, this, [this, reply](qint64 sent, qint64) {
+        if (m_inflightSent.contains(reply)) m_inflightSent[reply] = sent;
+    });
+    connect(reply, &QNetworkReply::finished, this, [this, reply, offset, length]() {
+        reply->deleteLater();
+        m_inflightSent.remove(reply);
+        if (m_stopped) return;
+        if (reply->error() != QNetworkReply::NoError) {
+            const int attempt = ++m_retries[offset];
+            if (attempt > MaxChunkRetries) {
+                fail(reply->errorString());
+                return;
+            }
+            qDebug() << "Chunk at" << offset << "failed, retrying:" << reply->errorString();
+            QTimer::singleShot(1000 * attempt, this, [this, offset]() {
+                m_queue.prepend(offset);
+                pump();
+            });
+            return;
+        }
+        m_acked += length;
+        pump();
+    });
+}
+
+void UploadTask::commit() {
+    m_sampleTimer.stop();
+    sampleThroughput();
+    QNetworkReply *reply = m_network.post(makeRequest("/" + m_uploadId + "/commit"), QByteArray());
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (m_stopped) return;
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 409 && !m_resynced) {
+            // The server is missing chunks we believed acknowledged: re-read its view once.
+            m_resynced = true;
+            queryStatus();
+            return;
+        }
+        if (reply->error() != QNetworkReply::NoError) {
+            if (status == 422) forgetUpload();
+            fail(reply->errorString());
+            return;
+        }
+        forgetUpload();
+        m_stopped = true;
+        emit finished(QJsonDocument::fromJson(reply->readAll()).object());
+        deleteLater();
+    });
+}
+
+void UploadTask::sampleThroughput() {
+    qint64 sent = m_acked;
+    for (qint64 inflight : std::as_const(m_inflightSent)) sent += inflight;
+    const qint64 now = m_clock.elapsed();
+    const qint64 dt = now - m_lastSampleMs;
+    if (dt > 0 && sent >= m_lastSampleBytes) {
+        const double instant = double(sent - m_lastSampleBytes) * 1000.0 / dt;
+        m_rate = m_rate == 0 ? instant : 0.8 * m_rate + 0.2 * instant;
+    }
+    m_lastSampleBytes = sent;
+    m_lastSampleMs = now;
+    const int eta = m_rate > 0 ? int((m_total - sent) / m_rate) : -1;
+    emit progress(sent, m_total, m_rate, eta);
+}
+
+void UploadTask::fail(const QString &error) {
+    if (m_stopped) return;
+    m_stopped = true;
+    m_sampleTimer.stop();
+    const auto replies = m_inflightSent.keys();
+    m_inflightSent.clear();
+    for (QNetworkReply *reply : replies) reply->abort();
+    qWarning() << "Upload of" << m_filePath << "failed:" << error;
+    emit failed(error);
+    deleteLater();
+}
+
+void UploadTask::cancel() {
+    fail("Cancelled");
+}
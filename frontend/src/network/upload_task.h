@@ -0,0 +1,76 @@
+#pragma once
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QJsonObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QNetworkReply;
+
+// Uploads one file through the chunked upload API: initiate, PUT chunks (several
+// in flight), commit. The file is hashed first; if the server already stores the
+// same content it is attached by hash and nothing is transferred. The upload id is
+// remembered per file, so starting the same file again resumes after the chunks
+// the server has already acknowledged.
+class UploadTask : public QObject {
+    Q_OBJECT
+public:
+    static const int MaxConcurrentChunks = 3;
+
+    UploadTask(const QString &jwtToken, const QString &ticketId, const QString &ticketCreatedAt, const QString &filePath,
+               QObject *parent = nullptr);
+    void start();
+    // Stops sending; the server keeps the received chunks for a later resume.
+    void cancel();
+    QString filePath() const { return m_filePath; }
+    // Name stored on the server; defaults to the file name of filePath().
+    void setUploadName(const QString &name) { m_uploadName = name; }
+    QString fileName() const;
+signals:
+    void progress(qint64 sent, qint64 total, double bytesPerSecond, int etaSeconds);
+    void finished(const QJsonObject &attachment);
+    void failed(const QString &error);
+private:
+    QNetworkRequest makeRequest(const QString &path) const;
+    QNetworkRequest makeApiRequest(const QString &path) const;
+    void hashFile();
+    void lookupBlob();
+    void attachByHash();
+    void initiate();
+    void queryStatus();
+    void onStatus(const QJsonObject &status);
+    void pump();
+    void sendChunk(qint64 offset);
+    void commit();
+    void sampleThroughput();
+    void fail(const QString &error);
+    QString resumeKey() const;
+    void rememberUpload();
+    void forgetUpload();
+
+    QString m_jwtToken;
+    QString m_ticketId;
+    QString m_ticketCreatedAt;
+    QString m_filePath;
+    QString m_uploadName;
+    QFile m_file;
+    QNetworkAccessManager m_network;
+    QString m_uploadId;
+    QByteArray m_sha256;
+    qint64 m_total = 0;
+    qint64 m_chunkSize = 0;
+    qint64 m_acked = 0;
+    QList<qint64> m_queue;
+    QHash<QNetworkReply *, qint64> m_inflightSent;
+    QHash<qint64, int> m_retries;
+    bool m_resynced = false;
+    bool m_stopped = false;
+    QTimer m_sampleTimer;
+    QElapsedTimer m_clock;
+    qint64 m_lastSampleBytes = 0;
+    qint64 m_lastSampleMs = 0;
+    double m_rate = 0;
+};
@@ -0,0 +1,168 @@
+#include "assignee_picker.h"
+#include "../config.h"
+#include <QCompleter>
+#include <QAbstractItemView>
+#include <QTimer>
+#include <QUrlQuery>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QDebug>
+
+AssigneePicker::AssigneePicker(QWidget *parent)
+    : QLineEdit(parent),
+      m_model(new AssigneeModel(this)),
+      m_completer(new QCompleter(this)),
+      m_searchTimer(new QTimer(this)) {
+    setPlaceholderText("Type to search assignees...");
+    // The model is already filtered, so the completer must show it as is.
+    m_completer->setModel(m_model);
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_completer->setMaxVisibleItems(12);
+    m_completer->setWidget(this);
+    connect(m_completer, QOverload<const QModelIndex &>::of(&QCompleter::activated),
+            this, &AssigneePicker::onCompletionActivated);
+
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(RemoteSearchDelayMs);
+    connect(m_searchTimer, &QTimer::timeout, this, &AssigneePicker::searchRemote);
+    connect(this, &QLineEdit::textEdited, this, &AssigneePicker::onTextEdited);
+
+    UserDirectory &directory = UserDirectory::instance();
+    connect(&directory, &UserDirectory::loaded, this, &AssigneePicker::onDirectoryLoaded);
+    directory.ensureLoaded();
+    if (directory.isLoaded()) m_model->setFilter(QString(), m_departmentId);
+}
+
+void AssigneePicker::setDepartment(int departmentId) {
+    m_departmentId = departmentId > 0 ? departmentId : 0;
+    const UserDirectory &directory = UserDirectory::instance();
+    if (!directory.isLoaded()) {
+        // Decided once the directory arrives; meanwhile offer server-side matches.
+        m_searchTimer->start();
+        return;
+    }
+    refreshSuggestions(false);
+    const UserInfo *current = directory.userById(m_userId);
+    if (!current || (m_departmentId > 0 && current->departmentId != m_departmentId)) {
+        selectFirstInDepartment();
+    }
+}
+
+void AssigneePicker::setCurrentUser(const QString &userId, const QString &username) {
+    QString name = username;
+    if (const UserInfo *user = UserDirectory::instance().userById(userId)) name = user->username;
+    select(userId, name);
+}
+
+void AssigneePicker::select(const QString &userId, const QString &username) {
+    m_username = username;
+    setText(username);
+    if (m_userId == userId) return;
+    m_userId = userId;
+    emit selectionChanged(m_userId);
+}
+
+void AssigneePicker::onTextEdited(const QString &text) {
+    if (!m_userId.isEmpty() && text != m_username) {
+        m_userId.clear();
+        m_username.clear();
+        emit selectionChanged(QString());
+    }
+    if (UserDirectory::instance().isLoaded()) {
+        refreshSuggestions(true);
+    } else {
+        m_searchTimer->start();
+    }
+}
+
+void AssigneePicker::onCompletionActivated(const QModelIndex &index) {
+    if (!index.isValid()) return;
+    select(index.data(AssigneeModel::UserIdRole).toString(), index.data(Qt::DisplayRole).toString());
+}
+
+void AssigneePicker::onDirectoryLoaded() {
+    m_searchTimer->stop();
+    ++m_searchGeneration;
+    const UserDirectory &directory = UserDirectory::instance();
+    refreshSuggestions(hasFocus() && m_userId.isEmpty());
+    const UserInfo *current = directory.userById(m_userId);
+    if (current) {
+        if (m_departmentId <= 0 || current->departmentId == m_departmentId) {
+            select(current->userId, current->username);
+            return;
+        }
+    }
+    // Keep whatever the user is typing; only fill an untouched field.
+    if (m_userId.isEmpty() && !text().isEmpty()) return;
+    selectFirstInDepartment();
+}
+
+void AssigneePicker::refreshSuggestions(bool showPopup) {
+    const QString prefix = m_userId.isEmpty() ? text() : QString();
+    m_model->setFilter(prefix, m_departmentId);
+    if (showPopup && m_model->rowCount() > 0) {
+        m_completer->complete();
+    } else if (m_model->rowCount() == 0) {
+        m_completer->popup()->hide();
+    }
+}
+
+void AssigneePicker::searchRemote() {
+    QUrl url(Config::instance().fullApiUrl() + "/users");
+    QUrlQuery query;
+    query.addQueryItem("q", m_userId.isEmpty() ? text().trimmed() : QString());
+    if (m_departmentId > 0) query.addQueryItem("department_id", QString::number(m_departmentId));
+    query.addQueryItem("limit", QString::number(RemoteSearchLimit));
+    url.setQuery(query);
+
+    const int generation = ++m_searchGeneration;
+    QNetworkReply *reply = m_network.get(QNetworkRequest(url));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, generation]() {
+        reply->deleteLater();
+        // A newer search or the full directory has superseded this one.
+        if (generation != m_searchGeneration || UserDirectory::instance().isLoaded()) return;
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "Assignee search failed:" << reply->errorString();
+            return;
+        }
+        QVector<UserInfo> users;
+        for (const QJsonValue &v : QJsonDocument::fromJson(reply->readAll()).array()) {
+            const QJsonObject o = v.toObject();
+            QString userId = o.value("user_id").toString();
+            if (userId.isEmpty()) userId = o.value("id").toString();
+            const QString username = o.value("username").toString();
+            const int deptId = o.value("department_id").toInt(-1);
+            if (userId.isEmpty() || username.isEmpty() || deptId <= 0) {
+                qWarning() << "Skipping assignee match without id, username or department:" << o;
+                continue;
+            }
+            users.append({username, userId, deptId});
+        }
+        m_model->setRemoteUsers(users);
+        if (m_autoSelectFirst && m_userId.isEmpty() && text().isEmpty() && !users.isEmpty()) {
+            select(users.first().userId, users.first().username);
+        } else if (hasFocus() && m_userId.isEmpty() && !users.isEmpty()) {
+            m_completer->complete();
+        }
+    });
+}
+
+void AssigneePicker::selectFirstInDepartment() {
+    if (!m_autoSelectFirst) {
+        if (!m_userId.isEmpty()) select(QString(), QString());
+        return;
+    }
+    const UserDirectory &directory = UserDirectory::instance();
+    const UserDirectory::Range range = directory.find(QString(), m_departmentId);
+    if (range.size() == 0) {
+        select(QString(), QString());
+        setPlaceholderText("No assignees for department");
+        return;
+    }
+    setPlaceholderText("Type to search assignees...");
+    const UserInfo &first = directory.at(range, 0);
+    select(first.userId, first.username);
+}
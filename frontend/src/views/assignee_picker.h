@@ -0,0 +1,46 @@
+#pragma once
+#include <QLineEdit>
+#include <QNetworkAccessManager>
+#include "models/user_directory.h"
+
+class QCompleter;
+class QTimer;
+
+// Type-ahead assignee field. Suggestions come from the shared UserDirectory, filtered
+// by name prefix and the current department; before the directory has arrived the
+// same filter is sent to GET /users?q=&department_id= instead.
+class AssigneePicker : public QLineEdit {
+    Q_OBJECT
+public:
+    static const int RemoteSearchDelayMs = 150;
+    static const int RemoteSearchLimit = 50;
+
+    explicit AssigneePicker(QWidget *parent = nullptr);
+    // Restricts suggestions to a department. If the selected user is not in it, the
+    // department's first user (by name) is selected instead.
+    void setDepartment(int departmentId);
+    void setCurrentUser(const QString &userId, const QString &username);
+    QString selectedUserId() const { return m_userId; }
+    // Whether an empty field is filled with the department's first user (default on).
+    void setAutoSelectFirst(bool enabled) { m_autoSelectFirst = enabled; }
+signals:
+    void selectionChanged(const QString &userId);
+private:
+    void select(const QString &userId, const QString &username);
+    void onTextEdited(const QString &text);
+    void onCompletionActivated(const QModelIndex &index);
+    void onDirectoryLoaded();
+    void refreshSuggestions(bool showPopup);
+    void searchRemote();
+    void selectFirstInDepartment();
+
+    AssigneeModel *m_model;
+    QCompleter *m_completer;
+    QTimer *m_searchTimer;
+    QNetworkAccessManager m_network;
+    int m_departmentId = 0;
+    bool m_autoSelectFirst = true;
+    int m_searchGeneration = 0;
+    QString m_userId;
+    QString m_username;
+};
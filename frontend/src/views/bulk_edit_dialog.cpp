@@ -0,0 +1,69 @@
+#include "bulk_edit_dialog.h"
+#include "assignee_picker.h"
+#include "models/ticket_model.h"
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+BulkEditDialog::BulkEditDialog(int ticketCount, QWidget *parent) : QDialog(parent) {
+    setWindowTitle("Edit selected tickets");
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(new QLabel(QString("Change %1 tickets. Unchecked fields are left as they are.").arg(ticketCount), this));
+
+    QFormLayout *form = new QFormLayout();
+    m_statusCheck = new QCheckBox("Status", this);
+    m_statusCombo = new QComboBox(this);
+    for (auto it = TicketItem::statusLabels.cbegin(); it != TicketItem::statusLabels.cend(); ++it)
+        m_statusCombo->addItem(it.value(), it.key());
+    form->addRow(m_statusCheck, m_statusCombo);
+
+    m_priorityCheck = new QCheckBox("Priority", this);
+    m_priorityCombo = new QComboBox(this);
+    for (auto it = TicketItem::priorityLabels.cbegin(); it != TicketItem::priorityLabels.cend(); ++it)
+        m_priorityCombo->addItem(it.value(), it.key());
+    form->addRow(m_priorityCheck, m_priorityCombo);
+
+    m_assigneeCheck = new QCheckBox("Assignee", this);
+    m_assigneePicker = new AssigneePicker(this);
+    m_assigneePicker->setAutoSelectFirst(false);
+    form->addRow(m_assigneeCheck, m_assigneePicker);
+    layout->addLayout(form);
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this);
+    m_okButton = buttons->button(QDialogButtonBox::Ok);
+    m_okButton->setText("Apply");
+    layout->addWidget(buttons);
+    connect(buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    // Editing a field turns it on.
+    connect(m_statusCombo, QOverload<int>::of(&QComboBox::activated), m_statusCheck, [this]{ m_statusCheck->setChecked(true); });
+    connect(m_priorityCombo, QOverload<int>::of(&QComboBox::activated), m_priorityCheck, [this]{ m_priorityCheck->setChecked(true); });
+    connect(m_assigneePicker, &AssigneePicker::selectionChanged, this, [this](const QString &userId) {
+        if (!userId.isEmpty()) m_assigneeCheck->setChecked(true);
+        updateOkButton();
+    });
+    for (QCheckBox *check : {m_statusCheck, m_priorityCheck, m_assigneeCheck})
+        connect(check, &QCheckBox::toggled, this, &BulkEditDialog::updateOkButton);
+    updateOkButton();
+}
+
+QJsonObject BulkEditDialog::patch() const {
+    QJsonObject patch;
+    if (m_statusCheck->isChecked() && m_statusCombo->currentIndex() >= 0)
+        patch["status_id"] = m_statusCombo->currentData().toInt();
+    if (m_priorityCheck->isChecked() && m_priorityCombo->currentIndex() >= 0)
+        patch["priority_id"] = m_priorityCombo->currentData().toInt();
+    if (m_assigneeCheck->isChecked() && !m_assigneePicker->selectedUserId().isEmpty())
+        patch["assignee_id"] = m_assigneePicker->selectedUserId();
+    return patch;
+}
+
+void BulkEditDialog::updateOkButton() {
+    const bool assigneeMissing = m_assigneeCheck->isChecked() && m_assigneePicker->selectedUserId().isEmpty();
+    m_okButton->setEnabled(!assigneeMissing && !patch().isEmpty());
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <QDialog>
+#include <QJsonObject>
+
+class QComboBox;
+class QCheckBox;
+class QPushButton;
+class AssigneePicker;
+
+// Picks the fields to change on a set of tickets. Only the fields that are switched
+// on end up in patch(), which is sent as-is to POST /tickets/batch.
+class BulkEditDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit BulkEditDialog(int ticketCount, QWidget *parent = nullptr);
+    QJsonObject patch() const;
+private:
+    void updateOkButton();
+
+    QCheckBox *m_statusCheck;
+    QComboBox *m_statusCombo;
+    QCheckBox *m_priorityCheck;
+    QComboBox *m_priorityCombo;
+    QCheckBox *m_assigneeCheck;
+    AssigneePicker *m_assigneePicker;
+    QPushButton *m_okButton;
+};
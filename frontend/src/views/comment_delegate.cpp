@@ -0,0 +1,130 @@
+#include "comment_delegate.h"
+#include "models/comment_model.h"
+#include <QAbstractItemView>
+#include <QPainter>
+#include <QFontMetrics>
+#include <QTextOption>
+#include <QtMath>
+
+static const int CommentPadding = 8;
+static const int HeaderSpacing = 4;
+static const int MaxCachedLayouts = 4000;
+
+CommentDelegate::CommentDelegate(QAbstractItemModel *model, QAbstractItemView *view)
+    : QStyledItemDelegate(view), m_view(view), m_layouts(MaxCachedLayouts) {
+    connect(model, &QAbstractItemModel::dataChanged, this,
+        [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+            for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                m_layouts.remove(cacheKey(topLeft.siblingAtRow(row)));
+            }
+        });
+    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+        [this, model](const QModelIndex &parent, int first, int last) {
+            for (int row = first; row <= last; ++row) {
+                m_layouts.remove(cacheKey(model->index(row, 0, parent)));
+            }
+        });
+    connect(model, &QAbstractItemModel::modelReset, this, &CommentDelegate::invalidateAll);
+}
+
+QString CommentDelegate::cacheKey(const QModelIndex &index) {
+    return index.data(CommentModel::IdRole).toString();
+}
+
+int CommentDelegate::layoutWidth() const {
+    return qMax(1, m_view->viewport()->width());
+}
+
+void CommentDelegate::invalidate(const QString &commentId) {
+    m_layouts.remove(commentId);
+}
+
+void CommentDelegate::invalidateAll() {
+    m_layouts.clear();
+}
+
+CommentDelegate::CommentLayout *CommentDelegate::layoutFor(const QModelIndex &index, int width, const QFont &font) const {
+    const QString key = cacheKey(index);
+    if (CommentLayout *cached = m_layouts.object(key)) {
+        if (cached->width == width) return cached;
+    }
+
+    // A row number would name another comment once pages are prepended, so
+    // a comment without an id is laid out on every call instead of cached.
+    CommentLayout *entry = new CommentLayout;
+    if (key.isEmpty()) m_uncached.reset(entry);
+    entry->width = width;
+    entry->author = index.data(CommentModel::AuthorNameRole).toString();
+    if (entry->author.isEmpty()) entry->author = "Unknown";
+    entry->timestamp = index.data(CommentModel::CreatedAtRole).toDateTime().toLocalTime().toString("hh:mm dd.MM.yyyy");
+
+    QFont authorFont = font;
+    authorFont.setBold(true);
+    QFontMetrics authorMetrics(authorFont);
+    entry->authorWidth = authorMetrics.horizontalAdvance(entry->author);
+    entry->headerHeight = authorMetrics.height();
+
+    QTextOption textOption;
+    textOption.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    entry->body.setText(index.data(CommentModel::ContentRole).toString());
+    entry->body.setFont(font);
+    entry->body.setTextOption(textOption);
+    entry->body.setCacheEnabled(true);
+
+    const int textWidth = qMax(1, width - 2 * CommentPadding);
+    qreal y = 0;
+    entry->body.beginLayout();
+    for (QTextLine line = entry->body.createLine(); line.isValid(); line = entry->body.createLine()) {
+        line.setLineWidth(textWidth);
+        line.setPosition(QPointF(0, y));
+        y += line.height();
+    }
+    entry->body.endLayout();
+
+    entry->height = CommentPadding + entry->headerHeight + HeaderSpacing + qCeil(y) + CommentPadding;
+    if (!key.isEmpty()) m_layouts.insert(key, entry);
+    return entry;
+}
+
+void CommentDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    CommentLayout *layout = layoutFor(index, layoutWidth(), option.font);
+    const bool selected = option.state & QStyle::State_Selected;
+    const QRect rect = option.rect;
+
+    painter->save();
+    if (selected) {
+        painter->fillRect(rect, option.palette.highlight());
+    }
+    const QColor textColor = selected ? option.palette.highlightedText().color() : option.palette.text().color();
+    const int x = rect.left() + CommentPadding;
+    const int headerTop = rect.top() + CommentPadding;
+
+    QFont authorFont = option.font;
+    authorFont.setBold(true);
+    painter->setFont(authorFont);
+    painter->setPen(textColor);
+    painter->drawText(QRect(x, headerTop, layout->authorWidth, layout->headerHeight), Qt::AlignLeft | Qt::AlignVCenter, layout->author);
+
+    QFont timeFont = option.font;
+    if (option.font.pointSizeF() > 0) {
+        timeFont.setPointSizeF(option.font.pointSizeF() * 0.9);
+    } else {
+        timeFont.setPixelSize(qMax(1, qRound(option.font.pixelSize() * 0.9)));
+    }
+    painter->setFont(timeFont);
+    painter->setPen(selected ? textColor : option.palette.color(QPalette::Disabled, QPalette::Text));
+    const int timeX = x + layout->authorWidth + CommentPadding;
+    painter->drawText(QRect(timeX, headerTop, qMax(0, rect.right() - timeX), layout->headerHeight), Qt::AlignLeft | Qt::AlignVCenter, layout->timestamp);
+
+    painter->setPen(textColor);
+    layout->body.draw(painter, QPointF(x, headerTop + layout->headerHeight + HeaderSpacing));
+
+    painter->setPen(option.palette.color(QPalette::Midlight));
+    painter->drawLine(rect.left() + CommentPadding, rect.bottom(), rect.right() - CommentPadding, rect.bottom());
+    painter->restore();
+}
+
+QSize CommentDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    const int width = layoutWidth();
+    return QSize(width, layoutFor(index, width, option.font)->height);
+}
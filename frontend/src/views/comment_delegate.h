@@ -0,0 +1,39 @@
+#pragma once
+#include <QStyledItemDelegate>
+#include <QTextLayout>
+#include <QCache>
+#include <memory>
+
+class QAbstractItemModel;
+class QAbstractItemView;
+
+// Paints a comment as author + timestamp header and a word-wrapped body.
+// Text layouts are cached per comment id for the width they were built at, so
+// scrolling only blits; an entry is rebuilt when the width changes or the
+// comment is edited.
+class CommentDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+public:
+    CommentDelegate(QAbstractItemModel *model, QAbstractItemView *view);
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    void invalidate(const QString &commentId);
+    void invalidateAll();
+private:
+    struct CommentLayout {
+        int width = 0;
+        int height = 0;
+        int headerHeight = 0;
+        int authorWidth = 0;
+        QString author;
+        QString timestamp;
+        QTextLayout body;
+    };
+    CommentLayout *layoutFor(const QModelIndex &index, int width, const QFont &font) const;
+    int layoutWidth() const;
+    static QString cacheKey(const QModelIndex &index);
+
+    QAbstractItemView *m_view;
+    mutable QCache<QString, CommentLayout> m_layouts;
+    mutable std::unique_ptr<CommentLayout> m_uncached;
+};
@@ -0,0 +1,66 @@
+#include "comment_list_view.h"
+#include <QIdentityProxyModel>
+#include <QScrollBar>
+
+namespace {
+
+// QAbstractItemView asks for more rows whenever the *last* row is visible, which for a
+// bottom-anchored list is always. Only allow fetching when the view sits at the top.
+class TopFetchProxyModel : public QIdentityProxyModel {
+public:
+    explicit TopFetchProxyModel(QAbstractScrollArea *view)
+        : QIdentityProxyModel(view), m_view(view) {}
+    bool canFetchMore(const QModelIndex &parent) const override {
+        const QScrollBar *bar = m_view->verticalScrollBar();
+        return bar->value() == bar->minimum() && QIdentityProxyModel::canFetchMore(parent);
+    }
+private:
+    QAbstractScrollArea *m_view;
+};
+
+}
+
+CommentListView::CommentListView(QWidget *parent)
+    : QListView(parent) {
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setResizeMode(QListView::Adjust);
+    setUniformItemSizes(false);
+    connect(verticalScrollBar(), &QScrollBar::rangeChanged, this, [this](int, int max) {
+        if (!m_restoreAnchor) return;
+        m_restoreAnchor = false;
+        verticalScrollBar()->setValue(max - m_anchorFromBottom);
+    });
+}
+
+void CommentListView::setModel(QAbstractItemModel *model) {
+    disconnect(m_aboutToInsertConnection);
+    QIdentityProxyModel *oldProxy = m_proxy;
+    m_proxy = nullptr;
+    if (model) {
+        m_proxy = new TopFetchProxyModel(this);
+        m_proxy->setSourceModel(model);
+    }
+    QListView::setModel(m_proxy);
+    if (oldProxy) oldProxy->deleteLater();
+    if (!model) return;
+    m_aboutToInsertConnection = connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this,
+        [this, model](const QModelIndex &parent, int start, int) {
+            if (parent.isValid() || start != 0 || model->rowCount() == 0) return;
+            QScrollBar *bar = verticalScrollBar();
+            m_anchorFromBottom = bar->maximum() - bar->value();
+            m_restoreAnchor = true;
+        });
+}
+
+void CommentListView::reset() {
+    QListView::reset();
+    scrollToBottom();
+}
+
+void CommentListView::verticalScrollbarValueChanged(int value) {
+    QListView::verticalScrollbarValueChanged(value);
+    if (value == verticalScrollBar()->minimum() && model() && model()->canFetchMore(rootIndex())) {
+        model()->fetchMore(rootIndex());
+    }
+}
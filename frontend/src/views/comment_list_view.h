@@ -0,0 +1,21 @@
+#pragma once
+#include <QListView>
+
+class QIdentityProxyModel;
+
+// Chat-style list: newest comment at the bottom, older pages are fetched when
+// the user scrolls to the top, and the viewport stays anchored while they load.
+class CommentListView : public QListView {
+    Q_OBJECT
+public:
+    explicit CommentListView(QWidget *parent = nullptr);
+    void setModel(QAbstractItemModel *model) override;
+    void reset() override;
+protected slots:
+    void verticalScrollbarValueChanged(int value) override;
+private:
+    QIdentityProxyModel *m_proxy = nullptr;
+    QMetaObject::Connection m_aboutToInsertConnection;
+    int m_anchorFromBottom = 0;
+    bool m_restoreAnchor = false;
+};
@@ -0,0 +1,204 @@
+#include "dashboard_view.h"
+#include "../config.h"
+#include "models/ticket_model.h"
+#include "models/user_directory.h"
+#include <QComboBox>
+#include <QDateTime>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLabel>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTableWidget>
+#include <QUrlQuery>
+#include <QVBoxLayout>
+#include <QDebug>
+#include <functional>
+
+namespace {
+
+const QStringList AgeBuckets = {"0-1d", "1-7d", "7-30d", "30d+"};
+
+QTableWidget *makeTable(const QStringList &headers, QWidget *parent) {
+    auto *table = new QTableWidget(0, headers.size(), parent);
+    table->setHorizontalHeaderLabels(headers);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionMode(QAbstractItemView::NoSelection);
+    table->verticalHeader()->hide();
+    table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    return table;
+}
+
+QGroupBox *boxed(const QString &title, QWidget *widget, QWidget *parent) {
+    auto *box = new QGroupBox(title, parent);
+    auto *layout = new QVBoxLayout(box);
+    layout->addWidget(widget);
+    return box;
+}
+
+QTableWidgetItem *countItem(qint64 count) {
+    auto *item = new QTableWidgetItem(QString::number(count));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+// Fills a two-column (name, count) table from [{id, count}], largest first as sent.
+void fillCounts(QTableWidget *table, const QJsonArray &counts, const std::function<QString(const QString &)> &label) {
+    table->setRowCount(counts.size());
+    for (int row = 0; row < counts.size(); ++row) {
+        const QJsonObject obj = counts.at(row).toObject();
+        table->setItem(row, 0, new QTableWidgetItem(label(obj.value("id").toString())));
+        table->setItem(row, 1, countItem(obj.value("count").toInteger()));
+    }
+}
+
+} // namespace
+
+DashboardView::DashboardView(const QString &jwt, QWidget *parent)
+    : QWidget(parent), m_jwt(jwt)
+{
+    m_refreshTimer.setSingleShot(true);
+    m_refreshTimer.setInterval(RefreshDelayMs);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &DashboardView::refresh);
+    m_ageTimer.setInterval(AgeRefreshMs);
+    connect(&m_ageTimer, &QTimer::timeout, this, &DashboardView::refresh);
+
+    auto *header = new QHBoxLayout;
+    m_summaryLabel = new QLabel("Loading...", this);
+    QFont font = m_summaryLabel->font();
+    font.setPointSizeF(font.pointSizeF() * 1.3);
+    font.setBold(true);
+    m_summaryLabel->setFont(font);
+    header->addWidget(m_summaryLabel, 1);
+    header->addWidget(new QLabel("Throughput over", this));
+    m_daysCombo = new QComboBox(this);
+    m_daysCombo->addItem("7 days", 7);
+    m_daysCombo->addItem("30 days", 30);
+    m_daysCombo->addItem("90 days", 90);
+    m_daysCombo->setCurrentIndex(1);
+    connect(m_daysCombo, &QComboBox::currentIndexChanged, this, &DashboardView::refresh);
+    header->addWidget(m_daysCombo);
+
+    m_departmentTable = makeTable({"Department", "Open"}, this);
+    m_priorityTable = makeTable({"Priority", "Open"}, this);
+    m_assigneeTable = makeTable({"Assignee", "Open"}, this);
+    QStringList ageHeaders = {"Department"};
+    ageHeaders += AgeBuckets;
+    m_ageTable = makeTable(ageHeaders, this);
+    m_throughputTable = makeTable({"Day", "Created", "Closed"}, this);
+
+    auto *grid = new QGridLayout;
+    grid->addWidget(boxed("Open by department", m_departmentTable, this), 0, 0);
+    grid->addWidget(boxed("Open by priority", m_priorityTable, this), 0, 1);
+    grid->addWidget(boxed("Open by assignee", m_assigneeTable, this), 0, 2);
+    grid->addWidget(boxed("Age of open tickets", m_ageTable, this), 1, 0, 1, 2);
+    grid->addWidget(boxed("Throughput", m_throughputTable, this), 1, 2);
+
+    auto *layout = new QVBoxLayout(this);
+    layout->addLayout(header);
+    layout->addLayout(grid, 1);
+
+    // Assignee names arrive with the directory; relabel once it is there.
+    connect(&UserDirectory::instance(), &UserDirectory::loaded, this, [this]() {
+        if (isVisible()) invalidate();
+    });
+}
+
+void DashboardView::invalidate() {
+    m_dirty = true;
+    if (isVisible() && !m_refreshTimer.isActive()) m_refreshTimer.start();
+}
+
+void DashboardView::showEvent(QShowEvent *event) {
+    QWidget::showEvent(event);
+    m_ageTimer.start();
+    if (m_dirty) refresh();
+}
+
+void DashboardView::hideEvent(QHideEvent *event) {
+    QWidget::hideEvent(event);
+    m_ageTimer.stop();
+    m_refreshTimer.stop();
+}
+
+void DashboardView::refresh() {
+    m_refreshTimer.stop();
+    m_dirty = true;
+    // One request at a time; a change that lands meanwhile is picked up when it returns.
+    if (m_inFlight) return;
+    m_dirty = false;
+
+    QUrl url(Config::instance().fullApiUrl() + "/dashboard");
+    QUrlQuery query;
+    query.addQueryItem("days", QString::number(m_daysCombo->currentData().toInt()));
+    url.setQuery(query);
+    QNetworkRequest req(url);
+    req.setRawHeader("Authorization", "Bearer " + m_jwt.toUtf8());
+    QNetworkReply *reply = m_network.get(req);
+    m_inFlight = reply;
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { onFinished(reply); });
+}
+
+void DashboardView::onFinished(QNetworkReply *reply) {
+    reply->deleteLater();
+    m_inFlight = nullptr;
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "Dashboard fetch failed:" << reply->errorString();
+        m_summaryLabel->setText("Dashboard unavailable: " + reply->errorString());
+        m_dirty = true;
+        return;
+    }
+    fill(QJsonDocument::fromJson(reply->readAll()).object());
+    if (m_dirty && isVisible()) m_refreshTimer.start();
+}
+
+void DashboardView::fill(const QJsonObject &dashboard) {
+    QString summary = QString("%1 open tickets").arg(dashboard.value("open_total").toInteger());
+    const QDateTime ageAt = QDateTime::fromString(dashboard.value("age_refreshed_at").toString(), Qt::ISODateWithMs);
+    if (ageAt.isValid()) summary += QString("  (ages as of %1)").arg(ageAt.toLocalTime().toString("HH:mm"));
+    m_summaryLabel->setText(summary);
+
+    fillCounts(m_departmentTable, dashboard.value("open_by_department").toArray(), [](const QString &id) {
+        return TicketItem::departmentNames.value(id.toInt(), id);
+    });
+    fillCounts(m_priorityTable, dashboard.value("open_by_priority").toArray(), [](const QString &id) {
+        return TicketItem::priorityLabels.value(id.toInt(), id);
+    });
+    fillCounts(m_assigneeTable, dashboard.value("open_by_assignee").toArray(), [](const QString &id) {
+        if (id.isEmpty()) return QString("Unassigned");
+        const UserInfo *user = UserDirectory::instance().userById(id);
+        return user ? user->username : id;
+    });
+
+    // Buckets arrive sorted by department, then age; one table row per department.
+    const QJsonArray buckets = dashboard.value("age_buckets").toArray();
+    m_ageTable->setRowCount(0);
+    int lastDepartment = -1;
+    for (const QJsonValue &v : buckets) {
+        const QJsonObject obj = v.toObject();
+        const int departmentId = obj.value("department_id").toInt();
+        if (departmentId != lastDepartment) {
+            const int row = m_ageTable->rowCount();
+            m_ageTable->insertRow(row);
+            m_ageTable->setItem(row, 0, new QTableWidgetItem(TicketItem::departmentNames.value(departmentId, QString::number(departmentId))));
+            for (int col = 1; col <= AgeBuckets.size(); ++col) m_ageTable->setItem(row, col, countItem(0));
+            lastDepartment = departmentId;
+        }
+        const int col = AgeBuckets.indexOf(obj.value("bucket").toString()) + 1;
+        if (col > 0) m_ageTable->setItem(m_ageTable->rowCount() - 1, col, countItem(obj.value("count").toInteger()));
+    }
+
+    // Newest day first.
+    const QJsonArray days = dashboard.value("throughput").toArray();
+    m_throughputTable->setRowCount(days.size());
+    for (int i = 0; i < days.size(); ++i) {
+        const QJsonObject obj = days.at(days.size() - 1 - i).toObject();
+        m_throughputTable->setItem(i, 0, new QTableWidgetItem(obj.value("day").toString()));
+        m_throughputTable->setItem(i, 1, countItem(obj.value("created").toInteger()));
+        m_throughputTable->setItem(i, 2, countItem(obj.value("closed").toInteger()));
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <QWidget>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QTimer>
+#include <QJsonObject>
+
+class QComboBox;
+class QLabel;
+class QTableWidget;
+class QNetworkReply;
+
+// Dashboard tab: open tickets per department, priority and assignee, open tickets by
+// age, and created/closed per day, all from GET /dashboard. The server keeps these
+// as summary tables, so the response is small and is simply refetched when change
+// events arrive (invalidate()) instead of being derived from ticket lists. While the
+// tab is hidden invalidations only mark it dirty; it reloads when shown.
+class DashboardView : public QWidget {
+    Q_OBJECT
+public:
+    // Bursts of change events within this window cost one request.
+    static const int RefreshDelayMs = 1000;
+    // Age buckets are recomputed by the server on a timer, not by events.
+    static const int AgeRefreshMs = 5 * 60 * 1000;
+
+    explicit DashboardView(const QString &jwt, QWidget *parent = nullptr);
+    void invalidate();
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+private:
+    void refresh();
+    void onFinished(QNetworkReply *reply);
+    void fill(const QJsonObject &dashboard);
+
+    QNetworkAccessManager m_network;
+    QString m_jwt;
+    QPointer<QNetworkReply> m_inFlight;
+    QTimer m_refreshTimer;
+    QTimer m_ageTimer;
+    bool m_dirty = true;
+
+    QComboBox *m_daysCombo;
+    QLabel *m_summaryLabel;
+    QTableWidget *m_departmentTable;
+    QTableWidget *m_priorityTable;
+    QTableWidget *m_assigneeTable;
+    QTableWidget *m_ageTable;
+    QTableWidget *m_throughputTable;
+};
@@ -0,0 +1,326 @@
+#include "image_viewer.h"
+#include <QPainter>
+#include <QBuffer>
+#include <QImageReader>
+#include <QVBoxLayout>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QThread>
+#include <QtMath>
+#include <QDebug>
+
+static const qsizetype TileCacheBytes = 96 * 1024 * 1024;
+static const qreal MaxScale = 8.0;
+// Largest decoded copy kept for cutting tiles, about 64 MB as ARGB32.
+static const qint64 FullImagePixelBudget = 4096LL * 4096;
+
+static QImage decodeImage(const QByteArray &data, const QRect &clip, const QSize &scaledSize) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    if (clip.isValid()) reader.setClipRect(clip);
+    if (scaledSize.isValid()) reader.setScaledSize(scaledSize);
+    QImage image = reader.read();
+    if (image.isNull()) qDebug() << "Image decode failed:" << reader.errorString();
+    return image;
+}
+
+TiledImageView::TiledImageView(QWidget *parent)
+    : QWidget(parent), m_tiles(TileCacheBytes) {
+    m_pool.setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+    m_tileTimer.setSingleShot(true);
+    m_tileTimer.setInterval(30);
+    connect(&m_tileTimer, &QTimer::timeout, this, &TiledImageView::requestVisibleTiles);
+}
+
+TiledImageView::~TiledImageView() {
+    releaseImage();
+}
+
+quint64 TiledImageView::tileKey(int level, int tx, int ty) {
+    return (quint64(level) << 56) | (quint64(quint32(tx) & 0xfffffff) << 28) | quint64(quint32(ty) & 0xfffffff);
+}
+
+void TiledImageView::releaseImage() {
+    // Workers read m_data directly, which may point into the mapping.
+    m_pool.clear();
+    m_pool.waitForDone();
+    ++m_generation;
+    m_data.clear();
+    m_imageSize = QSize();
+    m_preview = QImage();
+    m_full = QImage();
+    m_fullLevel = 0;
+    m_tiles.clear();
+    m_pendingTiles.clear();
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    m_file.close();
+}
+
+bool TiledImageView::setImageData(const QByteArray &data) {
+    releaseImage();
+    return loadImage(data);
+}
+
+bool TiledImageView::setImageFile(const QString &path) {
+    releaseImage();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return false;
+    m_mapped = m_file.map(0, m_file.size());
+    if (!m_mapped) {
+        m_file.close();
+        return false;
+    }
+    if (loadImage(QByteArray::fromRawData(reinterpret_cast<const char *>(m_mapped), m_file.size()))) return true;
+    releaseImage();
+    return false;
+}
+
+bool TiledImageView::loadImage(const QByteArray &data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    QImageReader reader(&buffer);
+    const QSize size = reader.size();
+    if (!reader.canRead() || !size.isValid()) return false;
+
+    m_data = data;
+    m_imageSize = size;
+    m_clipDecode = reader.supportsOption(QImageIOHandler::ClipRect);
+    m_preview = QImage();
+    m_full = QImage();
+    m_fullLevel = 0;
+    m_tiles.clear();
+    m_pendingTiles.clear();
+    fitToView();
+
+    const int generation = m_generation;
+    const QSize previewSize = size.width() > PreviewSize || size.height() > PreviewSize
+        ? size.scaled(PreviewSize, PreviewSize, Qt::KeepAspectRatio) : QSize();
+    const bool clipDecode = m_clipDecode;
+    m_pool.start([this, data, previewSize, clipDecode, generation]() {
+        QImage full;
+        QImage preview;
+        int fullLevel = 0;
+        if (clipDecode || !previewSize.isValid()) {
+            preview = decodeImage(data, QRect(), previewSize);
+        } else {
+            // One full decode serves both the preview and the tiles. Past the
+            // budget only a halved-down level is kept; deeper tiles decode from data.
+            full = decodeImage(data, QRect(), QSize());
+            if (!full.isNull()) {
+                while (qint64(full.width() >> fullLevel) * (full.height() >> fullLevel) > FullImagePixelBudget) ++fullLevel;
+                if (fullLevel > 0) {
+                    const int span = 1 << fullLevel;
+                    full = full.scaled((full.width() + span - 1) / span, (full.height() + span - 1) / span,
+                                       Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+                }
+                preview = full.scaled(previewSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, generation, preview, full, fullLevel]() {
+            onPreviewDecoded(generation, preview, full, fullLevel);
+        }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+void TiledImageView::fitToView() {
+    if (m_imageSize.isEmpty()) return;
+    const qreal sx = qreal(width()) / m_imageSize.width();
+    const qreal sy = qreal(height()) / m_imageSize.height();
+    m_fitScale = qMin(1.0, qMin(sx, sy) * 0.9);
+    m_scale = m_fitScale;
+    m_offset = QPointF((width() - m_imageSize.width() * m_scale) / 2, (height() - m_imageSize.height() * m_scale) / 2);
+    update();
+    m_tileTimer.start();
+}
+
+QRectF TiledImageView::imageRect() const {
+    return QRectF(m_offset, QSizeF(m_imageSize) * m_scale);
+}
+
+int TiledImageView::levelForScale(qreal scale) const {
+    // Pick the coarsest power-of-two level that still has at least one source pixel per screen pixel.
+    int level = 0;
+    while (scale * (1 << (level + 1)) <= 1.0 && level < 16) ++level;
+    return level;
+}
+
+QRect TiledImageView::tileSourceRect(int level, int tx, int ty) const {
+    const int span = TileSize << level;
+    return QRect(tx * span, ty * span, span, span) & QRect(QPoint(0, 0), m_imageSize);
+}
+
+void TiledImageView::requestVisibleTiles() {
+    if (m_imageSize.isEmpty() || m_preview.isNull()) return;
+    // The preview already is the whole image at full resolution.
+    if (m_preview.size() == m_imageSize) return;
+
+    const QRectF visible = QRectF(rect()).intersected(imageRect());
+    if (visible.isEmpty()) return;
+    const int level = levelForScale(m_scale);
+    const int span = TileSize << level;
+    const QRectF source((visible.topLeft() - m_offset) / m_scale, visible.size() / m_scale);
+    const int tx0 = qMax(0, int(source.left()) / span);
+    const int ty0 = qMax(0, int(source.top()) / span);
+    const int tx1 = qMin((m_imageSize.width() - 1) / span, int(source.right()) / span);
+    const int ty1 = qMin((m_imageSize.height() - 1) / span, int(source.bottom()) / span);
+
+    // Queued tiles for a previous viewport are dropped; running decodes still land in the cache.
+    m_pool.clear();
+    m_pendingTiles.clear();
+    const int generation = m_generation;
+    for (int ty = ty0; ty <= ty1; ++ty) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const quint64 key = tileKey(level, tx, ty);
+            if (m_tiles.contains(key) || m_pendingTiles.contains(key)) continue;
+            const QRect src = tileSourceRect(level, tx, ty);
+            const QSize scaled((src.width() + (1 << level) - 1) >> level, (src.height() + (1 << level) - 1) >> level);
+            m_pendingTiles.insert(key);
+            const QByteArray data = m_data;
+            // Shares m_full's pixels; only the tile's own rect is copied.
+            const QImage full = level >= m_fullLevel ? m_full : QImage();
+            const int fullLevel = m_fullLevel;
+            m_pool.start([this, data, full, fullLevel, src, scaled, key, generation]() {
+                QImage tile;
+                if (full.isNull()) {
+                    tile = decodeImage(data, src, scaled);
+                } else {
+                    const int span = 1 << fullLevel;
+                    const QRect fullSrc = QRect(src.x() / span, src.y() / span,
+                                                (src.width() + span - 1) / span, (src.height() + span - 1) / span) & full.rect();
+                    tile = full.copy(fullSrc);
+                    if (tile.size() != scaled) tile = tile.scaled(scaled, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+                }
+                QMetaObject::invokeMethod(this, [this, generation, key, tile]() {
+                    onTileDecoded(generation, key, tile);
+                }, Qt::QueuedConnection);
+            });
+        }
+    }
+}
+
+void TiledImageView::onPreviewDecoded(int generation, const QImage &preview, const QImage &full, int fullLevel) {
+    if (generation != m_generation || preview.isNull()) return;
+    m_preview = preview;
+    m_full = full;
+    m_fullLevel = fullLevel;
+    update();
+    requestVisibleTiles();
+}
+
+void TiledImageView::onTileDecoded(int generation, quint64 key, const QImage &tile) {
+    if (generation != m_generation) return;
+    m_pendingTiles.remove(key);
+    if (tile.isNull()) return;
+    m_tiles.insert(key, new QImage(tile), tile.sizeInBytes());
+    update();
+}
+
+void TiledImageView::paintEvent(QPaintEvent *) {
+    if (m_preview.isNull()) return;
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    const QRectF target = imageRect();
+    painter.drawImage(target, m_preview);
+
+    const int level = levelForScale(m_scale);
+    const int span = TileSize << level;
+    const QRectF visible = QRectF(rect()).intersected(target);
+    if (visible.isEmpty()) return;
+    const QRectF source((visible.topLeft() - m_offset) / m_scale, visible.size() / m_scale);
+    const int tx1 = qMin((m_imageSize.width() - 1) / span, int(source.right()) / span);
+    const int ty1 = qMin((m_imageSize.height() - 1) / span, int(source.bottom()) / span);
+    for (int ty = qMax(0, int(source.top()) / span); ty <= ty1; ++ty) {
+        for (int tx = qMax(0, int(source.left()) / span); tx <= tx1; ++tx) {
+            const QImage *tile = m_tiles.object(tileKey(level, tx, ty));
+            if (!tile) continue;
+            const QRect src = tileSourceRect(level, tx, ty);
+            painter.drawImage(QRectF(m_offset + QPointF(src.topLeft()) * m_scale, QSizeF(src.size()) * m_scale), *tile);
+        }
+    }
+}
+
+void TiledImageView::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    fitToView();
+}
+
+void TiledImageView::wheelEvent(QWheelEvent *event) {
+    if (m_imageSize.isEmpty()) return;
+    const qreal factor = qPow(1.25, event->angleDelta().y() / 120.0);
+    const qreal scale = qBound(m_fitScale * 0.5, m_scale * factor, MaxScale);
+    const QPointF anchor = event->position();
+    const QPointF imagePoint = (anchor - m_offset) / m_scale;
+    m_scale = scale;
+    m_offset = anchor - imagePoint * m_scale;
+    update();
+    m_tileTimer.start();
+    event->accept();
+}
+
+void TiledImageView::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) return QWidget::mousePressEvent(event);
+    m_pressPos = event->pos();
+    m_pressOffset = m_offset;
+    m_dragging = false;
+}
+
+void TiledImageView::mouseMoveEvent(QMouseEvent *event) {
+    if (!(event->buttons() & Qt::LeftButton)) return;
+    const QPoint delta = event->pos() - m_pressPos;
+    if (!m_dragging && delta.manhattanLength() < 4) return;
+    m_dragging = true;
+    setCursor(Qt::ClosedHandCursor);
+    m_offset = m_pressOffset + delta;
+    update();
+    m_tileTimer.start();
+}
+
+void TiledImageView::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) return QWidget::mouseReleaseEvent(event);
+    unsetCursor();
+    if (!m_dragging && !imageRect().contains(event->pos())) emit clickedOutsideImage();
+    m_dragging = false;
+}
+
+void TiledImageView::mouseDoubleClickEvent(QMouseEvent *) {
+    fitToView();
+}
+
+ImagePreviewDialog::ImagePreviewDialog(QWidget *parent)
+    : QDialog(parent) {
+    setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint);
+    setAttribute(Qt::WA_TranslucentBackground);
+    setModal(true);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0,0,0,0);
+    m_view = new TiledImageView(this);
+    layout->addWidget(m_view);
+    setLayout(layout);
+    connect(m_view, &TiledImageView::clickedOutsideImage, this, &QDialog::close);
+}
+
+bool ImagePreviewDialog::setImageData(const QByteArray &data) {
+    return m_view->setImageData(data);
+}
+
+bool ImagePreviewDialog::setImageFile(const QString &path) {
+    return m_view->setImageFile(path);
+}
+
+void ImagePreviewDialog::paintEvent(QPaintEvent *event) {
+    QPainter p(this);
+    p.fillRect(rect(), QColor(0,0,0,180));
+    QDialog::paintEvent(event);
+}
+
+void ImagePreviewDialog::showEvent(QShowEvent *event) {
+    QDialog::showEvent(event);
+    m_view->fitToView();
+}
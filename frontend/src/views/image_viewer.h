@@ -0,0 +1,86 @@
+#pragma once
+#include <QDialog>
+#include <QWidget>
+#include <QImage>
+#include <QCache>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QFile>
+
+// Shows a large image without decoding it at full size on the GUI thread.
+// A downscaled preview is decoded first; sharp tiles for the current zoom level
+// are then decoded on worker threads (QImageReader clip rect + scaled size) and
+// only the tiles that intersect the viewport are requested and painted. Formats
+// whose reader cannot clip (PNG among them) would decode the whole image per tile,
+// so for those the image is decoded once and tiles are cut from that copy, kept
+// no larger than a fixed pixel budget by halving it down to a coarser level.
+class TiledImageView : public QWidget {
+    Q_OBJECT
+public:
+    static const int TileSize = 512;
+    static const int PreviewSize = 1024;
+
+    explicit TiledImageView(QWidget *parent = nullptr);
+    ~TiledImageView() override;
+    // Takes the encoded image; returns false when the data is not a readable image.
+    bool setImageData(const QByteArray &data);
+    // Maps the file instead of reading it, so the encoded bytes never land on the heap.
+    bool setImageFile(const QString &path);
+    void fitToView();
+signals:
+    void clickedOutsideImage();
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+private:
+    bool loadImage(const QByteArray &data);
+    void releaseImage();
+    void requestVisibleTiles();
+    void onPreviewDecoded(int generation, const QImage &preview, const QImage &full, int fullLevel);
+    void onTileDecoded(int generation, quint64 key, const QImage &tile);
+    int levelForScale(qreal scale) const;
+    QRect tileSourceRect(int level, int tx, int ty) const;
+    QRectF imageRect() const;
+    static quint64 tileKey(int level, int tx, int ty);
+
+    QByteArray m_data;
+    QFile m_file;
+    uchar *m_mapped = nullptr;
+    QSize m_imageSize;
+    QImage m_preview;
+    // Whether the reader decodes clip rects itself; otherwise m_full holds the
+    // decoded image that tiles are cut from, downscaled by 2^m_fullLevel.
+    bool m_clipDecode = true;
+    QImage m_full;
+    int m_fullLevel = 0;
+    qreal m_scale = 1.0;
+    qreal m_fitScale = 1.0;
+    QPointF m_offset;
+    int m_generation = 0;
+    QCache<quint64, QImage> m_tiles;
+    QSet<quint64> m_pendingTiles;
+    QThreadPool m_pool;
+    QTimer m_tileTimer;
+    QPoint m_pressPos;
+    QPointF m_pressOffset;
+    bool m_dragging = false;
+};
+
+class ImagePreviewDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit ImagePreviewDialog(QWidget *parent = nullptr);
+    bool setImageData(const QByteArray &data);
+    bool setImageFile(const QString &path);
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+private:
+    TiledImageView *m_view;
+};
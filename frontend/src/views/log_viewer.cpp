@@ -0,0 +1,414 @@
+#include "log_viewer.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+#include <QFontDatabase>
+#include <QFileInfo>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLineEdit>
+#include <QLabel>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QShortcut>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+
+static const qint64 IndexBatchBytes = 8 * 1024 * 1024;
+static const qint64 SearchBlockBytes = 16 * 1024 * 1024;
+
+static inline char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+// Yields candidate match starts: positions of the needle's first byte (either case
+// when folding). memchr is vectorized in every libc we ship on, and each byte class
+// is searched once per block, not once per candidate.
+struct CandidateFinder {
+    const char *end;
+    char first;
+    char other;
+    const char *nextFirst = nullptr;
+    const char *nextOther = nullptr;
+    bool scannedFirst = false;
+    bool scannedOther = false;
+
+    CandidateFinder(const char *blockEnd, char c, bool caseSensitive)
+        : end(blockEnd), first(c), other(c) {
+        if (!caseSensitive) {
+            if (c >= 'a' && c <= 'z') other = char(c - ('a' - 'A'));
+            else if (c >= 'A' && c <= 'Z') other = char(c + ('a' - 'A'));
+        }
+    }
+
+    const char *next(const char *p) {
+        if (p >= end) return nullptr;
+        if (!scannedFirst || (nextFirst && nextFirst < p)) {
+            nextFirst = static_cast<const char *>(std::memchr(p, first, end - p));
+            scannedFirst = true;
+        }
+        if (other == first) return nextFirst;
+        if (!scannedOther || (nextOther && nextOther < p)) {
+            nextOther = static_cast<const char *>(std::memchr(p, other, end - p));
+            scannedOther = true;
+        }
+        if (!nextFirst) return nextOther;
+        if (!nextOther) return nextFirst;
+        return std::min(nextFirst, nextOther);
+    }
+};
+
+static bool matchesAt(const char *p, const QByteArray &needle, bool caseSensitive) {
+    if (caseSensitive) return std::memcmp(p, needle.constData(), needle.size()) == 0;
+    for (qsizetype i = 0; i < needle.size(); ++i) {
+        if (asciiLower(p[i]) != asciiLower(needle[i])) return false;
+    }
+    return true;
+}
+
+// Match starts in [from, to) that fit inside the file. With last = true the final
+// match in the range is returned instead of the first one. -1 when there is none,
+// -2 when cancelled.
+template <typename Cancelled>
+static qint64 findInRange(const char *data, qint64 size, qint64 from, qint64 to, const QByteArray &needle,
+                          bool caseSensitive, bool last, Cancelled cancelled) {
+    to = qMin(to, size - needle.size() + 1);
+    qint64 found = -1;
+    for (qint64 block = from; block < to; block += SearchBlockBytes) {
+        if (cancelled()) return -2;
+        const qint64 blockEnd = qMin(to, block + SearchBlockBytes);
+        CandidateFinder finder(data + blockEnd, needle[0], caseSensitive);
+        for (const char *p = finder.next(data + block); p; p = finder.next(p + 1)) {
+            if (matchesAt(p, needle, caseSensitive)) {
+                found = p - data;
+                if (!last) return found;
+            }
+        }
+    }
+    return found;
+}
+
+template <typename Cancelled>
+static qint64 findLastBefore(const char *data, qint64 size, qint64 before, const QByteArray &needle,
+                             bool caseSensitive, Cancelled cancelled) {
+    for (qint64 blockEnd = before; blockEnd > 0; blockEnd -= SearchBlockBytes) {
+        const qint64 blockStart = qMax<qint64>(0, blockEnd - SearchBlockBytes);
+        const qint64 found = findInRange(data, size, blockStart, blockEnd, needle, caseSensitive, true, cancelled);
+        if (found != -1) return found;
+    }
+    return -1;
+}
+
+static QString expandTabs(QString text) {
+    return text.replace(QLatin1Char('\t'), QLatin1String("    "));
+}
+
+LogView::LogView(QWidget *parent) : QAbstractScrollArea(parent) {
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    viewport()->setAutoFillBackground(false);
+    verticalScrollBar()->setSingleStep(1);
+    m_pool.setMaxThreadCount(2);
+}
+
+LogView::~LogView() {
+    closeFile();
+}
+
+bool LogView::openFile(const QString &path) {
+    closeFile();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open" << path << ":" << m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size > 0) {
+        m_data = reinterpret_cast<const char *>(m_file.map(0, m_size));
+        if (!m_data) {
+            qWarning() << "Cannot map" << path << ":" << m_file.errorString();
+            m_file.close();
+            m_size = 0;
+            return false;
+        }
+    }
+    m_lineStarts.assign(1, 0);
+    m_indexedBytes = 0;
+    m_longestLine = 0;
+    m_indexDone = m_size == 0;
+    if (!m_indexDone) startIndexing();
+    updateScrollBars();
+    viewport()->update();
+    return true;
+}
+
+void LogView::closeFile() {
+    m_cancelled = true;
+    ++m_searchGeneration;
+    m_pool.clear();
+    m_pool.waitForDone();
+    m_cancelled = false;
+    ++m_generation;
+    if (m_data) m_file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_data)));
+    m_data = nullptr;
+    m_file.close();
+    m_size = 0;
+    m_lineStarts.clear();
+    m_indexedBytes = 0;
+    m_longestLine = 0;
+    m_indexDone = true;
+    m_matchOffset = -1;
+    m_matchLength = 0;
+    m_scrollPending = false;
+}
+
+void LogView::startIndexing() {
+    const char *data = m_data;
+    const qint64 size = m_size;
+    const int generation = m_generation;
+    m_pool.start([this, data, size, generation]() {
+        qint64 lineStart = 0;
+        for (qint64 pos = 0; pos < size && !m_cancelled;) {
+            const qint64 end = qMin(size, pos + IndexBatchBytes);
+            std::vector<qint64> starts;
+            qint64 longest = 0;
+            const char *stop = data + end;
+            for (const char *p = data + pos; p < stop;) {
+                const char *newline = static_cast<const char *>(std::memchr(p, '\n', stop - p));
+                if (!newline) break;
+                const qint64 next = newline - data + 1;
+                longest = qMax(longest, next - 1 - lineStart);
+                starts.push_back(next);
+                lineStart = next;
+                p = newline + 1;
+            }
+            pos = end;
+            const bool done = pos >= size;
+            if (done) longest = qMax(longest, size - lineStart);
+            QMetaObject::invokeMethod(this, [this, generation, starts = std::move(starts), longest, pos, done]() {
+                onIndexBatch(generation, starts, longest, pos, done);
+            });
+        }
+    });
+}
+
+void LogView::onIndexBatch(int generation, const std::vector<qint64> &starts, qint64 longest, qint64 scanned, bool done) {
+    if (generation != m_generation) return;
+    m_lineStarts.insert(m_lineStarts.end(), starts.begin(), starts.end());
+    m_longestLine = qMax(m_longestLine, qMin<qint64>(longest, MaxDisplayLineBytes));
+    m_indexedBytes = scanned;
+    if (done) {
+        // A trailing newline ends the last line; it does not start an empty one.
+        if (m_lineStarts.size() > 1 && m_lineStarts.back() == m_size) m_lineStarts.pop_back();
+        m_indexDone = true;
+    }
+    updateScrollBars();
+    if (m_scrollPending && m_matchOffset < m_lineStarts.back()) {
+        m_scrollPending = false;
+        scrollToOffset(m_matchOffset);
+    }
+    viewport()->update();
+    emit indexProgress(m_indexedBytes, m_size, lineCount());
+}
+
+qint64 LogView::lineCount() const {
+    if (m_lineStarts.empty()) return 0;
+    // While indexing, the last known start belongs to a line whose end is not known yet.
+    return m_indexDone ? qint64(m_lineStarts.size()) : qint64(m_lineStarts.size()) - 1;
+}
+
+qint64 LogView::lineEnd(qint64 line) const {
+    qint64 end = line + 1 < qint64(m_lineStarts.size()) ? m_lineStarts[line + 1] - 1 : m_size;
+    if (end > m_lineStarts[line] && end <= m_size && m_data[end - 1] == '\r') --end;
+    return end;
+}
+
+qint64 LogView::lineForOffset(qint64 offset) const {
+    auto it = std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset);
+    return qMax<qint64>(0, (it - m_lineStarts.begin()) - 1);
+}
+
+int LogView::lineHeight() const {
+    return fontMetrics().height();
+}
+
+void LogView::updateScrollBars() {
+    const int visibleLines = qMax(1, viewport()->height() / lineHeight());
+    const qint64 maxTop = qMax<qint64>(0, lineCount() - visibleLines);
+    verticalScrollBar()->setRange(0, int(qMin<qint64>(maxTop, INT_MAX)));
+    verticalScrollBar()->setPageStep(visibleLines);
+    const QFontMetrics fm = fontMetrics();
+    const int charWidth = fm.horizontalAdvance(QLatin1Char('M'));
+    const int gutter = charWidth * (QString::number(qMax<qint64>(1, lineCount())).size() + 2);
+    const int contentWidth = gutter + int(m_longestLine) * charWidth;
+    horizontalScrollBar()->setRange(0, qMax(0, contentWidth - viewport()->width()));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(charWidth);
+}
+
+void LogView::resizeEvent(QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void LogView::paintEvent(QPaintEvent *event) {
+    QPainter painter(viewport());
+    painter.fillRect(event->rect(), palette().base());
+    if (!m_data) return;
+    const QFontMetrics fm = fontMetrics();
+    const int lh = fm.height();
+    const int charWidth = fm.horizontalAdvance(QLatin1Char('M'));
+    const qint64 count = lineCount();
+    const int gutter = charWidth * (QString::number(qMax<qint64>(1, count)).size() + 2);
+    const int xOffset = horizontalScrollBar()->value();
+    const QRect textArea(gutter, 0, viewport()->width() - gutter, viewport()->height());
+    painter.fillRect(QRect(0, 0, gutter - charWidth / 2, viewport()->height()), palette().alternateBase());
+
+    int y = 0;
+    for (qint64 line = verticalScrollBar()->value(); line < count && y < viewport()->height(); ++line, y += lh) {
+        const qint64 start = m_lineStarts[line];
+        const qint64 end = lineEnd(line);
+        const qint64 length = qMin<qint64>(end - start, MaxDisplayLineBytes);
+        painter.setClipping(false);
+        painter.setPen(palette().color(QPalette::PlaceholderText));
+        painter.drawText(QRect(0, y, gutter - charWidth, lh), Qt::AlignRight | Qt::AlignVCenter, QString::number(line + 1));
+
+        painter.setClipRect(textArea);
+        const int textX = gutter - xOffset;
+        if (m_matchOffset >= start && m_matchOffset < start + length) {
+            const qint64 matchEnd = qMin(m_matchOffset + m_matchLength, start + length);
+            const int x1 = fm.horizontalAdvance(expandTabs(QString::fromUtf8(m_data + start, m_matchOffset - start)));
+            const int x2 = fm.horizontalAdvance(expandTabs(QString::fromUtf8(m_data + start, matchEnd - start)));
+            painter.fillRect(QRect(textX + x1, y, qMax(2, x2 - x1), lh), palette().highlight());
+        }
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(textX, y + fm.ascent(), expandTabs(QString::fromUtf8(m_data + start, length)));
+    }
+}
+
+void LogView::find(const QString &text, bool caseSensitive, bool backwards) {
+    if (!m_data || text.isEmpty()) {
+        emit searchFinished(false);
+        return;
+    }
+    const QByteArray needle = text.toUtf8();
+    const int generation = ++m_searchGeneration;
+    qint64 from = 0;
+    if (m_matchOffset >= 0) {
+        from = backwards ? m_matchOffset : m_matchOffset + 1;
+    } else {
+        const qint64 top = verticalScrollBar()->value();
+        if (top < qint64(m_lineStarts.size())) from = m_lineStarts[top];
+    }
+    const char *data = m_data;
+    const qint64 size = m_size;
+    m_pool.start([this, data, size, from, needle, caseSensitive, backwards, generation]() {
+        auto cancelled = [this, generation]() { return m_cancelled || m_searchGeneration != generation; };
+        qint64 found;
+        if (backwards) {
+            found = findLastBefore(data, size, from, needle, caseSensitive, cancelled);
+            if (found == -1) found = findLastBefore(data, size, size, needle, caseSensitive, cancelled);
+        } else {
+            found = findInRange(data, size, from, size, needle, caseSensitive, false, cancelled);
+            if (found == -1) found = findInRange(data, size, 0, from, needle, caseSensitive, false, cancelled);
+        }
+        if (found == -2) return;
+        QMetaObject::invokeMethod(this, [this, generation, found, length = needle.size()]() {
+            onSearchResult(generation, found, length);
+        });
+    });
+}
+
+void LogView::onSearchResult(int generation, qint64 offset, qint64 length) {
+    if (generation != m_searchGeneration) return;
+    if (offset < 0) {
+        emit searchFinished(false);
+        return;
+    }
+    m_matchOffset = offset;
+    m_matchLength = length;
+    scrollToOffset(offset);
+    viewport()->update();
+    emit searchFinished(true);
+}
+
+void LogView::scrollToOffset(qint64 offset) {
+    if (!m_indexDone && offset >= m_lineStarts.back()) {
+        // The index has not reached the match yet; scroll when it does.
+        m_scrollPending = true;
+        return;
+    }
+    const qint64 line = lineForOffset(offset);
+    const int visibleLines = qMax(1, viewport()->height() / lineHeight());
+    const qint64 top = verticalScrollBar()->value();
+    if (line < top || line >= top + visibleLines) {
+        verticalScrollBar()->setValue(int(qMax<qint64>(0, line - visibleLines / 3)));
+    }
+    const QFontMetrics fm = fontMetrics();
+    const qint64 column = qMin<qint64>(offset - m_lineStarts[line], MaxDisplayLineBytes);
+    const int x = fm.horizontalAdvance(expandTabs(QString::fromUtf8(m_data + m_lineStarts[line], column)));
+    const int gutter = fm.horizontalAdvance(QLatin1Char('M')) * (QString::number(qMax<qint64>(1, lineCount())).size() + 2);
+    const int visibleWidth = viewport()->width() - gutter;
+    QScrollBar *hbar = horizontalScrollBar();
+    if (x < hbar->value() || x > hbar->value() + visibleWidth - fm.averageCharWidth() * 8) {
+        hbar->setValue(qMax(0, x - visibleWidth / 3));
+    }
+}
+
+LogViewerDialog::LogViewerDialog(QWidget *parent) : QDialog(parent) {
+    setAttribute(Qt::WA_DeleteOnClose);
+    resize(1000, 700);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    QHBoxLayout *searchLayout = new QHBoxLayout;
+    m_searchEdit = new QLineEdit(this);
+    m_searchEdit->setPlaceholderText("Search");
+    m_caseCheck = new QCheckBox("Match case", this);
+    QPushButton *prevBtn = new QPushButton("Previous", this);
+    QPushButton *nextBtn = new QPushButton("Next", this);
+    searchLayout->addWidget(m_searchEdit, 1);
+    searchLayout->addWidget(m_caseCheck);
+    searchLayout->addWidget(prevBtn);
+    searchLayout->addWidget(nextBtn);
+    layout->addLayout(searchLayout);
+    m_view = new LogView(this);
+    layout->addWidget(m_view, 1);
+    m_statusLabel = new QLabel(this);
+    layout->addWidget(m_statusLabel);
+
+    connect(m_searchEdit, &QLineEdit::returnPressed, this, [this]() { findNext(false); });
+    connect(nextBtn, &QPushButton::clicked, this, [this]() { findNext(false); });
+    connect(prevBtn, &QPushButton::clicked, this, [this]() { findNext(true); });
+    connect(new QShortcut(QKeySequence::FindNext, this), &QShortcut::activated, this, [this]() { findNext(false); });
+    connect(new QShortcut(QKeySequence::FindPrevious, this), &QShortcut::activated, this, [this]() { findNext(true); });
+    connect(new QShortcut(QKeySequence::Find, this), &QShortcut::activated, m_searchEdit, [this]() {
+        m_searchEdit->setFocus();
+        m_searchEdit->selectAll();
+    });
+    connect(m_view, &LogView::indexProgress, this, &LogViewerDialog::updateStatus);
+    connect(m_view, &LogView::searchFinished, this, [this](bool found) {
+        m_searchState = found ? QString() : QString("\"%1\" not found").arg(m_searchEdit->text());
+        updateStatus();
+    });
+}
+
+bool LogViewerDialog::openFile(const QString &path, const QString &title) {
+    setWindowTitle(title.isEmpty() ? QFileInfo(path).fileName() : title);
+    const bool ok = m_view->openFile(path);
+    updateStatus();
+    return ok;
+}
+
+void LogViewerDialog::findNext(bool backwards) {
+    if (m_searchEdit->text().isEmpty()) return;
+    m_searchState = "Searching...";
+    updateStatus();
+    m_view->find(m_searchEdit->text(), m_caseCheck->isChecked(), backwards);
+}
+
+void LogViewerDialog::updateStatus() {
+    QString text = QString("%1 lines, %2").arg(m_view->lineCount()).arg(locale().formattedDataSize(m_view->fileSize()));
+    if (m_view->isIndexing()) text += " (indexing...)";
+    if (!m_searchState.isEmpty()) text += " — " + m_searchState;
+    m_statusLabel->setText(text);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <QAbstractScrollArea>
+#include <QDialog>
+#include <QFile>
+#include <QThreadPool>
+#include <atomic>
+#include <vector>
+
+class QLineEdit;
+class QLabel;
+class QCheckBox;
+
+// Read-only view of a large text file. The file is memory-mapped, the line-start
+// index is built on a worker thread (lines appear while it runs), and only the
+// visible lines are decoded and painted. Search runs on a worker thread too, over
+// the mapped bytes with memchr/memcmp, so it goes at roughly memory bandwidth.
+class LogView : public QAbstractScrollArea {
+    Q_OBJECT
+public:
+    // Longer lines are cut off when painted; the bytes are still searched.
+    static const int MaxDisplayLineBytes = 4096;
+
+    explicit LogView(QWidget *parent = nullptr);
+    ~LogView() override;
+    bool openFile(const QString &path);
+    void closeFile();
+    qint64 fileSize() const { return m_size; }
+    qint64 lineCount() const;
+    bool isIndexing() const { return !m_indexDone; }
+    // Finds the next (or previous) occurrence after the current match and scrolls to it.
+    void find(const QString &text, bool caseSensitive, bool backwards);
+signals:
+    void indexProgress(qint64 scannedBytes, qint64 totalBytes, qint64 lines);
+    void searchFinished(bool found);
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+private:
+    void startIndexing();
+    void onIndexBatch(int generation, const std::vector<qint64> &starts, qint64 longest, qint64 scanned, bool done);
+    void onSearchResult(int generation, qint64 offset, qint64 length);
+    void updateScrollBars();
+    void scrollToOffset(qint64 offset);
+    qint64 lineForOffset(qint64 offset) const;
+    qint64 lineEnd(qint64 line) const;
+    int lineHeight() const;
+
+    QFile m_file;
+    const char *m_data = nullptr;
+    qint64 m_size = 0;
+    std::vector<qint64> m_lineStarts;
+    qint64 m_indexedBytes = 0;
+    qint64 m_longestLine = 0;
+    bool m_indexDone = true;
+    qint64 m_matchOffset = -1;
+    qint64 m_matchLength = 0;
+    bool m_scrollPending = false;
+    int m_generation = 0;
+    std::atomic<int> m_searchGeneration{0};
+    std::atomic<bool> m_cancelled{false};
+    QThreadPool m_pool;
+};
+
+class LogViewerDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit LogViewerDialog(QWidget *parent = nullptr);
+    bool openFile(const QString &path, const QString &title);
+private:
+    void findNext(bool backwards);
+    void updateStatus();
+
+    LogView *m_view;
+    QLineEdit *m_searchEdit;
+    QCheckBox *m_caseCheck;
+    QLabel *m_statusLabel;
+    QString m_searchState;
+};
@@ -26,9 +26,26 @@
 #include "models/ticket_model.h"
 #include "models/dictionary_model.h"
 #include "models/comment_model.h"
+#include "comment_delegate.h"
+#include "image_viewer.h"
+#include "log_viewer.h"
+#include "network/download_manager.h"
+#include "upload_queue_widget.h"
+#include "assignee_picker.h"
+#include "models/user_directory.h"
+#include "network/event_stream.h"
+#include "network/mutation_journal.h"
+#include <QUuid>
+#include <QProgressDialog>
+#include <QStandardPaths>
+#include <QDir>
+#include <QApplication>
 #include <QListView>
 #include <QInputDialog>
 #include <QMenu>
+#include <QSignalBlocker>
+#include <QCheckBox>
+#include <QFileInfo>
 #include "models/attachment_model.h"
 #include <QFileDialog>
 #include <QDesktopServices>
@@ -39,14 +56,49 @@
 #include <QBuffer>
 #include <QScreen>
 #include <QMouseEvent>
+#include <QUrlQuery>
+#include <QScrollBar>
+#include <QSet>
+
+static const int CommentPageSize = 50;
+// Attachments downloaded for viewing stay in the cache until it passes this size.
+static const qint64 AttachmentCacheBytes = 512LL * 1024 * 1024;
+
+static QString attachmentCachePath(const QString &attId) {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/attachments/" + attId;
+}
+
+// Whether the attachment is already cached; a hit is marked as just used.
+static bool touchCachedAttachment(const QString &path) {
+    QFile file(path);
+    if (!file.exists()) return false;
+    if (file.open(QIODevice::ReadWrite)) file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+// A NUL byte near the start means the file is not text in any encoding the log viewer reads.
+static bool looksBinary(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    return file.read(8192).contains('\0');
+}
+
+// Removes the least recently used downloads until the cache fits its budget.
+// Files with a suffix are in-progress .part/.json downloads and are left alone.
+static void trimAttachmentCache() {
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/attachments");
+    qint64 total = 0;
+    for (const QFileInfo &info : dir.entryInfoList(QDir::Files, QDir::Time)) {
+        if (info.fileName().contains('.')) continue;
+        total += info.size();
+        if (total > AttachmentCacheBytes && QFile::remove(info.absoluteFilePath())) total -= info.size();
+    }
+}
 
 class AttachmentDelegate : public QStyledItemDelegate {
 public:
-    AttachmentDelegate(const QString &ticketId, QMap<QString, QPixmap> *pixmapCache, TicketDialog *dialog, QObject *parent = nullptr)
-        : QStyledItemDelegate(parent), m_ticketId(ticketId), m_pixmapCache(pixmapCache), m_dialog(dialog) {}
-    QVariant displayRoleData(const QAbstractItemModel *model, const QModelIndex &index) const {
-        return model->data(index, Qt::DisplayRole);
-    }
+    AttachmentDelegate(ThumbnailService *thumbnails, TicketDialog *dialog, QObject *parent = nullptr)
+        : QStyledItemDelegate(parent), m_thumbnails(thumbnails), m_dialog(dialog) {}
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override {
         painter->save();
         QRect rect = option.rect;
@@ -54,25 +106,18 @@ public:
             painter->fillRect(rect, option.palette.highlight());
         }
         QString filename = index.data(AttachmentModel::FilenameRole).toString();
-        QString attId = index.data(AttachmentModel::IdRole).toString();
-        bool isImg = false;
-        QString lower = filename.toLower();
-        if (lower.endsWith(".jpg") || lower.endsWith(".jpeg") || lower.endsWith(".png") || lower.endsWith(".gif")) isImg = true;
         int x = rect.left() + 12;
-        int thumbSize = 128;
-        m_lastThumbRect = QRect();
-        if (isImg) {
-            QPixmap pix;
-            if (m_pixmapCache && m_pixmapCache->contains(attId)) {
-                pix = m_pixmapCache->value(attId).scaled(thumbSize, thumbSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        const int thumbSize = ThumbnailService::ThumbnailSize;
+        if (isImage(filename)) {
+            // Only blit what the thumbnail service already has; loading is driven by the dialog.
+            int y = rect.top() + (rect.height()-thumbSize)/2;
+            QPixmap pix = m_thumbnails->thumbnail(index.data(AttachmentModel::IdRole).toString());
+            if (pix.isNull()) {
+                painter->fillRect(QRect(x, y, thumbSize, thumbSize), Qt::lightGray);
             } else {
-                if (m_dialog) m_dialog->requestAttachmentImage(attId, m_ticketId);
-                pix = QPixmap(thumbSize, thumbSize);
-                pix.fill(Qt::lightGray);
+                QSizeF size = pix.deviceIndependentSize();
+                painter->drawPixmap(QPointF(x + (thumbSize - size.width())/2, y + (thumbSize - size.height())/2), pix);
             }
-            int y = rect.top() + (rect.height()-thumbSize)/2;
-            painter->drawPixmap(x, y, thumbSize, thumbSize, pix);
-            m_lastThumbRect = QRect(x, y, thumbSize, thumbSize);
             x += thumbSize + 8;
         }
         QRect textRect(x, rect.top(), rect.width() - (x-rect.left()), rect.height());
@@ -81,7 +126,7 @@ public:
         painter->restore();
     }
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override {
-        return QSize(option.rect.width(), 136);
+        return QSize(option.rect.width(), ThumbnailService::ThumbnailSize + 8);
     }
     
     bool editorEvent(QEvent *event, QAbstractItemModel *model, const QStyleOptionViewItem &option, const QModelIndex &index) override {
@@ -90,27 +135,25 @@ public:
             if (me->button() != Qt::LeftButton) return QStyledItemDelegate::editorEvent(event, model, option, index);
             QString filename = index.data(AttachmentModel::FilenameRole).toString();
             QString attId = index.data(AttachmentModel::IdRole).toString();
-            bool isImg = false;
-            QString lower = filename.toLower();
-            if (lower.endsWith(".jpg") || lower.endsWith(".jpeg") || lower.endsWith(".png") || lower.endsWith(".gif")) isImg = true;
             int x = option.rect.left() + 12;
-            int thumbSize = 128;
+            int thumbSize = ThumbnailService::ThumbnailSize;
             int y = option.rect.top() + (option.rect.height()-thumbSize)/2;
             QRect thumbRect(x, y, thumbSize, thumbSize);
-            if (isImg && thumbRect.contains(me->pos())) {
-                if (m_pixmapCache && m_pixmapCache->contains(attId) && m_dialog) {
-                    m_dialog->showImagePreview(m_pixmapCache->value(attId));
-                    return true;
-                }
+            if (isImage(filename) && thumbRect.contains(me->pos()) && m_dialog) {
+                m_dialog->openAttachmentPreview(attId);
+                return true;
             }
         }
         return QStyledItemDelegate::editorEvent(event, model, option, index);
     }
 private:
-    QString m_ticketId;
-    QMap<QString, QPixmap> *m_pixmapCache;
+    static bool isImage(const QString &filename) {
+        AttachmentItem item;
+        item.filename = filename;
+        return item.isImage();
+    }
+    ThumbnailService *m_thumbnails;
     TicketDialog *m_dialog;
-    mutable QRect m_lastThumbRect;
 };
 
 TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QWidget *parent, Mode mode)
@@ -158,9 +201,10 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         priorityCombo = new QComboBox(this);
         priorityCombo->addItem("Loading priorities...", -1);
         
-        qDebug() << "Creating assignee combo...";
-        assigneeCombo = new QComboBox(this);
-        assigneeCombo->addItem("Loading assignees...", "");
+        qDebug() << "Creating assignee picker...";
+        assigneePicker = new AssigneePicker(this);
+        if (mode == Edit && !ticket.assigneeId.isEmpty())
+            assigneePicker->setCurrentUser(ticket.assigneeId, ticket.assignee);
         
         qDebug() << "Creating tab widget...";
         QTabWidget *tabWidget = new QTabWidget(this);
@@ -179,7 +223,7 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         overviewLayout->addWidget(new QLabel("Priority", this));
         overviewLayout->addWidget(priorityCombo);
         overviewLayout->addWidget(new QLabel("Assignee", this));
-        overviewLayout->addWidget(assigneeCombo);
+        overviewLayout->addWidget(assigneePicker);
         
         QHBoxLayout *overviewBtnLayout = new QHBoxLayout();
         overviewCancelBtn = new QPushButton("Cancel", overviewTab);
@@ -213,8 +257,9 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         commentsTab = new QWidget(this);
         QVBoxLayout *commentsLayout = new QVBoxLayout(commentsTab);
         m_commentModel = new CommentModel(this);
-        m_commentsListView = new QListView(commentsTab);
+        m_commentsListView = new CommentListView(commentsTab);
         m_commentsListView->setModel(m_commentModel);
+        m_commentsListView->setItemDelegate(new CommentDelegate(m_commentModel, m_commentsListView));
         m_newCommentEdit = new QTextEdit(commentsTab);
         m_newCommentEdit->setPlaceholderText("Write a comment...");
         m_postCommentBtn = new QPushButton("Post Comment", commentsTab);
@@ -225,6 +270,7 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         commentsTab->setLayout(commentsLayout);
         tabWidget->addTab(commentsTab, "Comments");
         connect(m_postCommentBtn, &QPushButton::clicked, this, &TicketDialog::postNewComment);
+        connect(m_commentModel, &CommentModel::fetchMoreRequested, this, &TicketDialog::requestCommentsPage);
         m_commentsListView->setContextMenuPolicy(Qt::CustomContextMenu);
         connect(m_commentsListView, &QListView::customContextMenuRequested, this, [this](const QPoint &pos) {
             QModelIndex index = m_commentsListView->indexAt(pos);
@@ -250,9 +296,9 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
                     QNetworkRequest request(url);
                     request.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
                     QNetworkReply *reply = network->deleteResource(request);
-                    connect(reply, &QNetworkReply::finished, this, [this, reply, row=index.row()]() {
+                    connect(reply, &QNetworkReply::finished, this, [this, reply, commentId = comment.id]() {
                         if (reply->error() == QNetworkReply::NoError) {
-                            m_commentModel->removeComment(row);
+                            m_commentModel->removeComment(m_commentModel->rowOf(commentId));
                         } else {
                             QMessageBox::warning(this, "Error", "Failed to delete comment: " + reply->errorString());
                         }
@@ -273,9 +319,33 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         m_attachmentsListView->setWrapping(false);
         attachmentsLayout->addWidget(new QLabel("Attachments:", attachmentsTab));
         attachmentsLayout->addWidget(m_attachmentsListView);
-        m_uploadAttachmentBtn = new QPushButton("Upload file", attachmentsTab);
-        attachmentsLayout->addWidget(m_uploadAttachmentBtn);
+        m_uploadQueue = new UploadQueueWidget(m_jwtToken, m_ticket.id, m_ticket.createdAtRaw, attachmentsTab);
+        m_uploadQueue->acceptDropsOn(attachmentsTab);
+        m_uploadQueue->acceptDropsOn(m_attachmentsListView->viewport());
+        connect(m_uploadQueue, &UploadQueueWidget::attachmentUploaded, this, [this](const QJsonObject &obj) {
+            m_attachmentModel->addAttachment(AttachmentItem::fromJson(obj));
+        });
+        attachmentsLayout->addWidget(m_uploadQueue);
+        attachmentsLayout->addWidget(new QLabel("Drop files here to attach them", attachmentsTab));
+        const ImageUploadSettings imageSettings = Config::instance().imageUploadSettings(m_ticket.departmentId);
+        m_uploadQueue->setImageUploadSettings(imageSettings);
+        QCheckBox *optimizeImagesCheck = new QCheckBox(
+            QString("Downscale images to %1 px and recompress before upload").arg(imageSettings.maxDimension), attachmentsTab);
+        optimizeImagesCheck->setChecked(imageSettings.optimize);
+        connect(optimizeImagesCheck, &QCheckBox::toggled, this, [this](bool checked) {
+            ImageUploadSettings settings = m_uploadQueue->imageUploadSettings();
+            settings.optimize = checked;
+            m_uploadQueue->setImageUploadSettings(settings);
+        });
+        attachmentsLayout->addWidget(optimizeImagesCheck);
+        QHBoxLayout *attachmentButtonsLayout = new QHBoxLayout;
+        m_uploadAttachmentBtn = new QPushButton("Upload files...", attachmentsTab);
+        QPushButton *saveAllBtn = new QPushButton("Download all (zip)...", attachmentsTab);
+        attachmentButtonsLayout->addWidget(m_uploadAttachmentBtn);
+        attachmentButtonsLayout->addWidget(saveAllBtn);
+        attachmentsLayout->addLayout(attachmentButtonsLayout);
         connect(m_uploadAttachmentBtn, &QPushButton::clicked, this, &TicketDialog::uploadAttachment);
+        connect(saveAllBtn, &QPushButton::clicked, this, &TicketDialog::saveAllAttachments);
         attachmentsTab->setLayout(attachmentsLayout);
         tabWidget->addTab(attachmentsTab, "Attachments");
         // Context menu for delete
@@ -283,6 +353,10 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         connect(m_attachmentsListView, &QListView::customContextMenuRequested, this, [this](const QPoint &pos) {
             QModelIndex index = m_attachmentsListView->indexAt(pos);
             QMenu menu;
+            QAction *viewTextAction = menu.addAction("View as text");
+            viewTextAction->setEnabled(index.isValid());
+            QAction *saveAction = menu.addAction("Save as...");
+            saveAction->setEnabled(index.isValid());
             QAction *deleteAction = menu.addAction("Delete");
             bool canDelete = false;
             if (index.isValid()) {
@@ -293,7 +367,11 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
                 deleteAction->setEnabled(false);
             }
             QAction *selected = menu.exec(m_attachmentsListView->viewport()->mapToGlobal(pos));
-            if (selected == deleteAction) {
+            if (selected == viewTextAction) {
+                openAttachmentText(m_attachmentModel->getAttachment(index.row()));
+            } else if (selected == saveAction) {
+                saveAttachmentAs(m_attachmentModel->getAttachment(index.row()));
+            } else if (selected == deleteAction) {
                 if (!canDelete) {
                     QMessageBox::information(this, "No permission", "You cannot delete this attachment.");
                     return;
@@ -311,7 +389,29 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
                 }
             }
         });
-        m_attachmentsListView->setItemDelegate(new AttachmentDelegate(m_ticket.id, &m_attachmentPixmaps, this, m_attachmentsListView));
+        connect(m_attachmentsListView, &QListView::doubleClicked, this, [this](const QModelIndex &index) {
+            AttachmentItem att = m_attachmentModel->getAttachment(index.row());
+            if (att.isImage()) return;
+            if (att.isKnownBinary()) {
+                saveAttachmentAs(att);
+            } else {
+                openAttachmentText(att, true);
+            }
+        });
+        m_thumbnails = new ThumbnailService(m_jwtToken, m_attachmentsListView->devicePixelRatioF(), this);
+        m_attachmentsListView->setItemDelegate(new AttachmentDelegate(m_thumbnails, this, m_attachmentsListView));
+        connect(m_thumbnails, &ThumbnailService::thumbnailReady, this, &TicketDialog::onAttachmentThumbnailReady);
+        // Thumbnails are requested for visible rows only, once scrolling settles.
+        m_thumbnailTimer = new QTimer(this);
+        m_thumbnailTimer->setSingleShot(true);
+        m_thumbnailTimer->setInterval(50);
+        connect(m_thumbnailTimer, &QTimer::timeout, this, &TicketDialog::requestVisibleThumbnails);
+        auto scheduleThumbnails = [this]() { m_thumbnailTimer->start(); };
+        connect(m_attachmentsListView->verticalScrollBar(), &QScrollBar::valueChanged, this, scheduleThumbnails);
+        connect(m_attachmentsListView->verticalScrollBar(), &QScrollBar::rangeChanged, this, scheduleThumbnails);
+        connect(m_attachmentModel, &QAbstractItemModel::modelReset, this, scheduleThumbnails);
+        connect(m_attachmentModel, &QAbstractItemModel::rowsInserted, this, scheduleThumbnails);
+        connect(tabWidget, &QTabWidget::currentChanged, this, scheduleThumbnails);
         
         mainLayout->addWidget(tabWidget);
         
@@ -323,7 +423,7 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         
         qDebug() << "Creating network manager...";
         network = new QNetworkAccessManager(this);
-        m_attachmentImageManager = new QNetworkAccessManager(this);
+        m_downloads = new DownloadManager(m_jwtToken, this);
         
         qDebug() << "Setting focus...";
         titleEdit->setFocus();
@@ -333,10 +433,12 @@ TicketDialog::TicketDialog(const TicketItem &ticket, const QString &jwtToken, QW
         QTimer::singleShot(180, this, [this]{ loadPriorities(); });
         
         connect(departmentCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]{
-            int deptId = departmentCombo->currentData().toInt();
-            filterAssigneesByDepartment(deptId);
+            assigneePicker->setDepartment(departmentCombo->currentData().toInt());
+        });
+        connect(assigneePicker, &AssigneePicker::selectionChanged, this, [this](const QString &userId){
+            overviewSaveBtn->setEnabled(!userId.isEmpty());
         });
-        QTimer::singleShot(220, this, [this]{ loadUsers(); });
+        overviewSaveBtn->setEnabled(!assigneePicker->selectedUserId().isEmpty());
         
         if (mode == Edit && !ticket.id.isEmpty()) {
             loadHistory();
@@ -435,6 +537,8 @@ void TicketDialog::loadDepartments() {
                     QJsonArray arr = doc.array();
                     qDebug() << "Department array size:" << arr.size();
                     
+                    // Populate silently so the assignee picker only sees the final department.
+                    QSignalBlocker blocker(departmentCombo);
                     departmentCombo->clear();
                     bool hasValid = false;
                     
@@ -468,7 +572,13 @@ void TicketDialog::loadDepartments() {
                                 break; 
                             }
                         }
+                        if (m_mode == Edit) {
+                            int ticketIdx = departmentCombo->findData(m_ticket.departmentId);
+                            if (ticketIdx >= 0) idx = ticketIdx;
+                        }
                         departmentCombo->setCurrentIndex(idx);
+                        blocker.unblock();
+                        assigneePicker->setDepartment(departmentCombo->currentData().toInt());
                         qDebug() << "Set department combo to index:" << idx;
                     } else {
                         departmentCombo->addItem("No departments available", -1);
@@ -533,6 +643,10 @@ void TicketDialog::loadStatuses() {
                 for (int i = 0; i < statusCombo->count(); ++i) {
                     if (statusCombo->itemData(i).toInt() > 0) { idx = i; break; }
                 }
+                if (m_mode == Edit) {
+                    int ticketIdx = statusCombo->findData(m_ticket.statusId);
+                    if (ticketIdx >= 0) idx = ticketIdx;
+                }
                 statusCombo->setCurrentIndex(idx);
             } else {
                 statusCombo->addItem("No statuses available", -1);
@@ -582,6 +696,10 @@ void TicketDialog::loadPriorities() {
                 for (int i = 0; i < priorityCombo->count(); ++i) {
                     if (priorityCombo->itemData(i).toInt() > 0) { idx = i; break; }
                 }
+                if (m_mode == Edit) {
+                    int ticketIdx = priorityCombo->findData(m_ticket.priorityId);
+                    if (ticketIdx >= 0) idx = ticketIdx;
+                }
                 priorityCombo->setCurrentIndex(idx);
             } else {
                 priorityCombo->addItem("No priorities available", -1);
@@ -595,81 +713,6 @@ void TicketDialog::loadPriorities() {
     qDebug() << "=== loadPriorities() END ===";
 }
 
-void TicketDialog::loadUsers() {
-    if (!network) return;
-    QNetworkRequest req(QUrl(Config::instance().fullApiUrl() + "/users"));
-    QNetworkReply *reply = network->get(req);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QJsonDocument doc = QJsonDocument::fromJson(data);
-            if (doc.isNull() || !doc.isArray()) {
-                assigneeCombo->clear();
-                assigneeCombo->addItem("Invalid user response", "");
-                return;
-            }
-            QJsonArray arr = doc.array();
-            users.clear();
-            assigneeCombo->clear();
-            for (const QJsonValue &v : arr) {
-                if (!v.isObject()) continue;
-                QJsonObject o = v.toObject();
-                QString userId = o.value("user_id").toString();
-                if (userId.isEmpty()) userId = o.value("id").toString();
-                QString username = o.value("username").toString();
-                int deptId = o.value("department_id").toInt(-1);
-                if (!userId.isEmpty() && !username.isEmpty() && deptId > 0) {
-                    users.append({username, userId, deptId});
-                }
-            }
-            qDebug() << "Loaded users:";
-            for (const auto &u : users) {
-                qDebug() << u.username << u.userId << u.departmentId;
-            }
-            if (users.isEmpty())
-                assigneeCombo->addItem("No users available", "");
-            for (const auto &user : users) {
-                assigneeCombo->addItem(user.username, user.userId);
-            }
-            if (!users.isEmpty()) {
-                assigneeCombo->setCurrentIndex(0);
-                overviewSaveBtn->setEnabled(true);
-            } else {
-                overviewSaveBtn->setEnabled(false);
-            }
-        } else {
-            assigneeCombo->clear();
-            assigneeCombo->addItem("Failed to load users", "");
-        }
-        reply->deleteLater();
-    });
-}
-
-void TicketDialog::filterAssigneesByDepartment(int departmentId) {
-    assigneeCombo->clear();
-    QVector<int> validIndexes;
-    for (int i = 0; i < users.size(); ++i) {
-        const auto &user = users[i];
-        if (departmentId <= 0 || user.departmentId == departmentId) {
-            assigneeCombo->addItem(user.username, user.userId);
-            validIndexes.append(i);
-        }
-    }
-    if (validIndexes.isEmpty() && !users.isEmpty()) {
-        const auto &user = users[0];
-        assigneeCombo->addItem(user.username, user.userId);
-        assigneeCombo->setCurrentIndex(0);
-        overviewSaveBtn->setEnabled(true);
-    } else if (validIndexes.isEmpty()) {
-        assigneeCombo->addItem("No assignees for department", "");
-        assigneeCombo->setCurrentIndex(0);
-        overviewSaveBtn->setEnabled(false);
-    } else {
-        assigneeCombo->setCurrentIndex(0);
-        overviewSaveBtn->setEnabled(true);
-    }
-}
-
 void TicketDialog::onSaveClicked() {
     qDebug() << "=== onSaveClicked() START ===";
     
@@ -688,13 +731,11 @@ void TicketDialog::onSaveClicked() {
         return;
     }
     
-    QString assigneeId = assigneeCombo->currentData().toString();
-    qDebug() << "Assignee combo count:" << assigneeCombo->count();
-    qDebug() << "Current index:" << assigneeCombo->currentIndex();
-    qDebug() << "Current text:" << assigneeCombo->currentText();
-    qDebug() << "Current data:" << assigneeId;
+    QString assigneeId = assigneePicker->selectedUserId();
+    qDebug() << "Assignee:" << assigneePicker->text() << assigneeId;
     if (assigneeId.isEmpty()) {
-        QMessageBox::warning(this, "Error", "No available assignees");
+        QMessageBox::warning(this, "Error", "Please pick an assignee from the list");
+        assigneePicker->setFocus();
         return;
     }
     
@@ -703,29 +744,65 @@ void TicketDialog::onSaveClicked() {
     qDebug() << "Status ID:" << statusId;
     qDebug() << "Priority ID:" << priorityId;
     
+    const QString title = titleEdit->text().trimmed();
+    const QString description = descEdit->toPlainText().trimmed();
+    const bool editing = m_mode == Edit && !m_ticket.id.isEmpty();
+    // When editing, send only what differs from the loaded ticket: the server writes
+    // just those columns and records history just for them.
     QJsonObject obj;
-    obj["title"] = titleEdit->text().trimmed();
-    obj["description"] = descEdit->toPlainText().trimmed();
-    obj["department_id"] = deptId;
-    obj["status_id"] = statusId;
-    obj["priority_id"] = priorityId;
-    obj["assignee_id"] = assigneeId;
+    if (!editing || title != m_ticket.title)
+        obj["title"] = title;
+    if (!editing || description != m_ticket.description.trimmed())
+        obj["description"] = description;
+    if (!editing || deptId != m_ticket.departmentId)
+        obj["department_id"] = deptId;
+    if (!editing || statusId != m_ticket.statusId)
+        obj["status_id"] = statusId;
+    if (!editing || priorityId != m_ticket.priorityId)
+        obj["priority_id"] = priorityId;
+    if (!editing || assigneeId != m_ticket.assigneeId)
+        obj["assignee_id"] = assigneeId;
     
     qDebug() << "JSON object created:" << QJsonDocument(obj).toJson();
-    
-    APIClient *api = new APIClient(this);
-    connect(api, &APIClient::ticketCreated, this, [this](const QByteArray &data){
-        emit ticketSaved();
+    if (editing && obj.isEmpty()) {
+        qDebug() << "No changes, nothing to save";
         accept();
-    });
-    connect(api, &APIClient::apiError, this, [this](const QString &err){
-        QMessageBox::warning(this, "Error", err);
-    });
-    if (m_mode == Edit && !m_ticket.id.isEmpty()) {
-        api->updateTicket(m_jwtToken, m_ticket.id, obj);
+        return;
+    }
+    
+    if (!m_journal) {
+        qWarning() << "TicketDialog: no mutation journal, cannot save";
+        return;
+    }
+    TicketItem pending = m_ticket;
+    pending.title = title;
+    pending.description = description;
+    pending.departmentId = deptId;
+    pending.department = departmentCombo->currentText();
+    pending.statusId = statusId;
+    pending.status = TicketItem::statusLabels.value(statusId, statusCombo->currentText());
+    pending.priorityId = priorityId;
+    pending.priority = TicketItem::priorityLabels.value(priorityId, priorityCombo->currentText());
+    pending.assigneeId = assigneeId;
+    pending.assignee = assigneePicker->text();
+    if (editing) {
+        emit ticketChangePending(pending);
+        m_journal->enqueue("patch_ticket", "PATCH", m_ticket.apiPath(), obj, m_ticket.id);
     } else {
-        api->createTicket(m_jwtToken, obj);
+        // Id and creation time are picked here, so the new ticket can be shown, edited
+        // and commented on before the server has seen it.
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        pending.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        pending.creatorId = m_userId;
+        pending.createdAt = now;
+        pending.createdAtRaw = now.toString(Qt::ISODateWithMs);
+        pending.updatedAt = now;
+        obj["ticket_id"] = pending.id;
+        obj["created_at"] = pending.createdAtRaw;
+        emit ticketChangePending(pending);
+        m_journal->enqueue("create_ticket", "POST", "/tickets", obj, pending.id);
     }
+    accept();
 }
 
 void TicketDialog::setCurrentTab(int index) {
@@ -734,9 +811,64 @@ void TicketDialog::setCurrentTab(int index) {
     }
 }
 
+void TicketDialog::setEventStream(EventStream *events) {
+    if (!events || m_ticket.id.isEmpty()) return;
+    // Changes are applied by id: deletions drop the row, rows already shown (such as
+    // the echo of our own comment) are left alone, and only unseen rows are fetched.
+    // Reloading would throw away the older comment pages the user scrolled to.
+    connect(events, &EventStream::commentsChanged, this, [this](const QString &ticketId, const RowChanges &changes) {
+        if (ticketId != m_ticket.id) return;
+        for (const QString &id : changes.deleted) m_commentModel->removeComment(m_commentModel->rowOf(id));
+        bool unseen = changes.unknown;
+        for (const QString &id : changes.upserted) unseen = unseen || m_commentModel->rowOf(id) < 0;
+        if (unseen) mergeNewestComments();
+    });
+    connect(events, &EventStream::attachmentsChanged, this, [this](const QString &ticketId, const RowChanges &changes) {
+        if (ticketId != m_ticket.id) return;
+        for (const QString &id : changes.deleted) m_attachmentModel->removeAttachment(m_attachmentModel->rowOf(id));
+        bool unseen = changes.unknown;
+        for (const QString &id : changes.upserted) unseen = unseen || m_attachmentModel->rowOf(id) < 0;
+        if (unseen) loadAttachments();
+    });
+    connect(events, &EventStream::ticketsChanged, this, [this](const QVector<TicketItem> &updated, const QStringList &) {
+        for (const TicketItem &ticket : updated) {
+            if (ticket.id == m_ticket.id) {
+                loadHistory();
+                break;
+            }
+        }
+    });
+}
+
+void TicketDialog::setJournal(MutationJournal *journal) {
+    m_journal = journal;
+    if (!journal || m_ticket.id.isEmpty()) return;
+    auto commentRow = [this](const JournalEntry &entry) {
+        if (entry.kind != "add_comment" || entry.ticketId != m_ticket.id) return -1;
+        const QString commentId = entry.body.value("comment_id").toString();
+        for (int row = 0; row < m_commentModel->rowCount(); ++row) {
+            if (m_commentModel->getComment(row).id == commentId) return row;
+        }
+        return -1;
+    };
+    connect(journal, &MutationJournal::succeeded, this, [this, commentRow](const JournalEntry &entry, const QJsonObject &response) {
+        const int row = commentRow(entry);
+        if (row < 0) return;
+        CommentItem comment = m_commentModel->getComment(row);
+        comment.createdAt = QDateTime::fromString(response.value("created_at").toString(), Qt::ISODate);
+        comment.authorName = response.value("author_name").toString(comment.authorName);
+        comment.authorId = response.value("author_id").toString(comment.authorId);
+        m_commentModel->updateComment(row, comment);
+    });
+    connect(journal, &MutationJournal::failed, this, [this, commentRow](const JournalEntry &entry, const QString &) {
+        const int row = commentRow(entry);
+        if (row >= 0) m_commentModel->removeComment(row);
+    });
+}
+
 void TicketDialog::loadHistory() {
     if (!network || m_ticket.id.isEmpty()) return;
-    QUrl url(Config::instance().fullApiUrl() + "/tickets/" + m_ticket.id + "/history");
+    QUrl url(Config::instance().fullApiUrl() + m_ticket.apiPath("/history"));
     qDebug() << "Requesting history for ticket:" << m_ticket.id << "with token:" << m_jwtToken;
     QNetworkRequest req(url);
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
@@ -757,13 +889,8 @@ void TicketDialog::loadHistory() {
                     QDateTime dt = QDateTime::fromString(dateIso, Qt::ISODate);
                     QString date = dt.isValid() ? dt.toString("dd.MM.yyyy") : dateIso;
                     QString userId = o.value("changed_by").toString();
-                    QString user = userId;
-                    for (const auto &u : users) {
-                        if (u.userId == userId) {
-                            user = u.username;
-                            break;
-                        }
-                    }
+                    const UserInfo *changedBy = UserDirectory::instance().userById(userId);
+                    QString user = changedBy ? changedBy->username : userId;
                     QString field = o.value("field_name").toString();
                     QString oldValue = o.value("old_value").toString();
                     QString newValue = o.value("new_value").toString();
@@ -801,20 +928,60 @@ void TicketDialog::loadComments() {
         m_commentModel->clearComments();
         return;
     }
-    QUrl url(Config::instance().fullApiUrl() + "/tickets/" + m_ticket.id + "/comments");
+    requestCommentsPage(QString());
+}
+
+void TicketDialog::requestCommentsPage(const QString &cursor) {
+    QUrl url(Config::instance().fullApiUrl() + m_ticket.apiPath("/comments"));
+    QUrlQuery query(url);
+    query.addQueryItem("limit", QString::number(CommentPageSize));
+    if (!cursor.isEmpty()) query.addQueryItem("before", cursor);
+    url.setQuery(query);
     QNetworkRequest request(url);
     request.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
     QNetworkReply *reply = network->get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply, cursor]() {
         if (reply->error() == QNetworkReply::NoError) {
             QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            if (doc.isArray()) {
-                m_commentModel->loadComments(doc.array());
+            if (doc.isObject()) {
+                QJsonObject page = doc.object();
+                QJsonArray items = page.value("items").toArray();
+                QString nextCursor = page.value("next_cursor").toString();
+                if (cursor.isEmpty()) {
+                    m_commentModel->loadComments(items, nextCursor);
+                } else {
+                    m_commentModel->prependComments(items, nextCursor);
+                }
             } else {
-                qWarning() << "Expected JSON array for comments, but got something else.";
+                qWarning() << "Expected JSON page object for comments, but got something else.";
+                m_commentModel->fetchFailed();
             }
         } else {
             qWarning() << "Failed to load comments:" << reply->errorString();
+            m_commentModel->fetchFailed();
+        }
+        reply->deleteLater();
+    });
+}
+
+void TicketDialog::mergeNewestComments() {
+    QUrl url(Config::instance().fullApiUrl() + m_ticket.apiPath("/comments"));
+    QUrlQuery query(url);
+    query.addQueryItem("limit", QString::number(CommentPageSize));
+    url.setQuery(query);
+    QNetworkRequest request(url);
+    request.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
+    QNetworkReply *reply = network->get(request);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        if (reply->error() == QNetworkReply::NoError) {
+            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
+            if (doc.isObject()) {
+                m_commentModel->mergeNewest(doc.object().value("items").toArray());
+            } else {
+                qWarning() << "Expected JSON page object for comments, but got something else.";
+            }
+        } else {
+            qWarning() << "Failed to load new comments:" << reply->errorString();
         }
         reply->deleteLater();
     });
@@ -825,7 +992,7 @@ void TicketDialog::loadAttachments() {
         m_attachmentModel->clearAttachments();
         return;
     }
-    QUrl url(Config::instance().fullApiUrl() + "/tickets/" + m_ticket.id + "/attachments");
+    QUrl url(Config::instance().fullApiUrl() + m_ticket.apiPath("/attachments"));
     QNetworkRequest request(url);
     request.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
     QNetworkReply *reply = network->get(request);
@@ -846,80 +1013,62 @@ void TicketDialog::loadAttachments() {
 
 void TicketDialog::postNewComment() {
     QString content = m_newCommentEdit->toPlainText().trimmed();
-    if (content.isEmpty() || m_ticket.id.isEmpty()) {
+    if (content.isEmpty() || m_ticket.id.isEmpty() || !m_journal) {
         return;
     }
     CommentItem newComment;
+    newComment.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
     newComment.ticketId = m_ticket.id;
     newComment.ticketCreatedAt = m_ticket.createdAt;
     newComment.content = content;
     newComment.createdAt = QDateTime::currentDateTimeUtc();
     newComment.authorId = m_userId;
     newComment.authorName = "";
-    QUrl url(Config::instance().fullApiUrl() + "/tickets/" + m_ticket.id + "/comments");
-    QNetworkRequest request(url);
-    request.setRawHeader("Content-Type", "application/json");
-    request.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
     QJsonObject commentJson;
+    commentJson["comment_id"] = newComment.id;
     commentJson["content"] = content;
     commentJson["ticket_created_at"] = m_ticket.createdAtRaw;
-    QNetworkReply *reply = network->post(request, QJsonDocument(commentJson).toJson(QJsonDocument::Compact));
-    connect(reply, &QNetworkReply::finished, this, [this, reply, newComment]() mutable {
-        if (reply->error() == QNetworkReply::NoError) {
-            QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
-            if (doc.isObject()) {
-                QJsonObject responseObj = doc.object();
-                newComment.id = responseObj.value("comment_id").toString();
-                newComment.createdAt = QDateTime::fromString(responseObj.value("created_at").toString(), Qt::ISODate);
-                newComment.authorName = responseObj.value("author_name").toString(newComment.authorName);
-                newComment.authorId = responseObj.value("author_id").toString(newComment.authorId);
-            }
-            m_commentModel->addComment(newComment);
-            m_newCommentEdit->clear();
-            m_commentsListView->scrollToBottom();
-        } else {
-            qWarning() << "Failed to post comment:" << reply->errorString();
-        }
-        reply->deleteLater();
-    });
-} 
+    // Shown right away; the journal's answer fills in the server's fields.
+    m_commentModel->addComment(newComment);
+    m_newCommentEdit->clear();
+    m_commentsListView->scrollToBottom();
+    m_journal->enqueue("add_comment", "POST", m_ticket.apiPath("/comments"), commentJson, m_ticket.id);
+}
 
 void TicketDialog::uploadAttachment() {
-    QString filePath = QFileDialog::getOpenFileName(this, "Select a file to attach");
-    if (filePath.isEmpty()) return;
-    APIClient *api = new APIClient(this);
-    connect(api, &APIClient::attachmentUploaded, this, [this]() {
-        loadAttachments();
-        QMessageBox::information(this, "Success", "File uploaded successfully.");
-    });
-    connect(api, &APIClient::apiError, this, [this](const QString &err) {
-        QMessageBox::warning(this, "Error", err);
-    });
-    api->uploadAttachment(m_jwtToken, m_ticket.id, filePath);
-} 
+    const QStringList paths = QFileDialog::getOpenFileNames(this, "Select files to attach");
+    if (paths.isEmpty()) return;
+    m_uploadQueue->enqueue(paths);
+}
 
-void TicketDialog::requestAttachmentImage(const QString &attId, const QString &ticketId) {
-    if (m_attachmentPixmaps.contains(attId)) return;
-    QString url = QString("%1/tickets/%2/attachments/%3/download").arg(Config::instance().fullApiUrl()).arg(ticketId).arg(attId);
-    QNetworkRequest req{QUrl(url)};
-    req.setRawHeader("Authorization", "Bearer " + m_jwtToken.toUtf8());
-    QNetworkReply *reply = m_attachmentImageManager->get(req);
-    connect(reply, &QNetworkReply::finished, this, [this, reply, attId]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QPixmap pix;
-            bool ok = pix.loadFromData(data);
-            qDebug() << "Attachment image loaded for" << attId << "success:" << ok << "size:" << pix.size() << "data size:" << data.size();
-            m_attachmentPixmaps[attId] = pix;
-            onAttachmentImageLoaded(attId, pix);
-        } else {
-            qDebug() << "Failed to load image for" << attId << ":" << reply->errorString();
-        }
-        reply->deleteLater();
-    });
+void TicketDialog::requestVisibleThumbnails() {
+    if (!m_attachmentsListView->isVisible()) {
+        m_thumbnails->retainOnly({});
+        return;
+    }
+    const QRect viewport = m_attachmentsListView->viewport()->rect();
+    QModelIndex first = m_attachmentsListView->indexAt(viewport.topLeft());
+    if (!first.isValid()) first = m_attachmentModel->index(0);
+    QModelIndex last = m_attachmentsListView->indexAt(viewport.bottomLeft());
+    int lastRow = last.isValid() ? last.row() : m_attachmentModel->rowCount() - 1;
+    // One row of look-ahead on each side keeps short scrolls from showing placeholders.
+    int firstRow = qMax(0, first.row() - 1);
+    lastRow = qMin(m_attachmentModel->rowCount() - 1, lastRow + 1);
+    QSet<QString> visible;
+    QList<AttachmentItem> wanted;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        AttachmentItem att = m_attachmentModel->getAttachment(row);
+        if (!att.isImage()) continue;
+        visible.insert(att.id);
+        wanted.append(att);
+    }
+    m_thumbnails->retainOnly(visible);
+    for (const AttachmentItem &att : wanted) {
+        m_thumbnails->request(m_ticket.id, att.id);
+    }
 }
 
-void TicketDialog::onAttachmentImageLoaded(const QString &attId, const QPixmap &pixmap) {
+void TicketDialog::onAttachmentThumbnailReady(const QString &attId) {
     for (int row = 0; row < m_attachmentModel->rowCount(); ++row) {
         if (m_attachmentModel->getAttachment(row).id == attId) {
             QModelIndex idx = m_attachmentModel->index(row);
@@ -927,15 +1076,100 @@ void TicketDialog::onAttachmentImageLoaded(const QString &attId, const QPixmap &
             break;
         }
     }
-} 
+}
 
-void TicketDialog::showImagePreview(const QPixmap &pixmap) {
+QUrl TicketDialog::attachmentDownloadUrl(const QString &attId) const {
+    return QUrl(QString("%1/tickets/%2/attachments/%3/download").arg(Config::instance().fullApiUrl()).arg(m_ticket.id).arg(attId));
+}
+
+void TicketDialog::openAttachmentPreview(const QString &attId) {
+    // Attachments are immutable, so a completed download in the cache can be reused as is.
+    const QString cachePath = attachmentCachePath(attId);
+    if (touchCachedAttachment(cachePath)) {
+        showImagePreview(cachePath);
+        return;
+    }
+    DownloadTask *task = m_downloads->download(attachmentDownloadUrl(attId), cachePath);
+    connect(task, &DownloadTask::finished, this, &trimAttachmentCache);
+    connect(task, &DownloadTask::finished, this, &TicketDialog::showImagePreview, Qt::UniqueConnection);
+    connect(task, &DownloadTask::failed, this, [attId](const QString &error) {
+        qDebug() << "Failed to load image for" << attId << ":" << error;
+    });
+}
+
+void TicketDialog::openAttachmentText(const AttachmentItem &att, bool checkContent) {
+    auto show = [this, att, checkContent](const QString &path) {
+        const QString filename = att.filename;
+        if (checkContent && looksBinary(path)) {
+            if (QMessageBox::question(this, "Binary file", filename + " is not a text file. Save it instead?") == QMessageBox::Yes) {
+                saveAttachmentAs(att);
+            }
+            return;
+        }
+        LogViewerDialog *viewer = new LogViewerDialog(this);
+        if (!viewer->openFile(path, filename)) {
+            delete viewer;
+            QMessageBox::warning(this, "Error", "Cannot open " + filename);
+            return;
+        }
+        viewer->show();
+    };
+    const QString cachePath = attachmentCachePath(att.id);
+    if (touchCachedAttachment(cachePath)) {
+        show(cachePath);
+        return;
+    }
+    DownloadTask *task = m_downloads->download(attachmentDownloadUrl(att.id), cachePath);
+    showDownloadProgress(task, att.filename, this);
+    connect(task, &DownloadTask::finished, this, &trimAttachmentCache);
+    connect(task, &DownloadTask::finished, this, show);
+}
+
+void TicketDialog::saveAttachmentAs(const AttachmentItem &att) {
+    QString path = QFileDialog::getSaveFileName(this, "Save attachment", QDir::home().filePath(att.filename));
+    if (path.isEmpty()) return;
+    DownloadTask *task = m_downloads->download(attachmentDownloadUrl(att.id), path);
+    showDownloadProgress(task, att.filename, this);
+}
+
+void TicketDialog::saveAllAttachments() {
+    QString path = QFileDialog::getSaveFileName(this, "Save all attachments",
+        QDir::home().filePath(QString("ticket-%1-attachments.zip").arg(m_ticket.id)), "Zip archives (*.zip)");
+    if (path.isEmpty()) return;
+    const QUrl url(QString("%1/tickets/%2/attachments/archive").arg(Config::instance().fullApiUrl(), m_ticket.id));
+    showDownloadProgress(m_downloads->download(url, path), QFileInfo(path).fileName(), this);
+}
+
+void TicketDialog::showDownloadProgress(DownloadTask *task, const QString &label, QWidget *parent) {
+    auto *progress = new QProgressDialog(QString("Downloading %1...").arg(label), "Cancel", 0, 100, parent);
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    progress->setMinimumDuration(500);
+    connect(progress, &QProgressDialog::canceled, task, &DownloadTask::cancel);
+    connect(task, &DownloadTask::progress, progress, [progress, label](qint64 received, qint64 total) {
+        if (total > 0) {
+            progress->setValue(int(qMin<qint64>(99, received * 100 / total)));
+        } else {
+            progress->setRange(0, 0);
+        }
+        progress->setLabelText(QString("Downloading %1... %2").arg(label, progress->locale().formattedDataSize(received)));
+    });
+    connect(task, &DownloadTask::finished, progress, &QProgressDialog::close);
+    connect(task, &DownloadTask::failed, parent, [parent, progress](const QString &error) {
+        progress->close();
+        if (error != "Cancelled") QMessageBox::warning(parent, "Download failed", error);
+    });
+}
+
+void TicketDialog::showImagePreview(const QString &path) {
     if (!m_imagePreviewDialog) {
         m_imagePreviewDialog = new ImagePreviewDialog(this);
     }
-    m_imagePreviewDialog->setPixmap(pixmap);
     m_imagePreviewDialog->resize(qApp->primaryScreen()->size());
+    if (!m_imagePreviewDialog->setImageFile(path)) {
+        qDebug() << "Attachment is not a decodable image:" << path;
+        return;
+    }
     m_imagePreviewDialog->show();
     m_imagePreviewDialog->raise();
     m_imagePreviewDialog->activateWindow();
-} 
\ No newline at end of file
+}
@@ -6,8 +6,10 @@
 #include <QNetworkReply>
 #include <QComboBox>
 #include "models/comment_model.h"
+#include "views/comment_list_view.h"
 #include <QListView>
 #include "models/attachment_model.h"
+#include "network/thumbnail_service.h"
 #include <QFileDialog>
 #include <QNetworkAccessManager>
 #include <QMap>
@@ -23,31 +25,42 @@ class QWidget;
 class QLineEdit;
 class QTextEdit;
 class QTableView;
+class QTimer;
+class DownloadManager;
+class DownloadTask;
+class UploadQueueWidget;
+class AssigneePicker;
+class EventStream;
+class MutationJournal;
 
 class ImagePreviewDialog;
 
-struct UserInfo {
-    QString username;
-    QString userId;
-    int departmentId;
-};
-
 class TicketDialog : public QDialog {
     Q_OBJECT
 public:
     enum Mode { Create, Edit };
     TicketDialog(const TicketItem &ticket, const QString &jwt, QWidget *parent = nullptr, Mode mode = Edit);
-    void requestAttachmentImage(const QString &attId, const QString &ticketId);
+    void openAttachmentPreview(const QString &attId);
+    // With checkContent, a file that turns out to be binary is offered for saving instead.
+    void openAttachmentText(const AttachmentItem &att, bool checkContent = false);
     void setCurrentTab(int index);
-    void showImagePreview(const QPixmap &pixmap);
+    // Keeps the open tabs current with changes pushed by the server.
+    void setEventStream(EventStream *events);
+    // Saves and comments go through the journal, so the dialog never waits on the network.
+    void setJournal(MutationJournal *journal);
+    void showImagePreview(const QString &path);
+    // Progress dialog for a download; reports failures other than cancellation.
+    static void showDownloadProgress(DownloadTask *task, const QString &label, QWidget *parent);
 signals:
-    void ticketSaved();
+    // Emitted when a create or edit is queued, with the ticket as it will look once saved.
+    void ticketChangePending(const TicketItem &pending);
 private slots:
     void onSaveClicked();
 private:
     TicketItem m_ticket;
     QString m_jwtToken;
     Mode m_mode;
+    MutationJournal *m_journal = nullptr;
     QTabWidget *tabs;
     QWidget *overviewTab;
     QWidget *historyTab;
@@ -65,11 +78,10 @@ private:
     QComboBox *departmentCombo;
     QComboBox *statusCombo;
     QComboBox *priorityCombo;
-    QComboBox *assigneeCombo;
-    QVector<UserInfo> users;
+    AssigneePicker *assigneePicker;
     QPushButton *overviewSaveBtn = nullptr;
     QPushButton *overviewCancelBtn = nullptr;
-    QListView *m_commentsListView = nullptr;
+    CommentListView *m_commentsListView = nullptr;
     CommentModel *m_commentModel = nullptr;
     QTextEdit *m_newCommentEdit = nullptr;
     QPushButton *m_postCommentBtn = nullptr;
@@ -77,17 +89,23 @@ private:
     AttachmentModel *m_attachmentModel = nullptr;
     QPushButton *m_deleteAttachmentBtn = nullptr;
     QPushButton *m_uploadAttachmentBtn = nullptr;
-    QNetworkAccessManager *m_attachmentImageManager = nullptr;
-    QMap<QString, QPixmap> m_attachmentPixmaps;
-    void onAttachmentImageLoaded(const QString &attId, const QPixmap &pixmap);
+    UploadQueueWidget *m_uploadQueue = nullptr;
+    DownloadManager *m_downloads = nullptr;
+    ThumbnailService *m_thumbnails = nullptr;
+    QTimer *m_thumbnailTimer = nullptr;
+    void requestVisibleThumbnails();
+    void onAttachmentThumbnailReady(const QString &attId);
+    QUrl attachmentDownloadUrl(const QString &attId) const;
+    void saveAttachmentAs(const AttachmentItem &att);
+    void saveAllAttachments();
     void loadHistory();
     void loadComments();
+    void requestCommentsPage(const QString &cursor);
+    void mergeNewestComments();
     void loadAttachments();
     void loadDepartments();
     void loadStatuses();
     void loadPriorities();
-    void loadUsers();
-    void filterAssigneesByDepartment(int departmentId);
     void postNewComment();
     void decodeJwtToken();
     QString m_userRole;
@@ -96,37 +114,3 @@ private:
     void uploadAttachment();
     ImagePreviewDialog *m_imagePreviewDialog = nullptr;
 };
-
-class ImagePreviewDialog : public QDialog {
-    Q_OBJECT
-public:
-    ImagePreviewDialog(QWidget *parent = nullptr) : QDialog(parent) {
-        setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint);
-        setAttribute(Qt::WA_TranslucentBackground);
-        setModal(true);
-        QVBoxLayout *layout = new QVBoxLayout(this);
-        layout->setContentsMargins(0,0,0,0);
-        layout->setAlignment(Qt::AlignCenter);
-        m_label = new QLabel(this);
-        m_label->setAlignment(Qt::AlignCenter);
-        layout->addWidget(m_label);
-        setLayout(layout);
-    }
-    void setPixmap(const QPixmap &pix) {
-        m_label->setPixmap(pix.scaled(qApp->primaryScreen()->size() * 0.7, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-    }
-protected:
-    void paintEvent(QPaintEvent *event) override {
-        QPainter p(this);
-        p.setRenderHint(QPainter::Antialiasing);
-        p.fillRect(rect(), QColor(0,0,0,180));
-        QDialog::paintEvent(event);
-    }
-    void mousePressEvent(QMouseEvent *event) override {
-        if (!m_label->geometry().contains(event->pos())) {
-            close();
-        }
-    }
-private:
-    QLabel *m_label;
-}; 
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "upload_queue_widget.h"
+#include "../config.h"
+#include "network/upload_task.h"
+#include "image_optimizer.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QProgressBar>
+#include <QLabel>
+#include <QPushButton>
+#include <QFileInfo>
+#include <QMimeData>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QUrl>
+#include <QFile>
+#include <QThread>
+#include <QStandardPaths>
+#include <QPointer>
+#include <memory>
+#include <QDebug>
+
+static QStringList localFiles(const QMimeData *mime) {
+    QStringList paths;
+    if (!mime || !mime->hasUrls()) return paths;
+    for (const QUrl &url : mime->urls()) {
+        if (!url.isLocalFile()) continue;
+        const QString path = url.toLocalFile();
+        if (QFileInfo(path).isFile()) paths.append(path);
+    }
+    return paths;
+}
+
+UploadQueueWidget::UploadQueueWidget(const QString &jwtToken, const QString &ticketId, const QString &ticketCreatedAt,
+                                     QWidget *parent)
+    : QWidget(parent), m_jwtToken(jwtToken), m_ticketId(ticketId), m_ticketCreatedAt(ticketCreatedAt) {
+    m_layout = new QVBoxLayout(this);
+    m_layout->setContentsMargins(0, 0, 0, 0);
+    m_layout->setSpacing(2);
+    setVisible(false);
+}
+
+UploadQueueWidget::~UploadQueueWidget() {
+    // Tasks are children of this widget and go with it; their server-side chunks stay
+    // resumable for originals. Optimized copies are ours and go now.
+    for (const Row *row : std::as_const(m_rows)) {
+        if (!row->tempPath.isEmpty()) QFile::remove(row->tempPath);
+    }
+    qDeleteAll(m_rows);
+}
+
+void UploadQueueWidget::acceptDropsOn(QWidget *target) {
+    target->setAcceptDrops(true);
+    target->installEventFilter(this);
+}
+
+bool UploadQueueWidget::eventFilter(QObject *watched, QEvent *event) {
+    switch (event->type()) {
+    case QEvent::DragEnter:
+    case QEvent::DragMove: {
+        auto *drag = static_cast<QDragMoveEvent *>(event);
+        if (localFiles(drag->mimeData()).isEmpty()) return false;
+        drag->acceptProposedAction();
+        return true;
+    }
+    case QEvent::Drop: {
+        auto *drop = static_cast<QDropEvent *>(event);
+        const QStringList paths = localFiles(drop->mimeData());
+        if (paths.isEmpty()) return false;
+        drop->acceptProposedAction();
+        enqueue(paths);
+        return true;
+    }
+    default:
+        return QWidget::eventFilter(watched, event);
+    }
+}
+
+void UploadQueueWidget::enqueue(const QStringList &paths) {
+    for (const QString &path : paths) {
+        Row *row = new Row;
+        row->path = path;
+        row->widget = new QWidget(this);
+        QHBoxLayout *rowLayout = new QHBoxLayout(row->widget);
+        rowLayout->setContentsMargins(0, 0, 0, 0);
+        row->bar = new QProgressBar(row->widget);
+        row->bar->setRange(0, 1000);
+        row->bar->setValue(0);
+        row->label = new QLabel(QString("%1: queued").arg(QFileInfo(path).fileName()), row->widget);
+        row->button = new QPushButton("Cancel", row->widget);
+        row->dismissButton = new QPushButton("Dismiss", row->widget);
+        row->dismissButton->setVisible(false);
+        rowLayout->addWidget(row->bar, 1);
+        rowLayout->addWidget(row->label, 2);
+        rowLayout->addWidget(row->button);
+        rowLayout->addWidget(row->dismissButton);
+        connect(row->button, &QPushButton::clicked, this, [this, row]() { onButtonClicked(row); });
+        connect(row->dismissButton, &QPushButton::clicked, this, [this, row]() { removeRow(row); });
+        m_layout->addWidget(row->widget);
+        m_rows.append(row);
+    }
+    setVisible(!m_rows.isEmpty());
+    pump();
+}
+
+int UploadQueueWidget::activeCount() const {
+    int active = 0;
+    for (const Row *row : m_rows) {
+        if (row->task || row->preparing) ++active;
+    }
+    return active;
+}
+
+void UploadQueueWidget::pump() {
+    int active = activeCount();
+    const int limit = Config::instance().uploadMaxConcurrent();
+    for (Row *row : std::as_const(m_rows)) {
+        if (active >= limit) break;
+        if (row->task || row->preparing || row->failed) continue;
+        startRow(row);
+        ++active;
+    }
+}
+
+void UploadQueueWidget::startRow(Row *row) {
+    // A retry sends the same optimized copy, so the upload resumes where it stopped.
+    if (!row->tempPath.isEmpty() && QFile::exists(row->tempPath)) {
+        startUpload(row, row->tempPath, row->uploadName);
+        return;
+    }
+    if (!m_imageSettings.optimize) {
+        startUpload(row, row->path, QFileInfo(row->path).fileName());
+        return;
+    }
+    row->preparing = true;
+    row->button->setEnabled(false);
+    row->label->setText(QString("%1: optimizing").arg(QFileInfo(row->path).fileName()));
+    const QString path = row->path;
+    const ImageUploadSettings settings = m_imageSettings;
+    const QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation) + "/ticket-uploads";
+    auto result = std::make_shared<OptimizedImage>();
+    QThread *thread = QThread::create([path, settings, tempDir, result]() {
+        *result = optimizeImageForUpload(path, settings, tempDir);
+    });
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    // The queue may be gone by the time optimization finishes; nobody else would remove the copy then.
+    connect(thread, &QThread::finished, thread, [result, queue = QPointer<UploadQueueWidget>(this)]() {
+        if (!queue && result->optimized) QFile::remove(result->path);
+    });
+    connect(thread, &QThread::finished, this, [this, row, result]() {
+        row->preparing = false;
+        row->button->setEnabled(true);
+        if (result->optimized) {
+            row->tempPath = result->path;
+            row->uploadName = result->uploadName;
+            row->note = QString("optimized from %1, saved %2")
+                .arg(locale().formattedDataSize(result->originalBytes),
+                     locale().formattedDataSize(result->originalBytes - result->optimizedBytes));
+            qDebug() << "Optimized" << row->path << "from" << result->originalBytes << "to" << result->optimizedBytes << "bytes";
+        }
+        startUpload(row, result->path, result->uploadName);
+    });
+    thread->start();
+}
+
+void UploadQueueWidget::startUpload(Row *row, const QString &path, const QString &uploadName) {
+    UploadTask *task = new UploadTask(m_jwtToken, m_ticketId, m_ticketCreatedAt, path, this);
+    task->setUploadName(uploadName);
+    row->task = task;
+    const QString name = task->fileName();
+    row->label->setText(QString("%1: hashing").arg(name));
+    row->label->setToolTip(row->note);
+    connect(task, &UploadTask::progress, this, [this, row, name](qint64 sent, qint64 total, double bytesPerSecond, int etaSeconds) {
+        row->bar->setValue(total > 0 ? int(sent * 1000 / total) : 1000);
+        QString text = QString("%1: %2 of %3").arg(name, locale().formattedDataSize(sent), locale().formattedDataSize(total));
+        if (bytesPerSecond > 0) {
+            text += QString(", %1/s").arg(locale().formattedDataSize(qint64(bytesPerSecond)));
+        }
+        if (etaSeconds >= 0) {
+            text += QString(", %1:%2 left").arg(etaSeconds / 60).arg(etaSeconds % 60, 2, 10, QChar('0'));
+        }
+        if (!row->note.isEmpty()) text += QString(" (%1)").arg(row->note);
+        row->label->setText(text);
+    });
+    connect(task, &UploadTask::finished, this, [this, row](const QJsonObject &attachment) {
+        row->task = nullptr;
+        removeRow(row);
+        emit attachmentUploaded(attachment);
+        pump();
+    });
+    connect(task, &UploadTask::failed, this, [this, row, name](const QString &error) {
+        row->task = nullptr;
+        if (error == "Cancelled") {
+            removeRow(row);
+        } else {
+            // Keep the row so the user sees what failed; Retry resumes from the last acknowledged chunk.
+            row->failed = true;
+            row->label->setText(QString("%1: %2").arg(name, error));
+            row->button->setText("Retry");
+            row->dismissButton->setVisible(true);
+        }
+        pump();
+    });
+    task->start();
+}
+
+void UploadQueueWidget::onButtonClicked(Row *row) {
+    if (row->task) {
+        row->task->cancel();
+    } else if (row->failed) {
+        row->failed = false;
+        row->bar->setValue(0);
+        row->label->setText(QString("%1: queued").arg(QFileInfo(row->path).fileName()));
+        row->button->setText("Cancel");
+        row->dismissButton->setVisible(false);
+        pump();
+    } else {
+        removeRow(row);
+    }
+}
+
+void UploadQueueWidget::removeRow(Row *row) {
+    if (!row->tempPath.isEmpty()) QFile::remove(row->tempPath);
+    m_rows.removeOne(row);
+    row->widget->deleteLater();
+    delete row;
+    setVisible(!m_rows.isEmpty());
+}
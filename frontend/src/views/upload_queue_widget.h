@@ -0,0 +1,63 @@
+#pragma once
+#include <QWidget>
+#include <QList>
+#include <QJsonObject>
+#include <QStringList>
+#include "../config.h"
+
+class QVBoxLayout;
+class QProgressBar;
+class QLabel;
+class QPushButton;
+class UploadTask;
+
+// Queue of attachment uploads for one ticket, shown as one progress row per file.
+// At most Config::uploadMaxConcurrent() files are sent at once; the rest wait in
+// order. Widgets passed to acceptDropsOn() turn dropped local files into uploads.
+// With image optimization enabled, images are downscaled and re-encoded on a worker
+// thread before they are sent.
+class UploadQueueWidget : public QWidget {
+    Q_OBJECT
+public:
+    UploadQueueWidget(const QString &jwtToken, const QString &ticketId, const QString &ticketCreatedAt,
+                      QWidget *parent = nullptr);
+    ~UploadQueueWidget() override;
+    void enqueue(const QStringList &paths);
+    void acceptDropsOn(QWidget *target);
+    void setImageUploadSettings(const ImageUploadSettings &settings) { m_imageSettings = settings; }
+    ImageUploadSettings imageUploadSettings() const { return m_imageSettings; }
+    bool isBusy() const { return !m_rows.isEmpty(); }
+signals:
+    void attachmentUploaded(const QJsonObject &attachment);
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+private:
+    struct Row {
+        QString path;
+        QWidget *widget = nullptr;
+        QProgressBar *bar = nullptr;
+        QLabel *label = nullptr;
+        QPushButton *button = nullptr;
+        QPushButton *dismissButton = nullptr;
+        UploadTask *task = nullptr;
+        QString tempPath;   // re-encoded copy, kept across retries and deleted when the row is done
+        QString uploadName; // name the re-encoded copy is uploaded under
+        QString note;       // e.g. how much the optimization saved
+        bool preparing = false;
+        bool failed = false;
+    };
+
+    void pump();
+    void startRow(Row *row);
+    void startUpload(Row *row, const QString &path, const QString &uploadName);
+    void removeRow(Row *row);
+    void onButtonClicked(Row *row);
+    int activeCount() const;
+
+    QString m_jwtToken;
+    QString m_ticketId;
+    QString m_ticketCreatedAt;
+    ImageUploadSettings m_imageSettings;
+    QVBoxLayout *m_layout = nullptr;
+    QList<Row *> m_rows;
+};